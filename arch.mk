@@ -38,14 +38,14 @@ ifeq ($(ARCH),x86_64)
 	CFLAGS += -fopenmp -fPIC
 	CFLAGS += -O3 -ftree-vectorize
 	LDFLAGS += -fopenmp
-	LDLIBS += -lrt
+	LDLIBS += -lrt -lpthread
 endif
 
 # ARM11 (Raspberry Pi)
 ifeq ($(ARCH),armv6l)
 	CROSS_COMPILE = 
 	CFLAGS += -O3 -fPIC -Wno-unknown-pragmas
-	LDLIBS += -lrt
+	LDLIBS += -lrt -lpthread
 endif
 
 # Cortex-A8 (N900)
@@ -56,7 +56,7 @@ ifeq ($(ARCH),armv7l)
 #	CFLAGS += -O3 -ftree-vectorize -mfpu=neon -march=armv7-a -mvectorize-with-neon-quad -funsafe-math-optimizations
 	CFLAGS += -O3 -ftree-vectorize -mfpu=neon -mcpu=cortex-a7 -mtune=cortex-a7 -mvectorize-with-neon-quad -funsafe-math-optimizations
 	LDFLAGS += -fopenmp
-	LDLIBS += -lrt
+	LDLIBS += -lrt -lpthread
 endif
 
 ifeq ($(BUILD),release)
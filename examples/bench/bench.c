@@ -0,0 +1,128 @@
+/**
+ * @file
+ * @brief Measure all the transform engines in a single run.
+ *
+ * Usage: bench [-f csv|json] [-o file] [-e engines] [-s min] [-S max] [-V max]
+ * [-g growth] [-j levels] [-t threads] [-p strides] [-w warmup] [-n samples]
+ * [-q percentile] [-c counters] [-T trace] [-l]
+ *
+ * The lists (-j, -t, -p) are comma-separated, e.g. "-j 1,2,-1 -t 1,4".
+ * The engines are selected by their names or families, -l lists them.
+ * The hardware counters are given by their names, e.g. "-c cycles,l1d-misses"
+ * or "-c all", and reported per pixel. The phases of the last runs of each
+ * thread are written into the trace file given by -T (Chrome JSON).
+ */
+
+#include "libdwt.h"
+#include "bench.h"
+#include "trace.h"
+#include <stdlib.h>
+#include <string.h>
+
+int parse_list(const char *str, int *list)
+{
+	int count = 0;
+
+	while( *str && count < BENCH_LIST )
+	{
+		char *end;
+
+		list[count++] = (int)strtol(str, &end, 10);
+
+		if( end == str )
+			break;
+
+		str = (',' == *end) ? end+1 : end;
+	}
+
+	return count;
+}
+
+void usage(const char *name)
+{
+	fprintf(stderr, "Usage: %s [-f csv|json] [-o file] [-e engines] [-s min] [-S max] [-V max] [-g growth] [-j levels] [-t threads] [-p strides] [-w warmup] [-n samples] [-q percentile] [-c counters] [-T trace] [-l]\n", name);
+}
+
+int main(int argc, char *argv[])
+{
+	dwt_util_init();
+
+	struct bench_config_t config;
+
+	bench_config_default(&config);
+
+	enum bench_format format = BENCH_FORMAT_CSV;
+	const char *path = NULL;
+	const char *trace = NULL;
+
+	for(int i = 1; i < argc; i++)
+	{
+		const char *opt = argv[i];
+
+		if( !strcmp(opt, "-l") )
+		{
+			for(int n = 0; n < bench_engine_count(); n++)
+				printf("%s\t%s\t%i-D\n", bench_engine_get(n)->name, bench_engine_get(n)->family, bench_engine_get(n)->dims);
+			return 0;
+		}
+
+		if( '-' != opt[0] || !opt[1] || opt[2] || i+1 >= argc )
+		{
+			usage(argv[0]);
+			return 1;
+		}
+
+		const char *arg = argv[++i];
+
+		switch( opt[1] )
+		{
+			case 'f': format = !strcmp(arg, "json") ? BENCH_FORMAT_JSON : BENCH_FORMAT_CSV; break;
+			case 'o': path = arg; break;
+			case 'e': config.engines = arg; break;
+			case 's': config.size_min = atoi(arg); break;
+			case 'S': config.size_max = atoi(arg); break;
+			case 'V': config.volume_size_max = atoi(arg); break;
+			case 'g': config.growth = atof(arg); break;
+			case 'j': config.levels_count = parse_list(arg, config.levels); break;
+			case 't': config.threads_count = parse_list(arg, config.threads); break;
+			case 'p': config.opt_stride_count = parse_list(arg, config.opt_stride); break;
+			case 'w': config.warmup = atoi(arg); break;
+			case 'n': config.samples = atoi(arg); break;
+			case 'q': config.percentile = atof(arg); break;
+			case 'T': trace = arg; break;
+			case 'c':
+				config.counters = dwt_counters_parse(arg);
+				if( config.counters < 0 )
+					return 1;
+				break;
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+
+	FILE *out = path ? fopen(path, "w") : stdout;
+
+	if( !out )
+	{
+		dwt_util_log(LOG_ERR, "unable to open %s\n", path);
+		return 1;
+	}
+
+	if( trace )
+		dwt_trace_enable(1);
+
+	const int results = bench_run(&config, out, format);
+
+	dwt_util_log(LOG_INFO, "%i results\n", results);
+
+	if( trace )
+		dwt_util_log(LOG_INFO, "%i phases traced\n", dwt_trace_dump(trace));
+
+	if( path )
+		fclose(out);
+
+	dwt_util_finish();
+
+	return 0;
+}
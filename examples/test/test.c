@@ -5,6 +5,203 @@
  */
 
 #include "libdwt.h"
+#include "gabor.h"
+#include "dwt-lift.h"
+#include <math.h>
+#include <stdlib.h>
+
+/**
+ * @brief Round trip of the interleaved in-place integer CDF 9/7 transform.
+ *
+ * The levels of the images one or a few pixels tall (or wide) have
+ * columns (rows) of a single pixel.
+ */
+static
+int test_cdf97_2_inplace_i(
+	int size_x,
+	int size_y,
+	int j_max
+)
+{
+	const int stride_y = sizeof(int);
+	const int stride_x = size_x * stride_y;
+
+	void *data, *copy;
+
+	dwt_util_alloc_image(&data, stride_x, stride_y, size_x, size_y);
+	dwt_util_alloc_image(&copy, stride_x, stride_y, size_x, size_y);
+
+	dwt_util_test_image_fill_i(data, stride_x, stride_y, size_x, size_y, 0);
+	dwt_util_copy_i(data, copy, stride_x, stride_y, size_x, size_y);
+
+	int j = j_max;
+
+	dwt_cdf97_2f_inplace_i(data, stride_x, stride_y, size_x, size_y, size_x, size_y, &j, 1, 0);
+	dwt_cdf97_2i_inplace_i(data, stride_x, stride_y, size_x, size_y, size_x, size_y, j, 1, 0);
+
+	const int ret = dwt_util_compare_i(data, copy, stride_x, stride_y, size_x, size_y);
+
+	dwt_util_free_image(&data);
+	dwt_util_free_image(&copy);
+
+	return ret;
+}
+
+/**
+ * @brief Round trip of the interleaved in-place 16-bit integer transforms on full-range samples.
+ */
+static
+int test_inplace_i16(
+	int wavelet,	///< 53 or 97
+	int size_x,
+	int size_y,
+	int j_max
+)
+{
+	const int stride_y = sizeof(int16_t);
+	const int stride_x = size_x * stride_y;
+
+	int16_t *data = malloc(size_x * size_y * sizeof(int16_t));
+	int16_t *copy = malloc(size_x * size_y * sizeof(int16_t));
+
+	srand(42);
+
+	for(int i = 0; i < size_x * size_y; i++)
+		copy[i] = data[i] = (int16_t)rand();
+
+	int j = j_max;
+
+	if( 53 == wavelet )
+	{
+		dwt_cdf53_2f_inplace_i16(data, stride_x, stride_y, size_x, size_y, size_x, size_y, &j, 1, 0);
+		dwt_cdf53_2i_inplace_i16(data, stride_x, stride_y, size_x, size_y, size_x, size_y, j, 1, 0);
+	}
+	else
+	{
+		dwt_cdf97_2f_inplace_i16(data, stride_x, stride_y, size_x, size_y, size_x, size_y, &j, 1, 0);
+		dwt_cdf97_2i_inplace_i16(data, stride_x, stride_y, size_x, size_y, size_x, size_y, j, 1, 0);
+	}
+
+	int ret = 0;
+
+	for(int i = 0; i < size_x * size_y; i++)
+		if( data[i] != copy[i] )
+			ret = 1;
+
+	free(data);
+	free(copy);
+
+	return ret;
+}
+
+/**
+ * @brief Round trip of the generic lifting engine at the full depth.
+ *
+ * The odd sizes exercise the extension of the schemes at the boundaries.
+ */
+static
+int test_lift(
+	const struct dwt_lift_s *lift,
+	int size_x,
+	int size_y
+)
+{
+	const int stride_y = sizeof(float);
+	const int stride_x = size_x * stride_y;
+
+	float *data = malloc(size_x * size_y * sizeof(float));
+	float *copy = malloc(size_x * size_y * sizeof(float));
+
+	srand(42);
+
+	for(int i = 0; i < size_x * size_y; i++)
+		copy[i] = data[i] = (float)rand() / RAND_MAX;
+
+	int j = -1;
+
+	dwt_lift_2f_inplace_s(lift, data, stride_x, stride_y, size_x, size_y, size_x, size_y, &j, 0);
+	dwt_lift_2i_inplace_s(lift, data, stride_x, stride_y, size_x, size_y, size_x, size_y, j, 0);
+
+	int ret = 0;
+
+	for(int i = 0; i < size_x * size_y; i++)
+		if( fabsf(data[i] - copy[i]) > 1e-4f )
+			ret = 1;
+
+	free(data);
+	free(copy);
+
+	return ret;
+}
+
+/**
+ * @brief Compare the time-frequency planes of the recursive filters with the direct method.
+ *
+ * The magnitude and the argument planes are combined into the complex
+ * responses. Their greatest difference relative to the greatest magnitude
+ * must not exceed @p tolerance.
+ */
+static
+int test_gabor_iir(
+	int transform,	///< 0 for @ref gabor_ft_s, 1 for @ref gabor_wt_s
+	float sigma,
+	float tolerance
+)
+{
+	const int size = 2000, bins = 20;
+	const float freq = 5.f;
+
+	const int stride_y = sizeof(float);
+	const int stride_x = size * stride_y;
+
+	float *sig = NULL;
+	float *plane[2][2];
+
+	test_signal(&sig, stride_y, size, 0);
+
+	for(int m = 0; m < 2; m++)
+	{
+		gabor_set_method(m ? GABOR_IIR : GABOR_DIRECT);
+
+		for(int arg = 0; arg < 2; arg++)
+		{
+			plane[m][arg] = malloc(bins * stride_x);
+
+			if( transform )
+				(arg ? gabor_wt_arg_s : gabor_wt_s)(sig, stride_y, size, plane[m][arg], stride_x, stride_y, bins, sigma, freq);
+			else
+				(arg ? gabor_ft_arg_s : gabor_ft_s)(sig, stride_y, size, plane[m][arg], stride_x, stride_y, bins, sigma);
+		}
+	}
+
+	gabor_set_method(GABOR_DIRECT);
+
+	float err = 0.f, max = 0.f;
+
+	for(int i = 0; i < bins * size; i++)
+	{
+		const float mag_d = plane[0][0][i], arg_d = plane[0][1][i];
+		const float mag_r = plane[1][0][i], arg_r = plane[1][1][i];
+
+		const float re = mag_r * cosf(arg_r) - mag_d * cosf(arg_d);
+		const float im = mag_r * sinf(arg_r) - mag_d * sinf(arg_d);
+
+		// NaN fails
+		if( !(sqrtf(re*re + im*im) <= err) )
+			err = sqrtf(re*re + im*im);
+
+		max = fmaxf(max, mag_d);
+	}
+
+	dwt_util_log(LOG_INFO, "%s, sigma=%f: relative error %f\n", transform ? "WT" : "FT", sigma, err / max);
+
+	for(int m = 0; m < 2; m++)
+		for(int arg = 0; arg < 2; arg++)
+			free(plane[m][arg]);
+	free(sig);
+
+	return !(err <= tolerance * max);
+}
 
 int main()
 {
@@ -72,6 +269,71 @@ int main()
 	else
 		dwt_util_log(LOG_INFO, "success\n");
 
+	dwt_util_log(LOG_INFO, "Testing: CDF 9/7, 2D, int, in-place interleaved, decompose one pixel...\n");
+
+	{
+		const int sizes[][2] = { { 1000, 3 }, { 1000, 1 }, { 3, 1000 }, { 1, 1000 } };
+
+		for(int s = 0; s < 4; s++)
+		{
+			if( test_cdf97_2_inplace_i(sizes[s][0], sizes[s][1], 4) )
+				dwt_util_log(LOG_INFO, "fail\n");
+			else
+				dwt_util_log(LOG_INFO, "success\n");
+		}
+	}
+
+	dwt_util_log(LOG_INFO, "Testing: CDF 5/3 and 9/7, 2D, int16, in-place interleaved...\n");
+
+	for(int avx = 0; avx < 2; avx++)
+	{
+		dwt_util_set_avx(avx);
+
+		const int sizes[][2] = { { x, y }, { 1000, 999 }, { 77, 3 }, { 1, 100 } };
+
+		for(int s = 0; s < 4; s++)
+		{
+			if( test_inplace_i16(53, sizes[s][0], sizes[s][1], -1) || test_inplace_i16(97, sizes[s][0], sizes[s][1], -1) )
+				dwt_util_log(LOG_INFO, "fail\n");
+			else
+				dwt_util_log(LOG_INFO, "success\n");
+		}
+	}
+
+	dwt_util_set_avx(1);
+
+	dwt_util_log(LOG_INFO, "Testing: lifting engine, 2D, float, odd sizes...\n");
+
+	{
+		const char *names[] = { "haar", "daub4", "cdf53", "cdf97", "511", "137" };
+		const int sizes[][2] = { { 513, 257 }, { 33, 17 }, { 1000, 600 }, { 512, 512 } };
+
+		for(int n = 0; n < 6; n++)
+		{
+			for(int s = 0; s < 4; s++)
+			{
+				if( test_lift(dwt_lift_find_s(names[n]), sizes[s][0], sizes[s][1]) )
+					dwt_util_log(LOG_INFO, "fail\n");
+				else
+					dwt_util_log(LOG_INFO, "success\n");
+			}
+		}
+	}
+
+	dwt_util_log(LOG_INFO, "Testing: Gabor, recursive filters vs. direct...\n");
+
+	for(int transform = 0; transform < 2; transform++)
+	{
+		const float sigmas[] = { 5.f, 20.f, 60.f, 200.f };
+
+		for(int s = 0; s < 4; s++)
+		{
+			if( test_gabor_iir(transform, sigmas[s], 0.1f) )
+				dwt_util_log(LOG_INFO, "fail\n");
+			else
+				dwt_util_log(LOG_INFO, "success\n");
+		}
+	}
 
 	dwt_util_finish();
 
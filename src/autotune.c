@@ -0,0 +1,412 @@
+/**
+ * @brief Runtime selection of the fastest 2-D transform engine.
+ */
+
+#include "autotune.h"
+
+// dwt_util_log, dwt_cdf97_2f_inplace_s, dwt_util_get_clock
+#include "libdwt.h"
+
+// ceil_log2, ceil_div_pow2
+#include "inline.h"
+
+// dwt_cdf97_2f_dl_4x4_s
+#include "dwt-sym.h"
+
+// assert
+#include <assert.h>
+
+// errno, ENOENT
+#include <errno.h>
+
+// FILE, fopen, fgets, fprintf
+#include <stdio.h>
+
+// strcmp, strlen, strcpy
+#include <string.h>
+
+#if defined(__linux__) && !defined(__uClinux__)
+	#define AUTOTUNE_PTHREADS
+#endif
+
+#ifdef AUTOTUNE_PTHREADS
+	#include <pthread.h>
+#endif
+
+// the most winners in the memory, the oldest ones are replaced then
+#define AUTOTUNE_ENTRIES 256
+
+// untimed and timed runs of each engine
+#define AUTOTUNE_WARMUP 1
+#define AUTOTUNE_SAMPLES 5
+
+// the longest line of the cache file
+#define AUTOTUNE_LINE 512
+
+typedef void (*autotune_func_t)(void *, int, int, int, int, int, int, int *, int, int);
+
+static
+const struct {
+	const char *name;
+	autotune_func_t func;
+	int min_size;	///< the smallest size of the last level
+} autotune_engines[DWT_AUTOTUNE_LAST] = {
+	[DWT_AUTOTUNE_INPLACE]          = { "inplace",         dwt_cdf97_2f_inplace_s,         1 },
+	[DWT_AUTOTUNE_INPLACE_SEP]      = { "inplace_sep",     dwt_cdf97_2f_inplace_sep_s,     1 },
+	[DWT_AUTOTUNE_INPLACE_SEP_SDL]  = { "inplace_sep_sdl", dwt_cdf97_2f_inplace_sep_sdl_s, 1 },
+	[DWT_AUTOTUNE_INPLACE_SDL]      = { "inplace_sdl",     dwt_cdf97_2f_inplace_sdl_s,     1 },
+	[DWT_AUTOTUNE_DL_4X4]           = { "dl_4x4",          dwt_cdf97_2f_dl_4x4_s,          8 },
+};
+
+struct autotune_entry_t {
+	int threads;
+	int size_x;
+	int size_y;
+	int stride_x;
+	int stride_y;
+	int j;
+	int engine;
+};
+
+static struct autotune_entry_t autotune_entries[AUTOTUNE_ENTRIES];
+static int autotune_count = 0;
+static int autotune_next = 0;
+
+static char autotune_path[AUTOTUNE_LINE];
+
+#ifdef AUTOTUNE_PTHREADS
+static pthread_mutex_t autotune_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static
+int autotune_levels(
+	int size_x,
+	int size_y,
+	int j)
+{
+	const int j_limit = ceil_log2( min(size_x, size_y) );
+
+	if( j < 0 || j > j_limit )
+		j = j_limit;
+
+	return j;
+}
+
+static
+int autotune_eligible(
+	int engine,
+	int size_x,
+	int size_y,
+	int j)
+{
+	if( !j )
+		return 1;
+
+	// the size of the last level
+	return min(ceil_div_pow2(size_x, j-1), ceil_div_pow2(size_y, j-1)) >= autotune_engines[engine].min_size;
+}
+
+static
+struct autotune_entry_t *autotune_find(
+	const struct autotune_entry_t *key)
+{
+	for(int n = 0; n < autotune_count; n++)
+	{
+		struct autotune_entry_t *entry = &autotune_entries[n];
+
+		if( entry->threads == key->threads
+			&& entry->size_x == key->size_x && entry->size_y == key->size_y
+			&& entry->stride_x == key->stride_x && entry->stride_y == key->stride_y
+			&& entry->j == key->j )
+			return entry;
+	}
+
+	return NULL;
+}
+
+static
+void autotune_insert(
+	const struct autotune_entry_t *entry)
+{
+	struct autotune_entry_t *found = autotune_find(entry);
+
+	if( found )
+	{
+		*found = *entry;
+		return;
+	}
+
+	autotune_entries[autotune_next] = *entry;
+
+	autotune_next = (autotune_next + 1) % AUTOTUNE_ENTRIES;
+
+	if( autotune_count < AUTOTUNE_ENTRIES )
+		autotune_count++;
+}
+
+static
+double autotune_measure(
+	int engine,
+	void *ptr,
+	const struct autotune_entry_t *key)
+{
+	const int type = dwt_util_clock_autoselect();
+
+	double best = 0.;
+
+	for(int s = 0; s < AUTOTUNE_WARMUP + AUTOTUNE_SAMPLES; s++)
+	{
+		int j = key->j;
+
+		dwt_util_test_image_fill_s(ptr, key->stride_x, key->stride_y, key->size_x, key->size_y, 0);
+
+		const dwt_clock_t start = dwt_util_get_clock(type);
+
+		autotune_engines[engine].func(ptr, key->stride_x, key->stride_y, key->size_x, key->size_y, key->size_x, key->size_y, &j, 0, 0);
+
+		const dwt_clock_t stop = dwt_util_get_clock(type);
+
+		const double secs = (stop - start) / (double)dwt_util_get_frequency(type);
+
+		if( s >= AUTOTUNE_WARMUP && (s == AUTOTUNE_WARMUP || secs < best) )
+			best = secs;
+	}
+
+	return best;
+}
+
+static
+void autotune_write(
+	FILE *file,
+	const struct autotune_entry_t *entry,
+	double secs)
+{
+	fprintf(file, "%s\t%s\t%s\t%i\t%i\t%i\t%i\t%i\t%i\t%s\t%e\n",
+		dwt_util_version(), dwt_util_arch(), dwt_util_node(),
+		entry->threads, entry->size_x, entry->size_y, entry->stride_x, entry->stride_y, entry->j,
+		autotune_engines[entry->engine].name, secs);
+}
+
+// measure all the engines eligible for the class, the lock has to be held
+static
+void autotune_tune(
+	struct autotune_entry_t *key)
+{
+	void *ptr;
+
+	dwt_util_alloc_image(&ptr, key->stride_x, key->stride_y, key->size_x, key->size_y);
+
+	double best = 0.;
+
+	key->engine = DWT_AUTOTUNE_INPLACE;
+
+	for(int engine = 0; engine < DWT_AUTOTUNE_LAST; engine++)
+	{
+		if( !autotune_eligible(engine, key->size_x, key->size_y, key->j) )
+			continue;
+
+		const double secs = autotune_measure(engine, ptr, key);
+
+		dwt_util_log(LOG_DBG, "%s: %ix%i j=%i %s: %e secs\n", __FUNCTION__,
+			key->size_x, key->size_y, key->j, autotune_engines[engine].name, secs);
+
+		if( engine == DWT_AUTOTUNE_INPLACE || secs < best )
+		{
+			best = secs;
+			key->engine = engine;
+		}
+	}
+
+	dwt_util_free_image(&ptr);
+
+	autotune_insert(key);
+
+	if( *autotune_path )
+	{
+		FILE *file = fopen(autotune_path, "a");
+
+		if( !file )
+		{
+			dwt_util_log(LOG_WARN, "%s: unable to append to %s\n", __FUNCTION__, autotune_path);
+			return;
+		}
+
+		autotune_write(file, key, best);
+
+		fclose(file);
+	}
+}
+
+int dwt_autotune_cdf97_2f_s(
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y,
+	int j)
+{
+	assert( size_x > 0 && size_y > 0 );
+
+	struct autotune_entry_t key = {
+		.threads = dwt_util_get_max_threads(),
+		.size_x = size_x,
+		.size_y = size_y,
+		.stride_x = stride_x,
+		.stride_y = stride_y,
+		.j = autotune_levels(size_x, size_y, j),
+		.engine = DWT_AUTOTUNE_INPLACE,
+	};
+
+	// nothing to measure
+	if( !key.j )
+		return key.engine;
+
+#ifdef AUTOTUNE_PTHREADS
+	pthread_mutex_lock(&autotune_lock);
+#endif
+
+	const struct autotune_entry_t *entry = autotune_find(&key);
+
+	if( entry )
+		key.engine = entry->engine;
+	else
+		autotune_tune(&key);
+
+#ifdef AUTOTUNE_PTHREADS
+	pthread_mutex_unlock(&autotune_lock);
+#endif
+
+	return key.engine;
+}
+
+void dwt_cdf97_2f_auto_s(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_o_big_x,
+	int size_o_big_y,
+	int size_i_big_x,
+	int size_i_big_y,
+	int *j_max_ptr,
+	int decompose_one,
+	int zero_padding)
+{
+	if( size_o_big_x != size_i_big_x || size_o_big_y != size_i_big_y || decompose_one || zero_padding || size_i_big_x < 1 || size_i_big_y < 1 )
+	{
+		dwt_cdf97_2f_inplace_s(ptr, stride_x, stride_y, size_o_big_x, size_o_big_y, size_i_big_x, size_i_big_y, j_max_ptr, decompose_one, zero_padding);
+		return;
+	}
+
+	const int engine = dwt_autotune_cdf97_2f_s(stride_x, stride_y, size_i_big_x, size_i_big_y, *j_max_ptr);
+
+	autotune_engines[engine].func(ptr, stride_x, stride_y, size_o_big_x, size_o_big_y, size_i_big_x, size_i_big_y, j_max_ptr, decompose_one, zero_padding);
+}
+
+const char *dwt_autotune_engine_name(
+	int engine)
+{
+	assert( engine >= 0 && engine < DWT_AUTOTUNE_LAST );
+
+	return autotune_engines[engine].name;
+}
+
+static
+int autotune_load(
+	FILE *file)
+{
+	int loaded = 0;
+
+	char line[AUTOTUNE_LINE];
+
+	while( fgets(line, AUTOTUNE_LINE, file) )
+	{
+		char version[AUTOTUNE_LINE], arch[AUTOTUNE_LINE], node[AUTOTUNE_LINE], name[AUTOTUNE_LINE];
+
+		struct autotune_entry_t entry;
+
+		if( 10 != sscanf(line, "%[^\t]\t%[^\t]\t%[^\t]\t%i\t%i\t%i\t%i\t%i\t%i\t%s",
+			version, arch, node,
+			&entry.threads, &entry.size_x, &entry.size_y, &entry.stride_x, &entry.stride_y, &entry.j,
+			name) )
+			continue;
+
+		// winners of other machines
+		if( strcmp(version, dwt_util_version()) || strcmp(arch, dwt_util_arch()) || strcmp(node, dwt_util_node()) )
+			continue;
+
+		entry.engine = DWT_AUTOTUNE_LAST;
+
+		for(int engine = 0; engine < DWT_AUTOTUNE_LAST; engine++)
+		{
+			if( !strcmp(name, autotune_engines[engine].name) )
+				entry.engine = engine;
+		}
+
+		if( DWT_AUTOTUNE_LAST == entry.engine || entry.size_x < 1 || entry.size_y < 1
+			|| !autotune_eligible(entry.engine, entry.size_x, entry.size_y, entry.j) )
+			continue;
+
+		autotune_insert(&entry);
+
+		loaded++;
+	}
+
+	return loaded;
+}
+
+int dwt_autotune_set_cache(
+	const char *path)
+{
+	int loaded = 0;
+
+#ifdef AUTOTUNE_PTHREADS
+	pthread_mutex_lock(&autotune_lock);
+#endif
+
+	*autotune_path = 0;
+
+	if( path )
+	{
+		if( strlen(path) >= AUTOTUNE_LINE )
+		{
+			dwt_util_log(LOG_ERR, "%s: too long path %s\n", __FUNCTION__, path);
+			loaded = -1;
+		}
+		else
+		{
+			strcpy(autotune_path, path);
+
+			FILE *file = fopen(path, "r");
+
+			if( file )
+			{
+				loaded = autotune_load(file);
+				fclose(file);
+			}
+			else if( ENOENT != errno )
+			{
+				dwt_util_log(LOG_ERR, "%s: unable to read %s\n", __FUNCTION__, path);
+				loaded = -1;
+			}
+		}
+	}
+
+#ifdef AUTOTUNE_PTHREADS
+	pthread_mutex_unlock(&autotune_lock);
+#endif
+
+	return loaded;
+}
+
+void dwt_autotune_clear()
+{
+#ifdef AUTOTUNE_PTHREADS
+	pthread_mutex_lock(&autotune_lock);
+#endif
+
+	autotune_count = 0;
+	autotune_next = 0;
+
+#ifdef AUTOTUNE_PTHREADS
+	pthread_mutex_unlock(&autotune_lock);
+#endif
+}
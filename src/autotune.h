@@ -0,0 +1,91 @@
+/**
+ * @brief Runtime selection of the fastest 2-D transform engine.
+ */
+
+#ifndef AUTOTUNE_H
+#define AUTOTUNE_H
+
+/**
+ * @brief The interchangeable engines of the forward CDF 9/7 transform.
+ *
+ * All of them produce the same interleaved coefficients as
+ * @ref dwt_cdf97_2f_inplace_s (up to the rounding errors).
+ */
+enum dwt_autotune_engine {
+	DWT_AUTOTUNE_INPLACE = 0,	///< @ref dwt_cdf97_2f_inplace_s
+	DWT_AUTOTUNE_INPLACE_SEP = 1,	///< @ref dwt_cdf97_2f_inplace_sep_s
+	DWT_AUTOTUNE_INPLACE_SEP_SDL = 2,	///< @ref dwt_cdf97_2f_inplace_sep_sdl_s
+	DWT_AUTOTUNE_INPLACE_SDL = 3,	///< @ref dwt_cdf97_2f_inplace_sdl_s
+	DWT_AUTOTUNE_DL_4X4 = 4,	///< @ref dwt_cdf97_2f_dl_4x4_s, the levels of at least 8x8 pixels only
+	DWT_AUTOTUNE_LAST
+};
+
+/**
+ * @brief Forward transform by the fastest engine for the image size, the strides and the levels.
+ *
+ * The same interface as @ref dwt_cdf97_2f_inplace_s. The engines are measured
+ * on the first call for each (size, stride, levels, threads) class on this
+ * machine, the winner is then used by the following calls. If a cache file
+ * is set by @ref dwt_autotune_set_cache, the winners are stored there and
+ * the measurement is not repeated in the next runs of the program.
+ *
+ * The images nested in a larger frame, @p decompose_one and @p zero_padding
+ * are passed to @ref dwt_cdf97_2f_inplace_s directly.
+ *
+ * This function is thread safe.
+ */
+void dwt_cdf97_2f_auto_s(
+	void *ptr,		///< pointer to beginning of image data
+	int stride_x,		///< difference between rows (in bytes)
+	int stride_y,		///< difference between columns (in bytes)
+	int size_o_big_x,	///< width of outer image frame (in elements)
+	int size_o_big_y,	///< height of outer image frame (in elements)
+	int size_i_big_x,	///< width of nested image (in elements)
+	int size_i_big_y,	///< height of nested image (in elements)
+	int *j_max_ptr,		///< pointer to the number of intended decomposition levels (scales), the number of achieved decomposition levels will be stored also here
+	int decompose_one,	///< should be row or column of size one pixel decomposed? zero value if not
+	int zero_padding	///< fill padding in channels with zeros? zero value if not, should be non zero only for sparse decomposition
+);
+
+/**
+ * @brief The engine chosen for the class, measured now if not known yet.
+ *
+ * @returns the @ref dwt_autotune_engine
+ */
+int dwt_autotune_cdf97_2f_s(
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y,
+	int j		///< the number of levels, -1 for the most
+);
+
+/**
+ * @brief Short name of the @p engine, e.g. "inplace_sep_sdl".
+ */
+const char *dwt_autotune_engine_name(
+	int engine
+);
+
+/**
+ * @brief Use the cache file at @p path, NULL to stop using it.
+ *
+ * The winners measured on this machine by the previous runs are loaded from
+ * the file, the new ones are appended to it. The file is a text with a line
+ * per winner; the lines of other machines, architectures or library versions
+ * are ignored, thus a single file may be shared.
+ *
+ * @returns the number of the winners loaded, -1 if the file cannot be read
+ */
+int dwt_autotune_set_cache(
+	const char *path
+);
+
+/**
+ * @brief Forget all the winners in the memory.
+ *
+ * The cache file is kept.
+ */
+void dwt_autotune_clear();
+
+#endif
@@ -0,0 +1,823 @@
+/**
+ * @brief Unified benchmark of the transform engines.
+ */
+
+#include "bench.h"
+#include "libdwt.h"
+#include "inline.h"
+#include "dwt-core.h" // get_fdwt_diag_2x2_func, get_fdwt_vert_2x2_func
+#include "dwt-sym.h" // dwt_cdf97_2f_dl_4x4_s
+#include "dwt-sym-ms.h" // ms_cdf97_2f_dl_4x4_s, dwt_cdf97_2f_dl_2x2_s
+#include "dwt-batch.h" // dwt_cdf97_2f_batch_strided_s
+#include "core-int.h" // dwt_cdf97_2f_vert2x2_i
+#include "volume.h" // struct volume_t
+#include "volume-dwt.h" // cdf97_3f_op_wrapper_s
+#include "autotune.h" // dwt_cdf97_2f_auto_s
+// assert
+#include <assert.h>
+// ceil
+#include <math.h>
+// qsort
+#include <stdlib.h>
+// memcpy, strlen, strncmp
+#include <string.h>
+
+// the frame of the single-loop cores, the same as in the perf. functions of the cores
+#define BENCH_CORE_OFFSET 5
+#define BENCH_CORE_SHIFT 10
+#define BENCH_CORE_DECAY 4
+
+// the number of pixels of all the images of the batch
+#define BENCH_BATCH_PIXELS (1<<20)
+
+struct bench_buffers_t {
+	void *ptr;		///< the data the engine works on
+	void *input;		///< the input
+	void *dst;		///< the output of the out-of-place engines
+	void *view;		///< the image inside the frame of the cores
+	size_t size;		///< sizeof(ptr)
+	int stride_x;
+	int stride_y;
+	int input_stride_x;
+	int frame_x;		///< the size of the frame of the cores
+	int frame_y;
+	int count;		///< the number of images of the batch
+	int stride_image;
+	struct volume_t *src_v;
+	struct volume_t *dst_v;
+};
+
+static
+void bench_run_cdf97_2f_s(const struct bench_engine_t *engine, struct bench_buffers_t *b, const struct bench_case_t *c)
+{
+	UNUSED(engine);
+
+	int j = c->j;
+
+	dwt_cdf97_2f_s(b->ptr, b->stride_x, b->stride_y, c->size_x, c->size_y, c->size_x, c->size_y, &j, 0, 0);
+}
+
+static
+void bench_run_cdf97_2f_inplace_s(const struct bench_engine_t *engine, struct bench_buffers_t *b, const struct bench_case_t *c)
+{
+	UNUSED(engine);
+
+	int j = c->j;
+
+	dwt_cdf97_2f_inplace_s(b->ptr, b->stride_x, b->stride_y, c->size_x, c->size_y, c->size_x, c->size_y, &j, 0, 0);
+}
+
+static
+void bench_run_cdf97_2f_inplace_sep_s(const struct bench_engine_t *engine, struct bench_buffers_t *b, const struct bench_case_t *c)
+{
+	UNUSED(engine);
+
+	int j = c->j;
+
+	dwt_cdf97_2f_inplace_sep_s(b->ptr, b->stride_x, b->stride_y, c->size_x, c->size_y, c->size_x, c->size_y, &j, 0, 0);
+}
+
+static
+void bench_run_cdf97_2f_inplace_sep_sdl_s(const struct bench_engine_t *engine, struct bench_buffers_t *b, const struct bench_case_t *c)
+{
+	UNUSED(engine);
+
+	int j = c->j;
+
+	dwt_cdf97_2f_inplace_sep_sdl_s(b->ptr, b->stride_x, b->stride_y, c->size_x, c->size_y, c->size_x, c->size_y, &j, 0, 0);
+}
+
+static
+void bench_run_cdf97_2f_inplace_sdl_s(const struct bench_engine_t *engine, struct bench_buffers_t *b, const struct bench_case_t *c)
+{
+	UNUSED(engine);
+
+	int j = c->j;
+
+	dwt_cdf97_2f_inplace_sdl_s(b->ptr, b->stride_x, b->stride_y, c->size_x, c->size_y, c->size_x, c->size_y, &j, 0, 0);
+}
+
+static
+void bench_run_cdf97_2f_auto_s(const struct bench_engine_t *engine, struct bench_buffers_t *b, const struct bench_case_t *c)
+{
+	UNUSED(engine);
+
+	int j = c->j;
+
+	dwt_cdf97_2f_auto_s(b->ptr, b->stride_x, b->stride_y, c->size_x, c->size_y, c->size_x, c->size_y, &j, 0, 0);
+}
+
+static
+void bench_run_diag_core(const struct bench_engine_t *engine, struct bench_buffers_t *b, const struct bench_case_t *c)
+{
+	get_fdwt_diag_2x2_func(engine->approach)(b->view, b->stride_x, b->stride_y,
+		c->size_x+BENCH_CORE_SHIFT+BENCH_CORE_DECAY, c->size_y+BENCH_CORE_SHIFT+BENCH_CORE_DECAY);
+}
+
+static
+void bench_run_vert_core(const struct bench_engine_t *engine, struct bench_buffers_t *b, const struct bench_case_t *c)
+{
+	get_fdwt_vert_2x2_func(engine->approach)(b->view, b->stride_x, b->stride_y,
+		c->size_x+BENCH_CORE_SHIFT+BENCH_CORE_DECAY, c->size_y+BENCH_CORE_SHIFT+BENCH_CORE_DECAY);
+}
+
+static
+void bench_run_cdf97_2f_dl_4x4_s(const struct bench_engine_t *engine, struct bench_buffers_t *b, const struct bench_case_t *c)
+{
+	UNUSED(engine);
+
+	int j = c->j;
+
+	dwt_cdf97_2f_dl_4x4_s(b->ptr, b->stride_x, b->stride_y, c->size_x, c->size_y, c->size_x, c->size_y, &j, 0, 0);
+}
+
+static
+void bench_run_cdf97_2f_dl_2x2_s(const struct bench_engine_t *engine, struct bench_buffers_t *b, const struct bench_case_t *c)
+{
+	UNUSED(engine);
+
+	int j = c->j;
+
+	dwt_cdf97_2f_dl_2x2_s(b->ptr, b->stride_x, b->stride_y, c->size_x, c->size_y, c->size_x, c->size_y, &j, 0, 0);
+}
+
+static
+void bench_run_ms_cdf97_2f_dl_4x4_s(const struct bench_engine_t *engine, struct bench_buffers_t *b, const struct bench_case_t *c)
+{
+	UNUSED(engine);
+
+	ms_cdf97_2f_dl_4x4_s(c->size_x, c->size_y, b->ptr, b->stride_x, b->stride_y, c->j);
+}
+
+static
+void bench_run_ms_cdf97_2f_dl_2x2_s(const struct bench_engine_t *engine, struct bench_buffers_t *b, const struct bench_case_t *c)
+{
+	UNUSED(engine);
+
+	ms_cdf97_2f_dl_2x2_s(c->size_x, c->size_y, b->ptr, b->stride_x, b->stride_y, c->j);
+}
+
+static
+void bench_run_cdf53_2f_i(const struct bench_engine_t *engine, struct bench_buffers_t *b, const struct bench_case_t *c)
+{
+	UNUSED(engine);
+
+	int j = c->j;
+
+	dwt_cdf53_2f_i(b->ptr, b->stride_x, b->stride_y, c->size_x, c->size_y, c->size_x, c->size_y, &j, 0, 0);
+}
+
+static
+void bench_run_cdf97_2f_i(const struct bench_engine_t *engine, struct bench_buffers_t *b, const struct bench_case_t *c)
+{
+	UNUSED(engine);
+
+	int j = c->j;
+
+	dwt_cdf97_2f_i(b->ptr, b->stride_x, b->stride_y, c->size_x, c->size_y, c->size_x, c->size_y, &j, 0, 0);
+}
+
+static
+void bench_run_cdf97_2f_vert2x2_i(const struct bench_engine_t *engine, struct bench_buffers_t *b, const struct bench_case_t *c)
+{
+	UNUSED(engine);
+
+	dwt_cdf97_2f_vert2x2_i(b->ptr, b->stride_x, b->stride_y, b->dst, b->stride_x, b->stride_y, c->size_x, c->size_y);
+}
+
+static
+void bench_run_cdf97_2f_batch_s(const struct bench_engine_t *engine, struct bench_buffers_t *b, const struct bench_case_t *c)
+{
+	UNUSED(engine);
+
+	int j = c->j;
+
+	dwt_cdf97_2f_batch_strided_s(b->ptr, b->stride_image, b->count, b->stride_x, b->stride_y, c->size_x, c->size_y, &j, 0);
+}
+
+static
+void bench_run_cdf97_3f_s(const struct bench_engine_t *engine, struct bench_buffers_t *b, const struct bench_case_t *c)
+{
+	UNUSED(c);
+
+	cdf97_3f_op_wrapper_s(b->src_v, b->dst_v, engine->approach);
+}
+
+static
+void bench_run_cdf97_3f_ms_fused_s(const struct bench_engine_t *engine, struct bench_buffers_t *b, const struct bench_case_t *c)
+{
+	UNUSED(engine);
+
+	cdf97_3f_op_ms_fused_s(b->src_v, b->dst_v, c->j);
+}
+
+/**
+ * The registry. The engines of the same family are next to each other.
+ */
+static
+const struct bench_engine_t bench_engines[] = {
+	// name                         family        dims data                 align min max approach                run
+	{ "cdf97_2f_s",                 "separable",  2, BENCH_DATA_IMAGE_S,  1, 2, 0, 0,                      bench_run_cdf97_2f_s },
+	{ "cdf97_2f_inplace_sep_s",     "separable",  2, BENCH_DATA_IMAGE_S,  1, 2, 0, 0,                      bench_run_cdf97_2f_inplace_sep_s },
+	{ "cdf97_2f_inplace_s",         "sl",         2, BENCH_DATA_IMAGE_S,  1, 2, 0, 0,                      bench_run_cdf97_2f_inplace_s },
+	{ "cdf97_2f_inplace_sep_sdl_s", "sdl",        2, BENCH_DATA_IMAGE_S,  1, 2, 0, 0,                      bench_run_cdf97_2f_inplace_sep_sdl_s },
+	{ "cdf97_2f_inplace_sdl_s",     "sdl",        2, BENCH_DATA_IMAGE_S,  1, 2, 0, 0,                      bench_run_cdf97_2f_inplace_sdl_s },
+	// the first warmup run measures the engines
+	{ "cdf97_2f_auto_s",            "auto",       2, BENCH_DATA_IMAGE_S,  1, 2, 0, 0,                      bench_run_cdf97_2f_auto_s },
+	{ "fdwt_diag_2x2",              "diag-core",  2, BENCH_DATA_CORE_S,   2, 2, 1, ORDER_HORIZ,            bench_run_diag_core },
+	{ "fdwt_diag_2x2_strips",       "diag-core",  2, BENCH_DATA_CORE_S,   2, 2, 1, ORDER_HORIZ_STRIPS,     bench_run_diag_core },
+	{ "fdwt_vert_2x2",              "vert-core",  2, BENCH_DATA_CORE_S,   2, 2, 1, ORDER_HORIZ,            bench_run_vert_core },
+	{ "fdwt_vert_2x2_strips",       "vert-core",  2, BENCH_DATA_CORE_S,   2, 2, 1, ORDER_HORIZ_STRIPS,     bench_run_vert_core },
+	{ "fdwt_vert_4x4",              "vert-core",  2, BENCH_DATA_CORE_S,   4, 4, 1, ORDER_HORIZ_4X4,        bench_run_vert_core },
+	// the fused cores, the remainders of the frame smaller than the core are not transformed
+	{ "fdwt_diag_6x2",              "diag-core",  2, BENCH_DATA_CORE_S,   6, 6, 1, ORDER_HORIZ_6X2,        bench_run_diag_core },
+	{ "fdwt_diag_2x6",              "diag-core",  2, BENCH_DATA_CORE_S,   6, 6, 1, ORDER_HORIZ_2X6,        bench_run_diag_core },
+	{ "fdwt_diag_6x6",              "diag-core",  2, BENCH_DATA_CORE_S,   6, 6, 1, ORDER_HORIZ_6X6,        bench_run_diag_core },
+	{ "fdwt_vert_8x2",              "vert-core",  2, BENCH_DATA_CORE_S,   8, 8, 1, ORDER_HORIZ_8X2,        bench_run_vert_core },
+	{ "fdwt_vert_2x8",              "vert-core",  2, BENCH_DATA_CORE_S,   8, 8, 1, ORDER_HORIZ_2X8,        bench_run_vert_core },
+	{ "fdwt_vert_8x8",              "vert-core",  2, BENCH_DATA_CORE_S,   8, 8, 1, ORDER_HORIZ_8X8,        bench_run_vert_core },
+	{ "cdf97_2f_dl_2x2_s",          "dl",         2, BENCH_DATA_IMAGE_S,  2, 8, 0, 0,                      bench_run_cdf97_2f_dl_2x2_s },
+	{ "cdf97_2f_dl_4x4_s",          "dl",         2, BENCH_DATA_IMAGE_S,  4, 8, 0, 0,                      bench_run_cdf97_2f_dl_4x4_s },
+	// the fused levels need the overlap of 7<<J pixels, the last level of at least 13 pixels is safe
+	{ "ms_cdf97_2f_dl_2x2_s",       "multiscale", 2, BENCH_DATA_IMAGE_S,  2, 13, 0, 0,                      bench_run_ms_cdf97_2f_dl_2x2_s },
+	{ "ms_cdf97_2f_dl_4x4_s",       "multiscale", 2, BENCH_DATA_IMAGE_S,  4, 13, 0, 0,                      bench_run_ms_cdf97_2f_dl_4x4_s },
+	{ "cdf53_2f_i",                 "integer",    2, BENCH_DATA_IMAGE_I,  1, 2, 0, 0,                      bench_run_cdf53_2f_i },
+	{ "cdf97_2f_i",                 "integer",    2, BENCH_DATA_IMAGE_I,  1, 2, 0, 0,                      bench_run_cdf97_2f_i },
+	{ "cdf97_2f_vert2x2_i",         "integer",    2, BENCH_DATA_CORE_I,   2, 2, 1, 0,                      bench_run_cdf97_2f_vert2x2_i },
+	{ "cdf97_2f_batch_s",           "batch",      2, BENCH_DATA_BATCH_S,  1, 2, 0, 0,                      bench_run_cdf97_2f_batch_s },
+	{ "cdf97_3f_sep_horizontal",    "volume",     3, BENCH_DATA_VOLUME_S, 4, 8, 1, VOL_SEP_HORIZONTAL,     bench_run_cdf97_3f_s },
+	{ "cdf97_3f_sep_vertical",      "volume",     3, BENCH_DATA_VOLUME_S, 4, 8, 1, VOL_SEP_VERTICAL,       bench_run_cdf97_3f_s },
+	{ "cdf97_3f_slices_vert4x4",    "volume",     3, BENCH_DATA_VOLUME_S, 4, 8, 1, VOL_SLICES_VERT4X4,     bench_run_cdf97_3f_s },
+	{ "cdf97_3f_horiz_vert4x4x4",   "volume",     3, BENCH_DATA_VOLUME_S, 4, 8, 1, VOL_HORIZ_VERT4X4X4,    bench_run_cdf97_3f_s },
+	{ "cdf97_3f_horiz_diag2x2x2",   "volume",     3, BENCH_DATA_VOLUME_S, 4, 8, 1, VOL_HORIZ_DIAG2X2X2,    bench_run_cdf97_3f_s },
+	{ "cdf97_3f_ms_fused",          "volume",     3, BENCH_DATA_VOLUME_S, 4, 2, 0, 0,                      bench_run_cdf97_3f_ms_fused_s },
+};
+
+void bench_config_default(
+	struct bench_config_t *config)
+{
+	assert( config );
+
+	config->engines = NULL;
+	config->size_min = 32;
+	config->size_max = 2048;
+	config->volume_size_max = 64;
+	config->growth = 1.25f;
+	config->opt_stride[0] = 0;
+	config->opt_stride[1] = 1;
+	config->opt_stride_count = 2;
+	config->levels[0] = -1;
+	config->levels_count = 1;
+	config->threads[0] = dwt_util_get_max_threads();
+	config->threads_count = 1;
+	config->warmup = 2;
+	config->samples = 10;
+	config->percentile = 90.f;
+	config->flush = 1;
+	config->clock_type = dwt_util_clock_autoselect();
+	config->counters = 0;
+}
+
+int bench_engine_count()
+{
+	return sizeof(bench_engines) / sizeof(*bench_engines);
+}
+
+const struct bench_engine_t *bench_engine_get(
+	int n)
+{
+	assert( n >= 0 && n < bench_engine_count() );
+
+	return &bench_engines[n];
+}
+
+int bench_engine_selected(
+	const struct bench_engine_t *engine,
+	const char *list)
+{
+	assert( engine );
+
+	if( !list )
+		return 1;
+
+	while( *list )
+	{
+		const char *end = strchr(list, ',');
+		const size_t len = end ? (size_t)(end - list) : strlen(list);
+
+		if( (len == 3 && !strncmp(list, "all", len))
+			|| (len == strlen(engine->name) && !strncmp(list, engine->name, len))
+			|| (len == strlen(engine->family) && !strncmp(list, engine->family, len)) )
+			return 1;
+
+		list += len;
+
+		if( *list )
+			list++;
+	}
+
+	return 0;
+}
+
+/**
+ * The number of levels the engine can perform, zero if it cannot run on the size at all.
+ */
+static
+int bench_levels(
+	const struct bench_engine_t *engine,
+	const struct bench_case_t *c)
+{
+	const int size = c->size_z > 1 ? min(min(c->size_x, c->size_y), c->size_z) : min(c->size_x, c->size_y);
+
+	int limit = 0;
+
+	while( ceil_div_pow2(size, limit) >= engine->min_size )
+		limit++;
+
+	if( engine->max_levels && limit > engine->max_levels )
+		limit = engine->max_levels;
+
+	if( c->j < 0 || c->j > limit )
+		return limit;
+
+	return c->j;
+}
+
+static
+void bench_setup(
+	const struct bench_engine_t *engine,
+	struct bench_buffers_t *b,
+	const struct bench_case_t *c)
+{
+	memset(b, 0, sizeof(struct bench_buffers_t));
+
+	switch( engine->data )
+	{
+		case BENCH_DATA_IMAGE_S:
+		case BENCH_DATA_IMAGE_I:
+		{
+			const size_t elem = BENCH_DATA_IMAGE_S == engine->data ? sizeof(float) : sizeof(int);
+
+			b->stride_y = elem;
+			b->stride_x = dwt_util_get_stride(elem * c->size_x, c->opt_stride);
+			b->size = dwt_util_image_size(b->stride_x, b->stride_y, c->size_x, c->size_y);
+
+			dwt_util_alloc_image(&b->ptr, b->stride_x, b->stride_y, c->size_x, c->size_y);
+			dwt_util_alloc_image(&b->input, b->stride_x, b->stride_y, c->size_x, c->size_y);
+
+			if( BENCH_DATA_IMAGE_S == engine->data )
+				dwt_util_test_image_fill_s(b->input, b->stride_x, b->stride_y, c->size_x, c->size_y, 0);
+			else
+				dwt_util_test_image_fill_i(b->input, b->stride_x, b->stride_y, c->size_x, c->size_y, 0);
+		}
+		break;
+		case BENCH_DATA_CORE_S:
+		{
+			b->frame_x = BENCH_CORE_OFFSET + BENCH_CORE_SHIFT + c->size_x + BENCH_CORE_SHIFT + BENCH_CORE_DECAY;
+			b->frame_y = BENCH_CORE_OFFSET + BENCH_CORE_SHIFT + c->size_y + BENCH_CORE_SHIFT + BENCH_CORE_DECAY;
+
+			b->stride_y = sizeof(float);
+			b->stride_x = dwt_util_get_stride(sizeof(float) * b->frame_x, c->opt_stride);
+			b->size = dwt_util_image_size(b->stride_x, b->stride_y, b->frame_x, b->frame_y);
+
+			b->input_stride_x = dwt_util_get_stride(sizeof(float) * c->size_x, c->opt_stride);
+
+			dwt_util_alloc_image(&b->ptr, b->stride_x, b->stride_y, b->frame_x, b->frame_y);
+			dwt_util_alloc_image(&b->input, b->input_stride_x, b->stride_y, c->size_x, c->size_y);
+
+			dwt_util_test_image_fill_s(b->input, b->input_stride_x, b->stride_y, c->size_x, c->size_y, 0);
+
+			b->view = dwt_util_viewport(b->ptr, b->frame_x, b->frame_y, b->stride_x, b->stride_y,
+				BENCH_CORE_OFFSET + BENCH_CORE_SHIFT, BENCH_CORE_OFFSET + BENCH_CORE_SHIFT);
+		}
+		break;
+		case BENCH_DATA_CORE_I:
+		{
+			b->stride_y = sizeof(int);
+			b->stride_x = dwt_util_get_stride(sizeof(int) * c->size_x, c->opt_stride);
+			b->size = dwt_util_image_size(b->stride_x, b->stride_y, c->size_x, c->size_y);
+
+			dwt_util_alloc_image(&b->ptr, b->stride_x, b->stride_y, c->size_x, c->size_y);
+			dwt_util_alloc_image(&b->dst, b->stride_x, b->stride_y, c->size_x, c->size_y);
+
+			dwt_util_test_image_fill_i(b->ptr, b->stride_x, b->stride_y, c->size_x, c->size_y, 0);
+		}
+		break;
+		case BENCH_DATA_BATCH_S:
+		{
+			b->count = max(1, BENCH_BATCH_PIXELS / (c->size_x * c->size_y));
+
+			b->stride_y = sizeof(float);
+			b->stride_x = dwt_util_get_stride(sizeof(float) * c->size_x, c->opt_stride);
+			b->stride_image = b->stride_x * c->size_y;
+			b->size = dwt_util_image_size(b->stride_x, b->stride_y, c->size_x, c->size_y * b->count);
+
+			// the images are stacked into a single tall one
+			dwt_util_alloc_image(&b->ptr, b->stride_x, b->stride_y, c->size_x, c->size_y * b->count);
+			dwt_util_alloc_image(&b->input, b->stride_x, b->stride_y, c->size_x, c->size_y * b->count);
+
+			for(int n = 0; n < b->count; n++)
+				dwt_util_test_image_fill_s((char *)b->input + (size_t)n * b->stride_image, b->stride_x, b->stride_y, c->size_x, c->size_y, n);
+		}
+		break;
+		case BENCH_DATA_VOLUME_S:
+		{
+			b->src_v = volume_alloc_realiably(sizeof(float), c->size_x, c->size_y, c->size_z, c->opt_stride);
+			b->dst_v = volume_alloc_realiably(sizeof(float), c->size_x, c->size_y, c->size_z, c->opt_stride);
+
+			volume_fill_s(b->src_v);
+		}
+		break;
+		default:
+			dwt_util_error("unknown data type\n");
+	}
+}
+
+/**
+ * Restore the input, not timed.
+ */
+static
+void bench_reset(
+	const struct bench_engine_t *engine,
+	struct bench_buffers_t *b,
+	const struct bench_case_t *c)
+{
+	switch( engine->data )
+	{
+		case BENCH_DATA_IMAGE_S:
+		case BENCH_DATA_IMAGE_I:
+		case BENCH_DATA_BATCH_S:
+			memcpy(b->ptr, b->input, b->size);
+		break;
+		case BENCH_DATA_CORE_S:
+			// the cores read the zeros around the image
+			dwt_util_test_image_zero_s(b->ptr, b->stride_x, b->stride_y, b->frame_x, b->frame_y);
+			dwt_util_copy3_s(b->input, b->view, b->input_stride_x, b->stride_y, b->stride_x, b->stride_y, c->size_x, c->size_y);
+		break;
+		default:
+			// the out-of-place engines do not touch the input
+			;
+	}
+}
+
+static
+void bench_flush(
+	const struct bench_engine_t *engine,
+	struct bench_buffers_t *b)
+{
+	if( BENCH_DATA_VOLUME_S == engine->data )
+	{
+		dwt_util_flush_cache(b->src_v->data, b->src_v->stride_z * b->src_v->size_z);
+		dwt_util_flush_cache(b->dst_v->data, b->dst_v->stride_z * b->dst_v->size_z);
+		return;
+	}
+
+	dwt_util_flush_cache(b->ptr, b->size);
+
+	if( b->dst )
+		dwt_util_flush_cache(b->dst, b->size);
+}
+
+static
+void bench_teardown(
+	struct bench_buffers_t *b)
+{
+	if( b->ptr )
+		dwt_util_free_image(&b->ptr);
+	if( b->input )
+		dwt_util_free_image(&b->input);
+	if( b->dst )
+		dwt_util_free_image(&b->dst);
+	if( b->src_v )
+		volume_free(b->src_v);
+	if( b->dst_v )
+		volume_free(b->dst_v);
+}
+
+static
+int bench_cmp_double(const void *p1, const void *p2)
+{
+	const double a = *(const double *)p1;
+	const double b = *(const double *)p2;
+
+	return (a > b) - (a < b);
+}
+
+int bench_measure(
+	const struct bench_engine_t *engine,
+	const struct bench_case_t *c,
+	const struct bench_config_t *config,
+	struct bench_result_t *result)
+{
+	assert( engine && c && config && result );
+	assert( config->samples > 0 && config->warmup >= 0 );
+
+	if( c->size_x % engine->align || c->size_y % engine->align || (engine->dims > 2 && c->size_z % engine->align) )
+	{
+		dwt_util_log(LOG_ERR, "%s: %s: the size (%i,%i,%i) is not a multiple of %i\n", __FUNCTION__,
+			engine->name, c->size_x, c->size_y, c->size_z, engine->align);
+		return 1;
+	}
+
+	struct bench_case_t e = *c;
+
+	e.size_z = engine->dims > 2 ? c->size_z : 1;
+	e.j = bench_levels(engine, &e);
+
+	if( !e.j )
+		return 1;
+
+	const int threads = dwt_util_get_num_threads();
+
+	dwt_util_set_num_threads(e.threads);
+
+	struct bench_buffers_t b;
+
+	bench_setup(engine, &b, &e);
+
+	for(int n = 0; n < config->warmup; n++)
+	{
+		bench_reset(engine, &b, &e);
+		engine->run(engine, &b, &e);
+	}
+
+	double secs[config->samples];
+
+	struct dwt_counters_t counters;
+
+	dwt_counters_open(&counters, config->counters);
+
+	for(int i = 0; i < DWT_COUNTER_LAST; i++)
+		result->counters[i] = 0.;
+
+	for(int n = 0; n < config->samples; n++)
+	{
+		bench_reset(engine, &b, &e);
+
+		if( config->flush )
+			bench_flush(engine, &b);
+
+		// the counters enclose the timer
+		dwt_counters_start(&counters);
+
+		const dwt_clock_t start = dwt_util_get_clock(config->clock_type);
+		engine->run(engine, &b, &e);
+		const dwt_clock_t stop = dwt_util_get_clock(config->clock_type);
+
+		dwt_counters_stop(&counters);
+
+		secs[n] = (double)(stop - start) / dwt_util_get_frequency(config->clock_type);
+
+		for(int i = 0; i < DWT_COUNTER_LAST; i++)
+		{
+			if( !n || counters.value[i] < result->counters[i] )
+				result->counters[i] = counters.value[i];
+		}
+	}
+
+	result->counters_mask = counters.mask;
+
+	dwt_counters_close(&counters);
+
+	const double pixels = (double)e.size_x * e.size_y * e.size_z * (b.count ? b.count : 1);
+
+	bench_teardown(&b);
+
+	dwt_util_set_num_threads(threads);
+
+	qsort(secs, config->samples, sizeof(double), bench_cmp_double);
+
+	const int N = config->samples;
+
+	double sum = 0.;
+	for(int n = 0; n < N; n++)
+		sum += secs[n];
+
+	// the nearest-rank percentile
+	const int rank = (int)ceil(config->percentile / 100. * N);
+
+	result->engine = engine;
+	result->c = e;
+	result->pixels = pixels;
+	result->samples = N;
+	result->min = secs[0];
+	result->median = (N & 1) ? secs[N/2] : (secs[N/2-1] + secs[N/2]) / 2;
+	result->percentile = secs[max(min(rank, N), 1) - 1];
+	result->mean = sum / N;
+	result->max = secs[N-1];
+
+	return 0;
+}
+
+static
+void bench_json_string(
+	FILE *out,
+	const char *str)
+{
+	fputc('"', out);
+
+	for(; *str; str++)
+	{
+		if( '"' == *str || '\\' == *str )
+			fputc('\\', out);
+
+		if( (unsigned char)*str >= 0x20 )
+			fputc(*str, out);
+	}
+
+	fputc('"', out);
+}
+
+static
+void bench_write_header(
+	FILE *out,
+	enum bench_format format,
+	const struct bench_config_t *config)
+{
+	if( BENCH_FORMAT_CSV == format )
+	{
+		fprintf(out, "library,arch,engine,family,dims,size_x,size_y,size_z,opt_stride,levels,threads,pixels,samples,min,median,p%g,mean,max,min_secs_per_pixel", config->percentile);
+
+		for(int i = 0; i < DWT_COUNTER_LAST; i++)
+		{
+			if( config->counters & (1 << i) )
+				fprintf(out, ",%s_per_pixel", dwt_counters_name(i));
+		}
+
+		fprintf(out, "\n");
+		return;
+	}
+
+	fprintf(out, "{\n\t\"library\": ");
+	bench_json_string(out, dwt_util_version());
+	fprintf(out, ",\n\t\"arch\": ");
+	bench_json_string(out, dwt_util_arch());
+	fprintf(out, ",\n\t\"clock_type\": %i,\n", config->clock_type);
+	fprintf(out, "\t\"warmup\": %i,\n", config->warmup);
+	fprintf(out, "\t\"samples\": %i,\n", config->samples);
+	fprintf(out, "\t\"percentile\": %g,\n", config->percentile);
+	fprintf(out, "\t\"flush\": %i,\n", config->flush);
+	fprintf(out, "\t\"counters\": [");
+	for(int i = 0, first = 1; i < DWT_COUNTER_LAST; i++)
+	{
+		if( config->counters & (1 << i) )
+		{
+			fprintf(out, "%s\"%s\"", first ? "" : ", ", dwt_counters_name(i));
+			first = 0;
+		}
+	}
+	fprintf(out, "],\n");
+	fprintf(out, "\t\"results\": [");
+}
+
+static
+void bench_write_result(
+	FILE *out,
+	enum bench_format format,
+	const struct bench_config_t *config,
+	const struct bench_result_t *r,
+	int first)
+{
+	const struct bench_case_t *c = &r->c;
+
+	if( BENCH_FORMAT_CSV == format )
+	{
+		fprintf(out, "%s,%s,%s,%s,%i,%i,%i,%i,%i,%i,%i,%.0f,%i,%.9e,%.9e,%.9e,%.9e,%.9e,%.9e",
+			dwt_util_version(), dwt_util_arch(), r->engine->name, r->engine->family, r->engine->dims,
+			c->size_x, c->size_y, c->size_z, c->opt_stride, c->j, c->threads,
+			r->pixels, r->samples, r->min, r->median, r->percentile, r->mean, r->max, r->min / r->pixels);
+
+		// the counters which cannot be read are left empty
+		for(int i = 0; i < DWT_COUNTER_LAST; i++)
+		{
+			if( r->counters_mask & (1 << i) )
+				fprintf(out, ",%.6e", r->counters[i] / r->pixels);
+			else if( config->counters & (1 << i) )
+				fprintf(out, ",");
+		}
+
+		fprintf(out, "\n");
+		return;
+	}
+
+	fprintf(out, "%s\n\t\t{ \"engine\": ", first ? "" : ",");
+	bench_json_string(out, r->engine->name);
+	fprintf(out, ", \"family\": ");
+	bench_json_string(out, r->engine->family);
+	fprintf(out, ", \"dims\": %i, \"size\": [%i, %i, %i], \"opt_stride\": %i, \"levels\": %i, \"threads\": %i, "
+		"\"pixels\": %.0f, \"samples\": %i, \"min\": %.9e, \"median\": %.9e, \"percentile\": %.9e, \"mean\": %.9e, \"max\": %.9e, \"min_secs_per_pixel\": %.9e",
+		r->engine->dims, c->size_x, c->size_y, c->size_z, c->opt_stride, c->j, c->threads,
+		r->pixels, r->samples, r->min, r->median, r->percentile, r->mean, r->max, r->min / r->pixels);
+
+	if( r->counters_mask )
+	{
+		fprintf(out, ", \"counters_per_pixel\": {");
+
+		for(int i = 0, first_counter = 1; i < DWT_COUNTER_LAST; i++)
+		{
+			if( r->counters_mask & (1 << i) )
+			{
+				fprintf(out, "%s \"%s\": %.6e", first_counter ? "" : ",", dwt_counters_name(i), r->counters[i] / r->pixels);
+				first_counter = 0;
+			}
+		}
+
+		fprintf(out, " }");
+	}
+
+	fprintf(out, " }");
+}
+
+static
+void bench_write_footer(
+	FILE *out,
+	enum bench_format format)
+{
+	if( BENCH_FORMAT_JSON == format )
+		fprintf(out, "\n\t]\n}\n");
+}
+
+static
+int bench_grow(
+	int size,
+	float growth)
+{
+	const int next = (int)(size * growth);
+
+	return next > size ? next : size + 1;
+}
+
+int bench_run(
+	const struct bench_config_t *config,
+	FILE *out,
+	enum bench_format format)
+{
+	assert( config && out && format < BENCH_FORMAT_LAST );
+	assert( config->size_min > 0 && config->growth > 1.f );
+
+	int results = 0;
+
+	bench_write_header(out, format, config);
+
+	for(int n = 0; n < bench_engine_count(); n++)
+	{
+		const struct bench_engine_t *engine = bench_engine_get(n);
+
+		if( !bench_engine_selected(engine, config->engines) )
+			continue;
+
+		const int size_max = engine->dims > 2 ? config->volume_size_max : config->size_max;
+
+		for(int t = 0; t < config->threads_count; t++)
+		for(int s = 0; s < config->opt_stride_count; s++)
+		{
+			int last = 0;
+
+			for(int size = config->size_min; size <= size_max; size = bench_grow(size, config->growth))
+			{
+				const int size_a = (size + engine->align - 1) / engine->align * engine->align;
+
+				if( size_a == last )
+					continue;
+
+				last = size_a;
+
+				// the levels limited by the engine are measured once
+				unsigned done = 0;
+
+				for(int l = 0; l < config->levels_count; l++)
+				{
+					struct bench_case_t c = {
+						.size_x = size_a,
+						.size_y = size_a,
+						.size_z = engine->dims > 2 ? size_a : 1,
+						.opt_stride = config->opt_stride[s],
+						.j = config->levels[l],
+						.threads = config->threads[t],
+					};
+
+					const int j = bench_levels(engine, &c);
+
+					if( !j || (done & (1u << j)) )
+						continue;
+
+					done |= 1u << j;
+
+					struct bench_result_t result;
+
+					if( bench_measure(engine, &c, config, &result) )
+						continue;
+
+					bench_write_result(out, format, config, &result, !results);
+					fflush(out);
+
+					results++;
+				}
+			}
+		}
+	}
+
+	bench_write_footer(out, format);
+
+	return results;
+}
@@ -0,0 +1,178 @@
+/**
+ * @brief Unified benchmark of the transform engines.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "counters.h" // DWT_COUNTER_LAST
+#include <stdio.h> // FILE
+
+/**
+ * @brief The most values in the lists of @ref bench_config_t.
+ */
+#define BENCH_LIST 16
+
+/**
+ * @brief Output format of @ref bench_run.
+ */
+enum bench_format {
+	BENCH_FORMAT_CSV = 0,	///< a single header line, one line per result
+	BENCH_FORMAT_JSON = 1,	///< a single object with the array of results
+	BENCH_FORMAT_LAST
+};
+
+/**
+ * @brief The data an engine works on, prepared by the benchmark.
+ */
+enum bench_data {
+	BENCH_DATA_IMAGE_S,	///< float image transformed in place
+	BENCH_DATA_IMAGE_I,	///< int image transformed in place
+	BENCH_DATA_CORE_S,	///< float image in a frame as expected by the single-loop cores
+	BENCH_DATA_CORE_I,	///< int image transformed into another one
+	BENCH_DATA_BATCH_S,	///< many float images one after another
+	BENCH_DATA_VOLUME_S,	///< float volume transformed into another one
+	BENCH_DATA_LAST
+};
+
+/**
+ * @brief Parameters of a single measurement.
+ */
+struct bench_case_t {
+	int size_x;		///< width (in elements)
+	int size_y;		///< height (in elements)
+	int size_z;		///< depth (in elements), one for 2-D engines
+	int opt_stride;		///< use optimal stride, see @ref dwt_util_get_stride
+	int j;			///< the number of levels, -1 for the most
+	int threads;		///< the number of threads
+};
+
+/**
+ * @brief Buffers of a single measurement.
+ */
+struct bench_buffers_t;
+
+/**
+ * @brief Transform engine in the registry.
+ */
+struct bench_engine_t {
+	const char *name;	///< unique name
+	const char *family;	///< separable, sl, sdl, auto, diag-core, vert-core, dl, multiscale, integer, batch, volume
+	int dims;		///< 2 or 3
+	enum bench_data data;	///< the data the engine works on
+	int align;		///< the sizes are rounded up to a multiple of this
+	int min_size;		///< the smallest size of the last level
+	int max_levels;		///< the most levels, zero for any
+	int approach;		///< the approach passed to the volume engines
+	void (*run)(const struct bench_engine_t *engine, struct bench_buffers_t *buffers, const struct bench_case_t *c);
+};
+
+/**
+ * @brief Setup of @ref bench_run.
+ */
+struct bench_config_t {
+	const char *engines;		///< comma-separated names or families of the engines, NULL for all of them
+	int size_min;			///< the smallest size (in elements)
+	int size_max;			///< the largest size (in elements) of the 2-D engines
+	int volume_size_max;		///< the largest size (in elements) of the 3-D engines
+	float growth;			///< the sizes are multiplied by this factor, greater than one
+	int opt_stride[BENCH_LIST];	///< the strides to measure
+	int opt_stride_count;
+	int levels[BENCH_LIST];		///< the numbers of levels to measure, -1 for the most
+	int levels_count;
+	int threads[BENCH_LIST];	///< the numbers of threads to measure
+	int threads_count;
+	int warmup;			///< untimed runs before the samples
+	int samples;			///< timed runs
+	float percentile;		///< the reported percentile (e.g. 90)
+	int flush;			///< flush the caches before each run? zero value if not
+	int clock_type;			///< see @ref dwt_util_get_clock
+	int counters;			///< the hardware counters to read, see @ref dwt_counters_open, zero for none
+};
+
+/**
+ * @brief Statistics of a single measurement.
+ *
+ * The times are in seconds per a single run of the engine.
+ */
+struct bench_result_t {
+	const struct bench_engine_t *engine;
+	struct bench_case_t c;
+	double pixels;		///< the number of pixels transformed in a single run
+	int samples;
+	double min;
+	double median;
+	double percentile;	///< the percentile of @ref bench_config_t
+	double mean;
+	double max;
+	int counters_mask;			///< the counters actually read
+	double counters[DWT_COUNTER_LAST];	///< the least value over the samples
+};
+
+/**
+ * @brief Fill the @p config with the defaults.
+ *
+ * The sizes from 32 to 2048 (64 for the volumes), packed and optimal
+ * strides, all the levels, all the available threads, 2 warmup runs and 10
+ * samples, the 90th percentile.
+ */
+void bench_config_default(
+	struct bench_config_t *config
+);
+
+/**
+ * @brief The number of the engines in the registry.
+ */
+int bench_engine_count();
+
+/**
+ * @brief The engine @p n of the registry.
+ */
+const struct bench_engine_t *bench_engine_get(
+	int n
+);
+
+/**
+ * @brief Is the @p engine listed in @p list by its name or its family?
+ *
+ * The @p list is a comma-separated list, NULL or "all" lists all the engines.
+ */
+int bench_engine_selected(
+	const struct bench_engine_t *engine,
+	const char *list
+);
+
+/**
+ * @brief Measure the @p engine on the case @p c.
+ *
+ * The input is restored before each run, the restoring as well as the
+ * flushing of the caches is not timed. The @p c->j is limited according to
+ * the engine, the result records the number of levels actually performed.
+ * The hardware counters of @p config are read around the runs only.
+ *
+ * @returns zero value on success, non-zero if the engine cannot run on the case
+ */
+int bench_measure(
+	const struct bench_engine_t *engine,
+	const struct bench_case_t *c,
+	const struct bench_config_t *config,
+	struct bench_result_t *result
+);
+
+/**
+ * @brief Measure the selected engines over all the cases of the @p config.
+ *
+ * Sweeps the sizes, the strides, the levels and the threads. The results are
+ * written into @p out as they come, each along with the library version and
+ * the architecture. Thus, the results of several versions can be compared
+ * directly. The counters are reported per pixel.
+ *
+ * @returns the number of the results written
+ */
+int bench_run(
+	const struct bench_config_t *config,
+	FILE *out,
+	enum bench_format format
+);
+
+#endif
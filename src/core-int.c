@@ -2,15 +2,30 @@
 #include <stdint.h>
 #include "image.h"
 
+#define GCC_VERSION (__GNUC__ * 10000 + __GNUC_MINOR__ * 100 + __GNUC_PATCHLEVEL__)
+
+/** SSE4.1 intrinsics, compiled regardless of -m flags and selected at run-time */
+#if defined(__x86_64__) && (GCC_VERSION >= 40900)
+	#define ENABLE_SSE41
+	#include <smmintrin.h>
+#endif
+
 static
 int virt2real(int pos, int offset, int overlap, int size)
 {
 	int real = pos + offset - overlap;
 
-	if( real < 0 )
-		real *= -1;
-	if( real > size-1 )
-		real = 2*(size-1) - real;
+	if( size < 2 )
+		return 0;
+
+	// reflect until inside, the signal may be shorter than the overlap
+	while( real < 0 || real > size-1 )
+	{
+		if( real < 0 )
+			real *= -1;
+		if( real > size-1 )
+			real = 2*(size-1) - real;
+	}
 
 	return real;
 }
@@ -148,6 +163,195 @@ void core_vert2x2(
         }
 }
 
+#ifdef ENABLE_SSE41
+#pragma GCC push_options
+#pragma GCC target("sse4.1")
+
+static
+__m128i op_4x(__m128i l, __m128i r, __m128i w, int s)
+{
+	const __m128i k = _mm_set1_epi32(1<<(s-1));
+
+	return _mm_sra_epi32( _mm_add_epi32( _mm_mullo_epi32(w, _mm_add_epi32(l, r)), k ), _mm_cvtsi32_si128(s) );
+}
+
+/**
+ * The same as vert_2x1, but on four independent lanes. The buffer holds four
+ * vectors, i.e. the lanes are interleaved.
+ */
+static
+void vert_2x1_4x(
+	__m128i *data0, // left [4]
+	__m128i *data1, // right [4]
+	__m128i *buff // [4][4]
+)
+{
+	// weights
+	const __m128i w[4] = { _mm_set1_epi32(+1817), _mm_set1_epi32(+113), _mm_set1_epi32(-217), _mm_set1_epi32(-203) }; // [ u2 p2 u1 p1 ]
+	// shifts
+	const int s[4] = { 12, 7, 12, 7 }; // [ u2 p2 u1 p1 ]
+
+	__m128i r[4];
+	__m128i y0, y1;
+
+	// load
+	__m128i *l = buff;
+
+	// operation
+	y0   = l[0];
+	r[3] = *data1;
+	r[2] = _mm_add_epi32(*data0, op_4x(l[3], r[3], w[3], s[3]));
+	r[1] = _mm_add_epi32(l[3],   op_4x(l[2], r[2], w[2], s[2]));
+	r[0] = _mm_add_epi32(l[2],   op_4x(l[1], r[1], w[1], s[1]));
+	y1   = _mm_add_epi32(l[1],   op_4x(l[0], r[0], w[0], s[0]));
+
+	// update
+	l[0] = r[0];
+	l[1] = r[1];
+	l[2] = r[2];
+	l[3] = r[3];
+
+	// outputs
+	*data0 = y0;
+	*data1 = y1;
+}
+
+static
+void transpose_4x4(__m128i *t)
+{
+	const __m128i a0 = _mm_unpacklo_epi32(t[0], t[1]);
+	const __m128i a1 = _mm_unpacklo_epi32(t[2], t[3]);
+	const __m128i a2 = _mm_unpackhi_epi32(t[0], t[1]);
+	const __m128i a3 = _mm_unpackhi_epi32(t[2], t[3]);
+
+	t[0] = _mm_unpacklo_epi64(a0, a1);
+	t[1] = _mm_unpackhi_epi64(a0, a1);
+	t[2] = _mm_unpacklo_epi64(a2, a3);
+	t[3] = _mm_unpackhi_epi64(a2, a3);
+}
+
+/**
+ * The same as four core_vert2x2 calls on the 4x4 block. The horizontal steps
+ * run on four rows at once, the vertical ones on four columns at once.
+ */
+static
+void core_vert4x4_sse41(
+	struct image_t *src,
+	struct image_t *dst,
+	int x,
+	int y,
+	__m128i *buffer_x_ptr,
+	__m128i *buffer_y_ptr
+)
+{
+	int overlap_x_L = 5;
+	int overlap_y_L = 5;
+
+	const int step_y = 4;
+	const int step_x = 4;
+
+	const int shift = 4;
+
+	// 4x4, rows in the vectors
+	__m128i t[4];
+
+	// load
+	const int inside_x = x - overlap_x_L >= 0 && x - overlap_x_L + step_x <= src->size_x;
+
+	for(int yy = 0; yy < step_y; yy++)
+	{
+		const int pos_y = virt2real(y, yy, overlap_y_L, src->size_y);
+
+		if( inside_x && sizeof(int32_t) == src->stride_x )
+		{
+			t[yy] = _mm_loadu_si128((const __m128i *)get_pixel(src, x - overlap_x_L, pos_y));
+		}
+		else
+		{
+			int32_t row[4];
+
+			for(int xx = 0; xx < step_x; xx++)
+			{
+				const int pos_x = virt2real(x, xx, overlap_x_L, src->size_x);
+
+				row[xx] = *get_pixel(src, pos_x, pos_y);
+			}
+
+			t[yy] = _mm_loadu_si128((const __m128i *)row);
+		}
+	}
+
+	// calc
+	transpose_4x4(t);
+	vert_2x1_4x(t+0, t+1, buffer_y_ptr);
+	vert_2x1_4x(t+2, t+3, buffer_y_ptr);
+	transpose_4x4(t);
+	vert_2x1_4x(t+0, t+1, buffer_x_ptr);
+	vert_2x1_4x(t+2, t+3, buffer_x_ptr);
+
+	// store
+	const int inside_dst_x = x - shift - overlap_x_L >= 0 && x - shift - overlap_x_L + step_x <= src->size_x;
+
+	for(int yy = 0; yy < step_y; yy++)
+	{
+		const int pos_y = virt2real_error(y-shift, yy, overlap_y_L, src->size_y);
+		if( pos_y < 0 )
+			continue;
+
+		if( inside_dst_x && sizeof(int32_t) == dst->stride_x )
+		{
+			_mm_storeu_si128((__m128i *)get_pixel(dst, x - shift - overlap_x_L, pos_y), t[yy]);
+		}
+		else
+		{
+			int32_t row[4];
+
+			_mm_storeu_si128((__m128i *)row, t[yy]);
+
+			for(int xx = 0; xx < step_x; xx++)
+			{
+				const int pos_x = virt2real_error(x-shift, xx, overlap_x_L, src->size_x);
+				if( pos_x < 0 )
+					continue;
+
+				*get_pixel(dst, pos_x, pos_y) = row[xx];
+			}
+		}
+	}
+}
+
+static
+void dwt_cdf97_2f_vert4x4_sse41_i(
+	struct image_t *src,
+	struct image_t *dst
+)
+{
+	int overlap_x_L = 5;
+	int overlap_y_L = 5;
+	int overlap_x_R = 5;
+	int overlap_y_R = 5;
+
+	int step_x = 4;
+	int step_y = 4;
+
+	// rounded up to the multiple of the step, the extra outputs are discarded
+	int super_x = (overlap_x_L + src->size_x + overlap_x_R + step_x-1) / step_x * step_x;
+	int super_y = (overlap_y_L + src->size_y + overlap_y_R + step_y-1) / step_y * step_y;
+
+	// the lifting state of four columns (rows) in a single block of vectors
+	const int buff_elem_size = 4;
+
+	__m128i buffer_x[buff_elem_size*super_x/step_x];
+	__m128i buffer_y[buff_elem_size*super_y/step_y];
+
+	for(int y = 0; y < super_y; y += step_y)
+		for(int x = 0; x < super_x; x += step_x)
+			core_vert4x4_sse41(src, dst, x, y, buffer_x+x/step_x*buff_elem_size, buffer_y+y/step_y*buff_elem_size);
+}
+
+#pragma GCC pop_options
+#endif /* ENABLE_SSE41 */
+
 void dwt_cdf97_2f_vert2x2_i(
 	void *src_ptr,
 	int src_stride_x,
@@ -167,17 +371,27 @@ void dwt_cdf97_2f_vert2x2_i(
 	int overlap_x_R = 5;
 	int overlap_y_R = 5;
 
-	int super_x = overlap_x_L + size_x + overlap_x_R;
-	int super_y = overlap_y_L + size_y + overlap_y_R;
+#ifdef ENABLE_SSE41
+	__builtin_cpu_init();
+	if( __builtin_cpu_supports("sse4.1") )
+	{
+		dwt_cdf97_2f_vert4x4_sse41_i(&src, &dst);
+		return;
+	}
+#endif
+
+	int step_x = 2;
+	int step_y = 2;
+
+	// rounded up to the multiple of the step, the extra outputs are discarded
+	int super_x = (overlap_x_L + size_x + overlap_x_R + step_x-1) / step_x * step_x;
+	int super_y = (overlap_y_L + size_y + overlap_y_R + step_y-1) / step_y * step_y;
 
 	const int buff_elem_size = 4;
 
 	int32_t buffer_x[buff_elem_size*super_x];
 	int32_t buffer_y[buff_elem_size*super_y];
 
-	int step_x = 2;
-	int step_y = 2;
-
 	for(int y = 0; y < super_y; y += step_y)
 		for(int x = 0; x < super_x; x += step_x)
 			core_vert2x2(&src, &dst, x, y, buffer_x+x*buff_elem_size, buffer_y+y*buff_elem_size);
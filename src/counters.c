@@ -0,0 +1,327 @@
+/**
+ * @brief Hardware performance counters of the transform kernels.
+ */
+
+#include "counters.h"
+#include "libdwt.h" // dwt_util_log
+// assert
+#include <assert.h>
+// strchr, strlen, strncmp, memset
+#include <string.h>
+// malloc, realloc, free, atoi
+#include <stdlib.h>
+
+#if defined(__linux) && !defined(microblaze)
+	#define HAVE_PERF_EVENT
+#endif
+
+#ifdef HAVE_PERF_EVENT
+	#include <linux/perf_event.h> // struct perf_event_attr, PERF_*
+	#include <sys/syscall.h> // __NR_perf_event_open
+	#include <sys/ioctl.h> // ioctl
+	#include <unistd.h> // syscall, read, close
+	#include <stdint.h> // uint64_t
+	#include <dirent.h> // opendir, readdir
+	#include <sys/types.h> // pid_t
+#endif
+
+static
+const char *counters_names[DWT_COUNTER_LAST] = {
+	[DWT_COUNTER_CYCLES]       = "cycles",
+	[DWT_COUNTER_INSTRUCTIONS] = "instructions",
+	[DWT_COUNTER_L1D_MISSES]   = "l1d-misses",
+	[DWT_COUNTER_LLC_MISSES]   = "llc-misses",
+	[DWT_COUNTER_DTLB_MISSES]  = "dtlb-misses",
+	[DWT_COUNTER_PAGE_FAULTS]  = "page-faults",
+};
+
+#ifdef HAVE_PERF_EVENT
+// the generic cache events
+#define COUNTERS_CACHE_READ_MISS(cache) \
+	((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+static
+const struct {
+	uint32_t type;
+	uint64_t config;
+} counters_events[DWT_COUNTER_LAST] = {
+	[DWT_COUNTER_CYCLES]       = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+	[DWT_COUNTER_INSTRUCTIONS] = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+	[DWT_COUNTER_L1D_MISSES]   = { PERF_TYPE_HW_CACHE, COUNTERS_CACHE_READ_MISS(PERF_COUNT_HW_CACHE_L1D) },
+	[DWT_COUNTER_LLC_MISSES]   = { PERF_TYPE_HW_CACHE, COUNTERS_CACHE_READ_MISS(PERF_COUNT_HW_CACHE_LL) },
+	[DWT_COUNTER_DTLB_MISSES]  = { PERF_TYPE_HW_CACHE, COUNTERS_CACHE_READ_MISS(PERF_COUNT_HW_CACHE_DTLB) },
+	[DWT_COUNTER_PAGE_FAULTS]  = { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS },
+};
+#endif
+
+#ifdef HAVE_PERF_EVENT
+/**
+ * The thread IDs of the process, the calling thread first.
+ *
+ * @returns the number of the threads, zero if they cannot be listed
+ */
+static
+int counters_list_threads(
+	pid_t **ptids)
+{
+	const pid_t self = (pid_t)syscall(__NR_gettid);
+
+	DIR *dir = opendir("/proc/self/task");
+
+	int count = 0;
+	int size = 16;
+	pid_t *tids = malloc(size * sizeof(pid_t));
+
+	if( !tids )
+	{
+		if( dir )
+			closedir(dir);
+		return 0;
+	}
+
+	tids[count++] = self;
+
+	if( dir )
+	{
+		struct dirent *entry;
+
+		while( (entry = readdir(dir)) )
+		{
+			const pid_t tid = (pid_t)atoi(entry->d_name);
+
+			if( tid <= 0 || tid == self )
+				continue;
+
+			if( count == size )
+			{
+				pid_t *grown = realloc(tids, 2 * size * sizeof(pid_t));
+
+				if( !grown )
+					break;
+
+				tids = grown;
+				size *= 2;
+			}
+
+			tids[count++] = tid;
+		}
+
+		closedir(dir);
+	}
+
+	*ptids = tids;
+
+	return count;
+}
+#endif
+
+int dwt_counters_open(
+	struct dwt_counters_t *counters,
+	int mask)
+{
+	assert( counters );
+
+	memset(counters, 0, sizeof(struct dwt_counters_t));
+
+#ifdef HAVE_PERF_EVENT
+	pid_t *tids = NULL;
+
+	const int threads = counters_list_threads(&tids);
+
+	counters->fd = threads ? malloc(threads * DWT_COUNTER_LAST * sizeof(int)) : NULL;
+
+	if( !counters->fd )
+	{
+		free(tids);
+		dwt_util_log(LOG_ERR, "%s: unable to allocate memory\n", __FUNCTION__);
+		return 0;
+	}
+
+	counters->threads = threads;
+
+	for(int i = 0; i < threads * DWT_COUNTER_LAST; i++)
+		counters->fd[i] = -1;
+
+	for(int n = 0; n < DWT_COUNTER_LAST; n++)
+	{
+		if( !(mask & (1 << n)) )
+			continue;
+
+		struct perf_event_attr attr;
+
+		memset(&attr, 0, sizeof(struct perf_event_attr));
+
+		attr.size = sizeof(struct perf_event_attr);
+		attr.type = counters_events[n].type;
+		attr.config = counters_events[n].config;
+		attr.disabled = 1;
+		attr.inherit = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		// the calling thread goes first, the other ones can exit meanwhile
+		for(int t = 0; t < threads; t++)
+		{
+			const int fd = syscall(__NR_perf_event_open, &attr, tids[t], -1, -1, 0);
+
+			if( -1 == fd && !t )
+				break;
+
+			counters->fd[t * DWT_COUNTER_LAST + n] = fd;
+		}
+
+		if( -1 == counters->fd[n] )
+		{
+			// warn only once
+			static int warned = 0;
+
+			if( !(warned & (1 << n)) )
+				dwt_util_log(LOG_WARN, "%s: the counter %s is not available\n", __FUNCTION__, counters_names[n]);
+
+			warned |= 1 << n;
+			continue;
+		}
+
+		counters->mask |= 1 << n;
+	}
+
+	free(tids);
+#else
+	if( mask )
+		dwt_util_log(LOG_WARN, "%s: the counters are not available on this system\n", __FUNCTION__);
+#endif
+
+	return counters->mask;
+}
+
+void dwt_counters_start(
+	struct dwt_counters_t *counters)
+{
+	assert( counters );
+
+#ifdef HAVE_PERF_EVENT
+	for(int i = 0; i < counters->threads * DWT_COUNTER_LAST; i++)
+	{
+		if( counters->fd[i] < 0 )
+			continue;
+
+		ioctl(counters->fd[i], PERF_EVENT_IOC_RESET, 0);
+		ioctl(counters->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+	}
+#endif
+}
+
+void dwt_counters_stop(
+	struct dwt_counters_t *counters)
+{
+	assert( counters );
+
+	for(int n = 0; n < DWT_COUNTER_LAST; n++)
+		counters->value[n] = 0.;
+
+#ifdef HAVE_PERF_EVENT
+	for(int i = 0; i < counters->threads * DWT_COUNTER_LAST; i++)
+	{
+		if( counters->fd[i] < 0 )
+			continue;
+
+		ioctl(counters->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+	}
+
+	for(int i = 0; i < counters->threads * DWT_COUNTER_LAST; i++)
+	{
+		const int n = i % DWT_COUNTER_LAST;
+
+		if( counters->fd[i] < 0 )
+			continue;
+
+		// value, time enabled, time running
+		uint64_t data[3];
+
+		if( sizeof(data) != read(counters->fd[i], data, sizeof(data)) )
+		{
+			dwt_util_log(LOG_WARN, "%s: unable to read the counter %s\n", __FUNCTION__, counters_names[n]);
+			continue;
+		}
+
+		// multiplexed
+		if( data[2] && data[2] < data[1] )
+			counters->value[n] += (double)data[0] * data[1] / data[2];
+		else
+			counters->value[n] += (double)data[0];
+	}
+#endif
+}
+
+void dwt_counters_close(
+	struct dwt_counters_t *counters)
+{
+	assert( counters );
+
+#ifdef HAVE_PERF_EVENT
+	for(int i = 0; i < counters->threads * DWT_COUNTER_LAST; i++)
+	{
+		if( counters->fd[i] >= 0 )
+			close(counters->fd[i]);
+	}
+#endif
+
+	free(counters->fd);
+
+	counters->fd = NULL;
+	counters->threads = 0;
+	counters->mask = 0;
+}
+
+const char *dwt_counters_name(
+	int n)
+{
+	assert( n >= 0 && n < DWT_COUNTER_LAST );
+
+	return counters_names[n];
+}
+
+int dwt_counters_parse(
+	const char *list)
+{
+	assert( list );
+
+	int mask = 0;
+
+	while( *list )
+	{
+		const char *end = strchr(list, ',');
+		const size_t len = end ? (size_t)(end - list) : strlen(list);
+
+		int found = 0;
+
+		if( len == 3 && !strncmp(list, "all", len) )
+		{
+			mask |= DWT_COUNTERS_ALL;
+			found = 1;
+		}
+
+		for(int n = 0; n < DWT_COUNTER_LAST; n++)
+		{
+			if( len == strlen(counters_names[n]) && !strncmp(list, counters_names[n], len) )
+			{
+				mask |= 1 << n;
+				found = 1;
+			}
+		}
+
+		if( !found )
+		{
+			dwt_util_log(LOG_ERR, "%s: unknown counter %.*s\n", __FUNCTION__, (int)len, list);
+			return -1;
+		}
+
+		list += len;
+
+		if( *list )
+			list++;
+	}
+
+	return mask;
+}
@@ -0,0 +1,92 @@
+/**
+ * @brief Hardware performance counters of the transform kernels.
+ */
+
+#ifndef COUNTERS_H
+#define COUNTERS_H
+
+/**
+ * @brief The counters available through @ref dwt_counters_open.
+ */
+enum dwt_counter {
+	DWT_COUNTER_CYCLES = 0,		///< CPU cycles
+	DWT_COUNTER_INSTRUCTIONS = 1,	///< retired instructions
+	DWT_COUNTER_L1D_MISSES = 2,	///< L1 data cache read misses, i.e. the reads served by L2 or further
+	DWT_COUNTER_LLC_MISSES = 3,	///< last level cache read misses
+	DWT_COUNTER_DTLB_MISSES = 4,	///< data TLB read misses
+	DWT_COUNTER_PAGE_FAULTS = 5,	///< page faults (software counter)
+	DWT_COUNTER_LAST
+};
+
+/**
+ * @brief Mask of all the counters.
+ */
+#define DWT_COUNTERS_ALL ((1 << DWT_COUNTER_LAST) - 1)
+
+/**
+ * @brief Set of the counters of all the threads of the process.
+ */
+struct dwt_counters_t {
+	int mask;				///< the counters actually opened
+	int threads;				///< the number of the threads the counters are opened for
+	int *fd;				///< perf_event_open file descriptors, DWT_COUNTER_LAST for each thread
+	double value[DWT_COUNTER_LAST];		///< the values between the last start and stop, summed over the threads
+};
+
+/**
+ * @brief Open the counters given by the @p mask.
+ *
+ * Uses perf_event_open on Linux. Only the user-space events are counted.
+ * The counters are opened for each thread already running (e.g. the OpenMP
+ * team or the workers of the thread pool) and inherited by the threads
+ * created afterwards. The counters which are not supported (e.g. in a
+ * virtual machine or on other systems) are left out with a warning.
+ *
+ * @returns the mask of the counters actually opened
+ */
+int dwt_counters_open(
+	struct dwt_counters_t *counters,
+	int mask	///< bits 1 << @ref dwt_counter
+);
+
+/**
+ * @brief Reset and start the counting.
+ */
+void dwt_counters_start(
+	struct dwt_counters_t *counters
+);
+
+/**
+ * @brief Stop the counting and read the values.
+ *
+ * The values of all the threads are summed. When the kernel multiplexes the
+ * counters, the values are extrapolated to the whole interval.
+ */
+void dwt_counters_stop(
+	struct dwt_counters_t *counters
+);
+
+/**
+ * @brief Close the counters.
+ */
+void dwt_counters_close(
+	struct dwt_counters_t *counters
+);
+
+/**
+ * @brief Short name of the counter @p n, e.g. "cycles".
+ */
+const char *dwt_counters_name(
+	int n
+);
+
+/**
+ * @brief Parse the comma-separated list of the counter names, "all" for all of them.
+ *
+ * @returns the mask of the counters, -1 for an unknown name
+ */
+int dwt_counters_parse(
+	const char *list
+);
+
+#endif
@@ -0,0 +1,241 @@
+/**
+ * @brief Batched 2-D transform of many small images.
+ */
+
+#include "dwt-batch.h"
+#include "libdwt.h"
+#include "inline.h"
+#include "system.h" // dwt_util_alloc_aligned_ex_reliably
+// assert
+#include <assert.h>
+// free
+#include <stdlib.h>
+#ifdef __SSE__
+	#include <xmmintrin.h>
+#endif
+
+/**
+ * The image @p n, either from the array @p ptrs or from the buffer @p base.
+ */
+static
+void *batch_image(
+	void **ptrs,
+	void *base,
+	int stride_image,
+	int n)
+{
+	return ptrs ? ptrs[n] : (char *)base + (size_t)n * stride_image;
+}
+
+#ifdef __SSE__
+// the number of images in a group, one in each lane
+#define BATCH_LANES 4
+
+/**
+ * In-place lifting of the line of @p N vectors, the result is interleaved.
+ * Whole-sample symmetric extension, the same as in @ref dwt_cdf97_2f_s.
+ */
+static
+void batch_lift_s(
+	__m128 *t,
+	int N)
+{
+	const float w[4] = { -dwt_cdf97_p1_s, dwt_cdf97_u1_s, -dwt_cdf97_p2_s, dwt_cdf97_u2_s };
+
+	for(int k = 0; k < 4; k++)
+	{
+		const __m128 wk = _mm_set1_ps(w[k]);
+
+		// odd samples are predicted first
+		const int first = (k & 1) ? 0 : 1;
+
+		int i = first;
+
+		// the left border
+		if( 0 == i )
+		{
+			t[0] = _mm_add_ps(t[0], _mm_mul_ps(wk, _mm_add_ps(t[1], t[1])));
+			i += 2;
+		}
+
+		for(; i < N-1; i += 2)
+			t[i] = _mm_add_ps(t[i], _mm_mul_ps(wk, _mm_add_ps(t[i-1], t[i+1])));
+
+		// the right border
+		if( i == N-1 )
+			t[i] = _mm_add_ps(t[i], _mm_mul_ps(wk, _mm_add_ps(t[i-1], t[i-1])));
+	}
+}
+
+/**
+ * Transform the line of @p N vectors, @p stride vectors apart, into [L|H].
+ */
+static
+void batch_line_s(
+	__m128 *ptr,
+	int stride,
+	int N,
+	__m128 *t)
+{
+	for(int i = 0; i < N; i++)
+		t[i] = ptr[i*stride];
+
+	batch_lift_s(t, N);
+
+	const __m128 scale_l = _mm_set1_ps(dwt_cdf97_s1_s);
+	const __m128 scale_h = _mm_set1_ps(1/dwt_cdf97_s1_s);
+
+	const int L = ceil_div2(N);
+
+	for(int i = 0; i < N; i += 2)
+		ptr[(i/2)*stride] = _mm_mul_ps(t[i], scale_l);
+	for(int i = 1; i < N; i += 2)
+		ptr[(L+i/2)*stride] = _mm_mul_ps(t[i], scale_h);
+}
+
+/**
+ * Transform the group of the images [n, n+BATCH_LANES).
+ */
+static
+void batch_group_s(
+	void **ptrs,
+	void *base,
+	int stride_image,
+	int count,
+	int n,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y,
+	int J,
+	__m128 *buff,
+	__m128 *t)
+{
+	float *img[BATCH_LANES];
+
+	// the missing images of the last group are replaced by the last one, they are not stored
+	for(int l = 0; l < BATCH_LANES; l++)
+		img[l] = batch_image(ptrs, base, stride_image, min(n+l, count-1));
+
+	for(int y = 0; y < size_y; y++)
+		for(int x = 0; x < size_x; x++)
+			buff[y*size_x+x] = _mm_setr_ps(
+				*addr2_s(img[0], y, x, stride_x, stride_y),
+				*addr2_s(img[1], y, x, stride_x, stride_y),
+				*addr2_s(img[2], y, x, stride_x, stride_y),
+				*addr2_s(img[3], y, x, stride_x, stride_y)
+			);
+
+	for(int j = 0; j < J; j++)
+	{
+		const int size_x_j = ceil_div_pow2(size_x, j);
+		const int size_y_j = ceil_div_pow2(size_y, j);
+
+		if( size_x_j > 1 )
+		{
+			for(int y = 0; y < size_y_j; y++)
+				batch_line_s(buff + y*size_x, 1, size_x_j, t);
+		}
+
+		if( size_y_j > 1 )
+		{
+			for(int x = 0; x < size_x_j; x++)
+				batch_line_s(buff + x, size_x, size_y_j, t);
+		}
+	}
+
+	for(int l = 0; l < BATCH_LANES && n+l < count; l++)
+	{
+		for(int y = 0; y < size_y; y++)
+		{
+			for(int x = 0; x < size_x; x++)
+			{
+				const float *v = (const float *)&buff[y*size_x+x];
+
+				*addr2_s(img[l], y, x, stride_x, stride_y) = v[l];
+			}
+		}
+	}
+}
+#endif
+
+static
+void batch_cdf97_2f_s(
+	void **ptrs,
+	void *base,
+	int stride_image,
+	int count,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y,
+	int *j_max_ptr,
+	int decompose_one)
+{
+	assert( (ptrs || base) && count >= 0 && size_x > 0 && size_y > 0 && j_max_ptr );
+
+	const int j_limit = ceil_log2( decompose_one ? max(size_x, size_y) : min(size_x, size_y) );
+
+	if( *j_max_ptr < 0 || *j_max_ptr > j_limit )
+		*j_max_ptr = j_limit;
+
+	const int J = *j_max_ptr;
+
+	if( !count || !J )
+		return;
+
+#ifdef __SSE__
+	const int groups = ceil_div(count, BATCH_LANES);
+
+	#pragma omp parallel
+	{
+		__m128 *buff = dwt_util_alloc_aligned_ex_reliably(size_x * size_y, sizeof(__m128), 16);
+		__m128 *t = dwt_util_alloc_aligned_ex_reliably(max(size_x, size_y), sizeof(__m128), 16);
+
+		#pragma omp for schedule(static)
+		for(int g = 0; g < groups; g++)
+		{
+			batch_group_s(ptrs, base, stride_image, count, g*BATCH_LANES,
+				stride_x, stride_y, size_x, size_y, J, buff, t);
+		}
+
+		free(buff);
+		free(t);
+	}
+#else
+	for(int n = 0; n < count; n++)
+	{
+		int j = J;
+
+		dwt_cdf97_2f_s(batch_image(ptrs, base, stride_image, n), stride_x, stride_y,
+			size_x, size_y, size_x, size_y, &j, decompose_one, 0);
+	}
+#endif
+}
+
+void dwt_cdf97_2f_batch_s(
+	void **ptr,
+	int count,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y,
+	int *j_max_ptr,
+	int decompose_one)
+{
+	batch_cdf97_2f_s(ptr, NULL, 0, count, stride_x, stride_y, size_x, size_y, j_max_ptr, decompose_one);
+}
+
+void dwt_cdf97_2f_batch_strided_s(
+	void *ptr,
+	int stride_image,
+	int count,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y,
+	int *j_max_ptr,
+	int decompose_one)
+{
+	batch_cdf97_2f_s(NULL, ptr, stride_image, count, stride_x, stride_y, size_x, size_y, j_max_ptr, decompose_one);
+}
@@ -0,0 +1,46 @@
+/**
+ * @brief Batched 2-D transform of many small images.
+ */
+
+#ifndef DWT_BATCH_H
+#define DWT_BATCH_H
+
+/**
+ * @brief Forward 2-D CDF 9/7 transform of @p count equally-sized images.
+ *
+ * The images are transformed in groups of four, one image in each SIMD
+ * lane. Thus, the lifting runs on whole vectors regardless of the size of
+ * the images. The groups are distributed among the threads. The layout of
+ * the coefficients of each image is the same as produced by
+ * @ref dwt_cdf97_2f_s on the image alone.
+ */
+void dwt_cdf97_2f_batch_s(
+	void **ptr,		///< array of @p count pointers to the images
+	int count,		///< the number of images
+	int stride_x,		///< difference between rows (in bytes)
+	int stride_y,		///< difference between columns (in bytes)
+	int size_x,		///< width of the images (in elements)
+	int size_y,		///< height of the images (in elements)
+	int *j_max_ptr,		///< pointer to the number of intended decomposition levels (scales), the number of achieved decomposition levels will be stored also here
+	int decompose_one	///< should be row or column of size one pixel decomposed? zero value if not
+);
+
+/**
+ * @brief Forward 2-D CDF 9/7 transform of the images stored one after another.
+ *
+ * The same as @ref dwt_cdf97_2f_batch_s, the image n starts at
+ * @p ptr + n * @p stride_image.
+ */
+void dwt_cdf97_2f_batch_strided_s(
+	void *ptr,		///< pointer to the first image
+	int stride_image,	///< difference between images (in bytes)
+	int count,		///< the number of images
+	int stride_x,		///< difference between rows (in bytes)
+	int stride_y,		///< difference between columns (in bytes)
+	int size_x,		///< width of the images (in elements)
+	int size_y,		///< height of the images (in elements)
+	int *j_max_ptr,		///< pointer to the number of intended decomposition levels (scales), the number of achieved decomposition levels will be stored also here
+	int decompose_one	///< should be row or column of size one pixel decomposed? zero value if not
+);
+
+#endif
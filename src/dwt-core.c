@@ -6271,3 +6271,1353 @@ fdwt_vert_2x2_func_t get_fdwt_vert_2x2_func(enum order order)
 
 	return fdwt_vert_2x2_func[order];
 }
+
+/*
+	inverse transform, the same data flow as in fdwt_cdf97_diag_cor2x2_sse_s
+	but with the reversed lifting steps and the scaling applied on input
+ */
+static
+void idwt_cdf97_diag_cor2x2_sse_s(
+	float *ptrL0, float *ptrL1, // y=0
+	float *ptrR0, float *ptrR1, // y=1
+	float *outL0, float *outR0, // y=0
+	float *outL1, float *outR1, // y=1
+	float *lAL, // h0
+	float *lAR, // h1
+	float *lBL, // v0
+	float *lBR  // v1
+)
+{
+#ifdef __SSE__
+	const __m128 w = { dwt_cdf97_p1_s, -dwt_cdf97_u1_s, dwt_cdf97_p2_s, -dwt_cdf97_u2_s };
+	const __m128 v_vert = { 1/(dwt_cdf97_s1_s*dwt_cdf97_s1_s), 1.f, 1.f, (dwt_cdf97_s1_s*dwt_cdf97_s1_s) };
+
+	__m128 buff;
+	__m128 z;
+
+	// [ y0x0 y0x1 y1x0 y1x1 ]
+	buff[0] = *ptrL0;
+	buff[1] = *ptrL1;
+	buff[2] = *ptrR0;
+	buff[3] = *ptrR1;
+
+	// A/L+R
+	op4s_sdl2_scale_s_sse(buff, v_vert);
+
+	// A/L+R
+	op4s_sdl2_shuffle_input_low_s_sse(buff, *(__m128 *)(lAL+4), *(__m128 *)(lAL+8));
+	op4s_sdl2_shuffle_input_high_s_sse(buff, *(__m128 *)(lAR+4), *(__m128 *)(lAR+8));
+
+	// A/L
+	op4s_sdl2_op_s_sse(z, *(__m128 *)(lAL+4), w, *(__m128 *)(lAL+0), *(__m128 *)(lAL+8));
+	op4s_sdl2_output_low_s_sse(buff, *(__m128 *)(lAL+0), z);
+	op4s_sdl2_update_s_sse(*(__m128 *)(lAL+4), *(__m128 *)(lAL+0), *(__m128 *)(lAL+8), z);
+
+	// A/R
+	op4s_sdl2_op_s_sse(z, *(__m128 *)(lAR+4), w, *(__m128 *)(lAR+0), *(__m128 *)(lAR+8));
+	op4s_sdl2_output_high_s_sse(buff, *(__m128 *)(lAR+0), z);
+	op4s_sdl2_update_s_sse(*(__m128 *)(lAR+4), *(__m128 *)(lAR+0), *(__m128 *)(lAR+8), z);
+
+	// swap, this should by done by single shuffle instruction
+	buff = _mm_shuffle_ps(buff, buff, _MM_SHUFFLE(3,1,2,0));
+
+	// B/L+R
+	op4s_sdl2_shuffle_input_low_s_sse(buff, *(__m128 *)(lBL+4), *(__m128 *)(lBL+8));
+	op4s_sdl2_shuffle_input_high_s_sse(buff, *(__m128 *)(lBR+4), *(__m128 *)(lBR+8));
+
+	// B/L
+	op4s_sdl2_op_s_sse(z, *(__m128 *)(lBL+4), w, *(__m128 *)(lBL+0), *(__m128 *)(lBL+8));
+	op4s_sdl2_output_low_s_sse(buff, *(__m128 *)(lBL+0), z);
+	op4s_sdl2_update_s_sse(*(__m128 *)(lBL+4), *(__m128 *)(lBL+0), *(__m128 *)(lBL+8), z);
+
+	// B/R
+	op4s_sdl2_op_s_sse(z, *(__m128 *)(lBR+4), w, *(__m128 *)(lBR+0), *(__m128 *)(lBR+8));
+	op4s_sdl2_output_high_s_sse(buff, *(__m128 *)(lBR+0), z);
+	op4s_sdl2_update_s_sse(*(__m128 *)(lBR+4), *(__m128 *)(lBR+0), *(__m128 *)(lBR+8), z);
+
+	// [ y0x0 y1x0 y0x1 y1x1 ]
+	*outL0 = buff[0];
+	*outL1 = buff[1];
+	*outR0 = buff[2];
+	*outR1 = buff[3];
+#endif /* __SSE__ */
+}
+
+/*
+	inverse transform, the same data flow as in fdwt_cdf97_vert_cor2x2_sse_s
+	but with the reversed lifting steps and the scaling applied on input
+ */
+static
+void idwt_cdf97_vert_cor2x2_sse_s(
+	float *ptr_y0_x0, // in
+	float *ptr_y0_x1, // in
+	float *ptr_y1_x0, // in
+	float *ptr_y1_x1, // in
+	float *out_y0_x0, // out
+	float *out_y0_x1, // out
+	float *out_y1_x0, // out
+	float *out_y1_x1, // out
+	float *buff_h0, // [4]
+	float *buff_h1, // [4]
+	float *buff_v0, // [4]
+	float *buff_v1  // [4]
+)
+{
+#ifdef __SSE__
+	const __m128 w = { dwt_cdf97_p1_s, -dwt_cdf97_u1_s, dwt_cdf97_p2_s, -dwt_cdf97_u2_s };
+
+	const __m128 v_horizL = { 1/(dwt_cdf97_s1_s*dwt_cdf97_s1_s), 1.f,
+		0.f, 0.f };
+	const __m128 v_horizR = { 1.f, (dwt_cdf97_s1_s*dwt_cdf97_s1_s),
+		0.f, 0.f };
+
+	// temp
+	__m128 t;
+
+	// aux. variables
+	__m128 x, y, r, c;
+
+	// horiz 1
+	{
+		float *l = buff_h0;
+
+		// inputs
+		x[0] = *ptr_y0_x0;
+		x[1] = *ptr_y0_x1;
+
+		// scaling
+		x[0] *= v_horizL[0];
+		x[1] *= v_horizL[1];
+
+		// shuffles
+		y[0] = l[0];
+		c[0] = l[1];
+		c[1] = l[2];
+		c[2] = l[3];
+		c[3] = x[0];
+
+		// operation
+		r[3] = x[1];
+		r[2] = c[3]+w[3]*(l[3]+r[3]);
+		r[1] = c[2]+w[2]*(l[2]+r[2]);
+		r[0] = c[1]+w[1]*(l[1]+r[1]);
+		y[1] = c[0]+w[0]*(l[0]+r[0]);
+
+		// outputs
+		t[0] = y[0];
+		t[1] = y[1];
+
+		// update l[]
+		l[0] = r[0];
+		l[1] = r[1];
+		l[2] = r[2];
+		l[3] = r[3];
+	}
+
+	// horiz 2
+	{
+		float *l = buff_h1;
+
+		// inputs
+		x[0] = *ptr_y1_x0;
+		x[1] = *ptr_y1_x1;
+
+		// scaling
+		x[0] *= v_horizR[0];
+		x[1] *= v_horizR[1];
+
+		// shuffles
+		y[0] = l[0];
+		c[0] = l[1];
+		c[1] = l[2];
+		c[2] = l[3];
+		c[3] = x[0];
+
+		// operation
+		r[3] = x[1];
+		r[2] = c[3]+w[3]*(l[3]+r[3]);
+		r[1] = c[2]+w[2]*(l[2]+r[2]);
+		r[0] = c[1]+w[1]*(l[1]+r[1]);
+		y[1] = c[0]+w[0]*(l[0]+r[0]);
+
+		// outputs
+		t[2] = y[0];
+		t[3] = y[1];
+
+		// update l[]
+		l[0] = r[0];
+		l[1] = r[1];
+		l[2] = r[2];
+		l[3] = r[3];
+	}
+
+	// vert 1
+	{
+		float *l = buff_v0;
+
+		// inputs
+		x[0] = t[0];
+		x[1] = t[2];
+
+		// shuffles
+		y[0] = l[0];
+		c[0] = l[1];
+		c[1] = l[2];
+		c[2] = l[3];
+		c[3] = x[0];
+
+		// operation
+		r[3] = x[1];
+		r[2] = c[3]+w[3]*(l[3]+r[3]);
+		r[1] = c[2]+w[2]*(l[2]+r[2]);
+		r[0] = c[1]+w[1]*(l[1]+r[1]);
+		y[1] = c[0]+w[0]*(l[0]+r[0]);
+
+		// outputs
+		*out_y0_x0 = y[0];
+		*out_y1_x0 = y[1];
+
+		// update l[]
+		l[0] = r[0];
+		l[1] = r[1];
+		l[2] = r[2];
+		l[3] = r[3];
+	}
+
+	// vert 2
+	{
+		float *l = buff_v1;
+
+		// inputs
+		x[0] = t[1];
+		x[1] = t[3];
+
+		// shuffles
+		y[2] = l[0];
+		c[0] = l[1];
+		c[1] = l[2];
+		c[2] = l[3];
+		c[3] = x[0];
+
+		// operation
+		r[3] = x[1];
+		r[2] = c[3]+w[3]*(l[3]+r[3]);
+		r[1] = c[2]+w[2]*(l[2]+r[2]);
+		r[0] = c[1]+w[1]*(l[1]+r[1]);
+		y[3] = c[0]+w[0]*(l[0]+r[0]);
+
+		// outputs
+		*out_y0_x1 = y[2];
+		*out_y1_x1 = y[3];
+
+		// update l[]
+		l[0] = r[0];
+		l[1] = r[1];
+		l[2] = r[2];
+		l[3] = r[3];
+	}
+#endif /* __SSE__ */
+}
+
+// NOTE: read from (x,y) write to (x-shift,y-shift) for (base_x,base_y) <= (x,y) < (stop_x, stop_y)
+void idwt_diag_2x2_cor_HORIZ(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int base_x, // start at ...
+	int base_y,
+	int stop_x, // stop at ...
+	int stop_y,
+	float *buffer_y, // short_buffer
+	float *buffer_x  // long_buffer
+)
+{
+	// characteristic constants
+	const int shift = 10; // diag
+	const int buff_elem_size = 3*4; // diag
+
+	// initially
+	float *const buffer_y0 = &buffer_y[(base_y)*(buff_elem_size)];
+	float *const buffer_x0 = &buffer_x[(base_x)*(buff_elem_size)];
+
+	// initially
+	char *ptr_y0_x0 = (void *)addr2_s(ptr, base_y+0,       base_x+0,       stride_x, stride_y);
+	char *ptr_y1_x0 = (void *)addr2_s(ptr, base_y+1,       base_x+0,       stride_x, stride_y);
+	char *out_y0_x0 = (void *)addr2_s(ptr, base_y+0-shift, base_x+0-shift, stride_x, stride_y);
+	char *out_y1_x0 = (void *)addr2_s(ptr, base_y+1-shift, base_x+0-shift, stride_x, stride_y);
+
+	// increments
+	const ptrdiff_t diff_y0_x1 = (ptrdiff_t)addr1_s(0, +1, stride_y); // +1 rows
+
+	// increments
+	const ptrdiff_t diff_y2 = (ptrdiff_t)addr1_s(0, +2, stride_x); // +2 cols
+	const ptrdiff_t diff_x2 = (ptrdiff_t)addr1_s(0, +2, stride_y); // +2 rows
+
+	float *buffer_y0_i = buffer_y0;
+
+	for(int y = base_y; y+1 < stop_y; y += 2)
+	{
+		char *ptr_y0_x0_i = ptr_y0_x0;
+		char *ptr_y1_x0_i = ptr_y1_x0;
+		char *out_y0_x0_i = out_y0_x0;
+		char *out_y1_x0_i = out_y1_x0;
+
+		float *buffer_x0_i = buffer_x0;
+
+		for(int x = base_x; x+1 < stop_x; x += 2)
+		{
+			idwt_cdf97_diag_cor2x2_sse_s(
+				// ptr
+				(void *)ptr_y0_x0_i,
+				(void *)ptr_y0_x0_i + diff_y0_x1,
+				(void *)ptr_y1_x0_i,
+				(void *)ptr_y1_x0_i + diff_y0_x1,
+				// out
+				(void *)out_y0_x0_i,
+				(void *)out_y0_x0_i + diff_y0_x1,
+				(void *)out_y1_x0_i,
+				(void *)out_y1_x0_i + diff_y0_x1,
+				// buffers
+				buffer_y0_i+0*(buff_elem_size),
+				buffer_y0_i+1*(buff_elem_size),
+				buffer_x0_i+0*(buff_elem_size),
+				buffer_x0_i+1*(buff_elem_size)
+			);
+
+			ptr_y0_x0_i += diff_x2;
+			ptr_y1_x0_i += diff_x2;
+			out_y0_x0_i += diff_x2;
+			out_y1_x0_i += diff_x2;
+
+			buffer_x0_i += 2*(buff_elem_size);
+		}
+
+		ptr_y0_x0 += diff_y2;
+		ptr_y1_x0 += diff_y2;
+		out_y0_x0 += diff_y2;
+		out_y1_x0 += diff_y2;
+
+		buffer_y0_i += 2*(buff_elem_size);
+	}
+}
+
+void idwt_diag_2x2_cor_VERT(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int base_x, // start at ...
+	int base_y,
+	int stop_x, // stop at ...
+	int stop_y,
+	float *buffer_y, // short_buffer
+	float *buffer_x  // long_buffer
+)
+{
+	// characteristic constants
+	const int shift = 10; // diag
+	const int buff_elem_size = 3*4; // diag
+
+	// initially
+	float *buffer_y0 = &buffer_y[(base_y)*(buff_elem_size)];
+	float *buffer_x0 = &buffer_x[(base_x)*(buff_elem_size)];
+
+	// initially
+	char *ptr_y0_x0 = (void *)addr2_s(ptr, base_y,       base_x,       stride_x, stride_y);
+	char *out_y0_x0 = (void *)addr2_s(ptr, base_y-shift, base_x-shift, stride_x, stride_y);
+
+	// increments
+	const ptrdiff_t diff_y0_x0 = 0; // +0 col +0 row
+	const ptrdiff_t diff_y1_x0 = (ptrdiff_t)addr1_s(0, +1, stride_x); // +1 cols
+	const ptrdiff_t diff_y0_x1 = (ptrdiff_t)addr1_s(0, +1, stride_y); // +1 rows
+	const ptrdiff_t diff_y1_x1 = diff_y0_x1 + diff_y1_x0; // +1 col +1 row
+
+	// increments
+	const ptrdiff_t diff_y2 = (ptrdiff_t)addr1_s(0, +2, stride_x); // +2 cols
+	const ptrdiff_t diff_x2 = (ptrdiff_t)addr1_s(0, +2, stride_y); // +2 rows
+
+	float *buffer_x0_i = buffer_x0;
+
+	for(int x = base_x; x+1 < stop_x; x += 2)
+	{
+		char *ptr_y0_x0_i = ptr_y0_x0;
+		char *out_y0_x0_i = out_y0_x0;
+
+		float *buffer_y0_i = buffer_y0;
+
+		for(int y = base_y; y+1 < stop_y; y += 2)
+		{
+			idwt_cdf97_diag_cor2x2_sse_s(
+				// ptr
+				(void *)ptr_y0_x0_i + diff_y0_x0,
+				(void *)ptr_y0_x0_i + diff_y0_x1,
+				(void *)ptr_y0_x0_i + diff_y1_x0,
+				(void *)ptr_y0_x0_i + diff_y1_x1,
+				// out
+				(void *)out_y0_x0_i + diff_y0_x0,
+				(void *)out_y0_x0_i + diff_y0_x1,
+				(void *)out_y0_x0_i + diff_y1_x0,
+				(void *)out_y0_x0_i + diff_y1_x1,
+				// buffers
+				buffer_y0_i+0*(buff_elem_size),
+				buffer_y0_i+1*(buff_elem_size),
+				buffer_x0_i+0*(buff_elem_size),
+				buffer_x0_i+1*(buff_elem_size)
+			);
+
+			ptr_y0_x0_i += diff_y2;
+			out_y0_x0_i += diff_y2;
+
+			buffer_y0_i += 2*(buff_elem_size);
+		}
+
+		ptr_y0_x0 += diff_x2;
+		out_y0_x0 += diff_x2;
+
+		buffer_x0_i += 2*(buff_elem_size);
+	}
+}
+
+// NOTE: read from (x,y) write to (x-shift,y-shift) for (base_x,base_y) <= (x,y) < (stop_x, stop_y)
+void idwt_vert_2x2_cor_HORIZ(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int base_x, // start at ...
+	int base_y,
+	int stop_x, // stop at ...
+	int stop_y,
+	float *buffer_y, // short_buffer
+	float *buffer_x  // long_buffer
+)
+{
+	// characteristic constants
+	const int shift = 4; // vert
+	const int buff_elem_size = 1*4; // vert
+
+	// initially
+	float *const buffer_y0 = &buffer_y[(base_y)*(buff_elem_size)];
+	float *const buffer_x0 = &buffer_x[(base_x)*(buff_elem_size)];
+
+	// initially
+	char *ptr_y0_x0 = (void *)addr2_s(ptr, base_y+0,       base_x,       stride_x, stride_y);
+	char *ptr_y1_x0 = (void *)addr2_s(ptr, base_y+1,       base_x,       stride_x, stride_y);
+	char *out_y0_x0 = (void *)addr2_s(ptr, base_y+0-shift, base_x-shift, stride_x, stride_y);
+	char *out_y1_x0 = (void *)addr2_s(ptr, base_y+1-shift, base_x-shift, stride_x, stride_y);
+
+	// increments
+	const ptrdiff_t diff_y0_x1 = (ptrdiff_t)addr1_s(0, +1, stride_y); // +1 rows
+
+	// increments
+	const ptrdiff_t diff_y2 = (ptrdiff_t)addr1_s(0, +2, stride_x); // +2 cols
+	const ptrdiff_t diff_x2 = (ptrdiff_t)addr1_s(0, +2, stride_y); // +2 rows
+
+	float *buffer_y0_i = buffer_y0;
+
+	for(int y = base_y; y+1 < stop_y; y += 2)
+	{
+		char *ptr_y0_x0_i = ptr_y0_x0;
+		char *ptr_y1_x0_i = ptr_y1_x0;
+		char *out_y0_x0_i = out_y0_x0;
+		char *out_y1_x0_i = out_y1_x0;
+
+		float *buffer_x0_i = buffer_x0;
+
+		for(int x = base_x; x+1 < stop_x; x += 2)
+		{
+			idwt_cdf97_vert_cor2x2_sse_s(
+				// ptr
+				(void *)ptr_y0_x0_i,
+				(void *)ptr_y0_x0_i + diff_y0_x1,
+				(void *)ptr_y1_x0_i,
+				(void *)ptr_y1_x0_i + diff_y0_x1,
+				// out
+				(void *)out_y0_x0_i,
+				(void *)out_y0_x0_i + diff_y0_x1,
+				(void *)out_y1_x0_i,
+				(void *)out_y1_x0_i + diff_y0_x1,
+				// buffers
+				buffer_y0_i+0*(buff_elem_size),
+				buffer_y0_i+1*(buff_elem_size),
+				buffer_x0_i+0*(buff_elem_size),
+				buffer_x0_i+1*(buff_elem_size)
+			);
+
+			ptr_y0_x0_i += diff_x2;
+			ptr_y1_x0_i += diff_x2;
+			out_y0_x0_i += diff_x2;
+			out_y1_x0_i += diff_x2;
+
+			buffer_x0_i += 2*(buff_elem_size);
+		}
+
+		ptr_y0_x0 += diff_y2;
+		ptr_y1_x0 += diff_y2;
+		out_y0_x0 += diff_y2;
+		out_y1_x0 += diff_y2;
+
+		buffer_y0_i += 2*(buff_elem_size);
+	}
+}
+
+void idwt_vert_2x2_cor_VERT(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int base_x, // start at ...
+	int base_y,
+	int stop_x, // stop at ...
+	int stop_y,
+	float *buffer_y, // short_buffer
+	float *buffer_x  // long_buffer
+)
+{
+	// characteristic constants
+	const int shift = 4; // vert
+	const int buff_elem_size = 1*4; // vert
+
+	// initially
+	float *buffer_y0 = &buffer_y[(base_y)*(buff_elem_size)];
+	float *buffer_x0 = &buffer_x[(base_x)*(buff_elem_size)];
+
+	// initially
+	char *ptr_y0_x0 = (void *)addr2_s(ptr, base_y,       base_x,       stride_x, stride_y);
+	char *out_y0_x0 = (void *)addr2_s(ptr, base_y-shift, base_x-shift, stride_x, stride_y);
+
+	// increments
+	const ptrdiff_t diff_y0_x0 = 0; // +0 col +0 row
+	const ptrdiff_t diff_y1_x0 = (ptrdiff_t)addr1_s(0, +1, stride_x); // +1 cols
+	const ptrdiff_t diff_y0_x1 = (ptrdiff_t)addr1_s(0, +1, stride_y); // +1 rows
+	const ptrdiff_t diff_y1_x1 = diff_y0_x1 + diff_y1_x0; // +1 col +1 row
+
+	// increments
+	const ptrdiff_t diff_y2 = (ptrdiff_t)addr1_s(0, +2, stride_x); // +2 cols
+	const ptrdiff_t diff_x2 = (ptrdiff_t)addr1_s(0, +2, stride_y); // +2 rows
+
+	float *buffer_x0_i = buffer_x0;
+
+	for(int x = base_x; x+1 < stop_x; x += 2)
+	{
+		char *ptr_y0_x0_i = ptr_y0_x0;
+		char *out_y0_x0_i = out_y0_x0;
+
+		float *buffer_y0_i = buffer_y0;
+
+		for(int y = base_y; y+1 < stop_y; y += 2)
+		{
+			idwt_cdf97_vert_cor2x2_sse_s(
+				// ptr
+				(void *)ptr_y0_x0_i + diff_y0_x0,
+				(void *)ptr_y0_x0_i + diff_y0_x1,
+				(void *)ptr_y0_x0_i + diff_y1_x0,
+				(void *)ptr_y0_x0_i + diff_y1_x1,
+				// out
+				(void *)out_y0_x0_i + diff_y0_x0,
+				(void *)out_y0_x0_i + diff_y0_x1,
+				(void *)out_y0_x0_i + diff_y1_x0,
+				(void *)out_y0_x0_i + diff_y1_x1,
+				// buffers
+				buffer_y0_i+0*(buff_elem_size),
+				buffer_y0_i+1*(buff_elem_size),
+				buffer_x0_i+0*(buff_elem_size),
+				buffer_x0_i+1*(buff_elem_size)
+			);
+
+			ptr_y0_x0_i += diff_y2;
+			out_y0_x0_i += diff_y2;
+
+			buffer_y0_i += 2*(buff_elem_size);
+		}
+
+		ptr_y0_x0 += diff_x2;
+		out_y0_x0 += diff_x2;
+
+		buffer_x0_i += 2*(buff_elem_size);
+	}
+}
+
+void idwt_diag_2x2_HORIZ(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+)
+{
+	assert( is_even(size_x) && is_even(size_y) );
+	assert( size_x >= 0 && size_y >= 0 );
+
+	// aux.
+	const int buff_elem = 3*4; // 3*4 for SDL aka diagonal
+
+	float buffer_x[(buff_elem)*(size_x)] ALIGNED(16);
+	float buffer_y[(buff_elem)*(size_y)] ALIGNED(16);
+
+	dwt_util_zero_vec_s(buffer_x, (buff_elem)*(size_x));
+	dwt_util_zero_vec_s(buffer_y, (buff_elem)*(size_y));
+
+	// NOTE: loops iterate over source image (read head)
+
+	idwt_diag_2x2_cor_HORIZ(
+		ptr,
+		stride_x,
+		stride_y,
+		0, // base_x
+		0, // base_y
+		size_x, // stop_x
+		size_y, // stop_y
+		buffer_y,
+		buffer_x
+	);
+}
+
+void idwt_vert_2x2_HORIZ(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+)
+{
+	assert( is_even(size_x) && is_even(size_y) );
+	assert( size_x >= 0 && size_y >= 0 );
+
+	// aux.
+	const int buff_elem = 1*4; // 1*4 for DL aka vertical
+
+	float buffer_x[(buff_elem)*(size_x)] ALIGNED(16);
+	float buffer_y[(buff_elem)*(size_y)] ALIGNED(16);
+
+	dwt_util_zero_vec_s(buffer_x, (buff_elem)*(size_x));
+	dwt_util_zero_vec_s(buffer_y, (buff_elem)*(size_y));
+
+	// NOTE: loops iterate over source image (read head)
+
+	idwt_vert_2x2_cor_HORIZ(
+		ptr,
+		stride_x,
+		stride_y,
+		0, // base_x
+		0, // base_y
+		size_x, // stop_x
+		size_y, // stop_y
+		buffer_y,
+		buffer_x
+	);
+}
+
+void idwt_diag_2x2_VERT(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+)
+{
+	assert( is_even(size_x) && is_even(size_y) );
+	assert( size_x >= 0 && size_y >= 0 );
+
+	// aux.
+	const int buff_elem = 3*4; // 3*4 for SDL aka diagonal
+
+	float buffer_x[(buff_elem)*(size_x)] ALIGNED(16);
+	float buffer_y[(buff_elem)*(size_y)] ALIGNED(16);
+
+	dwt_util_zero_vec_s(buffer_x, (buff_elem)*(size_x));
+	dwt_util_zero_vec_s(buffer_y, (buff_elem)*(size_y));
+
+	// NOTE: loops iterate over source image (read head)
+
+	idwt_diag_2x2_cor_VERT(
+		ptr,
+		stride_x,
+		stride_y,
+		0, // base_x
+		0, // base_y
+		size_x, // stop_x
+		size_y, // stop_y
+		buffer_y,
+		buffer_x
+	);
+}
+
+void idwt_vert_2x2_VERT(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+)
+{
+	assert( is_even(size_x) && is_even(size_y) );
+	assert( size_x >= 0 && size_y >= 0 );
+
+	// aux.
+	const int buff_elem = 1*4; // 1*4 for DL aka vertical
+
+	float buffer_x[(buff_elem)*(size_x)] ALIGNED(16);
+	float buffer_y[(buff_elem)*(size_y)] ALIGNED(16);
+
+	dwt_util_zero_vec_s(buffer_x, (buff_elem)*(size_x));
+	dwt_util_zero_vec_s(buffer_y, (buff_elem)*(size_y));
+
+	// NOTE: loops iterate over source image (read head)
+
+	idwt_vert_2x2_cor_VERT(
+		ptr,
+		stride_x,
+		stride_y,
+		0, // base_x
+		0, // base_y
+		size_x, // stop_x
+		size_y, // stop_y
+		buffer_y,
+		buffer_x
+	);
+}
+
+void idwt_diag_2x2_HORIZ_STRIPS(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+)
+{
+	assert( is_even(size_x) && is_even(size_y) );
+	assert( size_x >= 0 && size_y >= 0 );
+
+	// aux.
+	const int buff_elem = 3*4; // 3*4 for SDL aka diagonal
+
+	float buffer_x[(buff_elem)*(size_x)] ALIGNED(16);
+	float buffer_y[(buff_elem)*(size_y)] ALIGNED(16);
+
+	dwt_util_zero_vec_s(buffer_x, (buff_elem)*(size_x));
+	dwt_util_zero_vec_s(buffer_y, (buff_elem)*(size_y));
+
+	const int strip_size_x = g_strip_x; // 128
+
+	// NOTE: loops iterate over source image (read head)
+
+	int base_x = 0;
+	// strips
+	for( ; base_x+strip_size_x <= size_x; base_x+=strip_size_x)
+	{
+		idwt_diag_2x2_cor_HORIZ(
+			ptr,
+			stride_x,
+			stride_y,
+			base_x, // base_x
+			0,      // base_y
+			base_x+strip_size_x, // stop_x
+			size_y,              // stop_y
+			buffer_y,
+			buffer_x
+		);
+	}
+	// last x
+	{
+		idwt_diag_2x2_cor_HORIZ(
+			ptr,
+			stride_x,
+			stride_y,
+			base_x, // base_x
+			0,      // base_y
+			size_x, // stop_x
+			size_y, // stop_y
+			buffer_y,
+			buffer_x
+		);
+	}
+}
+
+void idwt_vert_2x2_HORIZ_STRIPS(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+)
+{
+	assert( is_even(size_x) && is_even(size_y) );
+	assert( size_x >= 0 && size_y >= 0 );
+
+	// aux.
+	const int buff_elem = 1*4; // 1*4 for DL aka vertical
+
+	float buffer_x[(buff_elem)*(size_x)] ALIGNED(16);
+	float buffer_y[(buff_elem)*(size_y)] ALIGNED(16);
+
+	dwt_util_zero_vec_s(buffer_x, (buff_elem)*(size_x));
+	dwt_util_zero_vec_s(buffer_y, (buff_elem)*(size_y));
+
+	const int strip_size_x = g_strip_x; // 128
+
+	// NOTE: loops iterate over source image (read head)
+
+	int base_x = 0;
+	// strips
+	for( ; base_x+strip_size_x <= size_x; base_x+=strip_size_x)
+	{
+		idwt_vert_2x2_cor_HORIZ(
+			ptr,
+			stride_x,
+			stride_y,
+			base_x, // base_x
+			0,      // base_y
+			base_x+strip_size_x, // stop_x
+			size_y,              // stop_y
+			buffer_y,
+			buffer_x
+		);
+	}
+	// last x
+	{
+		idwt_vert_2x2_cor_HORIZ(
+			ptr,
+			stride_x,
+			stride_y,
+			base_x, // base_x
+			0,      // base_y
+			size_x, // stop_x
+			size_y, // stop_y
+			buffer_y,
+			buffer_x
+		);
+	}
+}
+
+void idwt_diag_2x2_VERT_STRIPS(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+)
+{
+	assert( is_even(size_x) && is_even(size_y) );
+	assert( size_x >= 0 && size_y >= 0 );
+
+	// aux.
+	const int buff_elem = 3*4; // 3*4 for SDL aka diagonal
+
+	float buffer_x[(buff_elem)*(size_x)] ALIGNED(16);
+	float buffer_y[(buff_elem)*(size_y)] ALIGNED(16);
+
+	dwt_util_zero_vec_s(buffer_x, (buff_elem)*(size_x));
+	dwt_util_zero_vec_s(buffer_y, (buff_elem)*(size_y));
+
+	const int strip_size_y = g_strip_y; // 8
+
+	// NOTE: loops iterate over source image (read head)
+
+	int base_y = 0;
+	// strips
+	for( ; base_y+strip_size_y <= size_y; base_y+=strip_size_y)
+	{
+		idwt_diag_2x2_cor_VERT(
+			ptr,
+			stride_x,
+			stride_y,
+			0,           // base_x
+			base_y,      // base_y
+			size_x,              // stop_y
+			base_y+strip_size_y, // stop_y
+			buffer_y,
+			buffer_x
+		);
+	}
+	// last y
+	{
+		idwt_diag_2x2_cor_VERT(
+			ptr,
+			stride_x,
+			stride_y,
+			0,      // base_x
+			base_y, // base_y
+			size_x, // stop_x
+			size_y, // stop_y
+			buffer_y,
+			buffer_x
+		);
+	}
+}
+
+void idwt_vert_2x2_VERT_STRIPS(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+)
+{
+	assert( is_even(size_x) && is_even(size_y) );
+	assert( size_x >= 0 && size_y >= 0 );
+
+	// aux.
+	const int buff_elem = 1*4; // 1*4 for DL aka vertical
+
+	float buffer_x[(buff_elem)*(size_x)] ALIGNED(16);
+	float buffer_y[(buff_elem)*(size_y)] ALIGNED(16);
+
+	dwt_util_zero_vec_s(buffer_x, (buff_elem)*(size_x));
+	dwt_util_zero_vec_s(buffer_y, (buff_elem)*(size_y));
+
+	const int strip_size_y = g_strip_y; // 8
+
+	// NOTE: loops iterate over source image (read head)
+
+	int base_y = 0;
+	// strips
+	for( ; base_y+strip_size_y <= size_y; base_y+=strip_size_y)
+	{
+		idwt_vert_2x2_cor_VERT(
+			ptr,
+			stride_x,
+			stride_y,
+			0,           // base_x
+			base_y,      // base_y
+			size_x,              // stop_y
+			base_y+strip_size_y, // stop_y
+			buffer_y,
+			buffer_x
+		);
+	}
+	// last y
+	{
+		idwt_vert_2x2_cor_VERT(
+			ptr,
+			stride_x,
+			stride_y,
+			0,      // base_x
+			base_y, // base_y
+			size_x, // stop_x
+			size_y, // stop_y
+			buffer_y,
+			buffer_x
+		);
+	}
+}
+
+void idwt_diag_2x2_HORIZ_BLOCK(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+)
+{
+	assert( is_even(size_x) && is_even(size_y) );
+	assert( size_x >= 0 && size_y >= 0 );
+
+	// aux.
+	const int buff_elem = 3*4; // 3*4 for SDL aka diagonal
+
+	float buffer_x[(buff_elem)*(size_x)] ALIGNED(16);
+	float buffer_y[(buff_elem)*(size_y)] ALIGNED(16);
+
+	dwt_util_zero_vec_s(buffer_x, (buff_elem)*(size_x));
+	dwt_util_zero_vec_s(buffer_y, (buff_elem)*(size_y));
+
+	const int strip_size_x = g_strip_x; // 128
+	const int strip_size_y = g_strip_y; // 128
+
+	// NOTE: loops iterate over source image (read head)
+
+	int base_y = 0;
+	// strips y
+	for( ; base_y+strip_size_y <= size_y; base_y+=strip_size_y)
+	{
+		int base_x = 0;
+		// strips x
+		for( ; base_x+strip_size_x <= size_x; base_x+=strip_size_x)
+		{
+			idwt_diag_2x2_cor_HORIZ(
+				ptr,
+				stride_x,
+				stride_y,
+				base_x,       // base_x
+				base_y,       // base_y
+				base_x+strip_size_x, // stop_y
+				base_y+strip_size_y, // stop_y
+				buffer_y,
+				buffer_x
+			);
+		}
+		// last x
+		{
+			idwt_diag_2x2_cor_HORIZ(
+				ptr,
+				stride_x,
+				stride_y,
+				base_x,       // base_x
+				base_y,      // base_y
+				size_x,              // stop_y
+				base_y+strip_size_y, // stop_y
+				buffer_y,
+				buffer_x
+			);
+		}
+	}
+	// last y
+	{
+		int base_x = 0;
+		// strips x
+		for( ; base_x+strip_size_x <= size_x; base_x+=strip_size_x)
+		{
+			idwt_diag_2x2_cor_HORIZ(
+				ptr,
+				stride_x,
+				stride_y,
+				base_x, // base_x
+				base_y, // base_y
+				base_x+strip_size_x, // stop_x
+				size_y,              // stop_y
+				buffer_y,
+				buffer_x
+			);
+		}
+		// last x
+		{
+			idwt_diag_2x2_cor_HORIZ(
+				ptr,
+				stride_x,
+				stride_y,
+				base_x, // base_x
+				base_y, // base_y
+				size_x, // stop_x
+				size_y, // stop_y
+				buffer_y,
+				buffer_x
+			);
+		}
+	}
+}
+
+void idwt_vert_2x2_HORIZ_BLOCK(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+)
+{
+	assert( is_even(size_x) && is_even(size_y) );
+	assert( size_x >= 0 && size_y >= 0 );
+
+	// aux.
+	const int buff_elem = 1*4; // 1*4 for DL aka vertical
+
+	float buffer_x[(buff_elem)*(size_x)] ALIGNED(16);
+	float buffer_y[(buff_elem)*(size_y)] ALIGNED(16);
+
+	dwt_util_zero_vec_s(buffer_x, (buff_elem)*(size_x));
+	dwt_util_zero_vec_s(buffer_y, (buff_elem)*(size_y));
+
+	const int strip_size_x = g_strip_x; // 128
+	const int strip_size_y = g_strip_y; // 128
+
+	// NOTE: loops iterate over source image (read head)
+
+	int base_y = 0;
+	// strips y
+	for( ; base_y+strip_size_y <= size_y; base_y+=strip_size_y)
+	{
+		int base_x = 0;
+		// strips x
+		for( ; base_x+strip_size_x <= size_x; base_x+=strip_size_x)
+		{
+			idwt_vert_2x2_cor_HORIZ(
+				ptr,
+				stride_x,
+				stride_y,
+				base_x,       // base_x
+				base_y,       // base_y
+				base_x+strip_size_x, // stop_y
+				base_y+strip_size_y, // stop_y
+				buffer_y,
+				buffer_x
+			);
+		}
+		// last x
+		{
+			idwt_vert_2x2_cor_HORIZ(
+				ptr,
+				stride_x,
+				stride_y,
+				base_x,       // base_x
+				base_y,      // base_y
+				size_x,              // stop_y
+				base_y+strip_size_y, // stop_y
+				buffer_y,
+				buffer_x
+			);
+		}
+	}
+	// last y
+	{
+		int base_x = 0;
+		// strips x
+		for( ; base_x+strip_size_x <= size_x; base_x+=strip_size_x)
+		{
+			idwt_vert_2x2_cor_HORIZ(
+				ptr,
+				stride_x,
+				stride_y,
+				base_x, // base_x
+				base_y, // base_y
+				base_x+strip_size_x, // stop_x
+				size_y,              // stop_y
+				buffer_y,
+				buffer_x
+			);
+		}
+		// last x
+		{
+			idwt_vert_2x2_cor_HORIZ(
+				ptr,
+				stride_x,
+				stride_y,
+				base_x, // base_x
+				base_y, // base_y
+				size_x, // stop_x
+				size_y, // stop_y
+				buffer_y,
+				buffer_x
+			);
+		}
+	}
+}
+
+void idwt_diag_2x2_VERT_BLOCK(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+)
+{
+	assert( is_even(size_x) && is_even(size_y) );
+	assert( size_x >= 0 && size_y >= 0 );
+
+	// aux.
+	const int buff_elem = 3*4; // 3*4 for SDL aka diagonal
+
+	float buffer_x[(buff_elem)*(size_x)] ALIGNED(16);
+	float buffer_y[(buff_elem)*(size_y)] ALIGNED(16);
+
+	dwt_util_zero_vec_s(buffer_x, (buff_elem)*(size_x));
+	dwt_util_zero_vec_s(buffer_y, (buff_elem)*(size_y));
+
+	const int strip_size_x = g_strip_x; // 32
+	const int strip_size_y = g_strip_y; // 32
+
+	// NOTE: loops iterate over source image (read head)
+
+	int base_x = 0;
+	// strips x
+	for( ; base_x+strip_size_x <= size_x; base_x+=strip_size_x)
+	{
+		int base_y = 0;
+		// strips y
+		for( ; base_y+strip_size_y <= size_y; base_y+=strip_size_y)
+		{
+			idwt_diag_2x2_cor_VERT(
+				ptr,
+				stride_x,
+				stride_y,
+				base_x, // base_x
+				base_y, // base_y
+				base_x+strip_size_x, // stop_x
+				base_y+strip_size_y, // stop_y
+				buffer_y,
+				buffer_x
+			);
+		}
+		// last y
+		{
+			idwt_diag_2x2_cor_VERT(
+				ptr,
+				stride_x,
+				stride_y,
+				base_x, // base_x
+				base_y, // base_y
+				base_x+strip_size_x, // stop_x
+				size_y, // stop_y
+				buffer_y,
+				buffer_x
+			);
+		}
+	}
+	// last x
+	{
+		int base_y = 0;
+		// strips y
+		for( ; base_y+strip_size_y <= size_y; base_y+=strip_size_y)
+		{
+			idwt_diag_2x2_cor_VERT(
+				ptr,
+				stride_x,
+				stride_y,
+				base_x, // base_x
+				base_y, // base_y
+				size_x,              // stop_x
+				base_y+strip_size_y, // stop_y
+				buffer_y,
+				buffer_x
+			);
+		}
+		// last y
+		{
+			idwt_diag_2x2_cor_VERT(
+				ptr,
+				stride_x,
+				stride_y,
+				base_x, // base_x
+				base_y, // base_y
+				size_x, // stop_x
+				size_y, // stop_y
+				buffer_y,
+				buffer_x
+			);
+		}
+	}
+}
+
+void idwt_vert_2x2_VERT_BLOCK(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+)
+{
+	assert( is_even(size_x) && is_even(size_y) );
+	assert( size_x >= 0 && size_y >= 0 );
+
+	// aux.
+	const int buff_elem = 1*4; // 1*4 for DL aka vertical
+
+	float buffer_x[(buff_elem)*(size_x)] ALIGNED(16);
+	float buffer_y[(buff_elem)*(size_y)] ALIGNED(16);
+
+	dwt_util_zero_vec_s(buffer_x, (buff_elem)*(size_x));
+	dwt_util_zero_vec_s(buffer_y, (buff_elem)*(size_y));
+
+	const int strip_size_x = g_strip_x; // 32
+	const int strip_size_y = g_strip_y; // 32
+
+	// NOTE: loops iterate over source image (read head)
+
+	int base_x = 0;
+	// strips x
+	for( ; base_x+strip_size_x <= size_x; base_x+=strip_size_x)
+	{
+		int base_y = 0;
+		// strips y
+		for( ; base_y+strip_size_y <= size_y; base_y+=strip_size_y)
+		{
+			idwt_vert_2x2_cor_VERT(
+				ptr,
+				stride_x,
+				stride_y,
+				base_x, // base_x
+				base_y, // base_y
+				base_x+strip_size_x, // stop_x
+				base_y+strip_size_y, // stop_y
+				buffer_y,
+				buffer_x
+			);
+		}
+		// last y
+		{
+			idwt_vert_2x2_cor_VERT(
+				ptr,
+				stride_x,
+				stride_y,
+				base_x, // base_x
+				base_y, // base_y
+				base_x+strip_size_x, // stop_x
+				size_y, // stop_y
+				buffer_y,
+				buffer_x
+			);
+		}
+	}
+	// last x
+	{
+		int base_y = 0;
+		// strips y
+		for( ; base_y+strip_size_y <= size_y; base_y+=strip_size_y)
+		{
+			idwt_vert_2x2_cor_VERT(
+				ptr,
+				stride_x,
+				stride_y,
+				base_x, // base_x
+				base_y, // base_y
+				size_x,              // stop_x
+				base_y+strip_size_y, // stop_y
+				buffer_y,
+				buffer_x
+			);
+		}
+		// last y
+		{
+			idwt_vert_2x2_cor_VERT(
+				ptr,
+				stride_x,
+				stride_y,
+				base_x, // base_x
+				base_y, // base_y
+				size_x, // stop_x
+				size_y, // stop_y
+				buffer_y,
+				buffer_x
+			);
+		}
+	}
+}
+
+idwt_diag_2x2_func_t get_idwt_diag_2x2_func(enum order order)
+{
+	assert( order < ORDER_LAST );
+
+	idwt_diag_2x2_func_t idwt_diag_2x2_func[ORDER_LAST] = {
+		// 2x2
+		[ORDER_HORIZ]        = idwt_diag_2x2_HORIZ,
+		[ORDER_VERT]         = idwt_diag_2x2_VERT,
+		[ORDER_HORIZ_STRIPS] = idwt_diag_2x2_HORIZ_STRIPS,
+		[ORDER_VERT_STRIPS]  = idwt_diag_2x2_VERT_STRIPS,
+		[ORDER_HORIZ_BLOCKS] = idwt_diag_2x2_HORIZ_BLOCK,
+		[ORDER_VERT_BLOCKS]  = idwt_diag_2x2_VERT_BLOCK,
+		// fused (no inverse counterparts)
+		[ORDER_HORIZ_6X2]    = NULL,
+		[ORDER_HORIZ_2X6]    = NULL,
+		[ORDER_HORIZ_6X6]    = NULL,
+	};
+
+	return idwt_diag_2x2_func[order];
+}
+
+idwt_vert_2x2_func_t get_idwt_vert_2x2_func(enum order order)
+{
+	assert( order < ORDER_LAST );
+
+	idwt_vert_2x2_func_t idwt_vert_2x2_func[ORDER_LAST] = {
+		// 2x2
+		[ORDER_HORIZ]        = idwt_vert_2x2_HORIZ,
+		[ORDER_VERT]         = idwt_vert_2x2_VERT,
+		[ORDER_HORIZ_STRIPS] = idwt_vert_2x2_HORIZ_STRIPS,
+		[ORDER_VERT_STRIPS]  = idwt_vert_2x2_VERT_STRIPS,
+		[ORDER_HORIZ_BLOCKS] = idwt_vert_2x2_HORIZ_BLOCK,
+		[ORDER_VERT_BLOCKS]  = idwt_vert_2x2_VERT_BLOCK,
+		// fused (no inverse counterparts)
+		[ORDER_HORIZ_4X4]    = NULL,
+		[ORDER_HORIZ_8X2]    = NULL,
+		[ORDER_HORIZ_2X8]    = NULL,
+		[ORDER_HORIZ_8X8]    = NULL,
+	};
+
+	return idwt_vert_2x2_func[order];
+}
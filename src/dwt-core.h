@@ -76,6 +76,114 @@ void fdwt_diag_2x2_VERT_BLOCK(
 	int size_y
 );
 
+/**
+ * @brief Inverse DWT with CDF 9/7 wavelet using single-loop @f$ 2 \times 2 @f$ core.
+ *
+ * Inverse counterpart of @ref fdwt_diag_2x2_HORIZ.
+ * As input, the interleaved transform with 4 decay coefficients around each edge is expected,
+ * @p ptr points one sample before the first decay coefficient (i.e. to a L coefficient).
+ * As output, the image is written back in place, i.e. to the position where the forward transform read it.
+ * The same applies to the other traversal orders and to the vertical (@p idwt_vert_) core.
+ * This function operates with a @p float data type.
+ *
+ * @warning experimental
+ */
+void idwt_diag_2x2_HORIZ(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+);
+
+void idwt_diag_2x2_VERT(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+);
+
+void idwt_diag_2x2_HORIZ_STRIPS(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+);
+
+void idwt_diag_2x2_VERT_STRIPS(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+);
+
+void idwt_diag_2x2_HORIZ_BLOCK(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+);
+
+void idwt_diag_2x2_VERT_BLOCK(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+);
+
+void idwt_vert_2x2_HORIZ(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+);
+
+void idwt_vert_2x2_VERT(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+);
+
+void idwt_vert_2x2_HORIZ_STRIPS(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+);
+
+void idwt_vert_2x2_VERT_STRIPS(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+);
+
+void idwt_vert_2x2_HORIZ_BLOCK(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+);
+
+void idwt_vert_2x2_VERT_BLOCK(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y
+);
+
 enum order {
 	ORDER_HORIZ = 0,
 	ORDER_VERT = 1,
@@ -106,4 +214,17 @@ fdwt_diag_2x2_func_t get_fdwt_diag_2x2_func(enum order order);
 
 fdwt_vert_2x2_func_t get_fdwt_vert_2x2_func(enum order order);
 
+typedef void (*idwt_diag_2x2_func_t)(void *, int, int, int, int);
+
+typedef void (*idwt_vert_2x2_func_t)(void *, int, int, int, int);
+
+/**
+ * Select a proper inverse function according to the order.
+ *
+ * The fused cores have no inverse counterparts, NULL is returned for their orders.
+ */
+idwt_diag_2x2_func_t get_idwt_diag_2x2_func(enum order order);
+
+idwt_vert_2x2_func_t get_idwt_vert_2x2_func(enum order order);
+
 #endif
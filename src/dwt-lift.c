@@ -0,0 +1,891 @@
+#include "dwt-lift.h"
+#include "libdwt.h"
+#include "inline.h"
+#include "system.h" // dwt_util_memcpy_stride_s
+#include "pool.h" // dwt_pool_get_threads
+// assert
+#include <assert.h>
+// strcmp
+#include <string.h>
+// NULL
+#include <stddef.h>
+
+#define SQRT2 1.41421356237309504880f
+#define SQRT3 1.73205080756887729353f
+
+const struct dwt_lift_s dwt_lift_haar_s = {
+	.name = "haar",
+	.steps = 2,
+	.step = {
+		{ DWT_LIFT_PREDICT,  0, 1, { -1.f } },
+		{ DWT_LIFT_UPDATE,   0, 1, { +0.5f } },
+	},
+	.scale_l = SQRT2,
+	.scale_h = 1/SQRT2,
+};
+
+// I. Daubechies, W. Sweldens. Factoring wavelet transforms into lifting steps. 1998.
+const struct dwt_lift_s dwt_lift_daub4_s = {
+	.name = "daub4",
+	.steps = 3,
+	.step = {
+		{ DWT_LIFT_UPDATE,   0, 1, { SQRT3 } },
+		{ DWT_LIFT_PREDICT, -1, 2, { -(SQRT3-2)/4, -SQRT3/4 } },
+		{ DWT_LIFT_UPDATE,  +1, 1, { -1.f } },
+	},
+	.scale_l = (SQRT3-1)/SQRT2,
+	.scale_h = (SQRT3+1)/SQRT2,
+	.periodic = 1,
+};
+
+// dwt_cdf53_p1_s, dwt_cdf53_u1_s, dwt_cdf53_s1_s
+const struct dwt_lift_s dwt_lift_cdf53_s = {
+	.name = "cdf53",
+	.steps = 2,
+	.step = {
+		{ DWT_LIFT_PREDICT,  0, 2, { -0.5f, -0.5f } },
+		{ DWT_LIFT_UPDATE,  -1, 2, { +0.25f, +0.25f } },
+	},
+	.scale_l = SQRT2,
+	.scale_h = 1/SQRT2,
+};
+
+// dwt_cdf97_p1_s, dwt_cdf97_u1_s, dwt_cdf97_p2_s, dwt_cdf97_u2_s, dwt_cdf97_s1_s
+const struct dwt_lift_s dwt_lift_cdf97_s = {
+	.name = "cdf97",
+	.steps = 4,
+	.step = {
+		{ DWT_LIFT_PREDICT,  0, 2, { -1.58613434342059f, -1.58613434342059f } },
+		{ DWT_LIFT_UPDATE,  -1, 2, { -0.0529801185729f, -0.0529801185729f } },
+		{ DWT_LIFT_PREDICT,  0, 2, { +0.8829110755309f, +0.8829110755309f } },
+		{ DWT_LIFT_UPDATE,  -1, 2, { +0.4435068520439f, +0.4435068520439f } },
+	},
+	.scale_l = 1.1496043988602f,
+	.scale_h = 1/1.1496043988602f,
+};
+
+// 5/3 followed by the predict (s[n-1] - s[n] - s[n+1] + s[n+2])/16
+const struct dwt_lift_s dwt_lift_511_s = {
+	.name = "511",
+	.steps = 3,
+	.step = {
+		{ DWT_LIFT_PREDICT,  0, 2, { -0.5f, -0.5f } },
+		{ DWT_LIFT_UPDATE,  -1, 2, { +0.25f, +0.25f } },
+		{ DWT_LIFT_PREDICT, -1, 4, { +1/16.f, -1/16.f, -1/16.f, +1/16.f } },
+	},
+	.scale_l = SQRT2,
+	.scale_h = 1/SQRT2,
+};
+
+const struct dwt_lift_s dwt_lift_137_s = {
+	.name = "137",
+	.steps = 2,
+	.step = {
+		{ DWT_LIFT_PREDICT, -1, 4, { +1/16.f, -9/16.f, -9/16.f, +1/16.f } },
+		{ DWT_LIFT_UPDATE,  -2, 4, { -1/32.f, +9/32.f, +9/32.f, -1/32.f } },
+	},
+	.scale_l = SQRT2,
+	.scale_h = 1/SQRT2,
+};
+
+static const struct dwt_lift_s *const lift_schemes[] = {
+	&dwt_lift_haar_s,
+	&dwt_lift_daub4_s,
+	&dwt_lift_cdf53_s,
+	&dwt_lift_cdf97_s,
+	&dwt_lift_511_s,
+	&dwt_lift_137_s,
+};
+
+const struct dwt_lift_s *dwt_lift_find_s(
+	const char *name)
+{
+	assert( name );
+
+	for(int i = 0; i < (int)(sizeof(lift_schemes)/sizeof(*lift_schemes)); i++)
+	{
+		if( 0 == strcmp(lift_schemes[i]->name, name) )
+			return lift_schemes[i];
+	}
+
+	return NULL;
+}
+
+/**
+ * A lifting step or a scaling (without taps), the transform is a sequence of
+ * these. The last two operations always touch the even and the odd samples
+ * without reading anything, a sample is final once they have passed it.
+ */
+struct lift_op {
+	int target;			///< 0 for the even samples, 1 for the odd ones
+	int off;			///< index of the first tap
+	int taps;			///< the number of taps, zero for the scaling
+	float w[DWT_LIFT_MAX_TAPS];	///< weights, w[0] is the scaling factor if taps is zero
+};
+
+#define LIFT_MAX_OPS (DWT_LIFT_MAX_STEPS+4)
+
+static
+void lift_op_scale(
+	struct lift_op *op,
+	int target,
+	float w)
+{
+	op->target = target;
+	op->off = 0;
+	op->taps = 0;
+	for(int i = 0; i < DWT_LIFT_MAX_TAPS; i++)
+		op->w[i] = 0.f;
+	op->w[0] = w;
+}
+
+/**
+ * Expand the scheme into the sequence of the operations.
+ */
+static
+int lift_ops(
+	const struct dwt_lift_s *lift,
+	int inverse,
+	struct lift_op *ops)
+{
+	assert( lift && lift->steps >= 0 && lift->steps <= DWT_LIFT_MAX_STEPS );
+
+	int count = 0;
+
+	if( !inverse )
+	{
+		for(int s = 0; s < lift->steps; s++)
+		{
+			const struct dwt_lift_step_s *step = &lift->step[s];
+
+			assert( step->taps > 0 && step->taps <= DWT_LIFT_MAX_TAPS );
+
+			ops[count].target = DWT_LIFT_PREDICT == step->target;
+			ops[count].off = step->off;
+			ops[count].taps = step->taps;
+			for(int i = 0; i < DWT_LIFT_MAX_TAPS; i++)
+				ops[count].w[i] = i < step->taps ? step->w[i] : 0.f;
+			count++;
+		}
+
+		lift_op_scale(&ops[count++], 0, lift->scale_l);
+		lift_op_scale(&ops[count++], 1, lift->scale_h);
+	}
+	else
+	{
+		lift_op_scale(&ops[count++], 0, 1/lift->scale_l);
+		lift_op_scale(&ops[count++], 1, 1/lift->scale_h);
+
+		for(int s = lift->steps-1; s >= 0; s--)
+		{
+			const struct dwt_lift_step_s *step = &lift->step[s];
+
+			assert( step->taps > 0 && step->taps <= DWT_LIFT_MAX_TAPS );
+
+			ops[count].target = DWT_LIFT_PREDICT == step->target;
+			ops[count].off = step->off;
+			ops[count].taps = step->taps;
+			for(int i = 0; i < DWT_LIFT_MAX_TAPS; i++)
+				ops[count].w[i] = i < step->taps ? -step->w[i] : 0.f;
+			count++;
+		}
+
+		lift_op_scale(&ops[count++], 0, 1.f);
+		lift_op_scale(&ops[count++], 1, 1.f);
+	}
+
+	return count;
+}
+
+/**
+ * The number of samples of the phase @p q (0 even, 1 odd) in a signal of
+ * @p N samples.
+ */
+static
+int lift_count(
+	int q,
+	int N)
+{
+	return q ? floor_div2(N) : ceil_div2(N);
+}
+
+/**
+ * Extension of the index @p n of the phase @p q into a signal of @p N samples
+ * (at least two). The whole-sample symmetric extension is used unless
+ * @p periodic is set, the periodic one needs even @p N. The phase is
+ * preserved.
+ */
+static
+int lift_extend(
+	int n,
+	int q,
+	int N,
+	int periodic)
+{
+	if( periodic )
+	{
+		assert( is_even(N) );
+
+		int p = (2*n+q) % N;
+
+		if( p < 0 )
+			p += N;
+
+		return (p-q)/2;
+	}
+
+	const int period = 2*(N-1);
+
+	int p = (2*n+q) % period;
+
+	if( p < 0 )
+		p += period;
+	if( p > N-1 )
+		p = period - p;
+
+	return (p-q)/2;
+}
+
+/**
+ * d[k] += sum_i w[i] * s[k+i] for k from 0 to n-1.
+ */
+static
+void lift_axpy_s(
+	float *restrict d,
+	const float *restrict s,
+	const float *w,
+	int taps,
+	int n)
+{
+	const float w0 = w[0], w1 = w[1], w2 = w[2], w3 = w[3];
+
+	switch(taps)
+	{
+		case 1:
+			for(int k = 0; k < n; k++)
+				d[k] += w0*s[k];
+			break;
+		case 2:
+			for(int k = 0; k < n; k++)
+				d[k] += w0*s[k] + w1*s[k+1];
+			break;
+		case 3:
+			for(int k = 0; k < n; k++)
+				d[k] += w0*s[k] + w1*s[k+1] + w2*s[k+2];
+			break;
+		case 4:
+			for(int k = 0; k < n; k++)
+				d[k] += w0*s[k] + w1*s[k+1] + w2*s[k+2] + w3*s[k+3];
+			break;
+	}
+}
+
+/**
+ * The same as lift_axpy_s, but each tap has its own line.
+ */
+static
+void lift_rows_s(
+	float *restrict d,
+	const float **s,
+	const float *w,
+	int taps,
+	int n,
+	int stride)
+{
+	const float w0 = w[0], w1 = w[1], w2 = w[2], w3 = w[3];
+
+	if( sizeof(float) == stride )
+	{
+		const float *restrict s0 = s[0];
+		const float *restrict s1 = s[1];
+		const float *restrict s2 = s[2];
+		const float *restrict s3 = s[3];
+
+		switch(taps)
+		{
+			case 1:
+				for(int k = 0; k < n; k++)
+					d[k] += w0*s0[k];
+				break;
+			case 2:
+				for(int k = 0; k < n; k++)
+					d[k] += w0*s0[k] + w1*s1[k];
+				break;
+			case 3:
+				for(int k = 0; k < n; k++)
+					d[k] += w0*s0[k] + w1*s1[k] + w2*s2[k];
+				break;
+			case 4:
+				for(int k = 0; k < n; k++)
+					d[k] += w0*s0[k] + w1*s1[k] + w2*s2[k] + w3*s3[k];
+				break;
+		}
+	}
+	else
+	{
+		for(int k = 0; k < n; k++)
+		{
+			float acc = 0.f;
+
+			for(int i = 0; i < taps; i++)
+				acc += w[i] * *addr1_const_s(s[i], k, stride);
+
+			*addr1_s(d, k, stride) += acc;
+		}
+	}
+}
+
+static
+void lift_scale_s(
+	float *d,
+	float w,
+	int n,
+	int stride)
+{
+	if( 1.f == w )
+		return;
+
+	for(int k = 0; k < n; k++)
+		*addr1_s(d, k, stride) *= w;
+}
+
+/**
+ * Apply the operations to the deinterleaved signal of N >= 2 samples, the
+ * even samples are in x[0], the odd ones in x[1].
+ */
+static
+void lift_line_s(
+	const struct lift_op *ops,
+	int count,
+	float *x[2],
+	int N,
+	int periodic)
+{
+	for(int k = 0; k < count; k++)
+	{
+		const struct lift_op *op = &ops[k];
+		const int p = op->target;
+		const int q = 1-p;
+		float *d = x[p];
+		const float *s = x[q];
+		const int nd = lift_count(p, N);
+		const int ns = lift_count(q, N);
+
+		if( 0 == op->taps )
+		{
+			lift_scale_s(d, op->w[0], nd, sizeof(float));
+			continue;
+		}
+
+		// no extension needed in [lo; hi)
+		const int lo = min(max(-op->off, 0), nd);
+		const int hi = max(min(ns - op->off - op->taps + 1, nd), lo);
+
+		lift_axpy_s(d+lo, s+lo+op->off, op->w, op->taps, hi-lo);
+
+		for(int n = 0; n < nd; n++)
+		{
+			if( n == lo )
+				n = hi;
+			if( n >= nd )
+				break;
+
+			float acc = 0.f;
+
+			for(int i = 0; i < op->taps; i++)
+				acc += op->w[i] * s[lift_extend(n + op->off + i, q, N, periodic)];
+
+			d[n] += acc;
+		}
+	}
+}
+
+/**
+ * Transform the strided interleaved signal using the operations.
+ */
+static
+void lift_ex_stride_inplace_s(
+	const struct lift_op *ops,
+	int count,
+	float *ptr,
+	int N,
+	int stride,
+	int periodic)
+{
+	if( N < 2 )
+		return;
+
+	const int nE = ceil_div2(N);
+
+	float t[N];
+	float *x[2] = { t, t+nE };
+
+	dwt_util_memcpy_stride_s(x[0], sizeof(float), addr1_s(ptr, 0, stride), 2*stride,  ceil_div2(N));
+	dwt_util_memcpy_stride_s(x[1], sizeof(float), addr1_s(ptr, 1, stride), 2*stride, floor_div2(N));
+
+	lift_line_s(ops, count, x, N, periodic);
+
+	dwt_util_memcpy_stride_s(addr1_s(ptr, 0, stride), 2*stride, x[0], sizeof(float),  ceil_div2(N));
+	dwt_util_memcpy_stride_s(addr1_s(ptr, 1, stride), 2*stride, x[1], sizeof(float), floor_div2(N));
+}
+
+void dwt_lift_f_ex_stride_inplace_s(
+	const struct dwt_lift_s *lift,
+	float *ptr,
+	int N,
+	int stride)
+{
+	assert( lift && N >= 0 && ptr && 0 != stride );
+
+	if( lift->periodic && is_odd(N) && N > 1 )
+	{
+		dwt_util_log(LOG_ERR, "%s: the periodic extension of %s needs an even length, %i given\n", __FUNCTION__, lift->name, N);
+		return;
+	}
+
+	struct lift_op ops[LIFT_MAX_OPS];
+	const int count = lift_ops(lift, 0, ops);
+
+	lift_ex_stride_inplace_s(ops, count, ptr, N, stride, lift->periodic);
+}
+
+void dwt_lift_i_ex_stride_inplace_s(
+	const struct dwt_lift_s *lift,
+	float *ptr,
+	int N,
+	int stride)
+{
+	assert( lift && N >= 0 && ptr && 0 != stride );
+
+	if( lift->periodic && is_odd(N) && N > 1 )
+	{
+		dwt_util_log(LOG_ERR, "%s: the periodic extension of %s needs an even length, %i given\n", __FUNCTION__, lift->name, N);
+		return;
+	}
+
+	struct lift_op ops[LIFT_MAX_OPS];
+	const int count = lift_ops(lift, 1, ops);
+
+	lift_ex_stride_inplace_s(ops, count, ptr, N, stride, lift->periodic);
+}
+
+/**
+ * Vertical part of a single decomposition level. Each operation keeps the
+ * number of rows (of its phase) it has processed so far.
+ */
+struct lift_level_s {
+	void *ptr;
+	int stride_row;		///< difference between rows (in bytes)
+	int stride_col;		///< difference between columns (in bytes)
+	int size_x;
+	int size_y;
+	int periodic;		///< periodic extension instead of the symmetric one
+	int avail[2];		///< the number of rows of each phase available to the first operation
+	int loaded;		///< the number of rows made available
+	int done;		///< the number of rows passed on
+	int F[LIFT_MAX_OPS];	///< progress of each operation
+};
+
+static
+float *lift_row_s(
+	const struct lift_level_s *L,
+	int y)
+{
+	return addr1_s(L->ptr, y, L->stride_row);
+}
+
+static
+void lift_level_init(
+	struct lift_level_s *L,
+	void *ptr,
+	int stride_row,
+	int stride_col,
+	int size_x,
+	int size_y,
+	int periodic)
+{
+	L->ptr = ptr;
+	L->stride_row = stride_row;
+	L->stride_col = stride_col;
+	L->size_x = size_x;
+	L->size_y = size_y;
+	L->periodic = periodic;
+	L->avail[0] = 0;
+	L->avail[1] = 0;
+	L->loaded = 0;
+	L->done = 0;
+
+	for(int k = 0; k < LIFT_MAX_OPS; k++)
+		L->F[k] = 0;
+}
+
+/**
+ * The number of samples of the phase @p q finished by the last operation
+ * preceding the operation @p k.
+ */
+static
+int lift_version(
+	const struct lift_level_s *L,
+	const struct lift_op *ops,
+	int k,
+	int q)
+{
+	for(int i = k-1; i >= 0; i--)
+		if( ops[i].target == q )
+			return L->F[i];
+
+	return L->avail[q];
+}
+
+/**
+ * Can the operation @p k be applied to the row @p n of its phase?
+ */
+static
+int lift_ready(
+	const struct lift_level_s *L,
+	const struct lift_op *ops,
+	int k,
+	int n)
+{
+	const struct lift_op *op = &ops[k];
+	const int N = L->size_y;
+	const int p = op->target;
+	const int q = 1-p;
+	const int np = lift_count(p, N);
+	const int nq = lift_count(q, N);
+
+	// the row itself
+	if( n >= lift_version(L, ops, k, p) )
+		return 0;
+
+	// the rows read
+	const int vq = lift_version(L, ops, k, q);
+
+	for(int i = 0; i < op->taps; i++)
+		if( lift_extend(n + op->off + i, q, N, L->periodic) >= vq )
+			return 0;
+
+	// the preceding operations must not read the row anymore
+	for(int i = k-1; i >= 0 && ops[i].target != p; i--)
+	{
+		const struct lift_op *prev = &ops[i];
+
+		if( 0 == prev->taps || L->F[i] >= nq )
+			continue;
+
+		if( L->F[i] + prev->off <= n )
+			return 0;
+
+		// reads beyond the end reflected (or wrapped) back
+		for(int t = max(L->F[i], np - prev->off - prev->taps + 1); t < nq; t++)
+			for(int j = 0; j < prev->taps; j++)
+				if( t + prev->off + j >= np && lift_extend(t + prev->off + j, p, N, L->periodic) == n )
+					return 0;
+	}
+
+	return 1;
+}
+
+static
+void lift_apply(
+	struct lift_level_s *L,
+	const struct lift_op *op,
+	int n)
+{
+	const int N = L->size_y;
+	const int p = op->target;
+	const int q = 1-p;
+
+	float *d = lift_row_s(L, 2*n+p);
+
+	if( 0 == op->taps )
+	{
+		lift_scale_s(d, op->w[0], L->size_x, L->stride_col);
+		return;
+	}
+
+	const float *s[DWT_LIFT_MAX_TAPS] = { NULL };
+
+	for(int i = 0; i < op->taps; i++)
+		s[i] = lift_row_s(L, 2*lift_extend(n + op->off + i, q, N, L->periodic) + q);
+
+	lift_rows_s(d, s, op->w, op->taps, L->size_x, L->stride_col);
+}
+
+/**
+ * Apply all the vertical operations possible.
+ *
+ * @returns non-zero if anything has been done
+ */
+static
+int lift_level_advance(
+	struct lift_level_s *L,
+	const struct lift_op *ops,
+	int count)
+{
+	int progress = 0;
+
+	if( L->size_y < 2 )
+		return 0;
+
+	for(int k = 0; k < count; k++)
+	{
+		const int np = lift_count(ops[k].target, L->size_y);
+
+		while( L->F[k] < np && lift_ready(L, ops, k, L->F[k]) )
+		{
+			lift_apply(L, &ops[k], L->F[k]);
+			L->F[k]++;
+			progress = 1;
+		}
+	}
+
+	return progress;
+}
+
+/**
+ * The number of leading rows (of the given phase) not touched by this level
+ * anymore.
+ */
+static
+int lift_level_final(
+	const struct lift_level_s *L,
+	int count,
+	int q)
+{
+	if( L->size_y < 2 )
+		return L->avail[q];
+
+	return L->F[count-2+q];
+}
+
+/**
+ * The number of leading rows (of both phases) not touched by this level
+ * anymore.
+ */
+static
+int lift_level_final_rows(
+	const struct lift_level_s *L,
+	int count)
+{
+	return min(L->size_y, min(2*lift_level_final(L, count, 0), 2*lift_level_final(L, count, 1)+1));
+}
+
+static
+void lift_level_load(
+	struct lift_level_s *L)
+{
+	L->loaded++;
+	L->avail[0] = ceil_div2(L->loaded);
+	L->avail[1] = floor_div2(L->loaded);
+}
+
+static
+void lift_level_horizontal(
+	const struct lift_level_s *L,
+	const struct lift_op *ops,
+	int count,
+	int y)
+{
+	lift_ex_stride_inplace_s(ops, count, lift_row_s(L, y), L->size_x, L->stride_col, L->periodic);
+}
+
+static
+int lift_levels(
+	int size_o_big_x,
+	int size_o_big_y,
+	int decompose_one)
+{
+	const int size_o_big_min = min(size_o_big_x,size_o_big_y);
+	const int size_o_big_max = max(size_o_big_x,size_o_big_y);
+
+	return ceil_log2( decompose_one ? size_o_big_max : size_o_big_min );
+}
+
+/**
+ * Limit the number of levels @p J of a periodic scheme to those whose
+ * lengths are even (or below two samples, which are left untouched).
+ */
+static
+int lift_levels_periodic(
+	const struct dwt_lift_s *lift,
+	int J,
+	int size_i_big_x,
+	int size_i_big_y)
+{
+	if( !lift->periodic )
+		return J;
+
+	for(int j = 0; j < J; j++)
+	{
+		const int size_x_j = ceil_div_pow2(size_i_big_x, j);
+		const int size_y_j = ceil_div_pow2(size_i_big_y, j);
+
+		if( (size_x_j > 1 && is_odd(size_x_j)) || (size_y_j > 1 && is_odd(size_y_j)) )
+		{
+			dwt_util_log(LOG_WARN, "%s: the periodic extension of %s needs even lengths, %ix%i at level %i, %i levels instead of %i\n",
+				__FUNCTION__, lift->name, size_x_j, size_y_j, j, j, J);
+			return j;
+		}
+	}
+
+	return J;
+}
+
+
+void dwt_lift_2f_inplace_s(
+	const struct dwt_lift_s *lift,
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_o_big_x,
+	int size_o_big_y,
+	int size_i_big_x,
+	int size_i_big_y,
+	int *j_max_ptr,
+	int decompose_one)
+{
+	assert( lift && ptr && j_max_ptr );
+
+	const int j_limit = lift_levels(size_o_big_x, size_o_big_y, decompose_one);
+
+	if( *j_max_ptr < 0 || *j_max_ptr > j_limit )
+		*j_max_ptr = j_limit;
+
+	*j_max_ptr = lift_levels_periodic(lift, *j_max_ptr, size_i_big_x, size_i_big_y);
+
+	const int J = *j_max_ptr;
+
+	if( 0 == J )
+		return;
+
+	// the dedicated transform runs in the pool
+	if( &dwt_lift_cdf97_s == lift && dwt_pool_get_threads() > 1 )
+	{
+		dwt_cdf97_2f_inplace_s(ptr, stride_x, stride_y, size_o_big_x, size_o_big_y, size_i_big_x, size_i_big_y, j_max_ptr, decompose_one, 0);
+		return;
+	}
+
+	struct lift_op ops[LIFT_MAX_OPS];
+	const int count = lift_ops(lift, 0, ops);
+
+	struct lift_level_s L[J];
+
+	for(int j = 0; j < J; j++)
+		lift_level_init(&L[j], ptr, stride_x << j, stride_y << j, ceil_div_pow2(size_i_big_x, j), ceil_div_pow2(size_i_big_y, j), lift->periodic);
+
+	for(;;)
+	{
+		int progress = 0;
+
+		for(int j = 0; j < J; j++)
+		{
+			progress |= lift_level_advance(&L[j], ops, count);
+
+			// the final even rows are the input rows of the next level
+			if( j+1 < J )
+			{
+				const int rows = lift_level_final(&L[j], count, 0);
+
+				while( L[j+1].loaded < rows )
+				{
+					lift_level_horizontal(&L[j+1], ops, count, L[j+1].loaded);
+					lift_level_load(&L[j+1]);
+					progress = 1;
+				}
+			}
+		}
+
+		if( progress )
+			continue;
+
+		if( L[0].loaded == L[0].size_y )
+			break;
+
+		lift_level_horizontal(&L[0], ops, count, L[0].loaded);
+		lift_level_load(&L[0]);
+	}
+
+	for(int j = 0; j < J; j++)
+		assert( lift_level_final_rows(&L[j], count) == L[j].size_y );
+}
+
+void dwt_lift_2i_inplace_s(
+	const struct dwt_lift_s *lift,
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_o_big_x,
+	int size_o_big_y,
+	int size_i_big_x,
+	int size_i_big_y,
+	int j_max,
+	int decompose_one)
+{
+	assert( lift && ptr );
+
+	int J = lift_levels(size_o_big_x, size_o_big_y, decompose_one);
+
+	if( j_max >= 0 && j_max < J )
+		J = j_max;
+
+	J = lift_levels_periodic(lift, J, size_i_big_x, size_i_big_y);
+
+	if( 0 == J )
+		return;
+
+	// the dedicated transform runs in the pool
+	if( &dwt_lift_cdf97_s == lift && dwt_pool_get_threads() > 1 )
+	{
+		dwt_cdf97_2i_inplace_s(ptr, stride_x, stride_y, size_o_big_x, size_o_big_y, size_i_big_x, size_i_big_y, j_max, decompose_one, 0);
+		return;
+	}
+
+	struct lift_op ops[LIFT_MAX_OPS];
+	const int count = lift_ops(lift, 1, ops);
+
+	struct lift_level_s L[J];
+
+	for(int j = 0; j < J; j++)
+	{
+		lift_level_init(&L[j], ptr, stride_x << j, stride_y << j, ceil_div_pow2(size_i_big_x, j), ceil_div_pow2(size_i_big_y, j), lift->periodic);
+
+		// the odd rows are not touched by the coarser levels
+		if( j+1 < J )
+			L[j].avail[1] = floor_div2(L[j].size_y);
+	}
+
+	for(;;)
+	{
+		int progress = 0;
+
+		for(int j = J-1; j >= 0; j--)
+		{
+			// the rows finished by the coarser level are the even rows of this one
+			if( j+1 < J )
+				L[j].avail[0] = L[j+1].done;
+
+			progress |= lift_level_advance(&L[j], ops, count);
+
+			const int rows = lift_level_final_rows(&L[j], count);
+
+			while( L[j].done < rows )
+			{
+				lift_level_horizontal(&L[j], ops, count, L[j].done);
+				L[j].done++;
+				progress = 1;
+			}
+		}
+
+		if( progress )
+			continue;
+
+		if( L[J-1].loaded == L[J-1].size_y )
+			break;
+
+		lift_level_load(&L[J-1]);
+	}
+
+	for(int j = 0; j < J; j++)
+		assert( L[j].done == L[j].size_y );
+}
@@ -0,0 +1,156 @@
+/**
+ * @brief Generic lifting scheme engine driven by a lifting-step descriptor.
+ */
+
+#ifndef DWT_LIFT_H
+#define DWT_LIFT_H
+
+/** the maximal number of lifting steps in a scheme */
+#define DWT_LIFT_MAX_STEPS 8
+
+/** the maximal number of taps of a single lifting step */
+#define DWT_LIFT_MAX_TAPS 4
+
+/**
+ * @brief Which samples are modified by a lifting step.
+ */
+enum dwt_lift_target {
+	DWT_LIFT_UPDATE = 0,	///< even samples are modified using the odd ones
+	DWT_LIFT_PREDICT = 1,	///< odd samples are modified using the even ones
+};
+
+/**
+ * @brief Single lifting step.
+ *
+ * The predict step computes
+ * x[2n+1] += sum_i w[i] * x[2(n+off+i)],
+ * the update step computes
+ * x[2n] += sum_i w[i] * x[2(n+off+i)+1],
+ * where i goes from 0 to @p taps-1. The signal is extended using the
+ * whole-sample symmetric extension, or periodically if the scheme says so.
+ */
+struct dwt_lift_step_s {
+	enum dwt_lift_target target;	///< predict or update
+	int off;			///< index of the first tap relative to the modified sample
+	int taps;			///< the number of taps, from 1 to DWT_LIFT_MAX_TAPS
+	float w[DWT_LIFT_MAX_TAPS];	///< weights of the taps
+};
+
+/**
+ * @brief Lifting scheme of a wavelet.
+ *
+ * The forward transform applies the steps in the order given followed by
+ * the scaling, the inverse transform undoes them in the reverse order.
+ */
+struct dwt_lift_s {
+	const char *name;				///< short name, e.g. "cdf97"
+	int steps;					///< the number of steps
+	struct dwt_lift_step_s step[DWT_LIFT_MAX_STEPS];	///< the steps
+	float scale_l;					///< scaling of the even (lowpass) samples
+	float scale_h;					///< scaling of the odd (highpass) samples
+	int periodic;					///< extend periodically instead of symmetrically, needs even lengths
+};
+
+/**
+ * @{
+ * @brief Predefined lifting schemes.
+ *
+ * Haar and Daubechies D4 are orthonormal. The D4 filters are not symmetric,
+ * thus it uses the periodic extension, which keeps it orthonormal but is
+ * limited to even lengths. The 13/7-T and 5/11-C are found in
+ * M. D. Adams. Reversible integer-to-integer wavelet transforms for image
+ * coding. 2002. CDF 5/3 and 9/7 use the same constants and the same scaling
+ * as the rest of the library.
+ */
+extern const struct dwt_lift_s dwt_lift_haar_s;
+extern const struct dwt_lift_s dwt_lift_daub4_s;
+extern const struct dwt_lift_s dwt_lift_cdf53_s;
+extern const struct dwt_lift_s dwt_lift_cdf97_s;
+extern const struct dwt_lift_s dwt_lift_511_s;
+extern const struct dwt_lift_s dwt_lift_137_s;
+/**@}*/
+
+/**
+ * @brief Find a predefined lifting scheme by its name.
+ *
+ * @returns NULL if no such scheme exists
+ */
+const struct dwt_lift_s *dwt_lift_find_s(
+	const char *name
+);
+
+/**
+ * @brief Forward 1-D transform of an interleaved signal in place.
+ *
+ * The even samples become the lowpass coefficients and the odd samples the
+ * highpass ones. Signals shorter than two samples are left untouched, as
+ * are signals of an odd length with a periodic scheme (an error is logged).
+ */
+void dwt_lift_f_ex_stride_inplace_s(
+	const struct dwt_lift_s *lift,	///< lifting scheme
+	float *ptr,			///< the signal
+	int N,				///< the number of samples
+	int stride			///< difference between the samples (in bytes)
+);
+
+/**
+ * @brief Inverse 1-D transform of an interleaved signal in place.
+ */
+void dwt_lift_i_ex_stride_inplace_s(
+	const struct dwt_lift_s *lift,	///< lifting scheme
+	float *ptr,			///< the signal
+	int N,				///< the number of samples
+	int stride			///< difference between the samples (in bytes)
+);
+
+/**
+ * @brief Forward 2-D transform in place using an arbitrary lifting scheme.
+ *
+ * Single-loop approach: the rows are transformed horizontally as they are
+ * reached, and each vertical lifting step advances as soon as the rows it
+ * depends on are ready. The decomposition levels are pipelined the same way,
+ * a row of the next level is processed once it is final in the previous one.
+ * Each vertical step is carried out on whole rows, i.e. vectorized along the
+ * rows. The layout of the coefficients and the number of levels are the same
+ * as with @ref dwt_cdf97_2f_inplace_s, except that a periodic scheme stops
+ * before the first level with an odd width or height (a warning is logged).
+ * The CDF 9/7 scheme is passed to the dedicated implementation when more
+ * than one thread is set.
+ *
+ * @warning experimental
+ */
+void dwt_lift_2f_inplace_s(
+	const struct dwt_lift_s *lift,	///< lifting scheme
+	void *ptr,			///< pointer to beginning of image data
+	int stride_x,			///< difference between rows (in bytes)
+	int stride_y,			///< difference between columns (in bytes)
+	int size_o_big_x,		///< width of outer image frame (in elements)
+	int size_o_big_y,		///< height of outer image frame (in elements)
+	int size_i_big_x,		///< width of nested image (in elements)
+	int size_i_big_y,		///< height of nested image (in elements)
+	int *j_max_ptr,			///< pointer to the number of intended decomposition levels (scales), the number of achieved decomposition levels will be stored also here
+	int decompose_one		///< should be row or column of size one pixel decomposed? zero value if not
+);
+
+/**
+ * @brief Inverse 2-D transform in place using an arbitrary lifting scheme.
+ *
+ * The counterpart of @ref dwt_lift_2f_inplace_s, the number of levels of a
+ * periodic scheme is limited the same way.
+ *
+ * @warning experimental
+ */
+void dwt_lift_2i_inplace_s(
+	const struct dwt_lift_s *lift,	///< lifting scheme
+	void *ptr,			///< pointer to beginning of image data
+	int stride_x,			///< difference between rows (in bytes)
+	int stride_y,			///< difference between columns (in bytes)
+	int size_o_big_x,		///< width of outer image frame (in elements)
+	int size_o_big_y,		///< height of outer image frame (in elements)
+	int size_i_big_x,		///< width of nested image (in elements)
+	int size_i_big_y,		///< height of nested image (in elements)
+	int j_max,			///< the number of decomposition levels (scales)
+	int decompose_one		///< should be row or column of size one pixel decomposed? zero value if not
+);
+
+#endif
@@ -0,0 +1,382 @@
+/**
+ * @brief Region-of-interest inverse transform.
+ */
+
+#include "dwt-roi.h"
+
+#include "libdwt.h"
+#include "inline.h"
+#include "system.h" // dwt_util_free
+
+// assert
+#include <assert.h>
+
+/**
+ * @brief Inverse lifting scheme, descaling followed by two-tap steps.
+ */
+struct roi_scheme {
+	int steps;		///< the number of lifting steps
+	int parity[4];		///< 0 if the step modifies the even samples, 1 for the odd ones
+	float w[4];		///< weight of both taps
+	float scale_l;		///< descaling of the even samples
+	float scale_h;		///< descaling of the odd samples
+	int lift_one;		///< are the lines of the outer size one transformed (i.e. scaled) too?
+};
+
+/**
+ * @brief Geometry of a single direction at a single level.
+ *
+ * The samples [a, b) of the level j-1 are needed. They are reconstructed
+ * from the window [A, B) which is wider by the number of lifting steps on
+ * each side (unless clipped by the signal boundary). The even samples of
+ * the window are the lowpass coefficients [l0, l1) of the level j.
+ */
+struct roi_span {
+	int a, b;	///< needed samples
+	int A, B;	///< window
+	int l0, l1;	///< lowpass coefficients
+	int N;		///< the number of samples at the level j-1
+	int lift;	///< is this direction transformed at this level?
+};
+
+static
+void roi_span(
+	struct roi_span *span,
+	int a,
+	int b,
+	int N,
+	int lift,
+	int margin)
+{
+	span->a = a;
+	span->b = b;
+	span->N = N;
+	span->lift = lift;
+
+	if( lift )
+	{
+		span->A = max(0, a - margin);
+		span->B = min(N, b + margin);
+		span->l0 = (span->A + 1) >> 1;
+		span->l1 = (span->B + 1) >> 1;
+	}
+	else
+	{
+		span->A = span->l0 = a;
+		span->B = span->l1 = b;
+	}
+}
+
+/**
+ * @brief Which subband holds the sample @p g, its index is stored into @p k.
+ *
+ * @returns 0 for the lowpass, 1 for the highpass
+ */
+static
+int roi_band(
+	const struct roi_span *span,
+	int g,
+	int *k)
+{
+	if( !span->lift )
+	{
+		*k = g;
+		return 0;
+	}
+
+	*k = g >> 1;
+	return g & 1;
+}
+
+static
+int roi_reflect(
+	int p,
+	int N)
+{
+	if( p < 0 )
+		return -p;
+	if( p >= N )
+		return 2*N - 2 - p;
+	return p;
+}
+
+/**
+ * @brief Inverse lifting of the window [A, B) of a signal of @p N samples.
+ *
+ * The sample p is the vector of @p cols floats at x + (p-A)*step. Taps
+ * outside the signal are reflected (whole-sample symmetric extension), taps
+ * outside the window are missing and the step is skipped there. Thus, the
+ * samples closer to the inner edge of the window than the number of steps
+ * are not valid.
+ */
+static
+void roi_lift_s(
+	const struct roi_scheme *scheme,
+	float *x,
+	int step,
+	int cols,
+	int A,
+	int B,
+	int N)
+{
+	for(int p = A; p < B; p++)
+	{
+		float *restrict c = x + (p - A) * step;
+		const float scale = (p & 1) ? scheme->scale_h : scheme->scale_l;
+
+		for(int i = 0; i < cols; i++)
+			c[i] *= scale;
+	}
+
+	if( N < 2 )
+		return;
+
+	for(int s = 0; s < scheme->steps; s++)
+	{
+		const float w = scheme->w[s];
+
+		for(int p = A + ((A ^ scheme->parity[s]) & 1); p < B; p += 2)
+		{
+			const int l = roi_reflect(p - 1, N);
+			const int r = roi_reflect(p + 1, N);
+
+			if( l < A || l >= B || r < A || r >= B )
+				continue;
+
+			float *restrict c = x + (p - A) * step;
+			const float *restrict cl = x + (l - A) * step;
+			const float *restrict cr = x + (r - A) * step;
+
+			for(int i = 0; i < cols; i++)
+				c[i] += w * (cl[i] + cr[i]);
+		}
+	}
+}
+
+static
+void roi_2i_s(
+	const struct roi_scheme *scheme,
+	const void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_o_big_x,
+	int size_o_big_y,
+	int size_i_big_x,
+	int size_i_big_y,
+	int j_max,
+	int decompose_one,
+	int level,
+	int x0,
+	int y0,
+	int size_x,
+	int size_y,
+	void *dst,
+	int dst_stride_x,
+	int dst_stride_y)
+{
+	assert( ptr && dst );
+
+	int j = ceil_log2( decompose_one ? max(size_o_big_x, size_o_big_y) : min(size_o_big_x, size_o_big_y) );
+
+	if( j_max >= 0 && j_max < j )
+		j = j_max;
+
+	assert( level >= 0 && level <= j );
+	assert( x0 >= 0 && size_x >= 0 && x0 + size_x <= ceil_div_pow2(size_i_big_x, level) );
+	assert( y0 >= 0 && size_y >= 0 && y0 + size_y <= ceil_div_pow2(size_i_big_y, level) );
+
+	if( !size_x || !size_y )
+		return;
+
+	// the dependency cone, from the target level up to the top one
+	struct roi_span span_x[j+1];
+	struct roi_span span_y[j+1];
+
+	for(int l = level+1; l <= j; l++)
+	{
+		const int a_x = (l > level+1) ? span_x[l-1].l0 : x0;
+		const int b_x = (l > level+1) ? span_x[l-1].l1 : x0 + size_x;
+		const int a_y = (l > level+1) ? span_y[l-1].l0 : y0;
+		const int b_y = (l > level+1) ? span_y[l-1].l1 : y0 + size_y;
+
+		roi_span(&span_x[l], a_x, b_x, ceil_div_pow2(size_i_big_x, l-1), scheme->lift_one || ceil_div_pow2(size_o_big_x, l-1) > 1, scheme->steps);
+		roi_span(&span_y[l], a_y, b_y, ceil_div_pow2(size_i_big_y, l-1), scheme->lift_one || ceil_div_pow2(size_o_big_y, l-1) > 1, scheme->steps);
+	}
+
+	if( j == level )
+	{
+		for(int y = 0; y < size_y; y++)
+			for(int x = 0; x < size_x; x++)
+				*addr2_s(dst, y, x, dst_stride_x, dst_stride_y) =
+					*addr2_const_s(ptr, y0 + y, x0 + x, stride_x, stride_y);
+		return;
+	}
+
+	// the part of the top LL subband
+	const int top_x = span_x[j].l1 - span_x[j].l0;
+	const int top_y = span_y[j].l1 - span_y[j].l0;
+
+	float *ll = dwt_util_alloc(top_x * top_y, sizeof(float));
+
+	if( !ll )
+	{
+		dwt_util_log(LOG_ERR, "%s: unable to allocate memory\n", __FUNCTION__);
+		return;
+	}
+
+	for(int y = 0; y < top_y; y++)
+		for(int x = 0; x < top_x; x++)
+			ll[y * top_x + x] = *addr2_const_s(ptr, span_y[j].l0 + y, span_x[j].l0 + x, stride_x, stride_y);
+
+	for(int l = j; l > level; l--)
+	{
+		const struct roi_span *sx = &span_x[l];
+		const struct roi_span *sy = &span_y[l];
+
+		const int ll_x = sx->l1 - sx->l0;
+
+		const void *band[4];
+		int band_x, band_y;
+
+		dwt_util_subband_const_s(ptr, stride_x, stride_y, size_o_big_x, size_o_big_y, size_i_big_x, size_i_big_y, l, DWT_HL, &band[1], &band_x, &band_y);
+		dwt_util_subband_const_s(ptr, stride_x, stride_y, size_o_big_x, size_o_big_y, size_i_big_x, size_i_big_y, l, DWT_LH, &band[2], &band_x, &band_y);
+		dwt_util_subband_const_s(ptr, stride_x, stride_y, size_o_big_x, size_o_big_y, size_i_big_x, size_i_big_y, l, DWT_HH, &band[3], &band_x, &band_y);
+
+		// the window of the level l-1
+		const int win_x = sx->B - sx->A;
+		const int win_y = sy->B - sy->A;
+
+		float *win = dwt_util_alloc(win_x * win_y, sizeof(float));
+
+		if( !win )
+		{
+			dwt_util_log(LOG_ERR, "%s: unable to allocate memory\n", __FUNCTION__);
+			dwt_util_free(ll);
+			return;
+		}
+
+		for(int y = 0; y < win_y; y++)
+		{
+			int k_y;
+			const int b_y = roi_band(sy, sy->A + y, &k_y);
+
+			for(int x = 0; x < win_x; x++)
+			{
+				int k_x;
+				const int b_x = roi_band(sx, sx->A + x, &k_x);
+				const int b = 2*b_y + b_x;
+
+				win[y * win_x + x] = b
+					? *addr2_const_s(band[b], k_y, k_x, stride_x, stride_y)
+					: ll[(k_y - sy->l0) * ll_x + (k_x - sx->l0)];
+			}
+		}
+
+		dwt_util_free(ll);
+
+		// rows, the whole window
+		if( sx->lift )
+		{
+			for(int y = 0; y < win_y; y++)
+				roi_lift_s(scheme, win + y * win_x, 1, 1, sx->A, sx->B, sx->N);
+		}
+
+		// columns, only the valid ones
+		if( sy->lift )
+			roi_lift_s(scheme, win + (sx->a - sx->A), win_x, sx->b - sx->a, sy->A, sy->B, sy->N);
+
+		// the samples needed by the next level
+		const int out_x = sx->b - sx->a;
+		const int out_y = sy->b - sy->a;
+
+		if( l - 1 == level )
+		{
+			for(int y = 0; y < out_y; y++)
+				for(int x = 0; x < out_x; x++)
+					*addr2_s(dst, y, x, dst_stride_x, dst_stride_y) =
+						win[(sy->a - sy->A + y) * win_x + (sx->a - sx->A + x)];
+
+			dwt_util_free(win);
+			return;
+		}
+
+		ll = dwt_util_alloc(out_x * out_y, sizeof(float));
+
+		if( !ll )
+		{
+			dwt_util_log(LOG_ERR, "%s: unable to allocate memory\n", __FUNCTION__);
+			dwt_util_free(win);
+			return;
+		}
+
+		for(int y = 0; y < out_y; y++)
+			for(int x = 0; x < out_x; x++)
+				ll[y * out_x + x] = win[(sy->a - sy->A + y) * win_x + (sx->a - sx->A + x)];
+
+		dwt_util_free(win);
+	}
+}
+
+void dwt_cdf97_2i_roi_s(
+	const void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_o_big_x,
+	int size_o_big_y,
+	int size_i_big_x,
+	int size_i_big_y,
+	int j_max,
+	int decompose_one,
+	int level,
+	int x0,
+	int y0,
+	int size_x,
+	int size_y,
+	void *dst,
+	int dst_stride_x,
+	int dst_stride_y)
+{
+	const struct roi_scheme scheme = {
+		.steps = 4,
+		.parity = { 0, 1, 0, 1 },
+		.w = { -dwt_cdf97_u2_s, dwt_cdf97_p2_s, -dwt_cdf97_u1_s, dwt_cdf97_p1_s },
+		.scale_l = dwt_cdf97_s2_s,
+		.scale_h = dwt_cdf97_s1_s,
+		.lift_one = 0,
+	};
+
+	roi_2i_s(&scheme, ptr, stride_x, stride_y, size_o_big_x, size_o_big_y, size_i_big_x, size_i_big_y,
+		j_max, decompose_one, level, x0, y0, size_x, size_y, dst, dst_stride_x, dst_stride_y);
+}
+
+void dwt_cdf53_2i_roi_s(
+	const void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_o_big_x,
+	int size_o_big_y,
+	int size_i_big_x,
+	int size_i_big_y,
+	int j_max,
+	int decompose_one,
+	int level,
+	int x0,
+	int y0,
+	int size_x,
+	int size_y,
+	void *dst,
+	int dst_stride_x,
+	int dst_stride_y)
+{
+	const struct roi_scheme scheme = {
+		.steps = 2,
+		.parity = { 0, 1 },
+		.w = { -dwt_cdf53_u1_s, dwt_cdf53_p1_s },
+		.scale_l = dwt_cdf53_s2_s,
+		.scale_h = dwt_cdf53_s1_s,
+		.lift_one = 1,
+	};
+
+	roi_2i_s(&scheme, ptr, stride_x, stride_y, size_o_big_x, size_o_big_y, size_i_big_x, size_i_big_y,
+		j_max, decompose_one, level, x0, y0, size_x, size_y, dst, dst_stride_x, dst_stride_y);
+}
@@ -0,0 +1,65 @@
+/**
+ * @brief Region-of-interest inverse transform.
+ */
+
+#ifndef DWT_ROI_H
+#define DWT_ROI_H
+
+/**
+ * @brief Inverse 2-D CDF 9/7 transform of a rectangle only.
+ *
+ * Reconstructs the rectangle [x0, x0+size_x) x [y0, y0+size_y) of the LL
+ * subband at the decomposition level @p level (zero for the image itself)
+ * from the coefficients produced by @ref dwt_cdf97_2f_s. Only the
+ * coefficients inside the dependency cone of the rectangle are read, i.e.
+ * the cost is proportional to the size of the rectangle rather than to the
+ * size of the image. The coefficients are not modified, the result is stored
+ * into @p dst. The result is the same (up to rounding) as the corresponding
+ * part of the output of @ref dwt_cdf97_2i_s.
+ */
+void dwt_cdf97_2i_roi_s(
+	const void *ptr,	///< pointer to beginning of image data
+	int stride_x,		///< difference between rows (in bytes)
+	int stride_y,		///< difference between columns (in bytes)
+	int size_o_big_x,	///< width of outer image frame (in elements)
+	int size_o_big_y,	///< height of outer image frame (in elements)
+	int size_i_big_x,	///< width of nested image (in elements)
+	int size_i_big_y,	///< height of nested image (in elements)
+	int j_max,		///< the number of decomposition levels (scales)
+	int decompose_one,	///< should be row or column of size one pixel decomposed? zero value if not
+	int level,		///< the level to reconstruct, from 0 up to the number of levels
+	int x0,			///< left column of the rectangle (at the level @p level)
+	int y0,			///< top row of the rectangle (at the level @p level)
+	int size_x,		///< width of the rectangle
+	int size_y,		///< height of the rectangle
+	void *dst,		///< pointer to the destination, size_x times size_y elements
+	int dst_stride_x,	///< difference between rows of the destination (in bytes)
+	int dst_stride_y	///< difference between columns of the destination (in bytes)
+);
+
+/**
+ * @brief Inverse 2-D CDF 5/3 transform of a rectangle only.
+ *
+ * The counterpart of @ref dwt_cdf97_2i_roi_s for @ref dwt_cdf53_2f_s.
+ */
+void dwt_cdf53_2i_roi_s(
+	const void *ptr,	///< pointer to beginning of image data
+	int stride_x,		///< difference between rows (in bytes)
+	int stride_y,		///< difference between columns (in bytes)
+	int size_o_big_x,	///< width of outer image frame (in elements)
+	int size_o_big_y,	///< height of outer image frame (in elements)
+	int size_i_big_x,	///< width of nested image (in elements)
+	int size_i_big_y,	///< height of nested image (in elements)
+	int j_max,		///< the number of decomposition levels (scales)
+	int decompose_one,	///< should be row or column of size one pixel decomposed? zero value if not
+	int level,		///< the level to reconstruct, from 0 up to the number of levels
+	int x0,			///< left column of the rectangle (at the level @p level)
+	int y0,			///< top row of the rectangle (at the level @p level)
+	int size_x,		///< width of the rectangle
+	int size_y,		///< height of the rectangle
+	void *dst,		///< pointer to the destination, size_x times size_y elements
+	int dst_stride_x,	///< difference between rows of the destination (in bytes)
+	int dst_stride_y	///< difference between columns of the destination (in bytes)
+);
+
+#endif
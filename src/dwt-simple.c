@@ -1,6 +1,7 @@
 #include "dwt-simple.h"
 #include "libdwt.h"
 #include "inline.h"
+#include "trace.h"
 #include <math.h>
 
 static
@@ -1677,6 +1678,8 @@ void fdwt2_cdf97_vertical_s(
 
 		if( size_x_j > 1 && size_x_j >= 5 )
 		{
+			const dwt_trace_t trace = DWT_TRACE_BEGIN();
+
 			for(int y = 0; y < size_y_j; y++)
 			{
 				fdwt_cdf97_prolog_s(
@@ -1684,9 +1687,13 @@ void fdwt2_cdf97_vertical_s(
 					size_x_j,
 					stride_y_j);
 			}
+
+			DWT_TRACE_END("vertical rows prolog", j, trace);
 		}
 		if( size_y_j > 1 && size_y_j >= 5 )
 		{
+			const dwt_trace_t trace = DWT_TRACE_BEGIN();
+
 			for(int x = 0; x < size_x_j; x++)
 			{
 				fdwt_cdf97_prolog_s(
@@ -1694,10 +1701,14 @@ void fdwt2_cdf97_vertical_s(
 					size_y_j,
 					stride_x_j);
 			}
+
+			DWT_TRACE_END("vertical columns prolog", j, trace);
 		}
 
 		if( size_x_j > 1 && size_x_j >= 5 )
 		{
+			const dwt_trace_t trace = DWT_TRACE_BEGIN();
+
 			#pragma omp parallel for schedule(static, threads_segment_y)
 			for(int y = 0; y < size_y_j; y++)
 			{
@@ -1706,9 +1717,13 @@ void fdwt2_cdf97_vertical_s(
 					size_x_j-offset,
 					stride_y_j);
 			}
+
+			DWT_TRACE_END("vertical rows core", j, trace);
 		}
 		if( size_y_j > 1 && size_y_j >= 5 )
 		{
+			const dwt_trace_t trace = DWT_TRACE_BEGIN();
+
 			#pragma omp parallel for schedule(static, threads_segment_x)
 			for(int x = 0; x < size_x_j; x++)
 			{
@@ -1717,10 +1732,14 @@ void fdwt2_cdf97_vertical_s(
 					size_y_j-offset,
 					stride_x_j);
 			}
+
+			DWT_TRACE_END("vertical columns core", j, trace);
 		}
 
 		if( size_x_j > 1 && size_x_j >= 5 )
 		{
+			const dwt_trace_t trace = DWT_TRACE_BEGIN();
+
 			for(int y = 0; y < size_y_j; y++)
 			{
 				fdwt_cdf97_epilog_s(
@@ -1728,9 +1747,13 @@ void fdwt2_cdf97_vertical_s(
 					size_x_j-offset,
 					stride_y_j);
 			}
+
+			DWT_TRACE_END("vertical rows epilog", j, trace);
 		}
 		if( size_y_j > 1 && size_y_j >= 5 )
 		{
+			const dwt_trace_t trace = DWT_TRACE_BEGIN();
+
 			for(int x = 0; x < size_x_j; x++)
 			{
 				fdwt_cdf97_epilog_s(
@@ -1738,6 +1761,8 @@ void fdwt2_cdf97_vertical_s(
 					size_y_j-offset,
 					stride_x_j);
 			}
+
+			DWT_TRACE_END("vertical columns epilog", j, trace);
 		}
 
 		j++;
@@ -3096,6 +3121,8 @@ void fdwt2_cdf97_diagonal_s(
 
 		if( size_x_j > 1 && size_x_j >= 5 )
 		{
+			const dwt_trace_t trace = DWT_TRACE_BEGIN();
+
 			for(int y = 0; y < size_y_j; y++)
 			{
 				fdwt_cdf97_prolog_s(
@@ -3103,9 +3130,13 @@ void fdwt2_cdf97_diagonal_s(
 					size_x_j,
 					stride_y_j);
 			}
+
+			DWT_TRACE_END("diagonal rows prolog", j, trace);
 		}
 		if( size_y_j > 1 && size_y_j >= 5 )
 		{
+			const dwt_trace_t trace = DWT_TRACE_BEGIN();
+
 			for(int x = 0; x < size_x_j; x++)
 			{
 				fdwt_cdf97_prolog_s(
@@ -3113,10 +3144,14 @@ void fdwt2_cdf97_diagonal_s(
 					size_y_j,
 					stride_x_j);
 			}
+
+			DWT_TRACE_END("diagonal columns prolog", j, trace);
 		}
 
 		if( size_x_j > 1 && size_x_j >= 5 )
 		{
+			const dwt_trace_t trace = DWT_TRACE_BEGIN();
+
 			#pragma omp parallel for schedule(static, threads_segment_y)
 			for(int y = 0; y < size_y_j; y++)
 			{
@@ -3125,9 +3160,13 @@ void fdwt2_cdf97_diagonal_s(
 					size_x_j-offset,
 					stride_y_j);
 			}
+
+			DWT_TRACE_END("diagonal rows core", j, trace);
 		}
 		if( size_y_j > 1 && size_y_j >= 5 )
 		{
+			const dwt_trace_t trace = DWT_TRACE_BEGIN();
+
 			#pragma omp parallel for schedule(static, threads_segment_x)
 			for(int x = 0; x < size_x_j; x++)
 			{
@@ -3136,10 +3175,14 @@ void fdwt2_cdf97_diagonal_s(
 					size_y_j-offset,
 					stride_x_j);
 			}
+
+			DWT_TRACE_END("diagonal columns core", j, trace);
 		}
 
 		if( size_x_j > 1 && size_x_j >= 5 )
 		{
+			const dwt_trace_t trace = DWT_TRACE_BEGIN();
+
 			for(int y = 0; y < size_y_j; y++)
 			{
 				fdwt_cdf97_epilog_s(
@@ -3147,9 +3190,13 @@ void fdwt2_cdf97_diagonal_s(
 					size_x_j-offset,
 					stride_y_j);
 			}
+
+			DWT_TRACE_END("diagonal rows epilog", j, trace);
 		}
 		if( size_y_j > 1 && size_y_j >= 5 )
 		{
+			const dwt_trace_t trace = DWT_TRACE_BEGIN();
+
 			for(int x = 0; x < size_x_j; x++)
 			{
 				fdwt_cdf97_epilog_s(
@@ -3157,6 +3204,8 @@ void fdwt2_cdf97_diagonal_s(
 					size_y_j-offset,
 					stride_x_j);
 			}
+
+			DWT_TRACE_END("diagonal columns epilog", j, trace);
 		}
 
 		j++;
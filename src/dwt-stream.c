@@ -0,0 +1,504 @@
+#include "dwt-stream.h"
+#include "libdwt.h"
+#include "inline.h"
+#include "system.h" // dwt_util_alloc1, dwt_util_free
+// assert
+#include <assert.h>
+// memcpy
+#include <string.h>
+// open
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+// mmap, madvise
+#include <sys/mman.h>
+// ftruncate, close, sysconf
+#include <unistd.h>
+
+// the number of rows kept for each level, at least 6 are needed
+#define STREAM_RING 8
+
+/**
+ * A single decomposition level of the stream.
+ */
+struct stream_level_s {
+	int size_x;	///< width of the input of this level
+	int size_y;	///< height of the input of this level
+	int rows;	///< the number of input rows received so far
+	float *ring;	///< STREAM_RING rows of @e size_x samples
+};
+
+struct stream_s {
+	int J;
+	struct stream_level_s *level;
+	float *tmp;
+	dwt_stream_sink_s_t sink;
+	void *sink_ctx;
+};
+
+/**
+ * whole-sample symmetric extension
+ */
+static
+int stream_mirror(
+	int y,
+	int size)
+{
+	if( y < 0 )
+		return -y;
+	if( y >= size )
+		return 2*(size-1) - y;
+	return y;
+}
+
+static
+float *stream_row(
+	const struct stream_level_s *level,
+	int y)
+{
+	const int m = stream_mirror(y, level->size_y);
+
+	return level->ring + (size_t)(m % STREAM_RING) * level->size_x;
+}
+
+/**
+ * dst[x] += w * (a[x] + b[x])
+ */
+static
+void stream_lift_s(
+	float *dst,
+	const float *a,
+	const float *b,
+	float w,
+	int size)
+{
+	for(int x = 0; x < size; x++)
+		dst[x] += w * (a[x] + b[x]);
+}
+
+static
+void stream_scale_s(
+	float *dst,
+	float v,
+	int size)
+{
+	for(int x = 0; x < size; x++)
+		dst[x] *= v;
+}
+
+/**
+ * In-place horizontal transform, the result is [L|H].
+ */
+static
+void stream_lift_row_s(
+	float *row,
+	float *tmp,
+	int N)
+{
+	// not decomposed, see dwt_cdf97_2f_s
+	if( N < 2 )
+		return;
+
+	const float w[4] = { -dwt_cdf97_p1_s, dwt_cdf97_u1_s, -dwt_cdf97_p2_s, dwt_cdf97_u2_s };
+
+	for(int k = 0; k < 4; k++)
+	{
+		// odd samples are predicted first
+		const int first = (k & 1) ? 0 : 1;
+
+		for(int i = first; i < N; i += 2)
+		{
+			const float l = row[stream_mirror(i-1, N)];
+			const float r = row[stream_mirror(i+1, N)];
+
+			row[i] += w[k] * (l + r);
+		}
+	}
+
+	const int L = ceil_div2(N);
+
+	for(int i = 0; i < N; i += 2)
+		tmp[i/2] = row[i] * dwt_cdf97_s1_s;
+	for(int i = 1; i < N; i += 2)
+		tmp[L+i/2] = row[i] * (1/dwt_cdf97_s1_s);
+
+	memcpy(row, tmp, sizeof(float) * N);
+}
+
+static
+int stream_push_s(
+	struct stream_s *stream,
+	int j,
+	const float *row
+);
+
+/**
+ * Emit the complete L row, its LL part goes to the next level.
+ */
+static
+int stream_emit_l_s(
+	struct stream_s *stream,
+	int j,
+	int y)
+{
+	struct stream_level_s *level = &stream->level[j];
+
+	float *row = stream_row(level, y);
+
+	if( level->size_y > 1 )
+		stream_scale_s(row, dwt_cdf97_s1_s, level->size_x);
+
+	const int size_l = ceil_div2(level->size_x);
+	const int size_h = floor_div2(level->size_x);
+
+	int err = 0;
+
+	if( size_h )
+		err |= stream->sink(stream->sink_ctx, j+1, DWT_HL, y/2, row+size_l, size_h);
+
+	if( j+1 < stream->J )
+		err |= stream_push_s(stream, j+1, row);
+	else
+		err |= stream->sink(stream->sink_ctx, j+1, DWT_LL, y/2, row, size_l);
+
+	return err;
+}
+
+/**
+ * Emit the complete H row.
+ */
+static
+int stream_emit_h_s(
+	struct stream_s *stream,
+	int j,
+	int y)
+{
+	struct stream_level_s *level = &stream->level[j];
+
+	float *row = stream_row(level, y);
+
+	stream_scale_s(row, 1/dwt_cdf97_s1_s, level->size_x);
+
+	const int size_l = ceil_div2(level->size_x);
+	const int size_h = floor_div2(level->size_x);
+
+	int err = 0;
+
+	err |= stream->sink(stream->sink_ctx, j+1, DWT_LH, y/2, row, size_l);
+
+	if( size_h )
+		err |= stream->sink(stream->sink_ctx, j+1, DWT_HH, y/2, row+size_l, size_h);
+
+	return err;
+}
+
+/**
+ * Vertical lifting triggered by the (real or virtual) even row @p e.
+ *
+ * Each step is applied on the row that has just all its neighbours ready:
+ * the 1st predict on e-1, the 1st update on e-2, the 2nd predict on e-3, the
+ * 2nd update on e-4. The rows e-5 and e-4 are complete after that.
+ */
+static
+int stream_step_s(
+	struct stream_s *stream,
+	int j,
+	int e)
+{
+	struct stream_level_s *level = &stream->level[j];
+
+	const int size_x = level->size_x;
+	const int size_y = level->size_y;
+
+	const float w[4] = { -dwt_cdf97_p1_s, dwt_cdf97_u1_s, -dwt_cdf97_p2_s, dwt_cdf97_u2_s };
+
+	for(int k = 0; k < 4; k++)
+	{
+		const int y = e-1-k;
+
+		if( y >= 0 && y < size_y )
+			stream_lift_s(stream_row(level, y), stream_row(level, y-1), stream_row(level, y+1), w[k], size_x);
+	}
+
+	int err = 0;
+
+	if( e-5 >= 0 && e-5 < size_y )
+		err |= stream_emit_h_s(stream, j, e-5);
+	if( e-4 >= 0 && e-4 < size_y )
+		err |= stream_emit_l_s(stream, j, e-4);
+
+	return err;
+}
+
+static
+int stream_push_s(
+	struct stream_s *stream,
+	int j,
+	const float *row)
+{
+	struct stream_level_s *level = &stream->level[j];
+
+	const int y = level->rows++;
+
+	assert( y < level->size_y );
+
+	float *dst = stream_row(level, y);
+
+	memcpy(dst, row, sizeof(float) * level->size_x);
+
+	stream_lift_row_s(dst, stream->tmp, level->size_x);
+
+	// not decomposed vertically
+	if( level->size_y < 2 )
+		return stream_emit_l_s(stream, j, y);
+
+	int err = 0;
+
+	if( !(y & 1) )
+		err |= stream_step_s(stream, j, y);
+
+	// flush using the symmetric extension
+	if( y == level->size_y-1 )
+	{
+		for(int e = to_even(y+2); e < level->size_y+5; e += 2)
+			err |= stream_step_s(stream, j, e);
+	}
+
+	return err;
+}
+
+int dwt_cdf97_2f_stream_s(
+	int size_x,
+	int size_y,
+	int *j_max_ptr,
+	int decompose_one,
+	dwt_stream_source_s_t source,
+	void *source_ctx,
+	dwt_stream_sink_s_t sink,
+	void *sink_ctx)
+{
+	assert( size_x > 0 && size_y > 0 && j_max_ptr && source && sink );
+
+	const int size_min = min(size_x, size_y);
+	const int size_max = max(size_x, size_y);
+
+	const int j_limit = ceil_log2( decompose_one ? size_max : size_min );
+
+	if( *j_max_ptr < 0 || *j_max_ptr > j_limit )
+		*j_max_ptr = j_limit;
+
+	const int J = *j_max_ptr;
+
+	// nothing to decompose, pass the image as LL
+	if( 0 == J )
+	{
+		float row[size_x];
+
+		for(int y = 0; y < size_y; y++)
+		{
+			if( source(source_ctx, y, row, size_x) )
+				return 1;
+			if( sink(sink_ctx, 0, DWT_LL, y, row, size_x) )
+				return 1;
+		}
+
+		return 0;
+	}
+
+	struct stream_level_s level[J];
+
+	size_t elems = size_x;
+
+	for(int j = 0; j < J; j++)
+	{
+		level[j].size_x = ceil_div_pow2(size_x, j);
+		level[j].size_y = ceil_div_pow2(size_y, j);
+		level[j].rows = 0;
+
+		elems += (size_t)STREAM_RING * level[j].size_x;
+	}
+
+	// input row, temporary row, rings
+	float *buff = dwt_util_alloc1(sizeof(float) * (elems + size_x));
+	if( !buff )
+	{
+		dwt_util_log(LOG_ERR, "dwt_cdf97_2f_stream_s: unable to allocate memory\n");
+		return 1;
+	}
+
+	float *row = buff;
+
+	struct stream_s stream = {
+		.J = J,
+		.level = level,
+		.tmp = buff + size_x,
+		.sink = sink,
+		.sink_ctx = sink_ctx
+	};
+
+	float *ring = buff + 2*size_x;
+
+	for(int j = 0; j < J; j++)
+	{
+		level[j].ring = ring;
+		ring += (size_t)STREAM_RING * level[j].size_x;
+	}
+
+	int err = 0;
+
+	for(int y = 0; y < size_y && !err; y++)
+	{
+		if( source(source_ctx, y, row, size_x) )
+		{
+			dwt_util_log(LOG_ERR, "dwt_cdf97_2f_stream_s: unable to get row %i\n", y);
+			err = 1;
+			break;
+		}
+
+		err |= stream_push_s(&stream, 0, row);
+	}
+
+	dwt_util_free(buff);
+
+	return err;
+}
+
+int dwt_stream_map_open_s(
+	struct dwt_stream_map_s *map,
+	const char *path,
+	int size_x,
+	int size_y,
+	int create)
+{
+	assert( map && path && size_x > 0 && size_y > 0 );
+
+	map->size_x = size_x;
+	map->size_y = size_y;
+	map->stride_y = sizeof(float);
+	map->stride_x = sizeof(float) * size_x;
+	map->length = (size_t)map->stride_x * size_y;
+	map->ptr = NULL;
+
+	map->fd = create ? open(path, O_CREAT|O_RDWR|O_TRUNC, S_IRUSR|S_IWUSR) : open(path, O_RDONLY);
+	if( map->fd < 0 )
+	{
+		dwt_util_log(LOG_ERR, "open() fails for '%s'\n", path);
+		return 1;
+	}
+
+	if( create )
+	{
+		if( ftruncate(map->fd, map->length) )
+		{
+			dwt_util_log(LOG_ERR, "ftruncate() fails\n");
+			close(map->fd);
+			return 1;
+		}
+	}
+	else
+	{
+		struct stat st;
+
+		if( fstat(map->fd, &st) || (size_t)st.st_size < map->length )
+		{
+			dwt_util_log(LOG_ERR, "'%s' is too short for %ix%i floats\n", path, size_x, size_y);
+			close(map->fd);
+			return 1;
+		}
+	}
+
+	void *ptr = mmap(0, map->length, create ? PROT_READ|PROT_WRITE : PROT_READ, MAP_SHARED, map->fd, 0);
+	if( MAP_FAILED == ptr )
+	{
+		dwt_util_log(LOG_ERR, "mmap() fails\n");
+		close(map->fd);
+		return 1;
+	}
+
+	if( !create )
+		madvise(ptr, map->length, MADV_SEQUENTIAL);
+
+	map->ptr = ptr;
+
+	return 0;
+}
+
+void dwt_stream_map_close_s(
+	struct dwt_stream_map_s *map)
+{
+	assert( map );
+
+	if( map->ptr )
+		munmap(map->ptr, map->length);
+
+	close(map->fd);
+
+	map->ptr = NULL;
+	map->fd = -1;
+}
+
+int dwt_stream_source_map_s(
+	void *ctx,
+	int y,
+	float *row,
+	int size_x)
+{
+	struct dwt_stream_map_s *map = ctx;
+
+	assert( map && map->ptr && size_x == map->size_x && y >= 0 && y < map->size_y );
+
+	const char *base = map->ptr;
+	const size_t begin = (size_t)y * map->stride_x;
+
+	memcpy(row, base + begin, sizeof(float) * size_x);
+
+	// drop the pages fully consumed
+	const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+	const size_t done = begin / page * page;
+
+	if( done && !(y & 63) )
+		madvise(map->ptr, done, MADV_DONTNEED);
+
+	return 0;
+}
+
+int dwt_stream_sink_map_s(
+	void *ctx,
+	int j,
+	enum dwt_subbands band,
+	int y,
+	const float *row,
+	int size)
+{
+	struct dwt_stream_map_s *map = ctx;
+
+	assert( map && map->ptr );
+
+	void *subband;
+	int subband_size_x, subband_size_y;
+
+	dwt_util_subband_s(
+		map->ptr,
+		map->stride_x,
+		map->stride_y,
+		map->size_x,
+		map->size_y,
+		map->size_x,
+		map->size_y,
+		j,
+		band,
+		&subband,
+		&subband_size_x,
+		&subband_size_y
+	);
+
+	if( y >= subband_size_y || size != subband_size_x )
+	{
+		dwt_util_log(LOG_ERR, "dwt_stream_sink_map_s: unexpected row %i of size %i\n", y, size);
+		return 1;
+	}
+
+	memcpy(addr1_s(subband, y, map->stride_x), row, sizeof(float) * size);
+
+	return 0;
+}
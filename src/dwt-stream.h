@@ -0,0 +1,136 @@
+/**
+ * @brief Out-of-core (streaming) 2-D transform.
+ */
+
+#ifndef DWT_STREAM_H
+#define DWT_STREAM_H
+
+#include "libdwt.h" // enum dwt_subbands
+#include <stddef.h> // size_t
+
+/**
+ * @brief Row source.
+ *
+ * Fills the @p row with @p size_x samples of the input row @p y. The rows are
+ * requested exactly once, from the top to the bottom.
+ *
+ * @returns zero value on success
+ */
+typedef int (*dwt_stream_source_s_t)(
+	void *ctx,	///< user data
+	int y,		///< row index
+	float *row,	///< output row
+	int size_x	///< the number of samples in the row
+);
+
+/**
+ * @brief Coefficient row sink.
+ *
+ * Receives the row @p y of the subband @p band of the decomposition level
+ * @p j (from 1 to J). The rows of each subband come in the increasing order,
+ * the subbands and the levels are interleaved. The DWT_LL subband is emitted
+ * for the last level only. The @p row is valid only during the call.
+ *
+ * @returns zero value on success
+ */
+typedef int (*dwt_stream_sink_s_t)(
+	void *ctx,		///< user data
+	int j,			///< decomposition level
+	enum dwt_subbands band,	///< subband
+	int y,			///< row index in the subband
+	const float *row,	///< coefficients
+	int size		///< the number of coefficients in the row
+);
+
+/**
+ * @brief Forward 2-D CDF 9/7 transform of a streamed image.
+ *
+ * The rows are pulled from the @p source and the coefficient rows are pushed
+ * to the @p sink as soon as they are complete. Each level keeps only eight
+ * rows in memory, the memory use is thus proportional to the width of the
+ * image and the number of levels, independent of its height. The symmetric
+ * extension and the subband sizes are the same as with @ref dwt_cdf97_2f_s.
+ *
+ * @returns zero value on success
+ *
+ * @warning experimental
+ */
+int dwt_cdf97_2f_stream_s(
+	int size_x,			///< width of the image
+	int size_y,			///< height of the image
+	int *j_max_ptr,			///< pointer to the number of intended decomposition levels (scales), the number of achieved decomposition levels will be stored also here
+	int decompose_one,		///< should be row or column of size one pixel decomposed? zero value if not
+	dwt_stream_source_s_t source,	///< row source
+	void *source_ctx,		///< user data for @p source
+	dwt_stream_sink_s_t sink,	///< coefficient sink
+	void *sink_ctx			///< user data for @p sink
+);
+
+/**
+ * @brief Memory-mapped raw image file.
+ *
+ * The file holds @p size_y rows of @p size_x floats without any header.
+ */
+struct dwt_stream_map_s {
+	int fd;
+	void *ptr;
+	size_t length;
+	int size_x;
+	int size_y;
+	int stride_x;	///< difference between rows (in bytes)
+	int stride_y;	///< difference between columns (in bytes)
+};
+
+/**
+ * @brief Map the raw image file.
+ *
+ * With @p create non-zero, the file is created (or truncated) to the size of
+ * the image and mapped for writing. Otherwise, the file is mapped read-only.
+ *
+ * @returns zero value on success
+ */
+int dwt_stream_map_open_s(
+	struct dwt_stream_map_s *map,
+	const char *path,
+	int size_x,
+	int size_y,
+	int create
+);
+
+/**
+ * @brief Unmap the file.
+ */
+void dwt_stream_map_close_s(
+	struct dwt_stream_map_s *map
+);
+
+/**
+ * @brief Source reading the rows of a mapped file.
+ *
+ * The @p ctx is a pointer to @ref dwt_stream_map_s opened by @ref dwt_stream_map_open_s.
+ * The pages of the rows already read are dropped from the process.
+ */
+int dwt_stream_source_map_s(
+	void *ctx,
+	int y,
+	float *row,
+	int size_x
+);
+
+/**
+ * @brief Sink writing the coefficients into a mapped file.
+ *
+ * The @p ctx is a pointer to @ref dwt_stream_map_s opened for writing. The
+ * layout of the file is the same as the one produced by @ref dwt_cdf97_2f_s
+ * on a packed image (see @ref dwt_util_subband_s).
+ */
+int dwt_stream_sink_map_s(
+	void *ctx,
+	int j,
+	enum dwt_subbands band,
+	int y,
+	const float *row,
+	int size
+);
+
+#endif
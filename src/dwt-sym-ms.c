@@ -1,6 +1,7 @@
 #include "dwt-sym-ms.h"
 #include "libdwt.h"
 #include "inline.h"
+#include "trace.h"
 #include <math.h>
 #ifdef __SSE__
 	#include <xmmintrin.h>
@@ -3027,6 +3028,8 @@ void copy_src_to_buff(
 	int size_y
 )
 {
+	const dwt_trace_t trace = DWT_TRACE_BEGIN();
+
 	for(int virt_y = 0; virt_y < size_y; virt_y++)
 	{
 		for(int virt_x = 0; virt_x < size_x; virt_x++)
@@ -3038,6 +3041,8 @@ void copy_src_to_buff(
 				*addr2_const_s(src_ptr, real_y, real_x, src_stride_x, src_stride_y);
 		}
 	}
+
+	DWT_TRACE_END("copy_src_to_buff", size_x*size_y, trace);
 }
 
 static
@@ -3079,6 +3084,8 @@ void copy_buff_to_dst(
 	}
 #endif
 #if 1
+	const dwt_trace_t trace = DWT_TRACE_BEGIN();
+
 	const int step = 4;
 
 	// H bands
@@ -3144,6 +3151,8 @@ void copy_buff_to_dst(
 // 					*addr2_const_s(src_ptr, y, x, src_stride_x, src_stride_y);
 // 		}
 // 	}
+
+	DWT_TRACE_END("copy_buff_to_dst", J, trace);
 #endif
 }
 
@@ -4156,6 +4165,448 @@ void ms_cdf97_2f_dl_4x4_fused2_s(
 	}
 }
 
+// ivert_2x4
+#ifdef __SSE__
+static
+void ivert_2x4(
+	// left input column [4]
+	__m128 in0,
+	// right input column [4]
+	__m128 in1,
+	// output 0 [4]
+	__m128 *out0,
+	// output 1 [4]
+	__m128 *out1,
+	// 4x buffer "L" with stride = (1*4) * sizeof(float)
+	float *buff
+)
+{
+	// weights
+	const __m128 w0 = { +dwt_cdf97_p1_s, +dwt_cdf97_p1_s, +dwt_cdf97_p1_s, +dwt_cdf97_p1_s };
+	const __m128 w1 = { -dwt_cdf97_u1_s, -dwt_cdf97_u1_s, -dwt_cdf97_u1_s, -dwt_cdf97_u1_s };
+	const __m128 w2 = { +dwt_cdf97_p2_s, +dwt_cdf97_p2_s, +dwt_cdf97_p2_s, +dwt_cdf97_p2_s };
+	const __m128 w3 = { -dwt_cdf97_u2_s, -dwt_cdf97_u2_s, -dwt_cdf97_u2_s, -dwt_cdf97_u2_s };
+
+	// variables
+	__m128 l0, l1, l2, l3;
+	__m128 c0, c1, c2, c3;
+	__m128 r0, r1, r2, r3;
+	__m128 x0, x1;
+	__m128 y0, y1;
+
+	// load "L"
+	l0 = _mm_load_ps(&buff[0*(1*4)]);
+	l1 = _mm_load_ps(&buff[1*(1*4)]);
+	l2 = _mm_load_ps(&buff[2*(1*4)]);
+	l3 = _mm_load_ps(&buff[3*(1*4)]);
+
+	// inputs
+	x0 = in0;
+	x1 = in1;
+
+	// shuffles
+	y0 = l0;
+	c0 = l1;
+	c1 = l2;
+	c2 = l3;
+	c3 = x0;
+
+	// operation
+	r3 = x1;
+	r2 = c3 + w3 * (l3 + r3);
+	r1 = c2 + w2 * (l2 + r2);
+	r0 = c1 + w1 * (l1 + r1);
+	y1 = c0 + w0 * (l0 + r0);
+
+	// update
+	l0 = r0;
+	l1 = r1;
+	l2 = r2;
+	l3 = r3;
+
+	// outputs
+	*out0 = y0;
+	*out1 = y1;
+
+	// store "L"
+	_mm_store_ps(&buff[0*(1*4)], l0);
+	_mm_store_ps(&buff[1*(1*4)], l1);
+	_mm_store_ps(&buff[2*(1*4)], l2);
+	_mm_store_ps(&buff[3*(1*4)], l3);
+}
+#endif
+
+// NOTE: the scaling is symmetric, thus it is the same for (L,H) pairs on input as for (H,L) pairs on output
+#define CORE_4X4_CALC_INV(t0, t1, t2, t3, buff_h, buff_v) \
+do { \
+	CORE_4X4_SCALE((t0), (t1), (t2), (t3)); \
+	\
+	ivert_2x4((t0), (t1), &(t0), &(t1), (buff_h)); \
+	ivert_2x4((t2), (t3), &(t2), &(t3), (buff_h)); \
+	\
+	_MM_TRANSPOSE4_PS((t0), (t1), (t2), (t3)); \
+	\
+	ivert_2x4((t0), (t1), &(t0), &(t1), (buff_v)); \
+	ivert_2x4((t2), (t3), &(t2), &(t3), (buff_v)); \
+} while(0)
+
+// whole-sample symmetric extension, folds also positions more than one period away
+static
+int virt2real_sym(int pos, int size)
+{
+	if( size < 2 )
+		return 0;
+
+	const int period = 2*(size-1);
+
+	int real = pos;
+
+	// more than one period away
+	if( real < -(size-1) || real > period-1 )
+	{
+		real %= period;
+
+		if( real < 0 )
+			real += period;
+	}
+
+	if( real < 0 )
+		real = -real;
+	if( real > size-1 )
+		real = period - real;
+
+	return real;
+}
+
+// the number of trailing rows/columns which are kept aside for the mirrored reads
+#define INV_GUARD 12
+
+/*
+ * The inverse 4x4 core. The block is read at (x,y) and written to (x-shift,y-shift).
+ * The mirrored reads behind the right/bottom edge would see already reconstructed
+ * samples, these are served from guard_x (trailing columns) and guard_y (trailing rows)
+ * filled when the samples are read for the first time.
+ */
+static
+void unified_4x4_inv(
+	int x, int y,
+	int size_x,
+	int size_y,
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	void *buffer_x,
+	void *buffer_y,
+	float *guard_x,
+	float *guard_y
+)
+{
+#ifdef __SSE__
+	// core size
+	const int step_y = 4;
+	const int step_x = 4;
+
+	// vertical vectorization
+	const int shift = 4;
+
+	// the first trailing column/row in guards
+	const int guard_base_x = max(size_x - INV_GUARD, 0);
+	const int guard_base_y = max(size_y - INV_GUARD, 0);
+
+	__m128 t[4];
+
+	// LOAD
+	if( x >= 0 && y >= 0 && x+step_x-1 < size_x && y+step_y-1 < size_y )
+	{
+		// inside the image
+		for(int xx = 0; xx < step_x; xx++)
+		{
+			for(int yy = 0; yy < step_y; yy++)
+			{
+				t[xx][yy] = *addr2_s(ptr, y+yy, x+xx, stride_x, stride_y);
+			}
+		}
+
+		// the samples read for the first time within guards
+		if( x+step_x-1 >= guard_base_x )
+		{
+			for(int xx = max(guard_base_x-x, 0); xx < step_x; xx++)
+				for(int yy = 0; yy < step_y; yy++)
+					guard_x[(x+xx - guard_base_x)*size_y + y+yy] = t[xx][yy];
+		}
+		if( y+step_y-1 >= guard_base_y )
+		{
+			for(int xx = 0; xx < step_x; xx++)
+				for(int yy = max(guard_base_y-y, 0); yy < step_y; yy++)
+					guard_y[(y+yy - guard_base_y)*size_x + x+xx] = t[xx][yy];
+		}
+	}
+	else
+	{
+		// virtual => real coordinates
+		int real_x[4], real_y[4];
+
+		for(int xx = 0; xx < step_x; xx++)
+			real_x[xx] = virt2real_sym(x + xx, size_x);
+		for(int yy = 0; yy < step_y; yy++)
+			real_y[yy] = virt2real_sym(y + yy, size_y);
+
+		for(int xx = 0; xx < step_x; xx++)
+		{
+			for(int yy = 0; yy < step_y; yy++)
+			{
+				const int virt_x = x + xx;
+				const int virt_y = y + yy;
+				const int pos_x = real_x[xx];
+				const int pos_y = real_y[yy];
+
+				float *guard_x_ptr = &guard_x[(pos_x - guard_base_x)*size_y + pos_y];
+				float *guard_y_ptr = &guard_y[(pos_y - guard_base_y)*size_x + pos_x];
+
+				// NOTE: the rows of the current block left of the image are not read yet
+				if( virt_y > size_y-1 && (virt_x >= 0 || pos_y < y) )
+				{
+					t[xx][yy] = *guard_y_ptr;
+				}
+				else if( virt_x > size_x-1 && virt_y >= 0 )
+				{
+					t[xx][yy] = *guard_x_ptr;
+				}
+				else
+				{
+					const float c = *addr2_s(ptr, pos_y, pos_x, stride_x, stride_y);
+
+					if( virt_x == pos_x && virt_y == pos_y )
+					{
+						if( pos_x >= guard_base_x )
+							*guard_x_ptr = c;
+						if( pos_y >= guard_base_y )
+							*guard_y_ptr = c;
+					}
+
+					t[xx][yy] = c;
+				}
+			}
+		}
+	}
+
+	// CALC
+	CORE_4X4_CALC_INV(t[0], t[1], t[2], t[3], buffer_y, buffer_x);
+
+	// STORE
+	if( x-shift >= 0 && y-shift >= 0 && x-shift+step_x-1 < size_x && y-shift+step_y-1 < size_y )
+	{
+		// inside the image
+		for(int yy = 0; yy < step_y; yy++)
+		{
+			for(int xx = 0; xx < step_x; xx++)
+			{
+				*addr2_s(ptr, y-shift+yy, x-shift+xx, stride_x, stride_y) = t[yy][xx];
+			}
+		}
+	}
+	else
+	for(int yy = 0; yy < step_y; yy++)
+	{
+		for(int xx = 0; xx < step_x; xx++)
+		{
+			// virtual => real coordinates
+			const int pos_x = virt2real_error(x-shift, xx, 0, size_x);
+			const int pos_y = virt2real_error(y-shift, yy, 0, size_y);
+			if( pos_x < 0 || pos_y < 0 )
+				continue;
+
+			*addr2_s(ptr, pos_y, pos_x, stride_x, stride_y) = t[yy][xx];
+		}
+	}
+#endif /* __SSE__ */
+}
+
+/*
+ * Each level leads its nominal row (the row of the read head scaled to the level)
+ * by a constant number of its own rows, thus the coarser levels lead by more
+ * rows of the image. The level j reads the rows written by the level j+1, which
+ * holds for 16 rows and more, one block is added as margin. The levels are
+ * processed row by row, each level sweeps its whole row of blocks at once.
+ */
+#define MS_LEAD_INV 20
+
+// the pipelines of each level are filled starting from INV_PROLOG samples before the image
+#define INV_PROLOG 4
+
+static
+void ms_loop_unified_4x4_inv(
+	int base_y,
+	int stop_y,
+	int size_x, int size_y,
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	float *buffer_x,
+	float *buffer_y,
+	float *guard_x,
+	float *guard_y,
+	const int *guard_x_offset,
+	const int *guard_y_offset,
+	int J,
+	int super_x,
+	int super_y,
+	int buffer_offset
+)
+{
+	const int words = 1; // vertical
+	const int buff_elem_size = words*4;
+
+	// core size
+	const int step_y = 4;
+	const int step_x = 4;
+
+	const int buffer_x_elems = buff_elem_size*super_x;
+	const int buffer_y_elems = buff_elem_size*super_y;
+
+	for(int y = base_y; y < stop_y; y += step_y)
+	{
+		// coarser levels first
+		for(int j = J-1; j >= 0; j--)
+		{
+			// mod == 0
+			if( (y&((4<<j)-1)) != (0) )
+				continue;
+
+			const int y_j = ceil_div_pow2(y,j) -(step_y) + MS_LEAD_INV;
+
+			const int size_x_j = ceil_div_pow2(size_x,j);
+			const int size_y_j = ceil_div_pow2(size_y,j);
+
+			// the level is not active here
+			if( y_j < -INV_PROLOG || y_j >= size_y_j+4 )
+				continue;
+
+			const int stride_x_j = mul_pow2(stride_x,j);
+			const int stride_y_j = mul_pow2(stride_y,j);
+
+			// order=horizontal
+			for(int x_j = -INV_PROLOG; x_j < size_x_j+4; x_j += step_x)
+			{
+				unified_4x4_inv(
+					x_j, y_j,
+					size_x_j, size_y_j,
+					ptr, stride_x_j, stride_y_j,
+					buffer_x + j*buffer_x_elems + (buffer_offset+x_j)*buff_elem_size,
+					buffer_y + j*buffer_y_elems + (buffer_offset+y_j)*buff_elem_size,
+					guard_x + guard_x_offset[j],
+					guard_y + guard_y_offset[j]
+				);
+			}
+		}
+	}
+}
+
+void ms_cdf97_2i_dl_4x4_s(
+	int size_x,
+	int size_y,
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int J
+)
+{
+	assert( J > 0 && ceil_div_pow2(size_x, J-1) > 1 && ceil_div_pow2(size_y, J-1) > 1 );
+
+	const int words = 1; // vertical
+	const int buff_elem_size = words*4;
+
+	// virtual coordinates of each level span from -INV_PROLOG up to size_j+4+step
+	const int buff_guard = INV_GUARD;
+	const int overlap_R = 4+4;
+
+	const int super_x = buff_guard + size_x + overlap_R;
+	const int super_y = buff_guard + size_y + overlap_R;
+
+	const int buffer_x_elems = buff_elem_size*super_x;
+	const int buffer_y_elems = buff_elem_size*super_y;
+
+	// alloc buffers
+	float buffer_x[J*buffer_x_elems] ALIGNED(16);
+	float buffer_y[J*buffer_y_elems] ALIGNED(16);
+
+	// NOTE: do not leave NaNs in the lifting pipelines
+	dwt_util_zero_vec_s(buffer_x, J*buffer_x_elems);
+	dwt_util_zero_vec_s(buffer_y, J*buffer_y_elems);
+
+	const int buffer_offset = buff_guard;
+
+	// guards, INV_GUARD trailing columns (rows) of each level
+	int guard_x_offset[J];
+	int guard_y_offset[J];
+	int guard_x_elems = 0;
+	int guard_y_elems = 0;
+
+	for(int j = 0; j < J; j++)
+	{
+		guard_x_offset[j] = guard_x_elems;
+		guard_y_offset[j] = guard_y_elems;
+
+		guard_x_elems += INV_GUARD*ceil_div_pow2(size_y, j);
+		guard_y_elems += INV_GUARD*ceil_div_pow2(size_x, j);
+	}
+
+	float guard_x[guard_x_elems];
+	float guard_y[guard_y_elems];
+
+	// the coarsest level starts first, the finest level finishes last
+	const int base_y = -mul_pow2(INV_PROLOG-4+MS_LEAD_INV, J-1);
+
+	int stop_y = base_y;
+
+	for(int j = 0; j < J; j++)
+	{
+		stop_y = max(stop_y, (ceil_div_pow2(size_y, j) + overlap_R - MS_LEAD_INV) << j);
+	}
+
+	// unified loop
+	{
+		ms_loop_unified_4x4_inv(
+			/* base */ base_y,
+			/* stop */ stop_y,
+			/* size */ size_x, size_y,
+			ptr,
+			stride_x, stride_y,
+			buffer_x, buffer_y,
+			guard_x, guard_y,
+			guard_x_offset, guard_y_offset,
+			J,
+			super_x, super_y,
+			buffer_offset
+		);
+	}
+}
+
+void ms_cdf97_2i_dl_4x4_level_s(
+	int size_x,
+	int size_y,
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int J,
+	int level
+)
+{
+	assert( level >= 0 && level <= J );
+
+	if( J == level )
+		return;
+
+	ms_cdf97_2i_dl_4x4_s(
+		ceil_div_pow2(size_x, level),
+		ceil_div_pow2(size_y, level),
+		ptr,
+		mul_pow2(stride_x, level),
+		mul_pow2(stride_y, level),
+		J - level
+	);
+}
+
 // TODO
 void dwt_util_perf_ms_cdf97_2f_dl_4x4_s(
 	int size_x,
@@ -4272,7 +4723,7 @@ void dwt_util_perf_ms_cdf97_2f_dl_4x4_s(
 		// perform M inv transforms
 		for(int m = 0; m < M; m++)
 		{
-			dwt_cdf97_2i_inplace_s(ptr[m], stride_x, stride_y, size_x, size_y, size_x, size_y, J, 0, 0);
+			ms_cdf97_2i_dl_4x4_s(size_x, size_y, ptr[m], stride_x, stride_y, J);
 		}
 		// stop timer
 		const dwt_clock_t time_inv_stop = dwt_util_get_clock(clock_type);
@@ -4774,10 +5225,10 @@ void cdf97_2f_dl_2x2_s(
 // 	const int limit0_x = overlap_x_L + offset + shift;
 // 	const int limit1_x = overlap_x_L + size_x - modulo_x_R - step_x*!modulo_x_R; // HACK: last term should not be here
 
-	dwt_util_log(LOG_DBG, "mod_L=%i ovl_L=%i mod_R=%i ovl_R=%i => %i+%i+%i\n",
-		modulo_x_L, overlap_x_L, modulo_x_R, overlap_x_R,
-		overlap_x_L, size_x, overlap_x_R
-    	);
+// 	dwt_util_log(LOG_DBG, "mod_L=%i ovl_L=%i mod_R=%i ovl_R=%i => %i+%i+%i\n",
+// 		modulo_x_L, overlap_x_L, modulo_x_R, overlap_x_R,
+// 		overlap_x_L, size_x, overlap_x_R
+//     	);
 
 	const int modulo_y_L = (offset) % step_y;
 	const int overlap_y_L = step_y + !!modulo_y_L * (step_y-modulo_y_L); // (step_x-modulo_x_L) + (!!offset * step_x);
@@ -4787,9 +5238,13 @@ void cdf97_2f_dl_2x2_s(
 // 	const int limit0_y = overlap_y_L + offset + shift;
 // 	const int limit1_y = overlap_y_L + size_y - modulo_y_R - step_y*!modulo_y_R; // HACK: last term should not be here
 
-	// alloc buffers
-	float buffer_x[buff_elem_size*super_x] ALIGNED(16);
-	float buffer_y[buff_elem_size*super_y] ALIGNED(16);
+	// alloc buffers, the loop starts at the negative coordinates and the last core can overhang the stop
+	float buffer_x[buff_elem_size*(overlap_x_L+super_x+step_x)] ALIGNED(16);
+	float buffer_y[buff_elem_size*(overlap_y_L+super_y+step_y)] ALIGNED(16);
+
+	// zero buffers
+	dwt_util_zero_vec_s(buffer_x, buff_elem_size*(overlap_x_L+super_x+step_x));
+	dwt_util_zero_vec_s(buffer_y, buff_elem_size*(overlap_y_L+super_y+step_y));
 
 	// unified loop
 	{
@@ -4799,7 +5254,8 @@ void cdf97_2f_dl_2x2_s(
 			/* size */ size_x, size_y,
 			src_ptr, src_stride_x, src_stride_y,
 			dst_ptr, dst_stride_x, dst_stride_y,
-			buffer_x, buffer_y
+			buffer_x + buff_elem_size*overlap_x_L,
+			buffer_y + buff_elem_size*overlap_y_L
 		);
 	}
 }
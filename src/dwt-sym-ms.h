@@ -46,6 +46,42 @@ void ms_cdf97_2f_dl_4x4_fused2_s(
 	int J
 );
 
+/**
+ * @brief Multi-scale single-loop inverse implementation using SSE vectorized core.
+ *
+ * Reconstructs all @p J levels in a single pass over the image.
+ * The coarser levels run ahead of the finer ones, each level keeps only its line buffers and a few trailing rows and columns.
+ * Inverse counterpart of @ref ms_cdf97_2f_dl_4x4_s, the transform is expected in the layout of @ref dwt_cdf97_2f_inplace_s.
+ *
+ * @warning experimental
+ */
+void ms_cdf97_2i_dl_4x4_s(
+	int size_x,
+	int size_y,
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int J
+);
+
+/**
+ * @brief Multi-scale single-loop inverse reconstructing the levels from @p J down to @p level only.
+ *
+ * The LL subband of the level is left at the beginning of the image data with the strides multiplied by 2^level.
+ * The coefficients of the finer levels are not touched.
+ *
+ * @warning experimental
+ */
+void ms_cdf97_2i_dl_4x4_level_s(
+	int size_x,
+	int size_y,
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int J,
+	int level
+);
+
 void dwt_util_perf_ms_cdf97_2f_dl_4x4_s(
 	int size_x,
 	int size_y,
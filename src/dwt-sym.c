@@ -533,6 +533,15 @@ void unified_4x4(
 #endif /* __SSE__ */
 }
 
+// the number of trailing rows/columns which are kept aside for the mirrored reads of the in-place inverse
+#define INV_GUARD 8
+
+/*
+ * The inverse 4x4 core. The block is read at (x,y) and written to (x-shift,y-shift).
+ * When running in-place, the mirrored reads behind the right/bottom edge would see
+ * already reconstructed samples, these are served from guard_x (trailing columns)
+ * and guard_y (trailing rows) instead. Both are NULL for not-in-place data.
+ */
 static
 void unified_4x4_inv(
 	int x, int y,
@@ -545,7 +554,9 @@ void unified_4x4_inv(
 	int dst_stride_x,
 	int dst_stride_y,
 	void *buffer_x,
-	void *buffer_y
+	void *buffer_y,
+	const float *guard_x,
+	const float *guard_y
 )
 {
 #ifdef __SSE__
@@ -554,9 +565,29 @@ void unified_4x4_inv(
 
 	const int shift = 4; // vertical vectorization
 
+	// the first trailing column/row in guards
+	const int guard_base_x = max(size_x - INV_GUARD, 0);
+	const int guard_base_y = max(size_y - INV_GUARD, 0);
+
+	// real coordinates of the block
+	const int real_x = x - overlap_x_L;
+	const int real_y = y - overlap_y_L;
+
 	__m128 t[4];
 
 	// CORE -- LOAD
+	if( real_x >= 0 && real_y >= 0 && real_x+step_x-1 < size_x && real_y+step_y-1 < size_y )
+	{
+		// inside the image
+		for(int xx = 0; xx < step_x; xx++)
+		{
+			for(int yy = 0; yy < step_y; yy++)
+			{
+				t[xx][yy] = *addr2_const_s(src_ptr, real_y+yy, real_x+xx, src_stride_x, src_stride_y);
+			}
+		}
+	}
+	else
 	for(int xx = 0; xx < step_x; xx++)
 	{
 		for(int yy = 0; yy < step_y; yy++)
@@ -565,7 +596,12 @@ void unified_4x4_inv(
 			const int pos_x = virt2real(x, xx, overlap_x_L, size_x);
 			const int pos_y = virt2real(y, yy, overlap_y_L, size_y);
 
-			t[xx][yy] = *addr2_const_s(src_ptr, pos_y, pos_x, src_stride_x, src_stride_y);
+			if( guard_x && real_x+xx > size_x-1 )
+				t[xx][yy] = guard_x[(pos_x - guard_base_x)*size_y + pos_y];
+			else if( guard_y && real_y+yy > size_y-1 )
+				t[xx][yy] = guard_y[(pos_y - guard_base_y)*size_x + pos_x];
+			else
+				t[xx][yy] = *addr2_const_s(src_ptr, pos_y, pos_x, src_stride_x, src_stride_y);
 		}
 	}
 
@@ -573,6 +609,18 @@ void unified_4x4_inv(
 	CORE_4X4_CALC_INV(t[0], t[1], t[2], t[3], buffer_y, buffer_x);
 
 	// CORE -- STORE
+	if( real_x-shift >= 0 && real_y-shift >= 0 && real_x-shift+step_x-1 < size_x && real_y-shift+step_y-1 < size_y )
+	{
+		// inside the image
+		for(int yy = 0; yy < step_y; yy++)
+		{
+			for(int xx = 0; xx < step_x; xx++)
+			{
+				*addr2_s(dst_ptr, real_y-shift+yy, real_x-shift+xx, dst_stride_x, dst_stride_y) = t[yy][xx];
+			}
+		}
+	}
+	else
 	for(int yy = 0; yy < step_y; yy++)
 	{
 		for(int xx = 0; xx < step_x; xx++)
@@ -693,7 +741,9 @@ void loop_unified_4x4_inv(
 	int dst_stride_x,
 	int dst_stride_y,
 	float *buffer_x,
-	float *buffer_y
+	float *buffer_y,
+	const float *guard_x,
+	const float *guard_y
 )
 {
 	const int words = 1; // vertical
@@ -719,7 +769,9 @@ void loop_unified_4x4_inv(
 				src_ptr, src_stride_x, src_stride_y,
 				dst_ptr, dst_stride_x, dst_stride_y,
 				buffer_x + x*buff_elem_size,
-				buffer_y + y*buff_elem_size
+				buffer_y + y*buff_elem_size,
+				guard_x,
+				guard_y
 			);
 		}
 	}
@@ -954,7 +1006,7 @@ void cdf97_2f_dl_4x4_s(
 	);
 #else
 	{
-		const void *src_ptr_shifted = addr2_const_s(src_ptr,       -overlap_y_L,       -overlap_x_L, dst_stride_x, dst_stride_y);
+		const void *src_ptr_shifted = addr2_const_s(src_ptr,       -overlap_y_L,       -overlap_x_L, src_stride_x, src_stride_y);
 		void       *dst_ptr_shifted =       addr2_s(dst_ptr, -shift-overlap_y_L, -shift-overlap_x_L, dst_stride_x, dst_stride_y);
 
 		// TODO: parallelize this using threads
@@ -1013,7 +1065,6 @@ void cdf97_2f_dl_4x4_s(
 #endif /* one big loop */
 }
 
-// TODO: in-place transforms is not treated
 void cdf97_2i_dl_4x4_s(
 	int size_x,
 	int size_y,
@@ -1072,6 +1123,26 @@ void cdf97_2i_dl_4x4_s(
 	dwt_util_zero_vec_s(buffer_y, buff_elem_size*super_y);
 #endif
 
+	// in-place data, keep aside INV_GUARD trailing columns (rows) for the mirrored reads
+	const int inplace = src_ptr == dst_ptr && src_stride_x == dst_stride_x && src_stride_y == dst_stride_y;
+
+	const int guard_size_x = min(size_x, INV_GUARD);
+	const int guard_size_y = min(size_y, INV_GUARD);
+
+	float guard_x[inplace ? guard_size_x*size_y : 1];
+	float guard_y[inplace ? guard_size_y*size_x : 1];
+
+	if( inplace )
+	{
+		for(int x = 0; x < guard_size_x; x++)
+			for(int y = 0; y < size_y; y++)
+				guard_x[x*size_y + y] = *addr2_const_s(src_ptr, y, size_x-guard_size_x+x, src_stride_x, src_stride_y);
+
+		for(int y = 0; y < guard_size_y; y++)
+			for(int x = 0; x < size_x; x++)
+				guard_y[y*size_x + x] = *addr2_const_s(src_ptr, size_y-guard_size_y+y, x, src_stride_x, src_stride_y);
+	}
+
 	// unified loop
 	{
 		loop_unified_4x4_inv(
@@ -1083,7 +1154,9 @@ void cdf97_2i_dl_4x4_s(
 			src_ptr, src_stride_x, src_stride_y,
 			dst_ptr, dst_stride_x, dst_stride_y,
 			buffer_x,
-			buffer_y
+			buffer_y,
+			inplace ? guard_x : NULL,
+			inplace ? guard_y : NULL
 		);
 	}
 }
@@ -1427,6 +1500,44 @@ void dwt_cdf97_2i_dl_4x4_s(
 	}
 }
 
+void dwt_cdf97_2i_dl_4x4_level_s(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_o_big_x,
+	int size_o_big_y,
+	int size_x,
+	int size_y,
+	int j_max,
+	int decompose_one,
+	int zero_padding,
+	int level
+)
+{
+	const int size_o_big_min = min(size_o_big_x,size_o_big_y);
+	const int size_o_big_max = max(size_o_big_x,size_o_big_y);
+
+	int j = ceil_log2( decompose_one ? size_o_big_max : size_o_big_min );
+
+	if( j_max >= 0 && j_max < j )
+		j = j_max;
+
+	assert( level >= 0 && level <= j );
+
+	dwt_cdf97_2i_dl_4x4_s(
+		ptr,
+		mul_pow2(stride_x, level),
+		mul_pow2(stride_y, level),
+		ceil_div_pow2(size_o_big_x, level),
+		ceil_div_pow2(size_o_big_y, level),
+		ceil_div_pow2(size_x, level),
+		ceil_div_pow2(size_y, level),
+		j - level,
+		decompose_one,
+		zero_padding
+	);
+}
+
 void dwt_util_perf_dwt_cdf97_2f_dl_4x4_s(
 	int size_x,
 	int size_y,
@@ -119,6 +119,28 @@ void dwt_cdf97_2i_dl_4x4_s(
 	int zero_padding	///< fill padding in channels with zeros? zero value if not, should be non zero only for sparse decomposition
 );
 
+/**
+ * @brief Inverse image fast wavelet transform using CDF 9/7 wavelet, in-place version, reconstruction down to the level @p level only.
+ *
+ * The LL subband of the level is left at the beginning of the image data with the strides multiplied by 2^level.
+ *
+ * @note for compatibility with @ref dwt_cdf97_2i_inplace_level_s
+ * @warning experimental
+ */
+void dwt_cdf97_2i_dl_4x4_level_s(
+	void *ptr,		///< pointer to beginning of image data
+	int stride_x,		///< difference between rows (in bytes)
+	int stride_y,		///< difference between columns (in bytes)
+	int size_o_big_x,	///< width of outer image frame (in elements)
+	int size_o_big_y,	///< height of outer image frame (in elements)
+	int size_x,		///< width of nested image (in elements)
+	int size_y,		///< height of nested image (in elements)
+	int j_max,		///< the number of decomposition levels (scales)
+	int decompose_one,	///< should be row or column of size one pixel decomposed? zero value if not
+	int zero_padding,	///< fill padding in channels with zeros? zero value if not, should be non zero only for sparse decomposition
+	int level		///< the level to reconstruct, from 0 up to the number of levels
+);
+
 void dwt_util_perf_dwt_cdf97_2f_dl_4x4_s(
 	int size_x,
 	int size_y,
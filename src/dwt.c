@@ -5440,6 +5440,9 @@ void dwt_util_measure_perf_cdf97_2_inplace_new_s(
 
 	assert( fwd_plot_data && inv_plot_data );
 
+	if( !get_idwt_diag_2x2_func(order) )
+		dwt_util_log(LOG_WARN, "%s: no inverse core for the order %i, the inverse is left out\n", __FUNCTION__, (int)order);
+
 	const float growth_factor = g_growth_factor_s;
 
 	// for x = min_x to max_x
@@ -5483,7 +5486,8 @@ void dwt_util_measure_perf_cdf97_2_inplace_new_s(
 
 		// printf into file
 		fprintf(fwd_plot_data, "%i\t%.10f\n", x*y, fwd_secs/denominator);
-		fprintf(inv_plot_data, "%i\t%.10f\n", x*y, inv_secs/denominator);
+		if( !isnan(inv_secs) )
+			fprintf(inv_plot_data, "%i\t%.10f\n", x*y, inv_secs/denominator);
 
 	}
 
@@ -5512,6 +5516,9 @@ void dwt_util_measure_perf_cdf97_2_inplace_new_VERT_s(
 
 	assert( fwd_plot_data && inv_plot_data );
 
+	if( !get_idwt_vert_2x2_func(order) )
+		dwt_util_log(LOG_WARN, "%s: no inverse core for the order %i, the inverse is left out\n", __FUNCTION__, (int)order);
+
 	const float growth_factor = g_growth_factor_s;
 
 	// for x = min_x to max_x
@@ -5558,7 +5565,8 @@ void dwt_util_measure_perf_cdf97_2_inplace_new_VERT_s(
 
 		// printf into file
 		fprintf(fwd_plot_data, "%i\t%.10f\n", x*y, fwd_secs/denominator);
-		fprintf(inv_plot_data, "%i\t%.10f\n", x*y, inv_secs/denominator);
+		if( !isnan(inv_secs) )
+			fprintf(inv_plot_data, "%i\t%.10f\n", x*y, inv_secs/denominator);
 
 	}
 
@@ -6114,7 +6122,7 @@ void dwt_util_perf_cdf97_2_inplace_new_s(
 	int shift = 10; // FIXME: diagonal/SDL
 
 	// offset
-	int offset = 1; // FIXME
+	int offset = 5; // FIXME: 1+decay for the single-loop inverse
 
 	// border
 	int decay = 4; // FIXME: CDF 9/7
@@ -6146,13 +6154,19 @@ void dwt_util_perf_cdf97_2_inplace_new_s(
 
 		src_ptr[m] = dwt_util_viewport(out_ptr[m], out_size_x, out_size_y, out_stride_x, out_stride_y, offset+shift, offset+shift);
 		src_img[m] = dwt_util_viewport(out_ptr[m], out_size_x, out_size_y, out_stride_x, out_stride_y, offset+shift, offset+shift);
-		dst_ptr[m] = dwt_util_viewport(out_ptr[m], out_size_x, out_size_y, out_stride_x, out_stride_y, 0, 0);
+		dst_ptr[m] = dwt_util_viewport(out_ptr[m], out_size_x, out_size_y, out_stride_x, out_stride_y, offset+shift-decay-1, offset+shift-decay-1);
 		dst_img[m] = dwt_util_viewport(out_ptr[m], out_size_x, out_size_y, out_stride_x, out_stride_y, offset+shift, offset+shift);
 	}
 
 	*fwd_secs = +INFINITY;
 	*inv_secs = +INFINITY;
 
+	// select the proper inverse function, the fused cores have none
+	idwt_diag_2x2_func_t ifunc = get_idwt_diag_2x2_func(order);
+
+	if( !ifunc )
+		*inv_secs = NAN;
+
 	// perform N test loops, select minimum
 	for(int n = 0; n < N; n++)
 	{
@@ -6222,22 +6236,21 @@ void dwt_util_perf_cdf97_2_inplace_new_s(
 			}
 		}
 
+		// the inverse is not measured
+		if( !ifunc )
+			continue;
+
 		// start timer
 		const dwt_clock_t time_inv_start = dwt_util_get_clock(clock_type);
 		// perform M inv transforms
 		for(int m = 0; m < M; m++)
 		{
-			dwt_cdf97_2i_inplace_s(
+			ifunc(
 				dst_ptr[m],
 				out_stride_x,
 				out_stride_y,
-				out_size_x,
-				out_size_y,
-				out_size_x,
-				out_size_y,
-				1,
-				0,
-				0
+				size_x+shift+decay+decay,
+				size_y+shift+decay+decay
 			);
 		}
 		// stop timer
@@ -6338,7 +6351,7 @@ void dwt_util_perf_cdf97_2_inplace_new_VERT_s(
 	int shift = 4; // FIXME: vertical/DL
 
 	// offset
-	int offset = 1; // FIXME
+	int offset = 5; // FIXME: 1+decay for the single-loop inverse
 
 	// border
 	int decay = 4; // FIXME: CDF 9/7
@@ -6370,13 +6383,19 @@ void dwt_util_perf_cdf97_2_inplace_new_VERT_s(
 
 		src_ptr[m] = dwt_util_viewport(out_ptr[m], out_size_x, out_size_y, out_stride_x, out_stride_y, offset+shift, offset+shift);
 		src_img[m] = dwt_util_viewport(out_ptr[m], out_size_x, out_size_y, out_stride_x, out_stride_y, offset+shift, offset+shift);
-		dst_ptr[m] = dwt_util_viewport(out_ptr[m], out_size_x, out_size_y, out_stride_x, out_stride_y, 0, 0);
+		dst_ptr[m] = dwt_util_viewport(out_ptr[m], out_size_x, out_size_y, out_stride_x, out_stride_y, offset+shift-decay-1, offset+shift-decay-1);
 		dst_img[m] = dwt_util_viewport(out_ptr[m], out_size_x, out_size_y, out_stride_x, out_stride_y, offset+shift, offset+shift);
 	}
 
 	*fwd_secs = +INFINITY;
 	*inv_secs = +INFINITY;
 
+	// select the proper inverse function, the fused cores have none
+	idwt_vert_2x2_func_t ifunc = get_idwt_vert_2x2_func(order);
+
+	if( !ifunc )
+		*inv_secs = NAN;
+
 	// perform N test loops, select minimum
 	for(int n = 0; n < N; n++)
 	{
@@ -6471,22 +6490,21 @@ void dwt_util_perf_cdf97_2_inplace_new_VERT_s(
 			}
 		}
 
+		// the inverse is not measured
+		if( !ifunc )
+			continue;
+
 		// start timer
 		const dwt_clock_t time_inv_start = dwt_util_get_clock(clock_type);
 		// perform M inv transforms
 		for(int m = 0; m < M; m++)
 		{
-			dwt_cdf97_2i_inplace_s(
+			ifunc(
 				dst_ptr[m],
 				out_stride_x,
 				out_stride_y,
-				out_size_x,
-				out_size_y,
-				out_size_x,
-				out_size_y,
-				1,
-				0,
-				0
+				size_x+shift+decay+decay,
+				size_y+shift+decay+decay
 			);
 		}
 		// stop timer
@@ -0,0 +1,220 @@
+/**
+ * @brief Radix-2 complex FFT with cached plans.
+ */
+
+#include "fft.h"
+
+// dwt_util_log
+#include "libdwt.h"
+
+// assert
+#include <assert.h>
+
+// malloc, free
+#include <stdlib.h>
+
+// cos, sin, M_PI
+#include <math.h>
+
+#if defined(__linux__) && !defined(__uClinux__)
+	#define FFT_PTHREADS
+#endif
+
+#ifdef FFT_PTHREADS
+	#include <pthread.h>
+#endif
+
+// one plan for each power of two
+#define FFT_MAX_LOG2 31
+
+static struct fft_plan_s *fft_plans[FFT_MAX_LOG2];
+
+#ifdef FFT_PTHREADS
+static pthread_mutex_t fft_plans_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static
+int fft_log2(
+	int size)
+{
+	int log2 = 0;
+
+	while( (1 << log2) < size )
+		log2++;
+
+	return log2;
+}
+
+int fft_size(
+	int size)
+{
+	assert( size > 0 && size <= (1 << (FFT_MAX_LOG2-1)) );
+
+	return 1 << fft_log2(size);
+}
+
+static
+void fft_plan_destroy(
+	struct fft_plan_s *plan)
+{
+	if( !plan )
+		return;
+
+	free(plan->twiddle);
+	free(plan->reverse);
+	free(plan);
+}
+
+static
+struct fft_plan_s *fft_plan_create(
+	int size,
+	int log2)
+{
+	struct fft_plan_s *plan = malloc(sizeof(struct fft_plan_s));
+
+	if( !plan )
+		return NULL;
+
+	plan->size = size;
+	plan->twiddle = malloc(sizeof(float complex) * (size/2 + 1));
+	plan->reverse = malloc(sizeof(int) * size);
+
+	if( !plan->twiddle || !plan->reverse )
+	{
+		fft_plan_destroy(plan);
+		return NULL;
+	}
+
+	for(int k = 0; k < size/2; k++)
+	{
+		const double phi = -2. * M_PI * k / size;
+
+		plan->twiddle[k] = (float)cos(phi) + I * (float)sin(phi);
+	}
+
+	for(int n = 0; n < size; n++)
+	{
+		int r = 0;
+
+		for(int b = 0; b < log2; b++)
+			r |= ((n >> b) & 1) << (log2 - 1 - b);
+
+		plan->reverse[n] = r;
+	}
+
+	return plan;
+}
+
+const struct fft_plan_s *fft_plan_s(
+	int size)
+{
+	if( size < 1 || (size & (size-1)) || size > (1 << (FFT_MAX_LOG2-1)) )
+	{
+		dwt_util_log(LOG_ERR, "%s: unsupported size %i\n", __FUNCTION__, size);
+		return NULL;
+	}
+
+	const int log2 = fft_log2(size);
+
+#ifdef FFT_PTHREADS
+	pthread_mutex_lock(&fft_plans_lock);
+#endif
+
+	if( !fft_plans[log2] )
+	{
+		fft_plans[log2] = fft_plan_create(size, log2);
+
+		if( !fft_plans[log2] )
+			dwt_util_log(LOG_ERR, "%s: unable to allocate the plan of size %i\n", __FUNCTION__, size);
+	}
+
+	const struct fft_plan_s *plan = fft_plans[log2];
+
+#ifdef FFT_PTHREADS
+	pthread_mutex_unlock(&fft_plans_lock);
+#endif
+
+	return plan;
+}
+
+void fft_plan_cache_clear()
+{
+#ifdef FFT_PTHREADS
+	pthread_mutex_lock(&fft_plans_lock);
+#endif
+
+	for(int log2 = 0; log2 < FFT_MAX_LOG2; log2++)
+	{
+		fft_plan_destroy(fft_plans[log2]);
+		fft_plans[log2] = NULL;
+	}
+
+#ifdef FFT_PTHREADS
+	pthread_mutex_unlock(&fft_plans_lock);
+#endif
+}
+
+void fft_cs(
+	const struct fft_plan_s *plan,
+	float complex *data,
+	int inverse)
+{
+	assert( plan && data );
+
+	const int size = plan->size;
+
+	// the complex numbers as pairs of floats, avoids the slow complex multiplication of C99
+	float *restrict d = (float *)data;
+	const float *restrict w = (const float *)plan->twiddle;
+
+	for(int n = 0; n < size; n++)
+	{
+		const int r = plan->reverse[n];
+
+		if( n < r )
+		{
+			const float t_re = d[2*n+0];
+			const float t_im = d[2*n+1];
+			d[2*n+0] = d[2*r+0];
+			d[2*n+1] = d[2*r+1];
+			d[2*r+0] = t_re;
+			d[2*r+1] = t_im;
+		}
+	}
+
+	const float sign = inverse ? -1.f : +1.f;
+
+	for(int len = 2; len <= size; len <<= 1)
+	{
+		const int half = len >> 1;
+		const int step = size / len;
+
+		for(int i = 0; i < size; i += len)
+		{
+			for(int k = 0; k < half; k++)
+			{
+				const float w_re = w[2*(k*step)+0];
+				const float w_im = w[2*(k*step)+1] * sign;
+
+				float *restrict a = d + 2*(i+k);
+				float *restrict b = d + 2*(i+k+half);
+
+				const float v_re = b[0] * w_re - b[1] * w_im;
+				const float v_im = b[0] * w_im + b[1] * w_re;
+
+				b[0] = a[0] - v_re;
+				b[1] = a[1] - v_im;
+				a[0] = a[0] + v_re;
+				a[1] = a[1] + v_im;
+			}
+		}
+	}
+
+	if( inverse )
+	{
+		const float scale = 1.f / size;
+
+		for(int n = 0; n < 2*size; n++)
+			d[n] *= scale;
+	}
+}
@@ -0,0 +1,58 @@
+/**
+ * @brief Radix-2 complex FFT with cached plans.
+ */
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <complex.h>
+
+/**
+ * @brief Precomputed tables of the transform of a single size.
+ */
+struct fft_plan_s {
+	int size;		///< the number of samples, a power of two
+	float complex *twiddle;	///< size/2 twiddle factors exp(-2*pi*i*k/size)
+	int *reverse;		///< bit-reversal permutation of the samples
+};
+
+/**
+ * @brief Get the plan of the transform of @p size samples.
+ *
+ * The plans are built once and cached until @ref fft_plan_cache_clear is
+ * called. This function is thread safe.
+ *
+ * @returns NULL if @p size is not a power of two or on failure
+ */
+const struct fft_plan_s *fft_plan_s(
+	int size	///< the number of samples, a power of two
+);
+
+/**
+ * @brief Release all the cached plans.
+ *
+ * @warning no plan may be in use
+ */
+void fft_plan_cache_clear();
+
+/**
+ * @brief The smallest power of two not less than @p size.
+ */
+int fft_size(
+	int size
+);
+
+/**
+ * @brief In-place complex FFT.
+ *
+ * The forward transform computes X[k] = sum_n x[n] exp(-2*pi*i*k*n/size),
+ * the inverse transform uses the positive exponent and the result is divided
+ * by the size.
+ */
+void fft_cs(
+	const struct fft_plan_s *plan,	///< the plan, see @ref fft_plan_s
+	float complex *data,		///< contiguous samples
+	int inverse			///< nonzero for the inverse transform
+);
+
+#endif
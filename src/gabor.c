@@ -4,6 +4,12 @@
 #include <stdlib.h>
 #include "inline.h"
 #include "libdwt.h"
+#include "fft.h"
+#include "pool.h" // dwt_pool_run
+
+#ifdef __SSE__
+	#include <xmmintrin.h>
+#endif
 
 float complex gabor_atom(
 	float t,	///< time around 0
@@ -528,397 +534,1563 @@ void test_signal(
 	}
 }
 
-void gabor_ft_s(
-	// input
-	const float *sig,	///< the analysed signal
-	int sig_stride,		///< the stride of the signal
-	int sig_size,		///< the length of the signal, the width of the plane
-	// output
-	void *plane,		///< put the plane here
-	int stride_x,		///< stride of rows of the plane
-	int stride_y,		///< stride of columns of the plane
-	int bins,		///< the height of the plane
-	// params
-	float sigma		///< std. deviation of the baseline kernel (implies the window size)
+static enum gabor_method gabor_method = GABOR_DIRECT;
+
+void gabor_set_method(
+	enum gabor_method method
 )
 {
-	assert( plane );
+	gabor_method = method;
+}
 
-	float complex *ckern = 0;
-	int ckern_stride = sizeof(float complex);
+enum gabor_method gabor_get_method()
+{
+	return gabor_method;
+}
 
-	int size_y = bins;
+/**
+ * @brief Parameters of the kernel of a single bin, see @ref gabor_wavelet.
+ */
+struct gabor_bin {
+	float sigma;	///< std. deviation
+	float freq;	///< frequency in radians
+	float a;	///< scale
+};
 
-	for(int y = 0; y < size_y; y++)
+static
+void gabor_ft_bins(
+	struct gabor_bin *bin,
+	int bins,
+	float sigma
+)
+{
+	for(int y = 0; y < bins; y++)
 	{
-		float norm_y = y/(float)size_y;
-
-		// TF-plane
-		float *row = dwt_util_addr_coeff_s(
-			plane,
-			size_y-y-1,
-			0,
-			stride_x,
-			stride_y
-		);
+		bin[y].sigma = sigma;
+		bin[y].freq = y/(float)bins * 1.0f * (float)M_PI;
+		bin[y].a = 1.0f;
+	}
+}
 
-		// gen. kernel
-		float freq = norm_y * 1.0f * (float)M_PI;
-		float a = 1.0f;
+static
+void gabor_wt_bins(
+	struct gabor_bin *bin,
+	int bins,
+	float sigma,
+	float freq
+)
+{
+	for(int y = 0; y < bins; y++)
+	{
+		const float f = (y+1.f)/(float)bins * 0.5f * 2.f*(float)M_PI;
 
-		gabor_gen_kernel(&ckern, ckern_stride, sigma, freq, a);
+		bin[y].sigma = sigma;
+		bin[y].freq = freq;
+		bin[y].a = gabor_scale(freq, f);
+	}
+}
 
-		int kern_size = gaussian_size(sigma, a);
-		int kern_center = gaussian_center(sigma, a);
+static
+void gabor_st_bins(
+	struct gabor_bin *bin,
+	int bins
+)
+{
+	for(int y = 0; y < bins; y++)
+	{
+		// see s_gen_kernel
+		const float f = (y+1.f)/(float)bins * 0.5f;
 
-		// response
-		timefreq_line(row, stride_y, sig, sig_stride, sig_size, ckern, ckern_stride, kern_size, kern_center);
+		bin[y].sigma = s_sigma(f);
+		bin[y].freq = 2.f * (float)M_PI * f;
+		bin[y].a = 1.f;
 	}
-
-	free(ckern);
 }
 
-void gabor_ft_arg_s(
-	// input
-	const float *sig,	///< the analysed signal
-	int sig_stride,		///< the stride of the signal
-	int sig_size,		///< the length of the signal, the width of the plane
-	// output
-	void *plane,		///< put the plane here
-	int stride_x,		///< stride of rows of the plane
-	int stride_y,		///< stride of columns of the plane
-	int bins,		///< the height of the plane
-	// params
-	float sigma		///< std. deviation of the baseline kernel (implies the window size)
+/**
+ * @brief Spectrum of the kernel of the bin multiplied by the spectrum of the signal.
+ *
+ * The response is the correlation with the kernel, i.e. the product with the
+ * complex conjugate of the kernel spectrum. The spectrum of the Gabor atom is
+ * the Gaussian exp(-(a*omega-freq)^2/(4*alpha)), alpha = 1/(2*sigma^2). This
+ * closed form is used unless the envelope is too wide for the zero padding
+ * of the signal. Such a kernel is sampled and transformed instead.
+ */
+static
+void gabor_fft_bin(
+	const struct fft_plan_s *plan,
+	const float complex *sig,
+	float complex *dst,
+	int sig_size,
+	const struct gabor_bin *bin
 )
 {
-	assert( plane );
+	const int size = plan->size;
 
-	float complex *ckern = 0;
-	int ckern_stride = sizeof(float complex);
+	const int kern_size = gaussian_size(bin->sigma, bin->a);
+	const int kern_center = gaussian_center(bin->sigma, bin->a);
+
+	if( kern_size - kern_center - 1 <= size - sig_size && kern_center <= size - sig_size )
+	{
+		const float alpha = 1.f/2.f/bin->sigma/bin->sigma;
+
+		for(int k = 0; k < size; k++)
+		{
+			// (-pi; +pi]
+			const float omega = 2.f*(float)M_PI * (k <= size/2 ? k : k - size) / size;
 
-	int size_y = bins;
+			float spectrum = 0.f;
 
-	for(int y = 0; y < size_y; y++)
+			// the spectrum of the sampled kernel is periodic
+			for(int p = -1; p <= +1; p++)
+			{
+				const float d = bin->a * (omega + 2.f*(float)M_PI*p) - bin->freq;
+				const float e = d*d / (4.f*alpha);
+
+				if( e < 40.f )
+					spectrum += expf(-e);
+			}
+
+			dst[k] = sig[k] * spectrum;
+		}
+	}
+	else
 	{
-		float norm_y = y/(float)size_y;
+		for(int k = 0; k < size; k++)
+			dst[k] = 0.f;
 
-		// TF-plane
-		float *row = dwt_util_addr_coeff_s(
-			plane,
-			size_y-y-1,
-			0,
-			stride_x,
-			stride_y
-		);
+		// lags outside (-sig_size; +sig_size) do not meet the signal
+		const int left = min(kern_center, sig_size-1);
+		const int right = min(kern_size-kern_center-1, sig_size-1);
 
-		// gen. kernel
-		float freq = norm_y * 1.0f * (float)M_PI;
-		float a = 1.0f;
+		for(int m = -left; m <= right; m++)
+			dst[(m + size) % size] = gabor_wavelet(m, bin->sigma, bin->freq, bin->a);
 
-		gabor_gen_kernel(&ckern, ckern_stride, sigma, freq, a);
+		fft_cs(plan, dst, 0);
 
-		int kern_size = gaussian_size(sigma, a);
-		int kern_center = gaussian_center(sigma, a);
+		for(int k = 0; k < size; k++)
+		{
+			const float s_re = crealf(sig[k]), s_im = cimagf(sig[k]);
+			const float k_re = crealf(dst[k]), k_im = cimagf(dst[k]);
 
-		// response
-		timefreq_arg_line(row, stride_y, sig, sig_stride, sig_size, ckern, ckern_stride, kern_size, kern_center);
+			dst[k] = (s_re*k_re + s_im*k_im) + I * (s_im*k_re - s_re*k_im);
+		}
 	}
 
-	free(ckern);
+	fft_cs(plan, dst, 1);
 }
 
-// wavelet transform
-void gabor_wt_s(
-	// input
-	const float *sig,	///< the analysed signal
-	int sig_stride,		///< the stride of the signal
-	int sig_size,		///< the length of the signal, the width of the plane
-	// output
-	void *plane,		///< put the plane here
-	int stride_x,		///< stride of rows of the plane
-	int stride_y,		///< stride of columns of the plane
-	int bins,		///< the height of the plane
-	// params
-	float sigma,		///< std. deviation of the baseline kernel (implies the window size)
-	float freq		///< frequency of the baseline kernel, in radians
+/**
+ * @brief Time-frequency plane using the FFT.
+ *
+ * The signal is zero-padded to at least twice its length so that the
+ * circular correlation equals the linear one with the zero extension.
+ */
+static
+void gabor_fft_plane_s(
+	const float *sig,
+	int sig_stride,
+	int sig_size,
+	void *plane,
+	int stride_x,
+	int stride_y,
+	int bins,
+	const struct gabor_bin *bin,
+	int arg
 )
 {
-	assert( plane );
+	assert( sig_size > 0 );
 
-// 	dwt_util_log(LOG_DBG, "analytic wavelet: (sigma^2)*(eta^2) >> 1 = %f\n", sigma*sigma*freq*freq);
+	const struct fft_plan_s *plan = fft_plan_s(fft_size(2*sig_size));
 
+	if( !plan )
+		return;
+
+	const int size = plan->size;
+
+	float complex *spectrum = malloc(sizeof(float complex) * size);
+	float complex *response = malloc(sizeof(float complex) * size);
+
+	if( !spectrum || !response )
 	{
-		const float f = 1.f/(float)bins * 0.5f * 2.f * (float)M_PI;
-		const float a = gabor_scale(freq, f);
-		dwt_util_log(LOG_DBG, "min: kernel_size=%i scale=%f freq=%f\n",
-			gaussian_size(sigma, a), a, f);
-	}
-	{
-		const float f = 1.f * 0.5f * 2.f * (float)M_PI;
-		const float a = gabor_scale(freq, f);
-		dwt_util_log(LOG_DBG, "max: kernel_size=%i scale=%f freq=%f\n",
-			gaussian_size(sigma, a), a, f);
+		dwt_util_log(LOG_ERR, "%s: unable to allocate memory\n", __FUNCTION__);
+		free(spectrum);
+		free(response);
+		return;
 	}
 
-	float complex *ckern = 0;
-	int ckern_stride = sizeof(float complex);
+	for(int i = 0; i < size; i++)
+		spectrum[i] = i < sig_size ? *addr1_const_s(sig, i, sig_stride) : 0.f;
 
-	int size_y = bins;
+	fft_cs(plan, spectrum, 0);
 
-	for(int y = 0; y < size_y; y++)
+	for(int y = 0; y < bins; y++)
 	{
-		//float norm0_y = (y+0.f)/(float)size_y; // [0; 1)
-		float norm1_y = (y+1.f)/(float)size_y; // (0; 1]
-
-		// TF-plane
 		float *row = dwt_util_addr_coeff_s(
 			plane,
-			size_y-y-1,
+			bins-y-1,
 			0,
 			stride_x,
 			stride_y
 		);
 
-		// gen. kernel
-		float f = norm1_y * 0.5f * 2.f*(float)M_PI; // (0; +pi]
-		float a = gabor_scale(freq, f);
-
-// 		dwt_util_log(LOG_DBG, "y=%i, freq(a=%f) = %f, freq*a = %f\n", size_y-y-1, a, gabor_freq(freq, a), gabor_freq(freq, a)*a);
+		gabor_fft_bin(plan, spectrum, response, sig_size, &bin[y]);
 
-		gabor_gen_kernel(&ckern, ckern_stride, sigma, freq, a);
-
-		int kern_size = gaussian_size(sigma, a);
-		int kern_center = gaussian_center(sigma, a);
-
-		// response
-		timefreq_line(row, stride_y, sig, sig_stride, sig_size, ckern, ckern_stride, kern_size, kern_center);
+		for(int i = 0; i < sig_size; i++)
+			*addr1_s(row, i, stride_y) = arg ? cargf(response[i]) : cabsf(response[i]);
 	}
 
-	free(ckern);
+	free(spectrum);
+	free(response);
 }
 
-// S transform
-void gabor_st_s(
-	// input
-	const float *sig,	///< the analysed signal
-	int sig_stride,		///< the stride of the signal
-	int sig_size,		///< the length of the signal, the width of the plane
-	// output
-	void *plane,		///< put the plane here
-	int stride_x,		///< stride of rows of the plane
-	int stride_y,		///< stride of columns of the plane
-	int bins		///< the height of the plane
-	// no params
+/**
+ * @brief Young-van Vliet recursive Gaussian filter of a single bin.
+ *
+ * The response of the bin at the sample i is
+ * exp(+i*Omega*i) * sum_t sig[t] * exp(-i*Omega*t) * g(t-i), where
+ * Omega = freq/a and g is the Gaussian of the std. deviation sigma*a and of
+ * the unit area. The demodulated signal is smoothed by the causal and the
+ * anticausal recursion w[n] = B*x[n] + b1*w[n-1] + b2*w[n-2] + b3*w[n-3].
+ * The poles of the recursion approach one as 1-1/(6.5*sigma*a), the
+ * recursion thus runs in double precision.
+ */
+struct gabor_iir {
+	double B, b1, b2, b3;	///< the normalized coefficients of the recursion
+	double omega;		///< demodulation frequency in radians
+	double rot_re, rot_im;	///< exp(-i*Omega*n) for the next sample n
+	double step_re, step_im;///< exp(-i*Omega)
+	double w_re[3], w_im[3];///< the last outputs of the causal recursion
+	double *buff;		///< outputs of the causal recursion not returned yet, pairs of doubles
+};
+
+struct gabor_stream {
+	int bins;		///< the height of the plane
+	int arg;		///< the complex argument instead of the magnitude?
+	int block;		///< the anticausal recursion runs over two blocks
+	int filled;		///< the number of samples in the buffers
+	long emitted;		///< the number of columns returned
+	struct gabor_iir *bin;	///< the filters
+	double *back;		///< output of the anticausal recursion, pairs of doubles
+};
+
+/**
+ * @brief Is the window of the bin narrow enough for the recursive filters?
+ */
+static
+int gabor_iir_stable(
+	const struct gabor_bin *bin
 )
 {
-	assert( plane );
-
-	float complex *ckern = 0;
-	int ckern_stride = sizeof(float complex);
+	return bin->sigma * bin->a <= GABOR_IIR_SIGMA_MAX;
+}
 
-	int size_y = bins;
+static
+void gabor_iir_init(
+	struct gabor_iir *iir,
+	const struct gabor_bin *bin
+)
+{
+	// Young, van Vliet: Recursive implementation of the Gaussian filter, 1995
+	const double sigma = fmax((double)bin->sigma * bin->a, 0.5);
 
-	for(int y = 0; y < size_y; y++)
-	{
-		//float norm0_y = (y+0.f)/(float)size_y;
-		float norm1_y = (y+1.f)/(float)size_y;;
+	assert( sigma <= GABOR_IIR_SIGMA_MAX );
 
-		// TF-plane
-		float *row = dwt_util_addr_coeff_s(
-			plane,
-#if 1
-			size_y-y-1,
-#else
-			y,
-#endif
-			0,
-			stride_x,
-			stride_y
-		);
+	const double q = sigma >= 2.5
+		? 0.98711*sigma - 0.96330
+		: 3.97156 - 4.14554*sqrt(1. - 0.26891*sigma);
 
-		// frequencies (0; 0.5] => (0; pi]
-#if 1
-		float f = norm1_y * 0.5f;
-#else
-		float f = norm1_y;
-#endif
-		float a = 1.f;
-		float sigma = s_sigma(f);
+	// the coefficients from the poles of the filter (Young, van Vliet, van
+	// Ginkel, 2002), the rounded polynomials of the 1995 paper scatter the
+	// poles close to one for wide windows
+	const double m0 = 1.16680, m1 = 1.10783, m2 = 1.40586;
+	const double mm = m1*m1 + m2*m2;
 
-// 		dwt_util_log(LOG_DBG, "S transform: y=%i, freq = %f\n", y, f);
+	const double scale = (m0 + q) * (mm + 2.*m1*q + q*q);
 
-		s_gen_kernel(&ckern, ckern_stride, f);
+	iir->b1 = q * (2.*m0*m1 + mm + (2.*m0 + 4.*m1)*q + 3.*q*q) / scale;
+	iir->b2 = -q*q * (m0 + 2.*m1 + 3.*q) / scale;
+	iir->b3 = q*q*q / scale;
+	// 1 - (b1+b2+b3) without the cancellation
+	iir->B = m0 * mm / scale;
 
-		int kern_size = gaussian_size(sigma, a);
-		int kern_center = gaussian_center(sigma, a);
+	iir->omega = (double)bin->freq / bin->a;
+	iir->step_re = cos(iir->omega);
+	iir->step_im = -sin(iir->omega);
+}
 
-		// response
-		timefreq_line(row, stride_y, sig, sig_stride, sig_size, ckern, ckern_stride, kern_size, kern_center);
-	}
+static
+void gabor_iir_reset(
+	struct gabor_iir *iir
+)
+{
+	iir->rot_re = 1.;
+	iir->rot_im = 0.;
 
-	free(ckern);
+	for(int k = 0; k < 3; k++)
+		iir->w_re[k] = iir->w_im[k] = 0.;
 }
 
-void gabor_st_arg_s(
-	// input
-	const float *sig,	///< the analysed signal
-	int sig_stride,		///< the stride of the signal
-	int sig_size,		///< the length of the signal, the width of the plane
-	// output
-	void *plane,		///< put the plane here
-	int stride_x,		///< stride of rows of the plane
-	int stride_y,		///< stride of columns of the plane
-	int bins		///< the height of the plane
-	// no params
+/**
+ * @brief Demodulate and filter @p size samples by the causal recursion into the buffer.
+ *
+ * A NULL @p sig stands for zeros.
+ */
+static
+void gabor_iir_causal_s(
+	struct gabor_iir *iir,
+	double *restrict dst,
+	const float *sig,
+	int sig_stride,
+	int size
 )
 {
-	assert( plane );
+	const double B = iir->B, b1 = iir->b1, b2 = iir->b2, b3 = iir->b3;
 
-	float complex *ckern = 0;
-	int ckern_stride = sizeof(float complex);
+	double w1_re = iir->w_re[0], w2_re = iir->w_re[1], w3_re = iir->w_re[2];
+	double w1_im = iir->w_im[0], w2_im = iir->w_im[1], w3_im = iir->w_im[2];
 
-	int size_y = bins;
+	double rot_re = iir->rot_re, rot_im = iir->rot_im;
 
-	for(int y = 0; y < size_y; y++)
+	for(int n = 0; n < size; n++)
 	{
-		//float norm0_y = (y+0.f)/(float)size_y;
-		float norm1_y = (y+1.f)/(float)size_y;;
+		const double s = sig ? B * *addr1_const_s(sig, n, sig_stride) : 0.;
 
-		// TF-plane
-		float *row = dwt_util_addr_coeff_s(
-			plane,
-#if 1
-			size_y-y-1,
-#else
-			y,
-#endif
-			0,
-			stride_x,
-			stride_y
-		);
+		const double w_re = s * rot_re + b1*w1_re + b2*w2_re + b3*w3_re;
+		const double w_im = s * rot_im + b1*w1_im + b2*w2_im + b3*w3_im;
 
-		// frequencies (0; 0.5] => (0; pi]
-#if 1
-		float f = norm1_y * 0.5f;
-#else
-		float f = norm1_y;
-#endif
-		float a = 1.f;
-		float sigma = s_sigma(f);
+		dst[2*n+0] = w_re;
+		dst[2*n+1] = w_im;
 
-		s_gen_kernel(&ckern, ckern_stride, f);
+		w3_re = w2_re; w2_re = w1_re; w1_re = w_re;
+		w3_im = w2_im; w2_im = w1_im; w1_im = w_im;
 
-		int kern_size = gaussian_size(sigma, a);
-		int kern_center = gaussian_center(sigma, a);
+		const double t_re = rot_re * iir->step_re - rot_im * iir->step_im;
+		const double t_im = rot_re * iir->step_im + rot_im * iir->step_re;
 
-		// response
-		timefreq_arg_line(row, stride_y, sig, sig_stride, sig_size, ckern, ckern_stride, kern_size, kern_center);
+		rot_re = t_re;
+		rot_im = t_im;
 	}
 
-	free(ckern);
+	// keep the rotation on the unit circle
+	const double norm = 1. / sqrt(rot_re*rot_re + rot_im*rot_im);
+
+	iir->rot_re = rot_re * norm;
+	iir->rot_im = rot_im * norm;
+
+	iir->w_re[0] = w1_re; iir->w_re[1] = w2_re; iir->w_re[2] = w3_re;
+	iir->w_im[0] = w1_im; iir->w_im[1] = w2_im; iir->w_im[2] = w3_im;
 }
 
-void gabor_wt_arg_s(
-	// input
-	const float *sig,	///< the analysed signal
-	int sig_stride,		///< the stride of the signal
-	int sig_size,		///< the length of the signal, the width of the plane
-	// output
-	void *plane,		///< put the plane here
-	int stride_x,		///< stride of rows of the plane
-	int stride_y,		///< stride of columns of the plane
-	int bins,		///< the height of the plane
-	// params
-	float sigma,		///< std. deviation of the baseline kernel (implies the window size)
-	float freq		///< frequency of the baseline kernel, in radians
+/**
+ * @brief The anticausal recursion over @p size samples, from zero state.
+ */
+static
+void gabor_iir_anticausal_s(
+	const struct gabor_iir *iir,
+	double *restrict dst,
+	const double *restrict src,
+	int size
 )
 {
-	assert( plane );
+	const double B = iir->B, b1 = iir->b1, b2 = iir->b2, b3 = iir->b3;
 
-	float complex *ckern = 0;
-	int ckern_stride = sizeof(float complex);
+	double y1_re = 0., y2_re = 0., y3_re = 0.;
+	double y1_im = 0., y2_im = 0., y3_im = 0.;
 
-	int size_y = bins;
+	for(int n = size-1; n >= 0; n--)
+	{
+		const double y_re = B * src[2*n+0] + b1*y1_re + b2*y2_re + b3*y3_re;
+		const double y_im = B * src[2*n+1] + b1*y1_im + b2*y2_im + b3*y3_im;
 
-	for(int y = 0; y < size_y; y++)
+		dst[2*n+0] = y_re;
+		dst[2*n+1] = y_im;
+
+		y3_re = y2_re; y2_re = y1_re; y1_re = y_re;
+		y3_im = y2_im; y2_im = y1_im; y1_im = y_im;
+	}
+}
+
+/**
+ * @brief Return the first @p count of @p size buffered samples as the columns of the plane.
+ */
+static
+void gabor_stream_emit_s(
+	gabor_stream_t *stream,
+	int count,
+	int size,
+	void *plane,
+	int stride_x,
+	int stride_y
+)
+{
+	for(int y = 0; y < stream->bins; y++)
 	{
-		//float norm0_y = (y+0.f)/(float)size_y; // [0; 1)
-		float norm1_y = (y+1.f)/(float)size_y; // (0; 1]
+		struct gabor_iir *iir = &stream->bin[y];
 
-		// TF-plane
 		float *row = dwt_util_addr_coeff_s(
 			plane,
-			size_y-y-1,
+			stream->bins-y-1,
 			0,
 			stride_x,
 			stride_y
 		);
 
-		// gen. kernel
-		float f = norm1_y * 0.5f * 2.f*(float)M_PI; // (0; +pi]
-		float a = gabor_scale(freq, f);
+		gabor_iir_anticausal_s(iir, stream->back, iir->buff, size);
+
+		for(int i = 0; i < count; i++)
+		{
+			const double re = stream->back[2*i+0];
+			const double im = stream->back[2*i+1];
+
+			if( stream->arg )
+			{
+				// remodulate, exp(+i*Omega*n)
+				const double phi = fmod(iir->omega * (double)(stream->emitted + i), 2.*M_PI);
+
+				double arg = atan2(im, re) + phi;
 
-		gabor_gen_kernel(&ckern, ckern_stride, sigma, freq, a);
+				if( arg > M_PI )
+					arg -= 2.*M_PI;
 
-		int kern_size = gaussian_size(sigma, a);
-		int kern_center = gaussian_center(sigma, a);
+				*addr1_s(row, i, stride_y) = (float)arg;
+			}
+			else
+				*addr1_s(row, i, stride_y) = (float)sqrt(re*re + im*im);
+		}
 
-		// response
-		timefreq_arg_line(row, stride_y, sig, sig_stride, sig_size, ckern, ckern_stride, kern_size, kern_center);
+		for(int i = 0; i < 2*(size-count); i++)
+			iir->buff[i] = iir->buff[2*count+i];
 	}
 
-	free(ckern);
+	stream->filled = size - count;
+	stream->emitted += count;
 }
 
-void phase_derivative_s(
-	const void *angle,
-	void *derivative,
-	int stride_x,
-	int stride_y,
-	int size_x,
-	int size_y,
-	float limit
+static
+gabor_stream_t *gabor_stream_create(
+	const struct gabor_bin *bin,
+	int bins,
+	int arg
 )
 {
-	assert( limit > 0.f );
+	assert( bins > 0 );
 
-	for(int y = 0; y < size_y; y++)
+	for(int y = 0; y < bins; y++)
 	{
-		for(int x = 0; x < size_x; x++)
+		if( !gabor_iir_stable(&bin[y]) )
 		{
-			float *out = addr2_s(derivative, y, x, stride_x, stride_y);
-
-			if( 0 == x )
-			{
-				*out = 0.f;
-			}
-			else
-			{
-				*out =
-					- *addr2_const_s(angle, y, x-1, stride_x, stride_y)
-					+ *addr2_const_s(angle, y, x,   stride_x, stride_y);
-
-				while( *out > +limit )
-					*out -= 2.f*(float)M_PI;
-				while( *out < -limit )
-					*out += 2.f*(float)M_PI;
-			}
+			dwt_util_log(LOG_ERR, "%s: the window is too wide for the recursive filters\n", __FUNCTION__);
+			return NULL;
 		}
 	}
-}
 
-void detect_ridges1_s(
-	const void *magnitude,
-	void *ridges,
+	gabor_stream_t *stream = malloc(sizeof(gabor_stream_t));
+
+	if( !stream )
+		goto error;
+
+	stream->bins = bins;
+	stream->arg = arg;
+	stream->block = 8;
+	stream->filled = 0;
+
+	// the anticausal recursion starts a block beyond the last returned sample
+	for(int y = 0; y < bins; y++)
+		stream->block = max(stream->block, (int)ceilf(5.f * bin[y].sigma * bin[y].a));
+
+	stream->bin = malloc(sizeof(struct gabor_iir) * bins);
+	stream->back = malloc(sizeof(double) * 2 * 3 * stream->block);
+
+	if( !stream->bin || !stream->back )
+	{
+		free(stream->bin);
+		free(stream->back);
+		free(stream);
+		goto error;
+	}
+
+	for(int y = 0; y < bins; y++)
+	{
+		gabor_iir_init(&stream->bin[y], &bin[y]);
+
+		stream->bin[y].buff = malloc(sizeof(double) * 2 * 3 * stream->block);
+
+		if( !stream->bin[y].buff )
+		{
+			stream->bins = y;
+			gabor_stream_destroy(stream);
+			goto error;
+		}
+	}
+
+	gabor_stream_flush_s(stream, NULL, 0, 0);
+
+	return stream;
+
+error:
+	dwt_util_log(LOG_ERR, "%s: unable to allocate memory\n", __FUNCTION__);
+	return NULL;
+}
+
+gabor_stream_t *gabor_stream_ft_create_s(
+	int bins,
+	float sigma,
+	int arg
+)
+{
+	struct gabor_bin bin[bins];
+
+	gabor_ft_bins(bin, bins, sigma);
+
+	return gabor_stream_create(bin, bins, arg);
+}
+
+gabor_stream_t *gabor_stream_wt_create_s(
+	int bins,
+	float sigma,
+	float freq,
+	int arg
+)
+{
+	struct gabor_bin bin[bins];
+
+	gabor_wt_bins(bin, bins, sigma, freq);
+
+	return gabor_stream_create(bin, bins, arg);
+}
+
+gabor_stream_t *gabor_stream_st_create_s(
+	int bins,
+	int arg
+)
+{
+	struct gabor_bin bin[bins];
+
+	gabor_st_bins(bin, bins);
+
+	return gabor_stream_create(bin, bins, arg);
+}
+
+void gabor_stream_destroy(
+	gabor_stream_t *stream
+)
+{
+	if( !stream )
+		return;
+
+	for(int y = 0; y < stream->bins; y++)
+		free(stream->bin[y].buff);
+
+	free(stream->bin);
+	free(stream->back);
+	free(stream);
+}
+
+int gabor_stream_delay(
+	const gabor_stream_t *stream
+)
+{
+	assert( stream );
+
+	return 2 * stream->block;
+}
+
+int gabor_stream_push_s(
+	gabor_stream_t *stream,
+	const float *sig,
+	int sig_stride,
+	int size,
+	void *plane,
+	int stride_x,
+	int stride_y
+)
+{
+	assert( stream && sig && size >= 0 );
+
+	const int block = stream->block;
+
+	int columns = 0;
+
+	while( size > 0 )
+	{
+		const int n = min(size, 2*block - stream->filled);
+
+		for(int y = 0; y < stream->bins; y++)
+		{
+			struct gabor_iir *iir = &stream->bin[y];
+
+			gabor_iir_causal_s(iir, iir->buff + 2*stream->filled, sig, sig_stride, n);
+		}
+
+		stream->filled += n;
+		sig = addr1_const_s(sig, n, sig_stride);
+		size -= n;
+
+		if( stream->filled == 2*block )
+		{
+			assert( plane );
+
+			gabor_stream_emit_s(stream, block, 2*block, dwt_util_addr_coeff_s(plane, 0, columns, stride_x, stride_y), stride_x, stride_y);
+
+			columns += block;
+		}
+	}
+
+	return columns;
+}
+
+int gabor_stream_flush_s(
+	gabor_stream_t *stream,
+	void *plane,
+	int stride_x,
+	int stride_y
+)
+{
+	assert( stream );
+
+	const int block = stream->block;
+	const int columns = stream->filled;
+
+	if( columns )
+	{
+		assert( plane );
+
+		// the causal recursion continues beyond the end of the signal
+		for(int y = 0; y < stream->bins; y++)
+		{
+			struct gabor_iir *iir = &stream->bin[y];
+
+			gabor_iir_causal_s(iir, iir->buff + 2*columns, NULL, 0, block);
+		}
+
+		gabor_stream_emit_s(stream, columns, columns + block, plane, stride_x, stride_y);
+	}
+
+	for(int y = 0; y < stream->bins; y++)
+		gabor_iir_reset(&stream->bin[y]);
+
+	stream->filled = 0;
+	stream->emitted = 0;
+
+	return columns;
+}
+
+/**
+ * @brief Time-frequency plane using the recursive filters.
+ */
+static
+void gabor_iir_plane_s(
+	const float *sig,
+	int sig_stride,
+	int sig_size,
+	void *plane,
+	int stride_x,
+	int stride_y,
+	int bins,
+	const struct gabor_bin *bin,
+	int arg
+)
+{
+	gabor_stream_t *stream = gabor_stream_create(bin, bins, arg);
+
+	if( !stream )
+		return;
+
+	const int columns = gabor_stream_push_s(stream, sig, sig_stride, sig_size, plane, stride_x, stride_y);
+
+	gabor_stream_flush_s(stream, dwt_util_addr_coeff_s(plane, 0, columns, stride_x, stride_y), stride_x, stride_y);
+
+	gabor_stream_destroy(stream);
+}
+
+/**
+ * @brief Time-frequency plane using the method set by @ref gabor_set_method.
+ */
+static
+void gabor_plane_s(
+	const float *sig,
+	int sig_stride,
+	int sig_size,
+	void *plane,
+	int stride_x,
+	int stride_y,
+	int bins,
+	const struct gabor_bin *bin,
+	int arg
+)
+{
+	if( GABOR_IIR != gabor_get_method() )
+	{
+		gabor_fft_plane_s(sig, sig_stride, sig_size, plane, stride_x, stride_y, bins, bin, arg);
+
+		return;
+	}
+
+	// the runs of the bins too wide for the recursive filters use the FFT
+	for(int y0 = 0, y1; y0 < bins; y0 = y1)
+	{
+		const int iir = gabor_iir_stable(&bin[y0]);
+
+		for(y1 = y0+1; y1 < bins && gabor_iir_stable(&bin[y1]) == iir; y1++)
+			;
+
+		// the bin y is stored in the row bins-y-1
+		void *rows = dwt_util_addr_coeff_s(plane, bins-y1, 0, stride_x, stride_y);
+
+		if( iir )
+			gabor_iir_plane_s(sig, sig_stride, sig_size, rows, stride_x, stride_y, y1-y0, bin+y0, arg);
+		else
+			gabor_fft_plane_s(sig, sig_stride, sig_size, rows, stride_x, stride_y, y1-y0, bin+y0, arg);
+	}
+}
+
+/**
+ * @brief The kernel of a single bin, real and imaginary parts apart.
+ */
+struct gabor_analyzer_kern {
+	int size;		///< the number of samples
+	int center;		///< the index of the sample at the time zero
+	float *re;		///< real parts
+	float *im;		///< imaginary parts
+};
+
+/**
+ * @brief The history of the signal is kept in a linear buffer.
+ *
+ * The sample n is stored at hist[n-base]. The buffer holds the samples
+ * needed by the next column (left, zero before the signal) up to the last
+ * pushed one. It has a room for another window of samples so the history is
+ * moved once per window.
+ */
+struct gabor_analyzer {
+	int bins;			///< the height of the plane
+	int arg;			///< the complex argument instead of the magnitude?
+	int left;			///< the longest left half of the kernels
+	int right;			///< the longest right half of the kernels
+	int capacity;			///< the size of the buffer
+	long base;			///< index of the first sample in the buffer
+	long pushed;			///< the number of samples pushed
+	long emitted;			///< the number of columns returned
+	float *hist;			///< the history of the signal
+	struct gabor_analyzer_kern *kern;	///< the kernels
+};
+
+static
+gabor_analyzer_t *gabor_analyzer_alloc(
+	int bins,
+	int arg
+)
+{
+	assert( bins > 0 );
+
+	gabor_analyzer_t *analyzer = malloc(sizeof(gabor_analyzer_t));
+
+	if( !analyzer )
+		return NULL;
+
+	analyzer->bins = bins;
+	analyzer->arg = arg;
+	analyzer->pushed = 0;
+	analyzer->emitted = 0;
+	analyzer->hist = NULL;
+	analyzer->kern = calloc(bins, sizeof(struct gabor_analyzer_kern));
+
+	if( !analyzer->kern )
+	{
+		free(analyzer);
+		return NULL;
+	}
+
+	return analyzer;
+}
+
+/**
+ * @brief Store the kernel of the bin @p y, see @ref gabor_gen_kernel.
+ */
+static
+int gabor_analyzer_kernel(
+	gabor_analyzer_t *analyzer,
+	int y,
+	const float complex *ckern,
+	int size,
+	int center
+)
+{
+	struct gabor_analyzer_kern *kern = &analyzer->kern[y];
+
+	kern->size = size;
+	kern->center = center;
+	kern->re = malloc(sizeof(float) * size);
+	kern->im = malloc(sizeof(float) * size);
+
+	if( !kern->re || !kern->im )
+		return -1;
+
+	for(int i = 0; i < size; i++)
+	{
+		kern->re[i] = crealf(ckern[i]);
+		kern->im[i] = cimagf(ckern[i]);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Allocate the history once all the kernels are known.
+ */
+static
+gabor_analyzer_t *gabor_analyzer_init(
+	gabor_analyzer_t *analyzer
+)
+{
+	analyzer->left = 0;
+	analyzer->right = 0;
+
+	for(int y = 0; y < analyzer->bins; y++)
+	{
+		analyzer->left = max(analyzer->left, analyzer->kern[y].center);
+		analyzer->right = max(analyzer->right, analyzer->kern[y].size - analyzer->kern[y].center - 1);
+	}
+
+	analyzer->capacity = 2 * (analyzer->left + analyzer->right + 1);
+	analyzer->hist = malloc(sizeof(float) * analyzer->capacity);
+
+	if( !analyzer->hist )
+	{
+		dwt_util_log(LOG_ERR, "%s: unable to allocate memory\n", __FUNCTION__);
+		gabor_analyzer_destroy(analyzer);
+		return NULL;
+	}
+
+	gabor_analyzer_flush_s(analyzer, NULL, 0, 0);
+
+	return analyzer;
+}
+
+static
+gabor_analyzer_t *gabor_analyzer_create(
+	const struct gabor_bin *bin,
+	int bins,
+	int arg
+)
+{
+	gabor_analyzer_t *analyzer = gabor_analyzer_alloc(bins, arg);
+
+	if( !analyzer )
+	{
+		dwt_util_log(LOG_ERR, "%s: unable to allocate memory\n", __FUNCTION__);
+		return NULL;
+	}
+
+	float complex *ckern = 0;
+	int ckern_stride = sizeof(float complex);
+
+	for(int y = 0; y < bins; y++)
+	{
+		gabor_gen_kernel(&ckern, ckern_stride, bin[y].sigma, bin[y].freq, bin[y].a);
+
+		if( gabor_analyzer_kernel(analyzer, y, ckern, gaussian_size(bin[y].sigma, bin[y].a), gaussian_center(bin[y].sigma, bin[y].a)) )
+		{
+			dwt_util_log(LOG_ERR, "%s: unable to allocate memory\n", __FUNCTION__);
+			free(ckern);
+			gabor_analyzer_destroy(analyzer);
+			return NULL;
+		}
+	}
+
+	free(ckern);
+
+	return gabor_analyzer_init(analyzer);
+}
+
+gabor_analyzer_t *gabor_analyzer_ft_create_s(
+	int bins,
+	float sigma,
+	int arg
+)
+{
+	struct gabor_bin bin[bins];
+
+	gabor_ft_bins(bin, bins, sigma);
+
+	return gabor_analyzer_create(bin, bins, arg);
+}
+
+gabor_analyzer_t *gabor_analyzer_wt_create_s(
+	int bins,
+	float sigma,
+	float freq,
+	int arg
+)
+{
+	struct gabor_bin bin[bins];
+
+	gabor_wt_bins(bin, bins, sigma, freq);
+
+	return gabor_analyzer_create(bin, bins, arg);
+}
+
+gabor_analyzer_t *gabor_analyzer_st_create_s(
+	int bins,
+	int arg
+)
+{
+	gabor_analyzer_t *analyzer = gabor_analyzer_alloc(bins, arg);
+
+	if( !analyzer )
+	{
+		dwt_util_log(LOG_ERR, "%s: unable to allocate memory\n", __FUNCTION__);
+		return NULL;
+	}
+
+	float complex *ckern = 0;
+	int ckern_stride = sizeof(float complex);
+
+	for(int y = 0; y < bins; y++)
+	{
+		// see gabor_st_s
+		const float f = (y+1.f)/(float)bins * 0.5f;
+		const float sigma = s_sigma(f);
+
+		s_gen_kernel(&ckern, ckern_stride, f);
+
+		if( gabor_analyzer_kernel(analyzer, y, ckern, gaussian_size(sigma, 1.f), gaussian_center(sigma, 1.f)) )
+		{
+			dwt_util_log(LOG_ERR, "%s: unable to allocate memory\n", __FUNCTION__);
+			free(ckern);
+			gabor_analyzer_destroy(analyzer);
+			return NULL;
+		}
+	}
+
+	free(ckern);
+
+	return gabor_analyzer_init(analyzer);
+}
+
+void gabor_analyzer_destroy(
+	gabor_analyzer_t *analyzer
+)
+{
+	if( !analyzer )
+		return;
+
+	for(int y = 0; y < analyzer->bins; y++)
+	{
+		free(analyzer->kern[y].re);
+		free(analyzer->kern[y].im);
+	}
+
+	free(analyzer->kern);
+	free(analyzer->hist);
+	free(analyzer);
+}
+
+int gabor_analyzer_delay(
+	const gabor_analyzer_t *analyzer
+)
+{
+	assert( analyzer );
+
+	return analyzer->right;
+}
+
+/**
+ * @brief Correlation of @p size samples with the kernel, sig * conj(kern).
+ *
+ * The real and imaginary parts are kept apart so that four products of each
+ * are summed at once.
+ */
+static
+void gabor_kern_dot_s(
+	const float *restrict s,
+	const float *restrict k_re,
+	const float *restrict k_im,
+	int size,
+	float *re,
+	float *im
+)
+{
+	int k = 0;
+
+	float sum_re = 0.f;
+	float sum_im = 0.f;
+
+#ifdef __SSE__
+	__m128 acc_re = _mm_setzero_ps();
+	__m128 acc_im = _mm_setzero_ps();
+
+	for(; k+4 <= size; k += 4)
+	{
+		const __m128 x = _mm_loadu_ps(s + k);
+
+		acc_re = _mm_add_ps(acc_re, _mm_mul_ps(x, _mm_loadu_ps(k_re + k)));
+		acc_im = _mm_add_ps(acc_im, _mm_mul_ps(x, _mm_loadu_ps(k_im + k)));
+	}
+
+	float part_re[4], part_im[4];
+
+	_mm_storeu_ps(part_re, acc_re);
+	_mm_storeu_ps(part_im, acc_im);
+
+	sum_re = (part_re[0] + part_re[1]) + (part_re[2] + part_re[3]);
+	sum_im = (part_im[0] + part_im[1]) + (part_im[2] + part_im[3]);
+#endif
+
+	for(; k < size; k++)
+	{
+		sum_re += s[k] * k_re[k];
+		sum_im += s[k] * k_im[k];
+	}
+
+	*re = +sum_re;
+	*im = -sum_im;
+}
+
+/**
+ * @brief Columns of the plane computed from a history of the signal.
+ *
+ * The sample of the first column is at hist[left].
+ */
+struct gabor_kern_job {
+	const gabor_analyzer_t *analyzer;
+	const float *hist;	///< the samples, zero outside of the signal
+	int columns;		///< the number of columns
+	void *plane;		///< the first column
+	int stride_x;		///< stride of rows of the plane
+	int stride_y;		///< stride of columns of the plane
+};
+
+/**
+ * @brief A single bin, i.e. a row of the plane.
+ */
+static
+void gabor_kern_tile_s(
+	void *arg,
+	int y,
+	int thread
+)
+{
+	const struct gabor_kern_job *job = arg;
+	const gabor_analyzer_t *analyzer = job->analyzer;
+	const struct gabor_analyzer_kern *kern = &analyzer->kern[y];
+
+	UNUSED(thread);
+
+	float *row = dwt_util_addr_coeff_s(
+		job->plane,
+		analyzer->bins-y-1,
+		0,
+		job->stride_x,
+		job->stride_y
+	);
+
+	// the samples under the kernel of the first column
+	const float *s = job->hist + (analyzer->left - kern->center);
+
+	for(int i = 0; i < job->columns; i++)
+	{
+		float re, im;
+
+		gabor_kern_dot_s(s + i, kern->re, kern->im, kern->size, &re, &im);
+
+		*addr1_s(row, i, job->stride_y) = analyzer->arg
+			? atan2f(im, re)
+			: sqrtf(re*re + im*im);
+	}
+}
+
+/**
+ * @brief Return the columns up to the sample @p end (exclusive).
+ *
+ * The bins are distributed over the thread pool.
+ */
+static
+int gabor_analyzer_emit_s(
+	gabor_analyzer_t *analyzer,
+	long end,
+	void *plane,
+	int stride_x,
+	int stride_y
+)
+{
+	const int columns = (int)(end - analyzer->emitted);
+
+	// the history starts with the left half of the longest kernel
+	assert( analyzer->base == analyzer->emitted - analyzer->left );
+
+	struct gabor_kern_job job = { analyzer, analyzer->hist, columns, plane, stride_x, stride_y };
+
+	dwt_pool_run(analyzer->bins, gabor_kern_tile_s, &job);
+
+	analyzer->emitted = end;
+
+	// drop the samples not needed anymore
+	const long base = analyzer->emitted - analyzer->left;
+	const int keep = (int)(analyzer->pushed - base);
+
+	for(int i = 0; i < keep; i++)
+		analyzer->hist[i] = analyzer->hist[base - analyzer->base + i];
+
+	analyzer->base = base;
+
+	return columns;
+}
+
+int gabor_analyzer_push_s(
+	gabor_analyzer_t *analyzer,
+	const float *sig,
+	int sig_stride,
+	int size,
+	void *plane,
+	int stride_x,
+	int stride_y
+)
+{
+	assert( analyzer && sig && size >= 0 );
+
+	int columns = 0;
+
+	while( size > 0 )
+	{
+		const int n = min(size, analyzer->capacity - (int)(analyzer->pushed - analyzer->base));
+
+		for(int i = 0; i < n; i++)
+			analyzer->hist[analyzer->pushed - analyzer->base + i] = *addr1_const_s(sig, i, sig_stride);
+
+		analyzer->pushed += n;
+		sig = addr1_const_s(sig, n, sig_stride);
+		size -= n;
+
+		const long end = analyzer->pushed - analyzer->right;
+
+		if( end > analyzer->emitted )
+		{
+			assert( plane );
+
+			columns += gabor_analyzer_emit_s(analyzer, end, dwt_util_addr_coeff_s(plane, 0, columns, stride_x, stride_y), stride_x, stride_y);
+		}
+	}
+
+	return columns;
+}
+
+int gabor_analyzer_flush_s(
+	gabor_analyzer_t *analyzer,
+	void *plane,
+	int stride_x,
+	int stride_y
+)
+{
+	assert( analyzer );
+
+	int columns = 0;
+
+	const long end = analyzer->pushed;
+
+	if( end > analyzer->emitted )
+	{
+		assert( plane );
+
+		// the signal is zero beyond its end
+		for(int i = 0; i < analyzer->right; i++)
+			analyzer->hist[analyzer->pushed - analyzer->base + i] = 0.f;
+
+		analyzer->pushed += analyzer->right;
+
+		columns = gabor_analyzer_emit_s(analyzer, end, plane, stride_x, stride_y);
+	}
+
+	// the signal is zero before its beginning
+	analyzer->base = -analyzer->left;
+	analyzer->pushed = 0;
+	analyzer->emitted = 0;
+
+	for(int i = 0; i < analyzer->left; i++)
+		analyzer->hist[i] = 0.f;
+
+	return columns;
+}
+
+/**
+ * @brief The whole plane of the direct method.
+ *
+ * The signal is copied between two runs of zeros, the bins are distributed
+ * over the thread pool.
+ */
+static
+void gabor_analyzer_plane_s(
+	const gabor_analyzer_t *analyzer,
+	const float *sig,
+	int sig_stride,
+	int sig_size,
+	void *plane,
+	int stride_x,
+	int stride_y
+)
+{
+	const int size = analyzer->left + sig_size + analyzer->right;
+
+	float *hist = malloc(sizeof(float) * size);
+
+	if( !hist )
+	{
+		dwt_util_log(LOG_ERR, "%s: unable to allocate memory\n", __FUNCTION__);
+		return;
+	}
+
+	for(int i = 0; i < size; i++)
+	{
+		const int n = i - analyzer->left;
+
+		hist[i] = (n >= 0 && n < sig_size) ? *addr1_const_s(sig, n, sig_stride) : 0.f;
+	}
+
+	struct gabor_kern_job job = { analyzer, hist, sig_size, plane, stride_x, stride_y };
+
+	dwt_pool_run(analyzer->bins, gabor_kern_tile_s, &job);
+
+	free(hist);
+}
+
+void gabor_ft_s(
+	// input
+	const float *sig,	///< the analysed signal
+	int sig_stride,		///< the stride of the signal
+	int sig_size,		///< the length of the signal, the width of the plane
+	// output
+	void *plane,		///< put the plane here
+	int stride_x,		///< stride of rows of the plane
+	int stride_y,		///< stride of columns of the plane
+	int bins,		///< the height of the plane
+	// params
+	float sigma		///< std. deviation of the baseline kernel (implies the window size)
+)
+{
+	assert( plane );
+
+	if( GABOR_DIRECT != gabor_get_method() )
+	{
+		struct gabor_bin bin[bins];
+
+		gabor_ft_bins(bin, bins, sigma);
+
+		gabor_plane_s(sig, sig_stride, sig_size, plane, stride_x, stride_y, bins, bin, 0);
+
+		return;
+	}
+
+	gabor_analyzer_t *analyzer = gabor_analyzer_ft_create_s(bins, sigma, 0);
+
+	if( !analyzer )
+		return;
+
+	gabor_analyzer_plane_s(analyzer, sig, sig_stride, sig_size, plane, stride_x, stride_y);
+
+	gabor_analyzer_destroy(analyzer);
+}
+
+void gabor_ft_arg_s(
+	// input
+	const float *sig,	///< the analysed signal
+	int sig_stride,		///< the stride of the signal
+	int sig_size,		///< the length of the signal, the width of the plane
+	// output
+	void *plane,		///< put the plane here
+	int stride_x,		///< stride of rows of the plane
+	int stride_y,		///< stride of columns of the plane
+	int bins,		///< the height of the plane
+	// params
+	float sigma		///< std. deviation of the baseline kernel (implies the window size)
+)
+{
+	assert( plane );
+
+	if( GABOR_DIRECT != gabor_get_method() )
+	{
+		struct gabor_bin bin[bins];
+
+		gabor_ft_bins(bin, bins, sigma);
+
+		gabor_plane_s(sig, sig_stride, sig_size, plane, stride_x, stride_y, bins, bin, 1);
+
+		return;
+	}
+
+	gabor_analyzer_t *analyzer = gabor_analyzer_ft_create_s(bins, sigma, 1);
+
+	if( !analyzer )
+		return;
+
+	gabor_analyzer_plane_s(analyzer, sig, sig_stride, sig_size, plane, stride_x, stride_y);
+
+	gabor_analyzer_destroy(analyzer);
+}
+
+// wavelet transform
+void gabor_wt_s(
+	// input
+	const float *sig,	///< the analysed signal
+	int sig_stride,		///< the stride of the signal
+	int sig_size,		///< the length of the signal, the width of the plane
+	// output
+	void *plane,		///< put the plane here
+	int stride_x,		///< stride of rows of the plane
+	int stride_y,		///< stride of columns of the plane
+	int bins,		///< the height of the plane
+	// params
+	float sigma,		///< std. deviation of the baseline kernel (implies the window size)
+	float freq		///< frequency of the baseline kernel, in radians
+)
+{
+	assert( plane );
+
+	if( GABOR_DIRECT != gabor_get_method() )
+	{
+		struct gabor_bin bin[bins];
+
+		gabor_wt_bins(bin, bins, sigma, freq);
+
+		gabor_plane_s(sig, sig_stride, sig_size, plane, stride_x, stride_y, bins, bin, 0);
+
+		return;
+	}
+
+	gabor_analyzer_t *analyzer = gabor_analyzer_wt_create_s(bins, sigma, freq, 0);
+
+	if( !analyzer )
+		return;
+
+	gabor_analyzer_plane_s(analyzer, sig, sig_stride, sig_size, plane, stride_x, stride_y);
+
+	gabor_analyzer_destroy(analyzer);
+}
+
+// S transform
+void gabor_st_s(
+	// input
+	const float *sig,	///< the analysed signal
+	int sig_stride,		///< the stride of the signal
+	int sig_size,		///< the length of the signal, the width of the plane
+	// output
+	void *plane,		///< put the plane here
+	int stride_x,		///< stride of rows of the plane
+	int stride_y,		///< stride of columns of the plane
+	int bins		///< the height of the plane
+	// no params
+)
+{
+	assert( plane );
+
+	if( GABOR_DIRECT != gabor_get_method() )
+	{
+		struct gabor_bin bin[bins];
+
+		gabor_st_bins(bin, bins);
+
+		gabor_plane_s(sig, sig_stride, sig_size, plane, stride_x, stride_y, bins, bin, 0);
+
+		return;
+	}
+
+	gabor_analyzer_t *analyzer = gabor_analyzer_st_create_s(bins, 0);
+
+	if( !analyzer )
+		return;
+
+	gabor_analyzer_plane_s(analyzer, sig, sig_stride, sig_size, plane, stride_x, stride_y);
+
+	gabor_analyzer_destroy(analyzer);
+}
+
+void gabor_st_arg_s(
+	// input
+	const float *sig,	///< the analysed signal
+	int sig_stride,		///< the stride of the signal
+	int sig_size,		///< the length of the signal, the width of the plane
+	// output
+	void *plane,		///< put the plane here
+	int stride_x,		///< stride of rows of the plane
+	int stride_y,		///< stride of columns of the plane
+	int bins		///< the height of the plane
+	// no params
+)
+{
+	assert( plane );
+
+	if( GABOR_DIRECT != gabor_get_method() )
+	{
+		struct gabor_bin bin[bins];
+
+		gabor_st_bins(bin, bins);
+
+		gabor_plane_s(sig, sig_stride, sig_size, plane, stride_x, stride_y, bins, bin, 1);
+
+		return;
+	}
+
+	gabor_analyzer_t *analyzer = gabor_analyzer_st_create_s(bins, 1);
+
+	if( !analyzer )
+		return;
+
+	gabor_analyzer_plane_s(analyzer, sig, sig_stride, sig_size, plane, stride_x, stride_y);
+
+	gabor_analyzer_destroy(analyzer);
+}
+
+void gabor_wt_arg_s(
+	// input
+	const float *sig,	///< the analysed signal
+	int sig_stride,		///< the stride of the signal
+	int sig_size,		///< the length of the signal, the width of the plane
+	// output
+	void *plane,		///< put the plane here
+	int stride_x,		///< stride of rows of the plane
+	int stride_y,		///< stride of columns of the plane
+	int bins,		///< the height of the plane
+	// params
+	float sigma,		///< std. deviation of the baseline kernel (implies the window size)
+	float freq		///< frequency of the baseline kernel, in radians
+)
+{
+	assert( plane );
+
+	if( GABOR_DIRECT != gabor_get_method() )
+	{
+		struct gabor_bin bin[bins];
+
+		gabor_wt_bins(bin, bins, sigma, freq);
+
+		gabor_plane_s(sig, sig_stride, sig_size, plane, stride_x, stride_y, bins, bin, 1);
+
+		return;
+	}
+
+	gabor_analyzer_t *analyzer = gabor_analyzer_wt_create_s(bins, sigma, freq, 1);
+
+	if( !analyzer )
+		return;
+
+	gabor_analyzer_plane_s(analyzer, sig, sig_stride, sig_size, plane, stride_x, stride_y);
+
+	gabor_analyzer_destroy(analyzer);
+}
+
+
+// the number of rows of the plane in a single tile of the pool
+#define GABOR_TILE_ROWS 16
+
+/**
+ * @brief A pass over the rows of a plane.
+ */
+struct gabor_rows_job {
+	const void *src;	///< the input plane
+	void *dst;		///< the output plane
+	int stride_x;		///< stride of rows
+	int stride_y;		///< stride of columns
+	int size_x;		///< width of the planes
+	int size_y;		///< height of the planes
+	float param;		///< the limit or the threshold
+};
+
+static
+void gabor_rows_run(
+	struct gabor_rows_job *job,
+	dwt_pool_tile_func_t func
+)
+{
+	dwt_pool_run(ceil_div(job->size_y, GABOR_TILE_ROWS), func, job);
+}
+
+static
+void phase_derivative_tile_s(
+	void *arg,
+	int tile,
+	int thread
+)
+{
+	const struct gabor_rows_job *job = arg;
+
+	UNUSED(thread);
+
+	const void *angle = job->src;
+	void *derivative = job->dst;
+	const int stride_x = job->stride_x;
+	const int stride_y = job->stride_y;
+	const int size_x = job->size_x;
+	const int size_y = job->size_y;
+	const float limit = job->param;
+
+	const int begin = tile * GABOR_TILE_ROWS;
+	const int end = min(begin + GABOR_TILE_ROWS, size_y);
+
+	for(int y = begin; y < end; y++)
+	{
+		for(int x = 0; x < size_x; x++)
+		{
+			float *out = addr2_s(derivative, y, x, stride_x, stride_y);
+
+			if( 0 == x )
+			{
+				*out = 0.f;
+			}
+			else
+			{
+				*out =
+					- *addr2_const_s(angle, y, x-1, stride_x, stride_y)
+					+ *addr2_const_s(angle, y, x,   stride_x, stride_y);
+
+				while( *out > +limit )
+					*out -= 2.f*(float)M_PI;
+				while( *out < -limit )
+					*out += 2.f*(float)M_PI;
+			}
+		}
+	}
+}
+
+void phase_derivative_s(
+	const void *angle,
+	void *derivative,
 	int stride_x,
 	int stride_y,
 	int size_x,
 	int size_y,
-	float threshold
+	float limit
 )
 {
-	for(int y = 0; y < size_y; y++)
+	assert( limit > 0.f );
+
+	struct gabor_rows_job job = { angle, derivative, stride_x, stride_y, size_x, size_y, limit };
+
+	gabor_rows_run(&job, phase_derivative_tile_s);
+}
+
+static
+void detect_ridges1_tile_s(
+	void *arg,
+	int tile,
+	int thread
+)
+{
+	const struct gabor_rows_job *job = arg;
+
+	UNUSED(thread);
+
+	const void *magnitude = job->src;
+	void *ridges = job->dst;
+	const int stride_x = job->stride_x;
+	const int stride_y = job->stride_y;
+	const int size_x = job->size_x;
+	const int size_y = job->size_y;
+	const float threshold = job->param;
+
+	const int begin = tile * GABOR_TILE_ROWS;
+	const int end = min(begin + GABOR_TILE_ROWS, size_y);
+
+	for(int y = begin; y < end; y++)
 	{
 		for(int x = 0; x < size_x; x++)
 		{
@@ -952,8 +2124,8 @@ void detect_ridges1_s(
 	}
 }
 
-void detect_ridges2_s(
-	const void *inst_freq,
+void detect_ridges1_s(
+	const void *magnitude,
 	void *ridges,
 	int stride_x,
 	int stride_y,
@@ -962,7 +2134,34 @@ void detect_ridges2_s(
 	float threshold
 )
 {
-	for(int y = 0; y < size_y; y++)
+	struct gabor_rows_job job = { magnitude, ridges, stride_x, stride_y, size_x, size_y, threshold };
+
+	gabor_rows_run(&job, detect_ridges1_tile_s);
+}
+
+static
+void detect_ridges2_tile_s(
+	void *arg,
+	int tile,
+	int thread
+)
+{
+	const struct gabor_rows_job *job = arg;
+
+	UNUSED(thread);
+
+	const void *inst_freq = job->src;
+	void *ridges = job->dst;
+	const int stride_x = job->stride_x;
+	const int stride_y = job->stride_y;
+	const int size_x = job->size_x;
+	const int size_y = job->size_y;
+	const float threshold = job->param;
+
+	const int begin = tile * GABOR_TILE_ROWS;
+	const int end = min(begin + GABOR_TILE_ROWS, size_y);
+
+	for(int y = begin; y < end; y++)
 	{
 		for(int x = 0; x < size_x; x++)
 		{
@@ -988,6 +2187,21 @@ void detect_ridges2_s(
 	}
 }
 
+void detect_ridges2_s(
+	const void *inst_freq,
+	void *ridges,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y,
+	float threshold
+)
+{
+	struct gabor_rows_job job = { inst_freq, ridges, stride_x, stride_y, size_x, size_y, threshold };
+
+	gabor_rows_run(&job, detect_ridges2_tile_s);
+}
+
 // difference of two samples
 float coeff_diff_s(
 	const void *ptr,
@@ -1108,17 +2322,29 @@ int grad_max_s(
 	return this >= next;
 }
 
-void detect_ridges3_s(
-	const void *magnitude,
-	void *ridges,
-	int stride_x,
-	int stride_y,
-	int size_x,
-	int size_y,
-	float threshold
+static
+void detect_ridges3_tile_s(
+	void *arg,
+	int tile,
+	int thread
 )
 {
-	for(int y = 0; y < size_y; y++)
+	const struct gabor_rows_job *job = arg;
+
+	UNUSED(thread);
+
+	const void *magnitude = job->src;
+	void *ridges = job->dst;
+	const int stride_x = job->stride_x;
+	const int stride_y = job->stride_y;
+	const int size_x = job->size_x;
+	const int size_y = job->size_y;
+	const float threshold = job->param;
+
+	const int begin = tile * GABOR_TILE_ROWS;
+	const int end = min(begin + GABOR_TILE_ROWS, size_y);
+
+	for(int y = begin; y < end; y++)
 	{
 		for(int x = 0; x < size_x; x++)
 		{
@@ -1151,3 +2377,18 @@ void detect_ridges3_s(
 		}
 	}
 }
+
+void detect_ridges3_s(
+	const void *magnitude,
+	void *ridges,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y,
+	float threshold
+)
+{
+	struct gabor_rows_job job = { magnitude, ridges, stride_x, stride_y, size_x, size_y, threshold };
+
+	gabor_rows_run(&job, detect_ridges3_tile_s);
+}
@@ -3,6 +3,43 @@
 
 #include <complex.h>
 
+/**
+ * @brief How the time-frequency planes are evaluated.
+ */
+enum gabor_method {
+	GABOR_DIRECT,	///< a dot product for each sample of the plane, O(size*bins*kernel_size)
+	GABOR_FFT,	///< a multiplication in the frequency domain, O(bins*size*log(size))
+	GABOR_IIR	///< recursive Gaussian filters, O(bins*size), see @ref gabor_stream_push_s
+};
+
+/**
+ * @brief The widest window (std. deviation times the scale) of the @ref GABOR_IIR method.
+ *
+ * The bins of wider windows are evaluated by the @ref GABOR_FFT method.
+ */
+#define GABOR_IIR_SIGMA_MAX 2048.f
+
+/**
+ * @brief Select the method used by @ref gabor_ft_s, @ref gabor_wt_s, @ref gabor_st_s and their complex argument counterparts.
+ *
+ * The default is @ref GABOR_DIRECT. The @ref GABOR_FFT method computes the
+ * spectrum of the signal once and then a single inverse FFT for each bin.
+ * The @ref GABOR_IIR method approximates the Gaussian window by recursive
+ * filters, the cost per sample does not depend on the window size. The
+ * approximation is good for windows of several samples (std. deviation);
+ * the stopband of narrower windows is noticeably worse. The windows wider
+ * than @ref GABOR_IIR_SIGMA_MAX fall back to the FFT. All the
+ * methods treat the signal as zero outside of its bounds.
+ */
+void gabor_set_method(
+	enum gabor_method method
+);
+
+/**
+ * @brief Get the method selected by @ref gabor_set_method.
+ */
+enum gabor_method gabor_get_method();
+
 /**
  * @brief Gabor function parametrized by the time, the width given by standard deviation (sigma) and the frequency.
  */
@@ -227,6 +264,186 @@ void gabor_wt_arg_s(
 	float freq		///< frequency of the baseline kernel, in radians
 );
 
+/**
+ * @brief State of a streaming time-frequency analysis using recursive filters.
+ */
+typedef struct gabor_stream gabor_stream_t;
+
+/**
+ * @brief Streaming counterpart of @ref gabor_ft_s and @ref gabor_ft_arg_s.
+ *
+ * @returns NULL on failure or if a window is wider than @ref GABOR_IIR_SIGMA_MAX
+ */
+gabor_stream_t *gabor_stream_ft_create_s(
+	int bins,		///< the height of the plane
+	float sigma,		///< std. deviation of the baseline kernel (implies the window size)
+	int arg			///< produce the complex argument instead of the magnitude?
+);
+
+/**
+ * @brief Streaming counterpart of @ref gabor_wt_s and @ref gabor_wt_arg_s.
+ *
+ * @returns NULL on failure or if a window is wider than @ref GABOR_IIR_SIGMA_MAX
+ */
+gabor_stream_t *gabor_stream_wt_create_s(
+	int bins,		///< the height of the plane
+	float sigma,		///< std. deviation of the baseline kernel (implies the window size)
+	float freq,		///< frequency of the baseline kernel, in radians
+	int arg			///< produce the complex argument instead of the magnitude?
+);
+
+/**
+ * @brief Streaming counterpart of @ref gabor_st_s and @ref gabor_st_arg_s.
+ *
+ * @returns NULL on failure or if a window is wider than @ref GABOR_IIR_SIGMA_MAX
+ */
+gabor_stream_t *gabor_stream_st_create_s(
+	int bins,		///< the height of the plane
+	int arg			///< produce the complex argument instead of the magnitude?
+);
+
+/**
+ * @brief Release the stream.
+ */
+void gabor_stream_destroy(
+	gabor_stream_t *stream
+);
+
+/**
+ * @brief The maximal number of samples pushed but not yet returned.
+ */
+int gabor_stream_delay(
+	const gabor_stream_t *stream
+);
+
+/**
+ * @brief Push the next @p size samples of the signal.
+ *
+ * Each bin is demodulated to the zero frequency and smoothed by the
+ * Young-van Vliet recursive Gaussian filter (a causal and an anticausal pass
+ * of the third order). The anticausal pass runs over blocks, the columns of
+ * the plane are returned once the samples following them are known. The
+ * cost per sample is constant. The columns ready are stored into @p plane,
+ * i.e. at most @p size + @ref gabor_stream_delay columns.
+ *
+ * @returns the number of columns stored
+ */
+int gabor_stream_push_s(
+	gabor_stream_t *stream,	///< the stream
+	const float *sig,	///< the next samples of the signal
+	int sig_stride,		///< the stride of the signal
+	int size,		///< the number of samples
+	void *plane,		///< put the ready columns here
+	int stride_x,		///< stride of rows of the plane
+	int stride_y		///< stride of columns of the plane
+);
+
+/**
+ * @brief End the signal, store the remaining columns.
+ *
+ * The signal is zero beyond its end. The stream is reset and can be reused
+ * for a next signal.
+ *
+ * @returns the number of columns stored, at most @ref gabor_stream_delay
+ */
+int gabor_stream_flush_s(
+	gabor_stream_t *stream,	///< the stream
+	void *plane,		///< put the remaining columns here
+	int stride_x,		///< stride of rows of the plane
+	int stride_y		///< stride of columns of the plane
+);
+
+/**
+ * @brief State of a streaming time-frequency analysis using the kernels of the direct method.
+ */
+typedef struct gabor_analyzer gabor_analyzer_t;
+
+/**
+ * @brief Streaming counterpart of @ref gabor_ft_s and @ref gabor_ft_arg_s.
+ *
+ * @returns NULL on failure
+ */
+gabor_analyzer_t *gabor_analyzer_ft_create_s(
+	int bins,		///< the height of the plane
+	float sigma,		///< std. deviation of the baseline kernel (implies the window size)
+	int arg			///< produce the complex argument instead of the magnitude?
+);
+
+/**
+ * @brief Streaming counterpart of @ref gabor_wt_s and @ref gabor_wt_arg_s.
+ *
+ * @returns NULL on failure
+ */
+gabor_analyzer_t *gabor_analyzer_wt_create_s(
+	int bins,		///< the height of the plane
+	float sigma,		///< std. deviation of the baseline kernel (implies the window size)
+	float freq,		///< frequency of the baseline kernel, in radians
+	int arg			///< produce the complex argument instead of the magnitude?
+);
+
+/**
+ * @brief Streaming counterpart of @ref gabor_st_s and @ref gabor_st_arg_s.
+ *
+ * @returns NULL on failure
+ */
+gabor_analyzer_t *gabor_analyzer_st_create_s(
+	int bins,		///< the height of the plane
+	int arg			///< produce the complex argument instead of the magnitude?
+);
+
+/**
+ * @brief Release the analyzer.
+ */
+void gabor_analyzer_destroy(
+	gabor_analyzer_t *analyzer
+);
+
+/**
+ * @brief The maximal number of samples pushed but not yet returned.
+ *
+ * This is the right half of the longest kernel.
+ */
+int gabor_analyzer_delay(
+	const gabor_analyzer_t *analyzer
+);
+
+/**
+ * @brief Push the next @p size samples of the signal.
+ *
+ * The kernels of all the bins are generated once when the analyzer is
+ * created. Only the samples covered by the longest kernel are kept, a column
+ * of the plane is returned as soon as its kernels are covered by the signal.
+ * The columns are the same (up to rounding) as those of the corresponding
+ * function using @ref GABOR_DIRECT. The columns ready are stored into
+ * @p plane, i.e. at most @p size + @ref gabor_analyzer_delay columns.
+ *
+ * @returns the number of columns stored
+ */
+int gabor_analyzer_push_s(
+	gabor_analyzer_t *analyzer,	///< the analyzer
+	const float *sig,		///< the next samples of the signal
+	int sig_stride,			///< the stride of the signal
+	int size,			///< the number of samples
+	void *plane,			///< put the ready columns here
+	int stride_x,			///< stride of rows of the plane
+	int stride_y			///< stride of columns of the plane
+);
+
+/**
+ * @brief End the signal, store the remaining columns.
+ *
+ * The signal is zero beyond its end. The analyzer is reset and can be reused
+ * for a next signal.
+ *
+ * @returns the number of columns stored, at most @ref gabor_analyzer_delay
+ */
+int gabor_analyzer_flush_s(
+	gabor_analyzer_t *analyzer,	///< the analyzer
+	void *plane,			///< put the remaining columns here
+	int stride_x,			///< stride of rows of the plane
+	int stride_y			///< stride of columns of the plane
+);
+
 /**
  * @brief Derivative of the phase.
  */
@@ -0,0 +1,750 @@
+/**
+ * @brief Binary image and coefficient files.
+ */
+
+#include "image-io.h"
+#include "libdwt.h" // dwt_util_log, dwt_util_alloc_image, dwt_util_load_from_pgm_s
+#include "inline.h" // addr2_s, addr2_i
+// assert
+#include <assert.h>
+// FILE, fopen, fread, fwrite
+#include <stdio.h>
+// malloc, calloc, free
+#include <stdlib.h>
+// memcpy, memcmp
+#include <string.h>
+// isspace
+#include <ctype.h>
+// uint8_t, uint16_t, uint32_t
+#include <stdint.h>
+// open
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+// mmap, munmap
+#include <sys/mman.h>
+// ftruncate, read, close
+#include <unistd.h>
+
+#define IMAGE_IO_RAW_MAGIC "LIBDWTIM"
+
+/**
+ * The header at the beginning of the raw file.
+ */
+struct image_io_raw_header {
+	char magic[8];
+	int size_x, size_y;
+	int stride_x, stride_y;
+	int j;
+};
+
+static
+int image_io_little_endian()
+{
+	const uint16_t one = 1;
+
+	return *(const uint8_t *)&one;
+}
+
+static
+void image_io_swap_s(
+	float *row,
+	int size_x)
+{
+	for(int x = 0; x < size_x; x++)
+	{
+		uint32_t word;
+
+		memcpy(&word, &row[x], sizeof(word));
+
+		word = (word >> 24) | ((word >> 8) & 0xff00) | ((word << 8) & 0xff0000) | (word << 24);
+
+		memcpy(&row[x], &word, sizeof(word));
+	}
+}
+
+// skip the white spaces and the comments of the Netpbm header
+static
+void image_io_skip(
+	FILE *file)
+{
+	int c;
+
+	while( EOF != (c = fgetc(file)) )
+	{
+		if( '#' == c )
+		{
+			while( EOF != (c = fgetc(file)) && '\n' != c )
+				;
+		}
+		else if( !isspace(c) )
+		{
+			ungetc(c, file);
+			return;
+		}
+	}
+}
+
+/**
+ * Read the header of the Netpbm file of the @p kind ('2', '5' or 'f'), up to
+ * the single white space before the raster. The value is the maximum value
+ * of PGM or the scale of PFM.
+ */
+static
+FILE *image_io_open_pnm(
+	const char *path,
+	int *kind,
+	int *size_x,
+	int *size_y,
+	float *value)
+{
+	FILE *file = fopen(path, "rb");
+
+	if( !file )
+	{
+		dwt_util_log(LOG_ERR, "%s: unable to open %s\n", __FUNCTION__, path);
+		return NULL;
+	}
+
+	char magic[2];
+
+	if( 2 != fread(magic, 1, 2, file) || 'P' != magic[0] )
+	{
+		dwt_util_log(LOG_ERR, "%s: %s is not a Netpbm file\n", __FUNCTION__, path);
+		fclose(file);
+		return NULL;
+	}
+
+	*kind = magic[1];
+
+	image_io_skip(file);
+	const int ok_x = fscanf(file, "%i", size_x);
+	image_io_skip(file);
+	const int ok_y = fscanf(file, "%i", size_y);
+	image_io_skip(file);
+	const int ok_v = fscanf(file, "%f", value);
+
+	if( 1 != ok_x || 1 != ok_y || 1 != ok_v || *size_x < 1 || *size_y < 1 || !isspace(fgetc(file)) )
+	{
+		dwt_util_log(LOG_ERR, "%s: %s has an invalid header\n", __FUNCTION__, path);
+		fclose(file);
+		return NULL;
+	}
+
+	return file;
+}
+
+/**
+ * Open the binary PGM file, the @p pdepth is its maximum value.
+ *
+ * @returns NULL and zero @p *pascii for the ASCII files
+ */
+static
+FILE *image_io_open_pgm(
+	const char *path,
+	int *pascii,
+	int *psize_x,
+	int *psize_y,
+	int *pdepth)
+{
+	int kind;
+	float value;
+
+	*pascii = 0;
+
+	FILE *file = image_io_open_pnm(path, &kind, psize_x, psize_y, &value);
+
+	if( !file )
+		return NULL;
+
+	if( '2' == kind )
+	{
+		*pascii = 1;
+		fclose(file);
+		return NULL;
+	}
+
+	*pdepth = (int)value;
+
+	if( '5' != kind || *pdepth < 1 || *pdepth > 65535 )
+	{
+		dwt_util_log(LOG_ERR, "%s: %s is not a graymap of a supported depth\n", __FUNCTION__, path);
+		fclose(file);
+		return NULL;
+	}
+
+	return file;
+}
+
+// read a row of the binary PGM, 16-bit samples are big-endian
+static
+int image_io_read_pgm_row(
+	FILE *file,
+	int size_x,
+	int depth,
+	unsigned char *raw,
+	int *row)
+{
+	const int bytes = depth > 255 ? 2 : 1;
+
+	if( (size_t)size_x != fread(raw, bytes, size_x, file) )
+		return 1;
+
+	for(int x = 0; x < size_x; x++)
+	{
+		row[x] = (2 == bytes) ? (raw[2*x] << 8) | raw[2*x+1] : raw[x];
+
+		if( row[x] > depth )
+			return 1;
+	}
+
+	return 0;
+}
+
+// the rows of the binary PGM, returns zero value on success
+static
+int image_io_load_pgm(
+	FILE *file,
+	int depth,
+	float max_value_s,
+	int max_value_i,
+	int integers,
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y)
+{
+	unsigned char *raw = malloc(2 * size_x);
+	int *row = malloc(sizeof(int) * size_x);
+
+	int err = !raw || !row;
+
+	for(int y = 0; !err && y < size_y; y++)
+	{
+		err = image_io_read_pgm_row(file, size_x, depth, raw, row);
+
+		if( integers )
+		{
+			for(int x = 0; !err && x < size_x; x++)
+				*addr2_i(ptr, y, x, stride_x, stride_y) = max_value_i * row[x] / depth;
+		}
+		else
+		{
+			for(int x = 0; !err && x < size_x; x++)
+				*addr2_s(ptr, y, x, stride_x, stride_y) = max_value_s * row[x] / depth;
+		}
+	}
+
+	free(raw);
+	free(row);
+
+	return err;
+}
+
+int image_io_load_pgm_s(
+	const char *path,
+	float max_value,
+	void **pptr,
+	int *pstride_x,
+	int *pstride_y,
+	int *psize_x,
+	int *psize_y)
+{
+	assert( path && pptr && pstride_x && pstride_y && psize_x && psize_y );
+
+	int ascii, depth;
+
+	FILE *file = image_io_open_pgm(path, &ascii, psize_x, psize_y, &depth);
+
+	if( ascii )
+		return dwt_util_load_from_pgm_s(path, max_value, pptr, pstride_x, pstride_y, psize_x, psize_y);
+
+	if( !file )
+		return 1;
+
+	*pstride_y = sizeof(float);
+	*pstride_x = dwt_util_get_opt_stride(*pstride_y * *psize_x);
+
+	dwt_util_alloc_image(pptr, *pstride_x, *pstride_y, *psize_x, *psize_y);
+
+	const int err = image_io_load_pgm(file, depth, max_value, 0, 0, *pptr, *pstride_x, *pstride_y, *psize_x, *psize_y);
+
+	fclose(file);
+
+	if( err )
+	{
+		dwt_util_log(LOG_ERR, "%s: %s has invalid data\n", __FUNCTION__, path);
+		dwt_util_free_image(pptr);
+		return 4;
+	}
+
+	return 0;
+}
+
+int image_io_load_pgm_i(
+	const char *path,
+	int max_value,
+	void **pptr,
+	int *pstride_x,
+	int *pstride_y,
+	int *psize_x,
+	int *psize_y)
+{
+	assert( path && pptr && pstride_x && pstride_y && psize_x && psize_y );
+
+	int ascii, depth;
+
+	FILE *file = image_io_open_pgm(path, &ascii, psize_x, psize_y, &depth);
+
+	if( ascii )
+		return dwt_util_load_from_pgm_i(path, max_value, pptr, pstride_x, pstride_y, psize_x, psize_y);
+
+	if( !file )
+		return 1;
+
+	*pstride_y = sizeof(int);
+	*pstride_x = dwt_util_get_opt_stride(*pstride_y * *psize_x);
+
+	dwt_util_alloc_image(pptr, *pstride_x, *pstride_y, *psize_x, *psize_y);
+
+	const int err = image_io_load_pgm(file, depth, 0.f, max_value, 1, *pptr, *pstride_x, *pstride_y, *psize_x, *psize_y);
+
+	fclose(file);
+
+	if( err )
+	{
+		dwt_util_log(LOG_ERR, "%s: %s has invalid data\n", __FUNCTION__, path);
+		dwt_util_free_image(pptr);
+		return 4;
+	}
+
+	return 0;
+}
+
+// quantize a value into 8 bits, reports the first incident
+static
+unsigned char image_io_quantize(
+	float px,
+	float max_value,
+	int *err,
+	int y,
+	int x)
+{
+	// isnan
+	if( px != px )
+	{
+		if( !(*err)++ )
+			dwt_util_log(LOG_WARN, "%s: NaN value at (y=%i, x=%i). Such an incident will be reported only once.\n", __FUNCTION__, y, x);
+		return 0;
+	}
+
+	if( px - 1e-3f > max_value || px + 1e-3f < 0.0f )
+	{
+		if( !(*err)++ )
+			dwt_util_log(LOG_WARN, "%s: Pixel intensity out of range (%f) at (y=%i, x=%i). Such an incident will be reported only once.\n", __FUNCTION__, px, y, x);
+	}
+
+	if( px >= max_value )
+		return 255;
+
+	if( px <= 0.0f )
+		return 0;
+
+	return (unsigned char)(255 * px / max_value);
+}
+
+static
+int image_io_save_pgm(
+	const char *path,
+	float max_value,
+	const void *ptr,
+	int integers,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y)
+{
+	assert( path && ptr && size_x > 0 && size_y > 0 && max_value > 0.0f );
+
+	FILE *file = fopen(path, "wb");
+
+	if( !file )
+	{
+		dwt_util_log(LOG_ERR, "%s: unable to open %s\n", __FUNCTION__, path);
+		return 1;
+	}
+
+	fprintf(file, "P5\n%i %i\n255\n", size_x, size_y);
+
+	unsigned char *row = malloc(size_x);
+
+	int err = 0;
+	int io_err = !row;
+
+	for(int y = 0; !io_err && y < size_y; y++)
+	{
+		for(int x = 0; x < size_x; x++)
+		{
+			const float px = integers ?
+				(float)*addr2_const_i(ptr, y, x, stride_x, stride_y) :
+				*addr2_const_s(ptr, y, x, stride_x, stride_y);
+
+			row[x] = image_io_quantize(px, max_value, &err, y, x);
+		}
+
+		io_err = (size_t)size_x != fwrite(row, 1, size_x, file);
+	}
+
+	free(row);
+
+	if( fclose(file) || io_err )
+	{
+		dwt_util_log(LOG_ERR, "%s: unable to write %s\n", __FUNCTION__, path);
+		return 1;
+	}
+
+	return 0;
+}
+
+int image_io_save_pgm_s(
+	const char *path,
+	float max_value,
+	const void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y)
+{
+	return image_io_save_pgm(path, max_value, ptr, 0, stride_x, stride_y, size_x, size_y);
+}
+
+int image_io_save_pgm_i(
+	const char *path,
+	int max_value,
+	const void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y)
+{
+	return image_io_save_pgm(path, (float)max_value, ptr, 1, stride_x, stride_y, size_x, size_y);
+}
+
+int image_io_load_pfm_s(
+	const char *path,
+	void **pptr,
+	int *pstride_x,
+	int *pstride_y,
+	int *psize_x,
+	int *psize_y)
+{
+	assert( path && pptr && pstride_x && pstride_y && psize_x && psize_y );
+
+	int kind;
+	float scale;
+
+	FILE *file = image_io_open_pnm(path, &kind, psize_x, psize_y, &scale);
+
+	if( !file )
+		return 1;
+
+	if( 'f' != kind || 0.0f == scale )
+	{
+		dwt_util_log(LOG_ERR, "%s: %s is not a grayscale float map\n", __FUNCTION__, path);
+		fclose(file);
+		return 2;
+	}
+
+	// the negative scale stands for little-endian
+	const int swap = (scale < 0.0f) != image_io_little_endian();
+
+	*pstride_y = sizeof(float);
+	*pstride_x = dwt_util_get_opt_stride(*pstride_y * *psize_x);
+
+	dwt_util_alloc_image(pptr, *pstride_x, *pstride_y, *psize_x, *psize_y);
+
+	int err = 0;
+
+	// the rows go from the bottom to the top
+	for(int y = *psize_y-1; !err && y >= 0; y--)
+	{
+		float *row = addr2_s(*pptr, y, 0, *pstride_x, *pstride_y);
+
+		err = (size_t)*psize_x != fread(row, sizeof(float), *psize_x, file);
+
+		if( swap )
+			image_io_swap_s(row, *psize_x);
+	}
+
+	fclose(file);
+
+	if( err )
+	{
+		dwt_util_log(LOG_ERR, "%s: %s is too short\n", __FUNCTION__, path);
+		dwt_util_free_image(pptr);
+		return 4;
+	}
+
+	return 0;
+}
+
+int image_io_save_pfm_s(
+	const char *path,
+	const void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y)
+{
+	assert( path && ptr && size_x > 0 && size_y > 0 );
+
+	FILE *file = fopen(path, "wb");
+
+	if( !file )
+	{
+		dwt_util_log(LOG_ERR, "%s: unable to open %s\n", __FUNCTION__, path);
+		return 1;
+	}
+
+	fprintf(file, "Pf\n%i %i\n%s\n", size_x, size_y, image_io_little_endian() ? "-1.0" : "1.0");
+
+	// the rows of other layouts are gathered
+	float *row = (sizeof(float) == stride_y) ? NULL : malloc(sizeof(float) * size_x);
+
+	int err = (sizeof(float) != stride_y) && !row;
+
+	for(int y = size_y-1; !err && y >= 0; y--)
+	{
+		const float *src = addr2_const_s(ptr, y, 0, stride_x, stride_y);
+
+		if( row )
+		{
+			for(int x = 0; x < size_x; x++)
+				row[x] = *addr2_const_s(ptr, y, x, stride_x, stride_y);
+			src = row;
+		}
+
+		err = (size_t)size_x != fwrite(src, sizeof(float), size_x, file);
+	}
+
+	free(row);
+
+	if( fclose(file) || err )
+	{
+		dwt_util_log(LOG_ERR, "%s: unable to write %s\n", __FUNCTION__, path);
+		return 1;
+	}
+
+	return 0;
+}
+
+int image_io_save_raw_s(
+	const char *path,
+	const void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_x,
+	int size_y,
+	int j)
+{
+	assert( path && ptr && size_x > 0 && size_y > 0 );
+
+	// keep the stride of the row-major images
+	const int file_stride_x = ( sizeof(float) == stride_y && stride_x >= (int)sizeof(float) * size_x ) ?
+		stride_x : (int)sizeof(float) * size_x;
+
+	FILE *file = fopen(path, "wb");
+
+	if( !file )
+	{
+		dwt_util_log(LOG_ERR, "%s: unable to open %s\n", __FUNCTION__, path);
+		return 1;
+	}
+
+	char *header = calloc(1, IMAGE_IO_RAW_HEADER);
+	char *row = calloc(1, file_stride_x);
+
+	int err = !header || !row;
+
+	if( !err )
+	{
+		const struct image_io_raw_header h = {
+			.magic = IMAGE_IO_RAW_MAGIC,
+			.size_x = size_x,
+			.size_y = size_y,
+			.stride_x = file_stride_x,
+			.stride_y = sizeof(float),
+			.j = j,
+		};
+
+		memcpy(header, &h, sizeof(h));
+
+		err = 1 != fwrite(header, IMAGE_IO_RAW_HEADER, 1, file);
+	}
+
+	// the padding of the rows is zero
+	for(int y = 0; !err && y < size_y; y++)
+	{
+		for(int x = 0; x < size_x; x++)
+			((float *)row)[x] = *addr2_const_s(ptr, y, x, stride_x, stride_y);
+
+		err = 1 != fwrite(row, file_stride_x, 1, file);
+	}
+
+	free(header);
+	free(row);
+
+	if( fclose(file) || err )
+	{
+		dwt_util_log(LOG_ERR, "%s: unable to write %s\n", __FUNCTION__, path);
+		return 1;
+	}
+
+	return 0;
+}
+
+static
+void image_io_map_geometry(
+	struct image_io_map_t *map,
+	const struct image_io_raw_header *header)
+{
+	map->size_x = header->size_x;
+	map->size_y = header->size_y;
+	map->stride_x = header->stride_x;
+	map->stride_y = header->stride_y;
+	map->j = header->j;
+
+	map->length = IMAGE_IO_RAW_HEADER + (size_t)map->stride_x * map->size_y;
+}
+
+static
+int image_io_map(
+	struct image_io_map_t *map,
+	int writable)
+{
+	// the private mapping can be transformed in place too
+	void *base = mmap(0, map->length, PROT_READ|PROT_WRITE, writable ? MAP_SHARED : MAP_PRIVATE, map->fd, 0);
+	if( MAP_FAILED == base )
+	{
+		dwt_util_log(LOG_ERR, "mmap() fails\n");
+		close(map->fd);
+		return 1;
+	}
+
+	map->base = base;
+	map->ptr = (char *)base + IMAGE_IO_RAW_HEADER;
+	map->writable = writable;
+
+	return 0;
+}
+
+int image_io_map_create_s(
+	struct image_io_map_t *map,
+	const char *path,
+	int size_x,
+	int size_y,
+	int opt_stride)
+{
+	assert( map && path );
+	assert( size_x > 0 && size_y > 0 );
+
+	const struct image_io_raw_header header = {
+		.magic = IMAGE_IO_RAW_MAGIC,
+		.size_x = size_x,
+		.size_y = size_y,
+		.stride_x = dwt_util_get_stride(sizeof(float) * size_x, opt_stride),
+		.stride_y = sizeof(float),
+		.j = 0,
+	};
+
+	image_io_map_geometry(map, &header);
+	map->base = map->ptr = NULL;
+
+	map->fd = open(path, O_CREAT|O_RDWR|O_TRUNC, S_IRUSR|S_IWUSR);
+	if( map->fd < 0 )
+	{
+		dwt_util_log(LOG_ERR, "open() fails for '%s'\n", path);
+		return 1;
+	}
+
+	if( ftruncate(map->fd, map->length) )
+	{
+		dwt_util_log(LOG_ERR, "ftruncate() fails\n");
+		close(map->fd);
+		return 1;
+	}
+
+	if( image_io_map(map, 1) )
+		return 1;
+
+	memcpy(map->base, &header, sizeof(header));
+
+	return 0;
+}
+
+int image_io_map_open_s(
+	struct image_io_map_t *map,
+	const char *path,
+	int writable)
+{
+	assert( map && path );
+
+	map->base = map->ptr = NULL;
+
+	map->fd = open(path, writable ? O_RDWR : O_RDONLY);
+	if( map->fd < 0 )
+	{
+		dwt_util_log(LOG_ERR, "open() fails for '%s'\n", path);
+		return 1;
+	}
+
+	struct image_io_raw_header header;
+
+	if( (ssize_t)sizeof(header) != read(map->fd, &header, sizeof(header)) || memcmp(header.magic, IMAGE_IO_RAW_MAGIC, sizeof(header.magic)) )
+	{
+		dwt_util_log(LOG_ERR, "'%s' is not a raw image\n", path);
+		close(map->fd);
+		return 1;
+	}
+
+	if( header.size_x < 1 || header.size_y < 1 || (int)sizeof(float) != header.stride_y ||
+		header.stride_x < header.stride_y * header.size_x || header.j < 0 )
+	{
+		dwt_util_log(LOG_ERR, "'%s' has an invalid header\n", path);
+		close(map->fd);
+		return 1;
+	}
+
+	image_io_map_geometry(map, &header);
+
+	struct stat st;
+
+	if( fstat(map->fd, &st) || (size_t)st.st_size < map->length )
+	{
+		dwt_util_log(LOG_ERR, "'%s' is too short for %ix%i floats\n", path, map->size_x, map->size_y);
+		close(map->fd);
+		return 1;
+	}
+
+	return image_io_map(map, writable);
+}
+
+void image_io_map_close_s(
+	struct image_io_map_t *map)
+{
+	assert( map );
+
+	if( map->base )
+	{
+		if( map->writable )
+			memcpy((char *)map->base + offsetof(struct image_io_raw_header, j), &map->j, sizeof(map->j));
+
+		munmap(map->base, map->length);
+	}
+
+	close(map->fd);
+
+	map->base = map->ptr = NULL;
+	map->fd = -1;
+}
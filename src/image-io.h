@@ -0,0 +1,197 @@
+/**
+ * @brief Binary image and coefficient files.
+ *
+ * The binary Netpbm formats (P5 graymap and Pf float map) are read and
+ * written by whole rows, unlike the ASCII ones of @ref dwt_util_load_from_pgm_s
+ * and @ref dwt_util_save_to_pgm_s. The raw format stores the floats in the
+ * (stride_x, stride_y) layout of the transforms behind a page-sized header,
+ * thus it can be memory-mapped and transformed directly.
+ */
+
+#ifndef IMAGE_IO_H
+#define IMAGE_IO_H
+
+#include <stddef.h> // size_t
+
+/**
+ * @brief Load a grayscale image from a PGM file, binary (P5) or ASCII (P2).
+ *
+ * The depth of P5 files is either 8 or 16 bits (maximum value above 255).
+ * The image is allocated with an optimal stride, the same way as by
+ * @ref dwt_util_load_from_pgm_s.
+ *
+ * @returns zero value on success
+ */
+int image_io_load_pgm_s(
+	const char *path,	///< input file name, e.g. "input.pgm"
+	float max_value,	///< maximum desired value of pixel, e.g. 1.0f if image values lie inside an interval [0.0f; 1.0f]
+	void **pptr,		///< place the pointer to beginning of image data at this address
+	int *pstride_x,		///< place the difference between rows (in bytes) at this address
+	int *pstride_y,		///< place the difference between columns (in bytes) at this address
+	int *psize_x,		///< place the width of the image (in elements) at this address
+	int *psize_y		///< place the height of the image (in elements) at this address
+);
+
+/**
+ * @brief Load a grayscale image from a PGM file into integers, see @ref image_io_load_pgm_s.
+ */
+int image_io_load_pgm_i(
+	const char *path,	///< input file name, e.g. "input.pgm"
+	int max_value,		///< maximum desired value of pixel, e.g. 255 if image values lie inside an interval [0; 255]
+	void **pptr,		///< place the pointer to beginning of image data at this address
+	int *pstride_x,		///< place the difference between rows (in bytes) at this address
+	int *pstride_y,		///< place the difference between columns (in bytes) at this address
+	int *psize_x,		///< place the width of the image (in elements) at this address
+	int *psize_y		///< place the height of the image (in elements) at this address
+);
+
+/**
+ * @brief Save a grayscale image into a binary (P5) PGM file of 8 bits.
+ *
+ * The values out of [0; @p max_value] are clamped, NaN values are saved as
+ * zero. Both are reported once.
+ *
+ * @returns zero value on success
+ */
+int image_io_save_pgm_s(
+	const char *path,	///< target file name, e.g. "output.pgm"
+	float max_value,	///< maximum value of pixel, e.g. 1.0f if image values lie inside an interval [0.0; 1.0]
+	const void *ptr,	///< pointer to beginning of image data
+	int stride_x,		///< difference between rows (in bytes)
+	int stride_y,		///< difference between columns (in bytes)
+	int size_x,		///< width of the image (in elements)
+	int size_y		///< height of the image (in elements)
+);
+
+/**
+ * @brief Save integers into a binary (P5) PGM file of 8 bits, see @ref image_io_save_pgm_s.
+ */
+int image_io_save_pgm_i(
+	const char *path,	///< target file name, e.g. "output.pgm"
+	int max_value,		///< maximum value of pixel, e.g. 255 if image values lie inside an interval [0; 255]
+	const void *ptr,	///< pointer to beginning of image data
+	int stride_x,		///< difference between rows (in bytes)
+	int stride_y,		///< difference between columns (in bytes)
+	int size_x,		///< width of the image (in elements)
+	int size_y		///< height of the image (in elements)
+);
+
+/**
+ * @brief Load a grayscale float map (PFM, "Pf").
+ *
+ * The values are taken as they are. The rows are read straight into the
+ * image unless the byte order of the file differs from the machine.
+ *
+ * @returns zero value on success
+ */
+int image_io_load_pfm_s(
+	const char *path,	///< input file name, e.g. "input.pfm"
+	void **pptr,		///< place the pointer to beginning of image data at this address
+	int *pstride_x,		///< place the difference between rows (in bytes) at this address
+	int *pstride_y,		///< place the difference between columns (in bytes) at this address
+	int *psize_x,		///< place the width of the image (in elements) at this address
+	int *psize_y		///< place the height of the image (in elements) at this address
+);
+
+/**
+ * @brief Save the floats into a grayscale float map (PFM, "Pf") in the byte order of the machine.
+ *
+ * Unlike PGM, any values (e.g. the coefficients of a transform) are saved
+ * without any loss.
+ *
+ * @returns zero value on success
+ */
+int image_io_save_pfm_s(
+	const char *path,	///< target file name, e.g. "output.pfm"
+	const void *ptr,	///< pointer to beginning of image data
+	int stride_x,		///< difference between rows (in bytes)
+	int stride_y,		///< difference between columns (in bytes)
+	int size_x,		///< width of the image (in elements)
+	int size_y		///< height of the image (in elements)
+);
+
+/**
+ * @brief Size of the header of the raw files, the data start at this offset.
+ *
+ * A multiple of the page size, thus the data of a mapped file are aligned.
+ */
+#define IMAGE_IO_RAW_HEADER 4096
+
+/**
+ * @brief Raw image of floats in a memory-mapped file.
+ *
+ * The file starts with a header of @ref IMAGE_IO_RAW_HEADER bytes, the rows
+ * follow including their padding up to stride_x. The data are in the byte
+ * order of the machine which wrote them.
+ */
+struct image_io_map_t {
+	int fd;
+	void *base;		///< the whole file including the header
+	size_t length;		///< length of the file (in bytes)
+	int writable;		///< are the changes written into the file? zero value if not
+
+	void *ptr;		///< pointer to beginning of image data
+	int size_x;		///< width of the image (in elements)
+	int size_y;		///< height of the image (in elements)
+	int stride_x;		///< difference between rows (in bytes)
+	int stride_y;		///< difference between columns (in bytes), sizeof(float)
+	int j;			///< the number of the levels of the transform stored, zero for an image
+};
+
+/**
+ * @brief Save the image (or the coefficients after @p j levels) into a raw file.
+ *
+ * The file keeps the @p stride_x of the row-major images (@p stride_y is
+ * sizeof(float)), thus it maps into the same layout.
+ *
+ * @returns zero value on success
+ */
+int image_io_save_raw_s(
+	const char *path,	///< target file name, e.g. "output.raw"
+	const void *ptr,	///< pointer to beginning of image data
+	int stride_x,		///< difference between rows (in bytes), at least sizeof(float)*size_x
+	int stride_y,		///< difference between columns (in bytes)
+	int size_x,		///< width of the image (in elements)
+	int size_y,		///< height of the image (in elements)
+	int j			///< the levels of the transform stored, zero for an image
+);
+
+/**
+ * @brief Create (or truncate) the raw file and map it for writing.
+ *
+ * All the values are zero. The stride is chosen as by
+ * @ref dwt_util_get_stride.
+ *
+ * @returns zero value on success
+ */
+int image_io_map_create_s(
+	struct image_io_map_t *map,
+	const char *path,
+	int size_x,	///< width of the image (in elements)
+	int size_y,	///< height of the image (in elements)
+	int opt_stride	///< use an optimal stride? zero value if not
+);
+
+/**
+ * @brief Map the existing raw file.
+ *
+ * The data are used in place, without any parsing or copying. When not
+ * @p writable, the mapping is private: the image can still be transformed
+ * in place, the pages touched are copied on write and the file is kept.
+ *
+ * @returns zero value on success
+ */
+int image_io_map_open_s(
+	struct image_io_map_t *map,
+	const char *path,
+	int writable	///< write the changes into the file? zero value if not
+);
+
+/**
+ * @brief Unmap the file, the @p map->j is stored into a writable file.
+ */
+void image_io_map_close_s(
+	struct image_io_map_t *map
+);
+
+#endif
@@ -8,8 +8,10 @@
 
 #ifdef __GNUC__
 	#define UNUSED_FUNC __attribute__ ((unused))
+	#define ALWAYS_INLINE __attribute__ ((always_inline))
 #else
 	#define UNUSED_FUNC
+	#define ALWAYS_INLINE
 #endif
 
 #define UNUSED(expr) do { (void)(expr); } while (0)
@@ -128,6 +130,22 @@ int *addr1_i(
 	return (int *)((char *)ptr+i*stride);
 }
 
+/**
+ * @brief Helper function returning address of given element.
+ *
+ * Evaluate address of (i) image element, returns (int16_t *).
+ */
+UNUSED_FUNC
+static
+int16_t *addr1_i16(
+	void *ptr,
+	int i,
+	int stride
+)
+{
+	return (int16_t *)((char *)ptr+i*stride);
+}
+
 /**
  * @brief Helper function returning address of given element.
  *
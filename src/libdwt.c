@@ -442,6 +442,13 @@
 	#include <xmmintrin.h>
 #endif
 
+/** AVX2 and FMA intrinsics, compiled regardless of -m flags and selected at run-time */
+#if defined(__x86_64__) && (GCC_VERSION >= 40900)
+	#pragma message "INFO: Using AVX2 (run-time dispatch)"
+	#define ENABLE_AVX
+	#include <immintrin.h>
+#endif
+
 /** OpenMP header when used */
 #ifdef _OPENMP
 	#pragma message "INFO: Using OpenMP"
@@ -774,6 +781,46 @@ int dwt_util_get_accel()
 	return get_accel_type();
 }
 
+/** use AVX2/FMA kernels if nonzero, detected in dwt_util_init() */
+int dwt_util_global_avx = 0;
+
+static
+void set_avx(
+	int avx
+)
+{
+	dwt_util_global_avx = avx;
+}
+
+static
+int get_avx()
+{
+	return dwt_util_global_avx;
+}
+
+static
+int detect_avx()
+{
+#ifdef ENABLE_AVX
+	__builtin_cpu_init();
+
+	return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+	return 0;
+#endif
+}
+
+void dwt_util_set_avx(
+	int avx)
+{
+	set_avx( avx && detect_avx() );
+}
+
+int dwt_util_get_avx()
+{
+	return get_avx();
+}
+
 #include "inline.h"
 
 int dwt_util_ceil_log2(
@@ -973,6 +1020,8 @@ int calc_and_set_temp_size_s(
 }
 
 #include "system.h" // is_aligned
+#include "pool.h" // dwt_pool_run
+#include "trace.h" // DWT_TRACE_BEGIN, DWT_TRACE_END
 
 static
 void *ptralign_down(
@@ -6783,191 +6832,1385 @@ void accel_lift_op4s_fwd_main_sdl_stride_sse_s(
 }
 #endif
 
-#ifdef __x86_64__
-static
-void accel_lift_op4s_main_dl_nosse_s(
-	float *arr,
-	int steps,
-	float alpha,
-	float beta,
-	float gamma,
-	float delta,
-	float zeta,
-	int scaling)
-// this long string disables SSE support (only no-sse is not enough)
-__attribute__ ((__target__ ("no-mmx,no-sse,no-sse2,no-sse3,no-sse4,no-sse4.1")));
-#endif
-static
-void accel_lift_op4s_main_dl_nosse_s(
-	float *arr,
-	int steps,
-	float alpha,
-	float beta,
-	float gamma,
-	float delta,
-	float zeta,
-	int scaling)
-{
-	assert( steps >= 0 );
+#ifdef ENABLE_AVX
+/*
+ * AVX2/FMA variants of the shifted double-loop kernels.
+ *
+ * The 256-bit registers hold two independent SDL states side by side. The
+ * lower half belongs to a signal at "addr", the upper half to a signal at
+ * "addr" shifted by "step" bytes. Since all shuffles used by the SSE
+ * kernels operate within 128-bit lanes, they map directly on AVX.
+ */
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
 
-	if( scaling < 0 )
-	{
-		for(int w = 0; w < dwt_util_get_num_workers(); w++)
-		{
-			float *arr_local = calc_temp_offset2_s(arr, w, 0);
+#define op4s_sdl2_import_preload_s_avx(out, addr, step) \
+do { \
+	(out) = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(addr)), _mm_load_ps(addr1_s((addr), 1, (step))), 1); \
+} while(0)
 
-			// constants
-			const float w[4] = { delta, gamma, beta, alpha };
-			const float v[2] = { 1/zeta, zeta };
+#define op4s_sdl2_import_s_avx(l, idx, out) \
+do { \
+	(out) = _mm256_shuffle_ps((out), (out), _MM_SHUFFLE(2,1,0,3)); \
+	(l) = _mm256_blend_ps((l), (out), 0x11); \
+	(l) = _mm256_shuffle_ps((l), (l), _MM_SHUFFLE((3==idx)?0:3,(2==idx)?0:2,(1==idx)?0:1,(0==idx)?0:0)); \
+} while(0)
 
-			// aux. variables
-			float in[2];
-			float out[2];
-			float r[4];
-			float c[4];
-			float l[4];
+#define op4s_sdl6_import_s_avx(l, idx, out) \
+do { \
+	(out) = _mm256_shuffle_ps((out), (out), _MM_SHUFFLE(2,1,0,3)); \
+	(l) = _mm256_blend_ps((l), (out), 0x11); \
+	(l) = _mm256_shuffle_ps((l), (l), _MM_SHUFFLE((3==idx)?0:3,(2==idx)?0:2,(1==idx)?0:1,(0==idx)?0:0)); \
+} while(0)
 
-			// values that have to be passed from iteration to iteration
-			// slide in left border
-			l[0] = arr_local[0];
-			l[1] = arr_local[1];
-			l[2] = arr_local[2];
-			l[3] = arr_local[3];
+#define op4s_sdl2_load_s_avx(in, addr, step) \
+do { \
+	(in) = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps((const float *)(addr))), _mm_load_ps(addr1_const_s((addr), 1, (step))), 1); \
+} while(0)
 
-			// init
-			float *addr = arr_local + 4;
+#define op4s_sdl2_shuffle_s_avx(c, r) \
+do { \
+	(c) = _mm256_shuffle_ps((c), (c), _MM_SHUFFLE(0,3,2,1)); \
+	(r) = _mm256_shuffle_ps((r), (r), _MM_SHUFFLE(0,3,2,1)); \
+} while(0)
 
-			// loop by pairs from left to right
-			for(int s = 0; s < steps; s++)
-			{
-				// inputs
-				in[0] = addr[0];
-				in[1] = addr[1];
+#define op4s_sdl2_input_low_s_avx(in, c, r) \
+do { \
+	__m256 t; \
+	(t) = (c); \
+	(t) = _mm256_shuffle_ps((t), (in), _MM_SHUFFLE(1,0,3,2)); \
+	(c) = _mm256_shuffle_ps((c), (t),  _MM_SHUFFLE(2,0,1,0)); \
+	(t) = _mm256_shuffle_ps((t), (r),  _MM_SHUFFLE(3,2,3,2)); \
+	(r) = _mm256_shuffle_ps((r), (t),  _MM_SHUFFLE(1,2,1,0)); \
+} while(0)
 
-				// scales
-				in[0] = in[0] * v[0];
-				in[1] = in[1] * v[1];
+#define op4s_sdl2_shuffle_input_low_s_avx(in, c, r) \
+do { \
+	__m256 t; \
+	(t) = (in); \
+	(t) = _mm256_shuffle_ps((t), (c), _MM_SHUFFLE(3,2,1,0)); \
+	(c) = _mm256_shuffle_ps((c), (t), _MM_SHUFFLE(0,3,2,1)); \
+	(t) = _mm256_shuffle_ps((t), (r), _MM_SHUFFLE(3,2,1,0)); \
+	(r) = _mm256_shuffle_ps((r), (t), _MM_SHUFFLE(1,3,2,1)); \
+} while(0)
 
-				// shuffles
-				out[0] = l[0];
-				c[0]   = l[1];
-				c[1]   = l[2];
-				c[2]   = l[3];
-				c[3]   = in[0];
+#define op4s_sdl2_shuffle_input_high_s_avx(in, c, r) \
+do { \
+	(in) = _mm256_shuffle_ps( (in), (c), _MM_SHUFFLE(3,2,3,2) ); \
+	(c)  = _mm256_shuffle_ps( (c), (in), _MM_SHUFFLE(0,3,2,1) ); \
+	(in) = _mm256_shuffle_ps( (in), (r), _MM_SHUFFLE(3,2,1,0) ); \
+	(r)  = _mm256_shuffle_ps( (r), (in), _MM_SHUFFLE(1,3,2,1) ); \
+} while(0)
 
-				// operation z[] = c[] + w[] * ( l[] + r[] )
-				// by sequential computation from top/right to bottom/left
-				r[3]   = in[1];
-				r[2]   = c[3]+w[3]*(l[3]+r[3]);
-				r[1]   = c[2]+w[2]*(l[2]+r[2]);
-				r[0]   = c[1]+w[1]*(l[1]+r[1]);
-				out[1] = c[0]+w[0]*(l[0]+r[0]);
+#define op4s_sdl2_op_s_avx(z, c, w, l, r) \
+do { \
+	(z) = _mm256_add_ps((l), (r)); \
+	(z) = _mm256_fmadd_ps((z), (w), (c)); \
+} while(0)
 
-				// outputs
-				addr[0-4] = out[0];
-				addr[1-4] = out[1];
+#define op4s_sdl6_op_s_avx(z, w, l, r) \
+do { \
+	__m256 t; \
+	(t) = _mm256_add_ps((l), (r)); \
+	(z) = _mm256_fmadd_ps((t), (w), (z)); \
+} while(0)
 
-				// update l[]
-				l[0] = r[0];
-				l[1] = r[1];
-				l[2] = r[2];
-				l[3] = r[3];
+#define op4s_sdl2_update_s_avx(c, l, r, z) \
+do { \
+	(c) = (l); \
+	(l) = (r); \
+	(r) = (z); \
+} while(0)
 
-				// pointers
-				addr += 2;
-			}
+#define op4s_sdl6_update_s_avx(z, l, r) \
+do { \
+	__m256 t; \
+	(t) = (z); \
+	(z) = (l); \
+	(l) = (r); \
+	(r) = (t); \
+} while(0)
 
-			// slide out right border
-			addr[0-4] = l[0];
-			addr[1-4] = l[1];
-			addr[2-4] = l[2];
-			addr[3-4] = l[3];
-		}
-	}
-	else if ( scaling > 0 )
-	{
-		for(int w = 0; w < dwt_util_get_num_workers(); w++)
-		{
-			float *arr_local = calc_temp_offset2_s(arr, w, 0);
+#define op4s_sdl2_output_low_s_avx(out, l, z) \
+do { \
+	(out) = _mm256_unpacklo_ps((l), (z)); \
+} while(0)
 
-			// constants
-			const float w[4] = { delta, gamma, beta, alpha };
-			const float v[2] = { 1/zeta, zeta };
+#define op4s_sdl2_output_high_s_avx(out, l, z) \
+do { \
+	__m256 t; \
+	(t) = _mm256_unpacklo_ps((l), (z)); \
+	(out) = _mm256_shuffle_ps((out), t, _MM_SHUFFLE(1,0,1,0)); \
+} while(0)
 
-			// aux. variables
-			float in[2];
-			float out[2];
-			float r[4];
-			float c[4];
-			float l[4];
+#define op4s_sdl2_scale_s_avx(out, v) \
+do { \
+	(out) = _mm256_mul_ps((out), (v)); \
+} while(0)
 
-			// values that have to be passed from iteration to iteration
-			// slide in left border
-			l[0] = arr_local[0];
-			l[1] = arr_local[1];
-			l[2] = arr_local[2];
-			l[3] = arr_local[3];
+#define op4s_sdl2_descale_s_avx(in, v) \
+do { \
+	(in) = _mm256_mul_ps((in), (v)); \
+} while(0)
 
-			// init
-			float *addr = arr_local + 4;
+#define op4s_sdl2_save_s_avx(out, addr, step) \
+do { \
+	_mm_storel_pi((__m64 *)(addr), _mm256_castps256_ps128(out)); \
+	_mm_storel_pi((__m64 *)addr1_s((addr), 1, (step)), _mm256_extractf128_ps((out), 1)); \
+} while(0)
 
-			// loop by pairs from left to right
-			for(int s = 0; s < steps; s++)
-			{
-				// inputs
-				in[0] = addr[0];
-				in[1] = addr[1];
+#define op4s_sdl2_save_shift_s_avx(out, addr, step) \
+do { \
+	_mm_store_ps((float *)(addr), _mm256_castps256_ps128(out)); \
+	_mm_store_ps(addr1_s((addr), 1, (step)), _mm256_extractf128_ps((out), 1)); \
+} while(0)
 
-				// shuffles
-				out[0] = l[0];
-				c[0]   = l[1];
-				c[1]   = l[2];
-				c[2]   = l[3];
-				c[3]   = in[0];
+#define op4s_sdl2_export_s_avx(l, addr, idx, step) \
+do { \
+	(addr)[(idx)] = (l)[(idx)]; \
+	addr1_s((addr), 1, (step))[(idx)] = (l)[4+(idx)]; \
+} while(0)
 
-				// operation z[] = c[] + w[] * ( l[] + r[] )
-				// by sequential computation from top/right to bottom/left
-				r[3]   = in[1];
-				r[2]   = c[3]+w[3]*(l[3]+r[3]);
-				r[1]   = c[2]+w[2]*(l[2]+r[2]);
-				r[0]   = c[1]+w[1]*(l[1]+r[1]);
-				out[1] = c[0]+w[0]*(l[0]+r[0]);
+#define op4s_sdl6_export_s_avx(l, addr, idx, step) \
+do { \
+	(addr)[(idx)] = (l)[(idx)]; \
+	addr1_s((addr), 1, (step))[(idx)] = (l)[4+(idx)]; \
+} while(0)
 
-				// scales
-				out[0] = out[0] * v[0];
-				out[1] = out[1] * v[1];
+#define op4s_sdl_import_stride_s_avx(l, addr, idx, stride, step) \
+do { \
+	l[idx] = *addr1_const_s(addr, idx, stride); \
+	l[4+idx] = *addr1_const_s(addr1_const_s(addr, 1, step), idx, stride); \
+} while(0)
 
-				// outputs
-				addr[0-4] = out[0];
-				addr[1-4] = out[1];
+#define op4s_sdl_load_stride_s_avx(in, addr, stride, step) \
+do { \
+	in[0] = *addr1_const_s(addr,0,stride); \
+	in[1] = *addr1_const_s(addr,1,stride); \
+	in[4] = *addr1_const_s(addr1_const_s(addr,1,step),0,stride); \
+	in[5] = *addr1_const_s(addr1_const_s(addr,1,step),1,stride); \
+} while(0)
 
-				// update l[]
-				l[0] = r[0];
-				l[1] = r[1];
-				l[2] = r[2];
-				l[3] = r[3];
+#define op4s_sdl_save_stride_s_avx(out, addr, stride, step) \
+do { \
+	*addr1_s(addr,0,stride) = out[0]; \
+	*addr1_s(addr,1,stride) = out[1]; \
+	*addr1_s(addr1_s(addr,1,step),0,stride) = out[4]; \
+	*addr1_s(addr1_s(addr,1,step),1,stride) = out[5]; \
+} while(0)
 
-				// pointers
-				addr += 2;
-			}
+#define op4s_sdl_export_stride_s_avx(l,addr,idx,stride,step) \
+do { \
+	*addr1_s(addr,idx,stride) = l[idx]; \
+	*addr1_s(addr1_s(addr,1,step),idx,stride) = l[4+idx]; \
+} while(0)
 
-			// slide out right border
-			addr[0-4] = l[0];
-			addr[1-4] = l[1];
-			addr[2-4] = l[2];
-			addr[3-4] = l[3];
-		}
-	}
-	else
-	{
-		// fallback, not implemented
-		accel_lift_op4s_main_s(arr, steps, alpha, beta, gamma, delta, zeta, scaling);
-	}
-}
+#define op4s_sdl2_preload_prolog_s_avx(w, v, l, c, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_import_preload_s_avx((out), (*(addr)), step); \
+	(*(addr)) += 4; \
+} while(0)
 
-/**
- * @brief Double-loop algorithm from Rade Kutil: A Single-Loop Approach to
- * SIMD Parallelization of 2-D Wavelet Lifting.
+#define op4s_sdl6_preload_prolog_s_avx(w, v, l, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_import_preload_s_avx((out), (*(addr)), step); \
+	(*(addr)) += 4; \
+} while(0)
+
+#define op4s_sdl2_pass_fwd_prolog_full_s_avx(w, v, l, c, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_load_s_avx((in), (*(addr)), step); \
+	op4s_sdl2_shuffle_input_low_s_avx((in), (c), (r)); \
+	op4s_sdl2_op_s_avx((z), (c), (w), (l), (r)); \
+	op4s_sdl2_update_s_avx((c), (l), (r), (z)); \
+	(*(addr)) += 4; \
+} while(0)
+
+#define op4s_sdl2_pass_inv_prolog_full_s_avx(w, v, l, c, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_load_s_avx((in), (*(addr)), step); \
+	op4s_sdl2_descale_s_avx((in), (v)); \
+	op4s_sdl2_shuffle_input_low_s_avx((in), (c), (r)); \
+	op4s_sdl2_op_s_avx((z), (c), (w), (l), (r)); \
+	op4s_sdl2_update_s_avx((c), (l), (r), (z)); \
+	(*(addr)) += 4; \
+} while(0)
+
+#define op4s_sdl6_pass_inv_prolog_full_s_avx(w, v, l, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_load_s_avx((in), (*(addr)), step); \
+	op4s_sdl2_descale_s_avx((in), (v)); \
+	op4s_sdl2_shuffle_input_low_s_avx((in), (z), (r)); \
+	op4s_sdl6_op_s_avx((z), (w), (l), (r)); \
+	op4s_sdl6_update_s_avx((z), (l), (r)); \
+	(*(addr)) += 4; \
+} while(0)
+
+#define op4s_sdl6_pass_fwd_prolog_full_s_avx(w, v, l, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_load_s_avx((in), (*(addr)), step); \
+	op4s_sdl2_shuffle_input_low_s_avx((in), (z), (r)); \
+	op4s_sdl6_op_s_avx((z), (w), (l), (r)); \
+	op4s_sdl6_update_s_avx((z), (l), (r)); \
+	(*(addr)) += 4; \
+} while(0)
+
+#define op4s_sdl2_pass_fwd_prolog_light_s_avx(w, v, l, c, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_input_high_s_avx((in), (c), (r)); \
+	op4s_sdl2_op_s_avx((z), (c), (w), (l), (r)); \
+	op4s_sdl2_update_s_avx((c), (l), (r), (z)); \
+} while(0)
+
+#define op4s_sdl2_pass_inv_prolog_light_s_avx(w, v, l, c, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_input_high_s_avx((in), (c), (r)); \
+	op4s_sdl2_op_s_avx((z), (c), (w), (l), (r)); \
+	op4s_sdl2_update_s_avx((c), (l), (r), (z)); \
+} while(0)
+
+#define op4s_sdl6_pass_inv_prolog_light_s_avx(w, v, l, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_input_high_s_avx((in), (z), (r)); \
+	op4s_sdl6_op_s_avx((z), (w), (l), (r)); \
+	op4s_sdl6_update_s_avx((z), (l), (r)); \
+} while(0)
+
+#define op4s_sdl6_pass_fwd_prolog_light_s_avx(w, v, l, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_input_high_s_avx((in), (z), (r)); \
+	op4s_sdl6_op_s_avx((z), (w), (l), (r)); \
+	op4s_sdl6_update_s_avx((z), (l), (r)); \
+} while(0)
+
+#define op4s_sdl2_pass_fwd_core_light_s_avx(w, v, l, c, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_input_high_s_avx((in), (c), (r)); \
+	op4s_sdl2_op_s_avx((z), (c), (w), (l), (r)); \
+	op4s_sdl2_output_low_s_avx((out), (l), (z)); \
+	op4s_sdl2_update_s_avx((c), (l), (r), (z)); \
+} while(0)
+
+#define op4s_sdl2_pass_inv_core_light_s_avx(w, v, l, c, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_input_high_s_avx((in), (c), (r)); \
+	op4s_sdl2_op_s_avx((z), (c), (w), (l), (r)); \
+	op4s_sdl2_output_low_s_avx((out), (l), (z)); \
+	op4s_sdl2_update_s_avx((c), (l), (r), (z)); \
+} while(0)
+
+#define op4s_sdl6_pass_inv_core_light_s_avx(w, v, l, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_input_high_s_avx((in), (z), (r)); \
+	op4s_sdl6_op_s_avx((z), (w), (l), (r)); \
+	op4s_sdl2_output_low_s_avx((out), (l), (z)); \
+} while(0)
+
+#define op4s_sdl6_pass_fwd_core_light_s_avx(w, v, l, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_input_high_s_avx((in), (z), (r)); \
+	op4s_sdl6_op_s_avx((z), (w), (l), (r)); \
+	op4s_sdl2_output_low_s_avx((out), (l), (z)); \
+} while(0)
+
+#define op4s_sdl6_pass_inv_postcore_light_s_avx(w, v, l, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_input_high_s_avx((in), (z), (r)); \
+	op4s_sdl6_op_s_avx((z), (w), (l), (r)); \
+	op4s_sdl2_output_low_s_avx((out), (l), (z)); \
+	op4s_sdl6_update_s_avx((z), (l), (r)); \
+} while(0)
+
+#define op4s_sdl6_pass_fwd_postcore_light_s_avx(w, v, l, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_input_high_s_avx((in), (z), (r)); \
+	op4s_sdl6_op_s_avx((z), (w), (l), (r)); \
+	op4s_sdl2_output_low_s_avx((out), (l), (z)); \
+	op4s_sdl6_update_s_avx((z), (l), (r)); \
+} while(0)
+
+#define op4s_sdl2_pass_fwd_core_full_s_avx(w, v, l, c, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_load_s_avx((in), (*(addr)), step); \
+	op4s_sdl2_shuffle_input_low_s_avx((in), (c), (r)); \
+	op4s_sdl2_op_s_avx((z), (c), (w), (l), (r)); \
+	op4s_sdl2_output_high_s_avx((out), (l), (z)); \
+	op4s_sdl2_scale_s_avx((out), (v)); \
+	op4s_sdl2_save_shift_s_avx((out), (*(addr))-12, step); \
+	op4s_sdl2_update_s_avx((c), (l), (r), (z)); \
+	(*(addr)) += 4; \
+} while(0)
+
+#define op4s_sdl2_pass_inv_core_full_s_avx(w, v, l, c, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_load_s_avx((in), (*(addr)), step); \
+	op4s_sdl2_descale_s_avx((in), (v)); \
+	op4s_sdl2_shuffle_input_low_s_avx((in), (c), (r)); \
+	op4s_sdl2_op_s_avx((z), (c), (w), (l), (r)); \
+	op4s_sdl2_output_high_s_avx((out), (l), (z)); \
+	op4s_sdl2_save_shift_s_avx((out), (*(addr))-12, step); \
+	op4s_sdl2_update_s_avx((c), (l), (r), (z)); \
+	(*(addr)) += 4; \
+} while(0)
+
+#define op4s_sdl6_pass_inv_core_full_s_avx(w, v, l, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_load_s_avx((in), (*(addr)), step); \
+	op4s_sdl2_descale_s_avx((in), (v)); \
+	op4s_sdl2_shuffle_input_low_s_avx((in), (z), (r)); \
+	op4s_sdl6_op_s_avx((z), (w), (l), (r)); \
+	op4s_sdl2_output_high_s_avx((out), (l), (z)); \
+	op4s_sdl2_save_shift_s_avx((out), (*(addr))-12, step); \
+	(*(addr)) += 4; \
+} while(0)
+
+#define op4s_sdl6_pass_fwd_core_full_s_avx(w, v, l, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_load_s_avx((in), (*(addr)), step); \
+	op4s_sdl2_shuffle_input_low_s_avx((in), (z), (r)); \
+	op4s_sdl6_op_s_avx((z), (w), (l), (r)); \
+	op4s_sdl2_output_high_s_avx((out), (l), (z)); \
+	op4s_sdl2_scale_s_avx((out), (v)); \
+	op4s_sdl2_save_shift_s_avx((out), (*(addr))-12, step); \
+	(*(addr)) += 4; \
+} while(0)
+
+#define op4s_sdl6_pass_inv_postcore_full_s_avx(w, v, l, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_load_s_avx((in), (*(addr)), step); \
+	op4s_sdl2_descale_s_avx((in), (v)); \
+	op4s_sdl2_shuffle_input_low_s_avx((in), (z), (r)); \
+	op4s_sdl6_op_s_avx((z), (w), (l), (r)); \
+	op4s_sdl2_output_high_s_avx((out), (l), (z)); \
+	op4s_sdl2_save_shift_s_avx((out), (*(addr))-12, step); \
+	op4s_sdl6_update_s_avx((z), (l), (r)); \
+	(*(addr)) += 4; \
+} while(0)
+
+#define op4s_sdl6_pass_fwd_postcore_full_s_avx(w, v, l, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_load_s_avx((in), (*(addr)), step); \
+	op4s_sdl2_shuffle_input_low_s_avx((in), (z), (r)); \
+	op4s_sdl6_op_s_avx((z), (w), (l), (r)); \
+	op4s_sdl2_output_high_s_avx((out), (l), (z)); \
+	op4s_sdl2_scale_s_avx((out), (v)); \
+	op4s_sdl2_save_shift_s_avx((out), (*(addr))-12, step); \
+	op4s_sdl6_update_s_avx((z), (l), (r)); \
+	(*(addr)) += 4; \
+} while(0)
+
+#define op4s_sdl2_pass_fwd_epilog_full_s_avx(w, v, l, c, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_s_avx((c), (r)); \
+	op4s_sdl2_op_s_avx((z), (c), (w), (l), (r)); \
+	op4s_sdl2_output_high_s_avx((out), (l), (z)); \
+	op4s_sdl2_scale_s_avx((out), (v)); \
+	op4s_sdl2_save_shift_s_avx((out), (*(addr))-12, step); \
+	op4s_sdl2_update_s_avx((c), (l), (r), (z)); \
+	(*(addr)) += 4; \
+} while(0)
+
+#define op4s_sdl2_pass_inv_epilog_full_s_avx(w, v, l, c, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_s_avx((c), (r)); \
+	op4s_sdl2_op_s_avx((z), (c), (w), (l), (r)); \
+	op4s_sdl2_output_high_s_avx((out), (l), (z)); \
+	op4s_sdl2_save_shift_s_avx((out), (*(addr))-12, step); \
+	op4s_sdl2_update_s_avx((c), (l), (r), (z)); \
+	(*(addr)) += 4; \
+} while(0)
+
+#define op4s_sdl6_pass_inv_epilog_full_s_avx(w, v, l, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_s_avx((z), (r)); \
+	op4s_sdl6_op_s_avx((z), (w), (l), (r)); \
+	op4s_sdl2_output_high_s_avx((out), (l), (z)); \
+	op4s_sdl2_save_shift_s_avx((out), (*(addr))-12, step); \
+	op4s_sdl6_update_s_avx((z), (l), (r)); \
+	(*(addr)) += 4; \
+} while(0)
+
+#define op4s_sdl6_pass_fwd_epilog_full_s_avx(w, v, l, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_s_avx((z), (r)); \
+	op4s_sdl6_op_s_avx((z), (w), (l), (r)); \
+	op4s_sdl2_output_high_s_avx((out), (l), (z)); \
+	op4s_sdl2_scale_s_avx((out), (v)); \
+	op4s_sdl2_save_shift_s_avx((out), (*(addr))-12, step); \
+	op4s_sdl6_update_s_avx((z), (l), (r)); \
+	(*(addr)) += 4; \
+} while(0)
+
+#define op4s_sdl2_pass_fwd_epilog_light_s_avx(w, v, l, c, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_s_avx((c), (r)); \
+	op4s_sdl2_op_s_avx((z), (c), (w), (l), (r)); \
+	op4s_sdl2_output_low_s_avx((out), (l), (z)); \
+	op4s_sdl2_update_s_avx((c), (l), (r), (z)); \
+} while(0)
+
+#define op4s_sdl2_pass_inv_epilog_light_s_avx(w, v, l, c, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_s_avx((c), (r)); \
+	op4s_sdl2_op_s_avx((z), (c), (w), (l), (r)); \
+	op4s_sdl2_output_low_s_avx((out), (l), (z)); \
+	op4s_sdl2_update_s_avx((c), (l), (r), (z)); \
+} while(0)
+
+#define op4s_sdl6_pass_inv_epilog_light_s_avx(w, v, l, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_s_avx((z), (r)); \
+	op4s_sdl6_op_s_avx((z), (w), (l), (r)); \
+	op4s_sdl2_output_low_s_avx((out), (l), (z)); \
+	op4s_sdl6_update_s_avx((z), (l), (r)); \
+} while(0)
+
+#define op4s_sdl6_pass_fwd_epilog_light_s_avx(w, v, l, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_s_avx((z), (r)); \
+	op4s_sdl6_op_s_avx((z), (w), (l), (r)); \
+	op4s_sdl2_output_low_s_avx((out), (l), (z)); \
+	op4s_sdl6_update_s_avx((z), (l), (r)); \
+} while(0)
+
+#define op4s_sdl2_pass_fwd_epilog_flush_s_avx(w, v, l, c, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_s_avx((c), (r)); \
+	op4s_sdl2_op_s_avx((z), (c), (w), (l), (r)); \
+	op4s_sdl2_output_low_s_avx((out), (l), (z)); \
+	op4s_sdl2_scale_s_avx((out), (v)); \
+	op4s_sdl2_save_s_avx((out), (*(addr))-12, step); \
+	op4s_sdl2_update_s_avx((c), (l), (r), (z)); \
+} while(0)
+
+#define op4s_sdl2_pass_inv_epilog_flush_s_avx(w, v, l, c, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_s_avx((c), (r)); \
+	op4s_sdl2_op_s_avx((z), (c), (w), (l), (r)); \
+	op4s_sdl2_output_low_s_avx((out), (l), (z)); \
+	op4s_sdl2_save_s_avx((out), (*(addr))-12, step); \
+	op4s_sdl2_update_s_avx((c), (l), (r), (z)); \
+} while(0)
+
+#define op4s_sdl6_pass_inv_epilog_flush_s_avx(w, v, l, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_s_avx((z), (r)); \
+	op4s_sdl6_op_s_avx((z), (w), (l), (r)); \
+	op4s_sdl2_output_low_s_avx((out), (l), (z)); \
+	op4s_sdl2_save_s_avx((out), (*(addr))-12, step); \
+	op4s_sdl6_update_s_avx((z), (l), (r)); \
+} while(0)
+
+#define op4s_sdl6_pass_fwd_epilog_flush_s_avx(w, v, l, r, z, in, out, addr, step) \
+do { \
+	op4s_sdl2_shuffle_s_avx((z), (r)); \
+	op4s_sdl6_op_s_avx((z), (w), (l), (r)); \
+	op4s_sdl2_output_low_s_avx((out), (l), (z)); \
+	op4s_sdl2_scale_s_avx((out), (v)); \
+	op4s_sdl2_save_s_avx((out), (*(addr))-12, step); \
+	op4s_sdl6_update_s_avx((z), (l), (r)); \
+} while(0)
+
+#define op4s_sdl_pass_fwd_prolog_stride_s_avx(w, v, l, c, r, z, in, out, addr, stride, step) \
+do { \
+	op4s_sdl2_shuffle_s_avx(c, r); \
+	op4s_sdl_load_stride_s_avx(in, addr1_s(*addr,4,stride), stride, step); \
+	op4s_sdl2_input_low_s_avx(in, c, r); \
+	op4s_sdl2_op_s_avx(z, c, w, l, r); \
+	op4s_sdl2_update_s_avx(c, l, r, z); \
+	*addr = addr1_s(*addr,2,stride); \
+} while(0)
+
+#define op4s_sdl_pass_fwd_core_stride_s_avx(w, v, l, c, r, z, in, out, addr, stride, step) \
+do { \
+	op4s_sdl2_shuffle_s_avx(c, r); \
+	op4s_sdl_load_stride_s_avx(in, addr1_s(*addr,4,stride), stride, step); \
+	op4s_sdl2_input_low_s_avx(in, c, r); \
+	op4s_sdl2_op_s_avx(z, c, w, l, r); \
+	op4s_sdl2_output_low_s_avx(out, l, z); \
+	op4s_sdl2_scale_s_avx(out, v); \
+	op4s_sdl_save_stride_s_avx(out, addr1_s(*addr,-6,stride), stride, step); \
+	op4s_sdl2_update_s_avx(c, l, r, z); \
+	*addr = addr1_s(*addr,2,stride); \
+} while(0)
+
+#define op4s_sdl_pass_fwd_epilog_stride_s_avx(w,v,l,c,r,z,in,out,addr,stride,step) \
+do { \
+	op4s_sdl2_shuffle_s_avx(c, r); \
+	op4s_sdl2_op_s_avx(z, c, w, l, r); \
+	op4s_sdl2_output_low_s_avx(out, l, z); \
+	op4s_sdl2_scale_s_avx(out, v); \
+	op4s_sdl_save_stride_s_avx(out, addr1_s(*addr,-6,stride), stride, step); \
+	op4s_sdl2_update_s_avx(c, l, r, z); \
+	(*addr) = addr1_s(*addr,2,stride); \
+} while(0)
+
+#define accel_lift_op4s_fwd_main_sdl_stride_avx_part_prolog2_s(base,w,v,l,c,r,z,in,out,addr,stride,step) \
+do { \
+	op4s_sdl_import_stride_s_avx(l, base, 3, stride, step); \
+	op4s_sdl_pass_fwd_prolog_stride_s_avx(w, v, l, c, r, z, in, out, addr, stride, step); \
+	op4s_sdl_import_stride_s_avx(l, base, 2, stride, step); \
+	op4s_sdl_pass_fwd_prolog_stride_s_avx(w, v, l, c, r, z, in, out, addr, stride, step); \
+	op4s_sdl_import_stride_s_avx(l, base, 1, stride, step); \
+	op4s_sdl_pass_fwd_prolog_stride_s_avx(w, v, l, c, r, z, in, out, addr, stride, step); \
+	op4s_sdl_import_stride_s_avx(l, base, 0, stride, step); \
+} while(0)
+
+#define accel_lift_op4s_fwd_main_sdl_stride_avx_part_epilog2_s(base,w,v,l,c,r,z,in,out,addr,stride,step) \
+do { \
+	op4s_sdl_export_stride_s_avx(l, base, 3, stride, step); \
+	op4s_sdl_pass_fwd_epilog_stride_s_avx(w, v, l, c, r, z, in, out, addr, stride, step); \
+	op4s_sdl_export_stride_s_avx(l, base, 2, stride, step); \
+	op4s_sdl_pass_fwd_epilog_stride_s_avx(w, v, l, c, r, z, in, out, addr, stride, step); \
+	op4s_sdl_export_stride_s_avx(l, base, 1, stride, step); \
+	op4s_sdl_pass_fwd_epilog_stride_s_avx(w, v, l, c, r, z, in, out, addr, stride, step); \
+	op4s_sdl_export_stride_s_avx(l, base, 0, stride, step); \
+} while(0)
+
+/**
+ * @brief Shifted double-loop algorithm (2 iterations merged) processing pairs of workers.
+ */
+static
+void accel_lift_op4s_main_sdl2_avx_s(
+	float *restrict arr,
+	int steps,
+	float alpha,
+	float beta,
+	float gamma,
+	float delta,
+	float zeta,
+	int scaling)
+{
+	// 6+ coeffs implies 3+ steps
+	assert( steps >= 3 );
+
+	const __m256 w = { delta, gamma, beta, alpha, delta, gamma, beta, alpha };
+	const __m256 v = { 1/zeta, zeta, 1/zeta, zeta, 1/zeta, zeta, 1/zeta, zeta };
+	__m256 l = _mm256_setzero_ps();
+	__m256 c = _mm256_setzero_ps();
+	__m256 r = _mm256_setzero_ps();
+	__m256 z = _mm256_setzero_ps();
+	__m256 in;
+	__m256 out;
+
+	const int workers = dwt_util_get_num_workers();
+
+	const int S = steps-3;
+	const int T = S >> 1;
+
+	if( scaling < 0 )
+	{
+		// ****** inverse transform ******
+
+		for(int wrk = 0; wrk < workers; wrk += 2)
+		{
+			// *** init ***
+
+			float *addr = ASSUME_ALIGNED(calc_temp_offset2_s(arr, wrk, 0), 16);
+			assert( is_aligned_16(addr) );
+			float *base = addr;
+
+			// the odd worker is processed in both halves of the registers
+			const int step = ( wrk+1 < workers ) ? (int)( (intptr_t)calc_temp_offset2_s(arr, wrk+1, 0) - (intptr_t)addr ) : 0;
+			assert( is_aligned_16(addr1_s(addr, 1, step)) );
+
+			// *** prolog2 ***
+
+			// prolog2: import-preload
+			op4s_sdl2_preload_prolog_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+			// prolog2: import(3)
+			op4s_sdl2_import_s_avx(l, 3, out);
+
+			// prolog2: pass-prolog-full
+			op4s_sdl2_pass_inv_prolog_full_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+			// prolog2: import(2)
+			op4s_sdl2_import_s_avx(l, 2, out);
+
+			// prolog2: pass-prolog-light
+			op4s_sdl2_pass_inv_prolog_light_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+			// prolog2: import(1)
+			op4s_sdl2_import_s_avx(l, 1, out);
+
+			// prolog2: pass-prolog-full
+			op4s_sdl2_pass_inv_prolog_full_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+			// prolog2: import(0)
+			op4s_sdl2_import_s_avx(l, 0, out);
+
+			// *** core ***
+
+			// core: for t = 0 to T do
+			for(int t = 0; t < T; t++)
+			{
+				// core: pass-core-light
+				op4s_sdl2_pass_inv_core_light_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+				// core: pass-core-full
+				op4s_sdl2_pass_inv_core_full_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+			}
+
+			// core: if odd then
+			if( is_odd(S) )
+			{
+				// core: pass-core-light
+				op4s_sdl2_pass_inv_core_light_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+			}
+
+			// *** epilog2 ***
+
+			if( is_odd(S) )
+			{
+				// epilog2: export(3)
+				op4s_sdl2_export_s_avx(l, &base[2*steps], 3, step);
+
+				// epilog2: pass-epilog-full
+				op4s_sdl2_pass_inv_epilog_full_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+				// epilog2: export(2)
+				op4s_sdl2_export_s_avx(l, &base[2*steps], 2, step);
+
+				// epilog2: pass-epilog-light
+				op4s_sdl2_pass_inv_epilog_light_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+				// epilog2: export(1)
+				op4s_sdl2_export_s_avx(l, &base[2*steps], 1, step);
+
+				// epilog2: pass-epilog-full
+				op4s_sdl2_pass_inv_epilog_full_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+				// epilog2: export(0)
+				op4s_sdl2_export_s_avx(l, &base[2*steps], 0, step);
+			}
+			else
+			{
+				// epilog2: export(3)
+				op4s_sdl2_export_s_avx(l, &base[2*steps], 3, step);
+
+				// epilog2: pass-epilog-light
+				op4s_sdl2_pass_inv_epilog_light_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+				// epilog2: export(2)
+				op4s_sdl2_export_s_avx(l, &base[2*steps], 2, step);
+
+				// epilog2: pass-epilog-full
+				op4s_sdl2_pass_inv_epilog_full_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+				// epilog2: export(1)
+				op4s_sdl2_export_s_avx(l, &base[2*steps], 1, step);
+
+				// epilog2: pass-epilog-flush
+				op4s_sdl2_pass_inv_epilog_flush_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+				// epilog2: export(0)
+				op4s_sdl2_export_s_avx(l, &base[2*steps], 0, step);
+			}
+		}
+	}
+	else if ( scaling > 0 )
+	{
+		// ****** forward transform ******
+
+		for(int wrk = 0; wrk < workers; wrk += 2)
+		{
+			// *** init ***
+
+			float *addr = ASSUME_ALIGNED(calc_temp_offset2_s(arr, wrk, 0), 16);
+			assert( is_aligned_16(addr) );
+			float *base = addr;
+
+			// the odd worker is processed in both halves of the registers
+			const int step = ( wrk+1 < workers ) ? (int)( (intptr_t)calc_temp_offset2_s(arr, wrk+1, 0) - (intptr_t)addr ) : 0;
+			assert( is_aligned_16(addr1_s(addr, 1, step)) );
+
+			// *** prolog2 ***
+
+			// prolog2: import-preload
+			op4s_sdl2_preload_prolog_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+			// prolog2: import(3)
+			op4s_sdl2_import_s_avx(l, 3, out);
+
+			// prolog2: pass-prolog-full
+			op4s_sdl2_pass_fwd_prolog_full_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+			// prolog2: import(2)
+			op4s_sdl2_import_s_avx(l, 2, out);
+
+			// prolog2: pass-prolog-light
+			op4s_sdl2_pass_fwd_prolog_light_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+			// prolog2: import(1)
+			op4s_sdl2_import_s_avx(l, 1, out);
+
+			// prolog2: pass-prolog-full
+			op4s_sdl2_pass_fwd_prolog_full_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+			// prolog2: import(0)
+			op4s_sdl2_import_s_avx(l, 0, out);
+
+			// *** core ***
+
+			// core: for t = 0 to T do
+			for(int t = 0; t < T; t++)
+			{
+				// core: pass-core-light
+				op4s_sdl2_pass_fwd_core_light_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+				// core: pass-core-full
+				op4s_sdl2_pass_fwd_core_full_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+			}
+
+			// core: if odd then
+			if( is_odd(S) )
+			{
+				// core: pass-core-light
+				op4s_sdl2_pass_fwd_core_light_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+			}
+
+			// *** epilog2 ***
+
+			if( is_odd(S) )
+			{
+				// epilog2: export(3)
+				op4s_sdl2_export_s_avx(l, &base[2*steps], 3, step);
+
+				// epilog2: pass-epilog-full
+				op4s_sdl2_pass_fwd_epilog_full_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+				// epilog2: export(2)
+				op4s_sdl2_export_s_avx(l, &base[2*steps], 2, step);
+
+				// epilog2: pass-epilog-light
+				op4s_sdl2_pass_fwd_epilog_light_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+				// epilog2: export(1)
+				op4s_sdl2_export_s_avx(l, &base[2*steps], 1, step);
+
+				// epilog2: pass-epilog-full
+				op4s_sdl2_pass_fwd_epilog_full_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+				// epilog2: export(0)
+				op4s_sdl2_export_s_avx(l, &base[2*steps], 0, step);
+			}
+			else
+			{
+				// epilog2: export(3)
+				op4s_sdl2_export_s_avx(l, &base[2*steps], 3, step);
+
+				// epilog2: pass-epilog-light
+				op4s_sdl2_pass_fwd_epilog_light_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+				// epilog2: export(2)
+				op4s_sdl2_export_s_avx(l, &base[2*steps], 2, step);
+
+				// epilog2: pass-epilog-full
+				op4s_sdl2_pass_fwd_epilog_full_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+				// epilog2: export(1)
+				op4s_sdl2_export_s_avx(l, &base[2*steps], 1, step);
+
+				// epilog2: pass-epilog-flush
+				op4s_sdl2_pass_fwd_epilog_flush_s_avx(w, v, l, c, r, z, in, out, &addr, step);
+
+				// epilog2: export(0)
+				op4s_sdl2_export_s_avx(l, &base[2*steps], 0, step);
+			}
+		}
+	}
+	else
+	{
+		// ****** transform w/o scaling ******
+
+		// not implemented yet
+		dwt_util_abort();
+	}
+}
+
+/**
+ * @brief Shifted double-loop algorithm (6 iterations merged) processing pairs of workers.
+ */
+static
+void accel_lift_op4s_main_sdl6_avx_s(
+	float *restrict arr,
+	int steps,
+	float alpha,
+	float beta,
+	float gamma,
+	float delta,
+	float zeta,
+	int scaling)
+{
+	// 6+ coeffs implies 3+ steps
+	assert( steps >= 3 );
+
+	const __m256 w = { delta, gamma, beta, alpha, delta, gamma, beta, alpha };
+	const __m256 v = { 1/zeta, zeta, 1/zeta, zeta, 1/zeta, zeta, 1/zeta, zeta };
+	__m256 l = _mm256_setzero_ps();
+	__m256 r = _mm256_setzero_ps();
+	__m256 z = _mm256_setzero_ps();
+	__m256 in;
+	__m256 out;
+
+	const int workers = dwt_util_get_num_workers();
+
+	const int S = steps-3;
+	const int U = S / 6;
+	const int M = S % 6;
+	const int T = M >> 1;
+
+	if( scaling < 0 )
+	{
+		// ****** inverse transform ******
+
+		for(int wrk = 0; wrk < workers; wrk += 2)
+		{
+			// *** init ***
+
+			float *addr = ASSUME_ALIGNED(calc_temp_offset2_s(arr, wrk, 0), 16);
+			assert( is_aligned_16(addr) );
+			float *base = addr;
+
+			// the odd worker is processed in both halves of the registers
+			const int step = ( wrk+1 < workers ) ? (int)( (intptr_t)calc_temp_offset2_s(arr, wrk+1, 0) - (intptr_t)addr ) : 0;
+			assert( is_aligned_16(addr1_s(addr, 1, step)) );
+
+			// *** prolog2 ***
+
+			// prolog2: import-preload
+			op4s_sdl6_preload_prolog_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+			// prolog2: import(3)
+			op4s_sdl6_import_s_avx(l, 3, out);
+
+			// prolog2: pass-prolog-full
+			op4s_sdl6_pass_inv_prolog_full_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+			// prolog2: import(2)
+			op4s_sdl6_import_s_avx(l, 2, out);
+
+			// prolog2: pass-prolog-light
+			op4s_sdl6_pass_inv_prolog_light_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+			// prolog2: import(1)
+			op4s_sdl6_import_s_avx(l, 1, out);
+
+			// prolog2: pass-prolog-full
+			op4s_sdl6_pass_inv_prolog_full_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+			// prolog2: import(0)
+			op4s_sdl6_import_s_avx(l, 0, out);
+
+			// *** core ***
+
+			// core: for u = 0 to U
+			for(int u = 0; u < U; u++)
+			{
+				// NOTE: l, r, z
+
+				// core: pass1-core-light
+				op4s_sdl6_pass_inv_core_light_s_avx(w, v, /*l*/l, /*r*/r, /*z*/z, in, out, &addr, step);
+
+				// NOTE: z => l, l => r, r => z
+
+				// core: pass1-core-full
+				op4s_sdl6_pass_inv_core_full_s_avx(w, v, /*l*/r, /*r*/z, /*z*/l, in, out, &addr, step);
+
+				// NOTE: (r => z) => l, (z => l) => r, (l => r) => z
+
+				// core: pass2-core-light
+				op4s_sdl6_pass_inv_core_light_s_avx(w, v, /*l*/z, /*r*/l, /*z*/r, in, out, &addr, step);
+
+				// NOTE: ((l => r) => z) => l, ((r => z) => l) => r, ((z => l) => r) => z
+
+				// core: pass2-core-full
+				op4s_sdl6_pass_inv_core_full_s_avx(w, v, /*l*/l, /*r*/r, /*z*/z, in, out, &addr, step);
+
+				// NOTE: z => l, l => r, r => z
+
+				// core: pass3-core-light
+				op4s_sdl6_pass_inv_core_light_s_avx(w, v, /*l*/r, /*r*/z, /*z*/l, in, out, &addr, step);
+
+				// NOTE: (r => z) => l, (z => l) => r, (l => r) => z
+
+				// core: pass3-core-full
+				op4s_sdl6_pass_inv_core_full_s_avx(w, v, /*l*/z, /*r*/l, /*z*/r, in, out, &addr, step);
+
+				// NOTE: ((l => r) => z) => l, ((r => z) => l) => r, ((z => l) => r) => z
+			}
+
+			// core: for t = 0 to T do
+			for(int t = 0; t < T; t++)
+			{
+				// core: pass-core-light
+				op4s_sdl6_pass_inv_postcore_light_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+				// core: pass-core-full
+				op4s_sdl6_pass_inv_postcore_full_s_avx(w, v, l, r, z, in, out, &addr, step);
+			}
+
+			// core: if odd then
+			if( is_odd(S) )
+			{
+				// core: pass-core-light
+				op4s_sdl6_pass_inv_postcore_light_s_avx(w, v, l, r, z, in, out, &addr, step);
+			}
+
+			// *** epilog2 ***
+
+			if( is_odd(S) )
+			{
+				// epilog2: export(3)
+				op4s_sdl6_export_s_avx(l, &base[2*steps], 3, step);
+
+				// epilog2: pass-epilog-full
+				op4s_sdl6_pass_inv_epilog_full_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+				// epilog2: export(2)
+				op4s_sdl6_export_s_avx(l, &base[2*steps], 2, step);
+
+				// epilog2: pass-epilog-light
+				op4s_sdl6_pass_inv_epilog_light_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+				// epilog2: export(1)
+				op4s_sdl6_export_s_avx(l, &base[2*steps], 1, step);
+
+				// epilog2: pass-epilog-full
+				op4s_sdl6_pass_inv_epilog_full_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+				// epilog2: export(0)
+				op4s_sdl6_export_s_avx(l, &base[2*steps], 0, step);
+			}
+			else
+			{
+				// epilog2: export(3)
+				op4s_sdl6_export_s_avx(l, &base[2*steps], 3, step);
+
+				// epilog2: pass-epilog-light
+				op4s_sdl6_pass_inv_epilog_light_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+				// epilog2: export(2)
+				op4s_sdl6_export_s_avx(l, &base[2*steps], 2, step);
+
+				// epilog2: pass-epilog-full
+				op4s_sdl6_pass_inv_epilog_full_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+				// epilog2: export(1)
+				op4s_sdl6_export_s_avx(l, &base[2*steps], 1, step);
+
+				// epilog2: pass-epilog-flush
+				op4s_sdl6_pass_inv_epilog_flush_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+				// epilog2: export(0)
+				op4s_sdl6_export_s_avx(l, &base[2*steps], 0, step);
+			}
+		}
+	}
+	else if ( scaling > 0 )
+	{
+		// ****** forward transform ******
+
+		for(int wrk = 0; wrk < workers; wrk += 2)
+		{
+			// *** init ***
+
+			float *addr = ASSUME_ALIGNED(calc_temp_offset2_s(arr, wrk, 0), 16);
+			assert( is_aligned_16(addr) );
+			float *base = addr;
+
+			// the odd worker is processed in both halves of the registers
+			const int step = ( wrk+1 < workers ) ? (int)( (intptr_t)calc_temp_offset2_s(arr, wrk+1, 0) - (intptr_t)addr ) : 0;
+			assert( is_aligned_16(addr1_s(addr, 1, step)) );
+
+			// *** prolog2 ***
+
+			// prolog2: import-preload
+			op4s_sdl6_preload_prolog_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+			// prolog2: import(3)
+			op4s_sdl6_import_s_avx(l, 3, out);
+
+			// prolog2: pass-prolog-full
+			op4s_sdl6_pass_fwd_prolog_full_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+			// prolog2: import(2)
+			op4s_sdl6_import_s_avx(l, 2, out);
+
+			// prolog2: pass-prolog-light
+			op4s_sdl6_pass_fwd_prolog_light_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+			// prolog2: import(1)
+			op4s_sdl6_import_s_avx(l, 1, out);
+
+			// prolog2: pass-prolog-full
+			op4s_sdl6_pass_fwd_prolog_full_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+			// prolog2: import(0)
+			op4s_sdl6_import_s_avx(l, 0, out);
+
+			// *** core ***
+
+			// core: for u = 0 to U
+			for(int u = 0; u < U; u++)
+			{
+				// NOTE: l, r, z
+
+				// core: pass1-core-light
+				op4s_sdl6_pass_fwd_core_light_s_avx(w, v, /*l*/l, /*r*/r, /*z*/z, in, out, &addr, step);
+
+				// NOTE: z => l, l => r, r => z
+
+				// core: pass1-core-full
+				op4s_sdl6_pass_fwd_core_full_s_avx(w, v, /*l*/r, /*r*/z, /*z*/l, in, out, &addr, step);
+
+				// NOTE: (r => z) => l, (z => l) => r, (l => r) => z
+
+				// core: pass2-core-light
+				op4s_sdl6_pass_fwd_core_light_s_avx(w, v, /*l*/z, /*r*/l, /*z*/r, in, out, &addr, step);
+
+				// NOTE: ((l => r) => z) => l, ((r => z) => l) => r, ((z => l) => r) => z
+
+				// core: pass2-core-full
+				op4s_sdl6_pass_fwd_core_full_s_avx(w, v, /*l*/l, /*r*/r, /*z*/z, in, out, &addr, step);
+
+				// NOTE: z => l, l => r, r => z
+
+				// core: pass3-core-light
+				op4s_sdl6_pass_fwd_core_light_s_avx(w, v, /*l*/r, /*r*/z, /*z*/l, in, out, &addr, step);
+
+				// NOTE: (r => z) => l, (z => l) => r, (l => r) => z
+
+				// core: pass3-core-full
+				op4s_sdl6_pass_fwd_core_full_s_avx(w, v, /*l*/z, /*r*/l, /*z*/r, in, out, &addr, step);
+
+				// NOTE: ((l => r) => z) => l, ((r => z) => l) => r, ((z => l) => r) => z
+			}
+
+			// core: for t = 0 to T do
+			for(int t = 0; t < T; t++)
+			{
+				// core: pass-core-light
+				op4s_sdl6_pass_fwd_postcore_light_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+				// core: pass-core-full
+				op4s_sdl6_pass_fwd_postcore_full_s_avx(w, v, l, r, z, in, out, &addr, step);
+			}
+
+			// core: if odd then
+			if( is_odd(S) )
+			{
+				// core: pass-core-light
+				op4s_sdl6_pass_fwd_postcore_light_s_avx(w, v, l, r, z, in, out, &addr, step);
+			}
+
+			// *** epilog2 ***
+
+			if( is_odd(S) )
+			{
+				// epilog2: export(3)
+				op4s_sdl6_export_s_avx(l, &base[2*steps], 3, step);
+
+				// epilog2: pass-epilog-full
+				op4s_sdl6_pass_fwd_epilog_full_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+				// epilog2: export(2)
+				op4s_sdl6_export_s_avx(l, &base[2*steps], 2, step);
+
+				// epilog2: pass-epilog-light
+				op4s_sdl6_pass_fwd_epilog_light_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+				// epilog2: export(1)
+				op4s_sdl6_export_s_avx(l, &base[2*steps], 1, step);
+
+				// epilog2: pass-epilog-full
+				op4s_sdl6_pass_fwd_epilog_full_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+				// epilog2: export(0)
+				op4s_sdl6_export_s_avx(l, &base[2*steps], 0, step);
+			}
+			else
+			{
+				// epilog2: export(3)
+				op4s_sdl6_export_s_avx(l, &base[2*steps], 3, step);
+
+				// epilog2: pass-epilog-light
+				op4s_sdl6_pass_fwd_epilog_light_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+				// epilog2: export(2)
+				op4s_sdl6_export_s_avx(l, &base[2*steps], 2, step);
+
+				// epilog2: pass-epilog-full
+				op4s_sdl6_pass_fwd_epilog_full_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+				// epilog2: export(1)
+				op4s_sdl6_export_s_avx(l, &base[2*steps], 1, step);
+
+				// epilog2: pass-epilog-flush
+				op4s_sdl6_pass_fwd_epilog_flush_s_avx(w, v, l, r, z, in, out, &addr, step);
+
+				// epilog2: export(0)
+				op4s_sdl6_export_s_avx(l, &base[2*steps], 0, step);
+			}
+		}
+	}
+	else
+	{
+		// ****** transform w/o scaling ******
+
+		// not implemented yet
+		dwt_util_abort();
+	}
+}
+
+/**
+ * @brief Shifted double-loop algorithm processing two lines at once.
+ *
+ * The lines start at @e arr and @e arr shifted by @e step bytes.
+ */
+static
+void accel_lift_op4s_fwd_main_sdl_stride_avx_s(
+	float *arr,
+	int steps,
+	float alpha,
+	float beta,
+	float gamma,
+	float delta,
+	float zeta,
+	int scaling,
+	int stride,
+	int step
+)
+{
+	assert( scaling > 0 );
+	assert( 1 == dwt_util_get_num_workers() );
+
+	if( steps < 3 )
+	{
+		accel_lift_op4s_fwd_main_sdl_stride_ref_part_exception_s(arr, steps, alpha, beta, gamma, delta, zeta, scaling, stride);
+		accel_lift_op4s_fwd_main_sdl_stride_ref_part_exception_s(addr1_s(arr, 1, step), steps, alpha, beta, gamma, delta, zeta, scaling, stride);
+
+		return;
+	}
+
+	const __m256 w = { delta, gamma, beta, alpha, delta, gamma, beta, alpha };
+	const __m256 v = { 1/zeta, zeta, 1/zeta, zeta, 1/zeta, zeta, 1/zeta, zeta };
+
+	__m256 l = _mm256_setzero_ps();
+	__m256 c = _mm256_setzero_ps();
+	__m256 r = _mm256_setzero_ps();
+	__m256 z = _mm256_setzero_ps();
+	__m256 in;
+	__m256 out;
+
+	const int S = steps-3;
+
+	// *** init ***
+	float *addr = arr;
+
+	// *** prolog2 ***
+	accel_lift_op4s_fwd_main_sdl_stride_avx_part_prolog2_s(arr, w, v, l, c, r, z, in, out, &addr, stride, step);
+
+	// *** core ***
+	for(int s = 0; s < S; s++)
+	{
+		// core: pass-core
+		op4s_sdl_pass_fwd_core_stride_s_avx(w, v, l, c, r, z, in, out, &addr, stride, step);
+	}
+
+	// *** epilog2 ***
+	accel_lift_op4s_fwd_main_sdl_stride_avx_part_epilog2_s(addr1_s(arr,2*steps,stride), w, v, l, c, r, z, in, out, &addr, stride, step);
+}
+
+#pragma GCC pop_options
+#endif /* ENABLE_AVX */
+
+#ifdef __x86_64__
+static
+void accel_lift_op4s_main_dl_nosse_s(
+	float *arr,
+	int steps,
+	float alpha,
+	float beta,
+	float gamma,
+	float delta,
+	float zeta,
+	int scaling)
+// this long string disables SSE support (only no-sse is not enough)
+__attribute__ ((__target__ ("no-mmx,no-sse,no-sse2,no-sse3,no-sse4,no-sse4.1")));
+#endif
+static
+void accel_lift_op4s_main_dl_nosse_s(
+	float *arr,
+	int steps,
+	float alpha,
+	float beta,
+	float gamma,
+	float delta,
+	float zeta,
+	int scaling)
+{
+	assert( steps >= 0 );
+
+	if( scaling < 0 )
+	{
+		for(int w = 0; w < dwt_util_get_num_workers(); w++)
+		{
+			float *arr_local = calc_temp_offset2_s(arr, w, 0);
+
+			// constants
+			const float w[4] = { delta, gamma, beta, alpha };
+			const float v[2] = { 1/zeta, zeta };
+
+			// aux. variables
+			float in[2];
+			float out[2];
+			float r[4];
+			float c[4];
+			float l[4];
+
+			// values that have to be passed from iteration to iteration
+			// slide in left border
+			l[0] = arr_local[0];
+			l[1] = arr_local[1];
+			l[2] = arr_local[2];
+			l[3] = arr_local[3];
+
+			// init
+			float *addr = arr_local + 4;
+
+			// loop by pairs from left to right
+			for(int s = 0; s < steps; s++)
+			{
+				// inputs
+				in[0] = addr[0];
+				in[1] = addr[1];
+
+				// scales
+				in[0] = in[0] * v[0];
+				in[1] = in[1] * v[1];
+
+				// shuffles
+				out[0] = l[0];
+				c[0]   = l[1];
+				c[1]   = l[2];
+				c[2]   = l[3];
+				c[3]   = in[0];
+
+				// operation z[] = c[] + w[] * ( l[] + r[] )
+				// by sequential computation from top/right to bottom/left
+				r[3]   = in[1];
+				r[2]   = c[3]+w[3]*(l[3]+r[3]);
+				r[1]   = c[2]+w[2]*(l[2]+r[2]);
+				r[0]   = c[1]+w[1]*(l[1]+r[1]);
+				out[1] = c[0]+w[0]*(l[0]+r[0]);
+
+				// outputs
+				addr[0-4] = out[0];
+				addr[1-4] = out[1];
+
+				// update l[]
+				l[0] = r[0];
+				l[1] = r[1];
+				l[2] = r[2];
+				l[3] = r[3];
+
+				// pointers
+				addr += 2;
+			}
+
+			// slide out right border
+			addr[0-4] = l[0];
+			addr[1-4] = l[1];
+			addr[2-4] = l[2];
+			addr[3-4] = l[3];
+		}
+	}
+	else if ( scaling > 0 )
+	{
+		for(int w = 0; w < dwt_util_get_num_workers(); w++)
+		{
+			float *arr_local = calc_temp_offset2_s(arr, w, 0);
+
+			// constants
+			const float w[4] = { delta, gamma, beta, alpha };
+			const float v[2] = { 1/zeta, zeta };
+
+			// aux. variables
+			float in[2];
+			float out[2];
+			float r[4];
+			float c[4];
+			float l[4];
+
+			// values that have to be passed from iteration to iteration
+			// slide in left border
+			l[0] = arr_local[0];
+			l[1] = arr_local[1];
+			l[2] = arr_local[2];
+			l[3] = arr_local[3];
+
+			// init
+			float *addr = arr_local + 4;
+
+			// loop by pairs from left to right
+			for(int s = 0; s < steps; s++)
+			{
+				// inputs
+				in[0] = addr[0];
+				in[1] = addr[1];
+
+				// shuffles
+				out[0] = l[0];
+				c[0]   = l[1];
+				c[1]   = l[2];
+				c[2]   = l[3];
+				c[3]   = in[0];
+
+				// operation z[] = c[] + w[] * ( l[] + r[] )
+				// by sequential computation from top/right to bottom/left
+				r[3]   = in[1];
+				r[2]   = c[3]+w[3]*(l[3]+r[3]);
+				r[1]   = c[2]+w[2]*(l[2]+r[2]);
+				r[0]   = c[1]+w[1]*(l[1]+r[1]);
+				out[1] = c[0]+w[0]*(l[0]+r[0]);
+
+				// scales
+				out[0] = out[0] * v[0];
+				out[1] = out[1] * v[1];
+
+				// outputs
+				addr[0-4] = out[0];
+				addr[1-4] = out[1];
+
+				// update l[]
+				l[0] = r[0];
+				l[1] = r[1];
+				l[2] = r[2];
+				l[3] = r[3];
+
+				// pointers
+				addr += 2;
+			}
+
+			// slide out right border
+			addr[0-4] = l[0];
+			addr[1-4] = l[1];
+			addr[2-4] = l[2];
+			addr[3-4] = l[3];
+		}
+	}
+	else
+	{
+		// fallback, not implemented
+		accel_lift_op4s_main_s(arr, steps, alpha, beta, gamma, delta, zeta, scaling);
+	}
+}
+
+/**
+ * @brief Double-loop algorithm from Rade Kutil: A Single-Loop Approach to
+ * SIMD Parallelization of 2-D Wavelet Lifting.
  */
 static
 void accel_lift_op4s_main_dl_s(
@@ -10651,6 +11894,10 @@ void accel_lift_op4s_s(
 
 			if( steps < 3 )
 				accel_lift_op4s_main_s(arr+off, steps, alpha, beta, gamma, delta, zeta, scaling);
+#ifdef ENABLE_AVX
+			else if( get_avx() && dwt_util_get_num_workers() > 1 )
+				accel_lift_op4s_main_sdl2_avx_s(arr+off, steps, alpha, beta, gamma, delta, zeta, scaling);
+#endif
 			else
 #ifdef __SSE__
 				accel_lift_op4s_main_sdl2_sse_s(arr+off, steps, alpha, beta, gamma, delta, zeta, scaling);
@@ -10664,6 +11911,10 @@ void accel_lift_op4s_s(
 
 			if( steps < 3 )
 				accel_lift_op4s_main_s(arr+off, steps, alpha, beta, gamma, delta, zeta, scaling);
+#ifdef ENABLE_AVX
+			else if( get_avx() && dwt_util_get_num_workers() > 1 )
+				accel_lift_op4s_main_sdl6_avx_s(arr+off, steps, alpha, beta, gamma, delta, zeta, scaling);
+#endif
 			else
 			{
 #ifdef __SSE__
@@ -10875,29 +12126,549 @@ void dwt_cdf97_f_ex_stride_inplace_part_core_sdl_sse_s(
 {
 	const int offset = 1;
 
-	accel_lift_op4s_fwd_main_sdl_stride_sse_s(addr1_s(ptr, offset, stride), (to_even(N-offset)-4)/2, -dwt_cdf97_p1_s, dwt_cdf97_u1_s, -dwt_cdf97_p2_s, dwt_cdf97_u2_s, dwt_cdf97_s1_s, +1, stride);
+	accel_lift_op4s_fwd_main_sdl_stride_sse_s(addr1_s(ptr, offset, stride), (to_even(N-offset)-4)/2, -dwt_cdf97_p1_s, dwt_cdf97_u1_s, -dwt_cdf97_p2_s, dwt_cdf97_u2_s, dwt_cdf97_s1_s, +1, stride);
+}
+#endif
+
+#ifdef ENABLE_AVX
+/**
+ * @brief Core of the shifted double-loop for two lines, the second one is @e step bytes after @e ptr.
+ */
+static
+void dwt_cdf97_f_ex_stride_inplace_part_core_sdl_avx_s(
+	float *ptr,
+	int N,
+	int stride,
+	int step
+)
+{
+	const int offset = 1;
+
+	accel_lift_op4s_fwd_main_sdl_stride_avx_s(addr1_s(ptr, offset, stride), (to_even(N-offset)-4)/2, -dwt_cdf97_p1_s, dwt_cdf97_u1_s, -dwt_cdf97_p2_s, dwt_cdf97_u2_s, dwt_cdf97_s1_s, +1, stride, step);
+}
+#endif
+
+static
+void dwt_cdf97_f_ex_stride_inplace_part_epilog_s(
+	float *ptr,
+	int N,
+	int stride
+)
+{
+	const int offset = 1;
+
+	accel_lift_op4s_epilog_stride_s(ptr, offset, N, -dwt_cdf97_p1_s, dwt_cdf97_u1_s, -dwt_cdf97_p2_s, dwt_cdf97_u2_s, dwt_cdf97_s1_s, +1, stride);
+}
+
+/*
+ * CDF 9/7 (4,4)
+ * http://www.ece.uvic.ca/~frodo/publications/phdthesis.pdf
+ * * 9/7-F, p. 88, 89
+ * * [24] M. Antonini, M. Barlaud, P. Mathieu, and I. Daubechies. Image coding using wavelet transform. IEEE Trans. on Image Processing, 1(2):205–220, April 1992.
+ * * [40] A. R. Calderbank, I. Daubechies,W. Sweldens, and B.-L. Yeo. Wavelet transforms that map integers to integers. Applied and Computational Harmonic Analysis, 5(3):332–369, July 1998.
+ */
+/**
+ * One lifting step of the integer transforms on deinterleaved samples,
+ * dst[k] += sign * ( ( w * (a[k] + b[k]) + c ) >> s ).
+ */
+struct lift_int_step {
+	int odd;	///< predict (odd samples) if nonzero, update (even samples) otherwise
+	int w;		///< weight
+	int c;		///< rounding constant
+	int s;		///< shift
+	int sign;	///< +1 or -1
+};
+
+// reversible 5/3, see dwt_cdf53_f_ex_stride_i
+static const struct lift_int_step cdf53_fwd_steps_i[] = {
+	{ 1, 1, 0, 1, -1 },
+	{ 0, 1, 2, 2, +1 },
+};
+
+static const struct lift_int_step cdf53_inv_steps_i[] = {
+	{ 0, 1, 2, 2, -1 },
+	{ 1, 1, 0, 1, +1 },
+};
+
+// fixed-point 9/7, see dwt_cdf97_f_ex_stride_i
+static const struct lift_int_step cdf97_fwd_steps_i[] = {
+	{ 1, +203, -(1<<6), 7, -1 },
+	{ 0, -217, +(1<<11), 12, +1 },
+	{ 1, -113, -(1<<6), 7, -1 },
+	{ 0, 1817, +(1<<11), 12, +1 },
+};
+
+static const struct lift_int_step cdf97_inv_steps_i[] = {
+	{ 0, 1817, +(1<<11), 12, -1 },
+	{ 1, -113, -(1<<6), 7, +1 },
+	{ 0, -217, +(1<<11), 12, -1 },
+	{ 1, +203, -(1<<6), 7, +1 },
+};
+
+// fixed-point 9/7, see dwt_cdf97_f_ex_stride_inplace_i
+static const struct lift_int_step cdf97_fwd_inplace_steps_i[] = {
+	{ 1, -203, +(1<<6), 7, +1 },
+	{ 0, -217, +(1<<11), 12, +1 },
+	{ 1, +113, +(1<<6), 7, +1 },
+	{ 0, 1817, +(1<<11), 12, +1 },
+};
+
+static const struct lift_int_step cdf97_inv_inplace_steps_i[] = {
+	{ 0, 1817, +(1<<11), 12, -1 },
+	{ 1, +113, +(1<<6), 7, -1 },
+	{ 0, -217, +(1<<11), 12, -1 },
+	{ 1, -203, +(1<<6), 7, -1 },
+};
+
+static
+void lift_int_step_i(
+	int *dst,
+	const int *a,
+	const int *b,
+	int n,
+	const struct lift_int_step *step)
+{
+	for(int k = 0; k < n; k++)
+	{
+		const int v = ( step->w * (a[k] + b[k]) + step->c ) >> step->s;
+
+		if( step->sign > 0 )
+			dst[k] += v;
+		else
+			dst[k] -= v;
+	}
+}
+
+#ifdef ENABLE_AVX
+#pragma GCC push_options
+#pragma GCC target("sse4.1")
+static
+void lift_int_step_sse41_i(
+	int *dst,
+	const int *a,
+	const int *b,
+	int n,
+	const struct lift_int_step *step)
+{
+	const __m128i w = _mm_set1_epi32(step->w);
+	const __m128i c = _mm_set1_epi32(step->c);
+	const __m128i s = _mm_cvtsi32_si128(step->s);
+
+	int k = 0;
+
+	for(; k+4 <= n; k += 4)
+	{
+		__m128i t = _mm_add_epi32(_mm_loadu_si128((const __m128i *)(a+k)), _mm_loadu_si128((const __m128i *)(b+k)));
+
+		if( 1 != step->w )
+			t = _mm_mullo_epi32(t, w);
+
+		t = _mm_sra_epi32(_mm_add_epi32(t, c), s);
+
+		const __m128i d = _mm_loadu_si128((const __m128i *)(dst+k));
+
+		_mm_storeu_si128((__m128i *)(dst+k), step->sign > 0 ? _mm_add_epi32(d, t) : _mm_sub_epi32(d, t));
+	}
+
+	lift_int_step_i(dst+k, a+k, b+k, n-k, step);
+}
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+static
+void lift_int_step_avx2_i(
+	int *dst,
+	const int *a,
+	const int *b,
+	int n,
+	const struct lift_int_step *step)
+{
+	const __m256i w = _mm256_set1_epi32(step->w);
+	const __m256i c = _mm256_set1_epi32(step->c);
+	const __m128i s = _mm_cvtsi32_si128(step->s);
+
+	int k = 0;
+
+	for(; k+8 <= n; k += 8)
+	{
+		__m256i t = _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)(a+k)), _mm256_loadu_si256((const __m256i *)(b+k)));
+
+		if( 1 != step->w )
+			t = _mm256_mullo_epi32(t, w);
+
+		t = _mm256_sra_epi32(_mm256_add_epi32(t, c), s);
+
+		const __m256i d = _mm256_loadu_si256((const __m256i *)(dst+k));
+
+		_mm256_storeu_si256((__m256i *)(dst+k), step->sign > 0 ? _mm256_add_epi32(d, t) : _mm256_sub_epi32(d, t));
+	}
+
+	lift_int_step_i(dst+k, a+k, b+k, n-k, step);
+}
+#pragma GCC pop_options
+#endif /* ENABLE_AVX */
+
+/** SSE4.1 support, detected on the first use */
+static int lift_int_sse41 = -1;
+
+static
+void lift_int_step_dispatch_i(
+	int *dst,
+	const int *a,
+	const int *b,
+	int n,
+	const struct lift_int_step *step)
+{
+#ifdef ENABLE_AVX
+	if( get_avx() )
+	{
+		lift_int_step_avx2_i(dst, a, b, n, step);
+		return;
+	}
+
+	if( lift_int_sse41 < 0 )
+	{
+		__builtin_cpu_init();
+		lift_int_sse41 = __builtin_cpu_supports("sse4.1");
+	}
+
+	if( lift_int_sse41 )
+	{
+		lift_int_step_sse41_i(dst, a, b, n, step);
+		return;
+	}
+#endif
+	lift_int_step_i(dst, a, b, n, step);
+}
+
+/**
+ * Integer lifting of a deinterleaved signal of length N >= 2, the even
+ * samples in E[ceil(N/2)], the odd ones in O[floor(N/2)]. The signal is
+ * extended symmetrically, as in the scalar implementations.
+ */
+static
+void lift_int_line_i(
+	int *E,
+	int *O,
+	int N,
+	const struct lift_int_step *steps,
+	int count)
+{
+	const int nE = ceil_div2(N);
+	const int nO = floor_div2(N);
+
+	for(int t = 0; t < count; t++)
+	{
+		const struct lift_int_step *step = &steps[t];
+
+		if( step->odd )
+		{
+			lift_int_step_dispatch_i(O, E, E+1, nE-1, step);
+
+			if( is_even(N) )
+				lift_int_step_i(O+nO-1, E+nE-1, E+nE-1, 1, step);
+		}
+		else
+		{
+			lift_int_step_i(E, O, O, 1, step);
+
+			lift_int_step_dispatch_i(E+1, O, O+1, nO-1, step);
+
+			if( is_odd(N) )
+				lift_int_step_i(E+nE-1, O+nO-1, O+nO-1, 1, step);
+		}
+	}
+}
+
+// the number of columns transformed at once by lift_int_cols_i
+#define LIFT_INT_COLS 256
+
+/**
+ * The same as lift_int_line_i, but the N samples are rows of @p cols
+ * contiguous integers, i.e. @p cols columns are transformed at once.
+ */
+static
+void lift_int_cols_i(
+	void *ptr,
+	int N,
+	int stride,
+	int cols,
+	const struct lift_int_step *steps,
+	int count)
+{
+	// fix for small N
+	if(N < 2)
+		return;
+
+	for(int t = 0; t < count; t++)
+	{
+		const struct lift_int_step *step = &steps[t];
+
+		if( step->odd )
+		{
+			for(int i = 1; i < N-2+(N&1); i += 2)
+				lift_int_step_dispatch_i(addr1_i(ptr, i, stride), addr1_i(ptr, i-1, stride), addr1_i(ptr, i+1, stride), cols, step);
+
+			if( is_even(N) )
+				lift_int_step_dispatch_i(addr1_i(ptr, N-1, stride), addr1_i(ptr, N-2, stride), addr1_i(ptr, N-2, stride), cols, step);
+		}
+		else
+		{
+			lift_int_step_dispatch_i(addr1_i(ptr, 0, stride), addr1_i(ptr, 1, stride), addr1_i(ptr, 1, stride), cols, step);
+
+			for(int i = 2; i < N-(N&1); i += 2)
+				lift_int_step_dispatch_i(addr1_i(ptr, i, stride), addr1_i(ptr, i-1, stride), addr1_i(ptr, i+1, stride), cols, step);
+
+			if( is_odd(N) )
+				lift_int_step_dispatch_i(addr1_i(ptr, N-1, stride), addr1_i(ptr, N-2, stride), addr1_i(ptr, N-2, stride), cols, step);
+		}
+	}
+}
+
+/**
+ * The same as lift_int_step_i on 16-bit samples. The step is evaluated in
+ * int, the result is stored modulo 2^16.
+ */
+static
+void lift_i16_step_i16(
+	int16_t *dst,
+	const int16_t *a,
+	const int16_t *b,
+	int n,
+	const struct lift_int_step *step)
+{
+	for(int k = 0; k < n; k++)
+	{
+		const int v = ( step->w * (a[k] + b[k]) + step->c ) >> step->s;
+
+		if( step->sign > 0 )
+			dst[k] = (int16_t)(dst[k] + v);
+		else
+			dst[k] = (int16_t)(dst[k] - v);
+	}
+}
+
+#ifdef ENABLE_AVX
+#pragma GCC push_options
+#pragma GCC target("sse4.1")
+static
+void lift_i16_step_sse41_i16(
+	int16_t *dst,
+	const int16_t *a,
+	const int16_t *b,
+	int n,
+	const struct lift_int_step *step)
+{
+	const __m128i w = _mm_set1_epi16((int16_t)step->w);
+	const __m128i c = _mm_set1_epi32(step->c);
+	const __m128i s = _mm_cvtsi32_si128(step->s);
+	const __m128i mask = _mm_set1_epi32(0xffff);
+
+	int k = 0;
+
+	for(; k+8 <= n; k += 8)
+	{
+		const __m128i va = _mm_loadu_si128((const __m128i *)(a+k));
+		const __m128i vb = _mm_loadu_si128((const __m128i *)(b+k));
+
+		// w*a + w*b in int, a+b does not fit 16 bits
+		__m128i lo = _mm_madd_epi16(_mm_unpacklo_epi16(va, vb), w);
+		__m128i hi = _mm_madd_epi16(_mm_unpackhi_epi16(va, vb), w);
+
+		lo = _mm_sra_epi32(_mm_add_epi32(lo, c), s);
+		hi = _mm_sra_epi32(_mm_add_epi32(hi, c), s);
+
+		// the lower halves
+		const __m128i t = _mm_packus_epi32(_mm_and_si128(lo, mask), _mm_and_si128(hi, mask));
+
+		const __m128i d = _mm_loadu_si128((const __m128i *)(dst+k));
+
+		_mm_storeu_si128((__m128i *)(dst+k), step->sign > 0 ? _mm_add_epi16(d, t) : _mm_sub_epi16(d, t));
+	}
+
+	lift_i16_step_i16(dst+k, a+k, b+k, n-k, step);
+}
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+static
+void lift_i16_step_avx2_i16(
+	int16_t *dst,
+	const int16_t *a,
+	const int16_t *b,
+	int n,
+	const struct lift_int_step *step)
+{
+	const __m256i w = _mm256_set1_epi16((int16_t)step->w);
+	const __m256i c = _mm256_set1_epi32(step->c);
+	const __m128i s = _mm_cvtsi32_si128(step->s);
+	const __m256i mask = _mm256_set1_epi32(0xffff);
+
+	int k = 0;
+
+	for(; k+16 <= n; k += 16)
+	{
+		const __m256i va = _mm256_loadu_si256((const __m256i *)(a+k));
+		const __m256i vb = _mm256_loadu_si256((const __m256i *)(b+k));
+
+		// the unpacks and the pack work within 128-bit lanes, the order is kept
+		__m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(va, vb), w);
+		__m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(va, vb), w);
+
+		lo = _mm256_sra_epi32(_mm256_add_epi32(lo, c), s);
+		hi = _mm256_sra_epi32(_mm256_add_epi32(hi, c), s);
+
+		const __m256i t = _mm256_packus_epi32(_mm256_and_si256(lo, mask), _mm256_and_si256(hi, mask));
+
+		const __m256i d = _mm256_loadu_si256((const __m256i *)(dst+k));
+
+		_mm256_storeu_si256((__m256i *)(dst+k), step->sign > 0 ? _mm256_add_epi16(d, t) : _mm256_sub_epi16(d, t));
+	}
+
+	lift_i16_step_i16(dst+k, a+k, b+k, n-k, step);
+}
+#pragma GCC pop_options
+#endif /* ENABLE_AVX */
+
+static
+void lift_i16_step_dispatch_i16(
+	int16_t *dst,
+	const int16_t *a,
+	const int16_t *b,
+	int n,
+	const struct lift_int_step *step)
+{
+#ifdef ENABLE_AVX
+	if( get_avx() )
+	{
+		lift_i16_step_avx2_i16(dst, a, b, n, step);
+		return;
+	}
+
+	if( lift_int_sse41 < 0 )
+	{
+		__builtin_cpu_init();
+		lift_int_sse41 = __builtin_cpu_supports("sse4.1");
+	}
+
+	if( lift_int_sse41 )
+	{
+		lift_i16_step_sse41_i16(dst, a, b, n, step);
+		return;
+	}
+#endif
+	lift_i16_step_i16(dst, a, b, n, step);
+}
+
+/**
+ * The same as lift_int_line_i on 16-bit samples.
+ */
+static
+void lift_i16_line_i16(
+	int16_t *E,
+	int16_t *O,
+	int N,
+	const struct lift_int_step *steps,
+	int count)
+{
+	const int nE = ceil_div2(N);
+	const int nO = floor_div2(N);
+
+	for(int t = 0; t < count; t++)
+	{
+		const struct lift_int_step *step = &steps[t];
+
+		if( step->odd )
+		{
+			lift_i16_step_dispatch_i16(O, E, E+1, nE-1, step);
+
+			if( is_even(N) )
+				lift_i16_step_i16(O+nO-1, E+nE-1, E+nE-1, 1, step);
+		}
+		else
+		{
+			lift_i16_step_i16(E, O, O, 1, step);
+
+			lift_i16_step_dispatch_i16(E+1, O, O+1, nO-1, step);
+
+			if( is_odd(N) )
+				lift_i16_step_i16(E+nE-1, O+nO-1, O+nO-1, 1, step);
+		}
+	}
+}
+
+/**
+ * The same as lift_int_cols_i on 16-bit samples.
+ */
+static
+void lift_i16_cols_i16(
+	void *ptr,
+	int N,
+	int stride,
+	int cols,
+	const struct lift_int_step *steps,
+	int count)
+{
+	// fix for small N
+	if(N < 2)
+		return;
+
+	for(int t = 0; t < count; t++)
+	{
+		const struct lift_int_step *step = &steps[t];
+
+		if( step->odd )
+		{
+			for(int i = 1; i < N-2+(N&1); i += 2)
+				lift_i16_step_dispatch_i16(addr1_i16(ptr, i, stride), addr1_i16(ptr, i-1, stride), addr1_i16(ptr, i+1, stride), cols, step);
+
+			if( is_even(N) )
+				lift_i16_step_dispatch_i16(addr1_i16(ptr, N-1, stride), addr1_i16(ptr, N-2, stride), addr1_i16(ptr, N-2, stride), cols, step);
+		}
+		else
+		{
+			lift_i16_step_dispatch_i16(addr1_i16(ptr, 0, stride), addr1_i16(ptr, 1, stride), addr1_i16(ptr, 1, stride), cols, step);
+
+			for(int i = 2; i < N-(N&1); i += 2)
+				lift_i16_step_dispatch_i16(addr1_i16(ptr, i, stride), addr1_i16(ptr, i-1, stride), addr1_i16(ptr, i+1, stride), cols, step);
+
+			if( is_odd(N) )
+				lift_i16_step_dispatch_i16(addr1_i16(ptr, N-1, stride), addr1_i16(ptr, N-2, stride), addr1_i16(ptr, N-2, stride), cols, step);
+		}
+	}
 }
-#endif
 
+/**
+ * Lifting of N interleaved 16-bit samples in-place.
+ */
 static
-void dwt_cdf97_f_ex_stride_inplace_part_epilog_s(
-	float *ptr,
+void lift_i16_stride_inplace_i16(
+	void *ptr,
 	int N,
-	int stride
-)
+	int stride,
+	const struct lift_int_step *steps,
+	int count)
 {
-	const int offset = 1;
+	// fix for small N
+	if(N < 2)
+		return;
 
-	accel_lift_op4s_epilog_stride_s(ptr, offset, N, -dwt_cdf97_p1_s, dwt_cdf97_u1_s, -dwt_cdf97_p2_s, dwt_cdf97_u2_s, dwt_cdf97_s1_s, +1, stride);
+	const int nE = ceil_div2(N);
+
+	int16_t buff[N];
+
+	// even samples first
+	for(int i = 0; i < N; i++)
+		buff[is_even(i) ? i/2 : nE+i/2] = *addr1_i16(ptr, i, stride);
+
+	lift_i16_line_i16(buff, buff+nE, N, steps, count);
+
+	for(int i = 0; i < N; i++)
+		*addr1_i16(ptr, i, stride) = buff[is_even(i) ? i/2 : nE+i/2];
 }
 
-/*
- * CDF 9/7 (4,4)
- * http://www.ece.uvic.ca/~frodo/publications/phdthesis.pdf
- * * 9/7-F, p. 88, 89
- * * [24] M. Antonini, M. Barlaud, P. Mathieu, and I. Daubechies. Image coding using wavelet transform. IEEE Trans. on Image Processing, 1(2):205–220, April 1992.
- * * [40] A. R. Calderbank, I. Daubechies,W. Sweldens, and B.-L. Yeo. Wavelet transforms that map integers to integers. Applied and Computational Harmonic Analysis, 5(3):332–369, July 1998.
- */
 void dwt_cdf97_f_ex_stride_i(
 	const int *src,
 	int *dst_l,
@@ -10912,38 +12683,17 @@ void dwt_cdf97_f_ex_stride_i(
 	if(N < 2)
 		return;
 
-	// copy src into tmp
-	dwt_util_memcpy_stride_i(tmp, sizeof(int), src, stride, N);
-
-	// predict 1 + update 1
-	for(int i=1; i<N-2+(N&1); i+=2)
-		tmp[i] -= ( +203*(tmp[i-1]+tmp[i+1]) - (1<<6) ) >> 7;
-
-	if(is_odd(N))
-		tmp[N-1] += ( -217*(tmp[N-2]+tmp[N-2]) + (1<<11) ) >> 12;
-	else
-		tmp[N-1] -= ( +203*(tmp[N-2]+tmp[N-2]) - (1<<6) ) >> 7;
-	tmp[0] += ( -217*(tmp[1]+tmp[1]) + (1<<11) ) >> 12;
-
-	for(int i=2; i<N-(N&1); i+=2)
-		tmp[i] += ( -217*(tmp[i-1]+tmp[i+1]) + (1<<11) ) >> 12;
-
-	// predict 2 + update 2
-	for(int i=1; i<N-2+(N&1); i+=2)
-		tmp[i] -= ( -113*(tmp[i-1]+tmp[i+1]) - (1<<6) ) >> 7;
+	const int nE = ceil_div2(N);
 
-	if(is_odd(N))
-		tmp[N-1] += ( 1817*(tmp[N-2]+tmp[N-2]) + (1<<11) ) >> 12;
-	else
-		tmp[N-1] -= ( -113*(tmp[N-2]+tmp[N-2]) - (1<<6) ) >> 7;
-	tmp[0] += ( 1817*(tmp[1]+tmp[1]) + (1<<11) ) >> 12;
+	// copy src into tmp, even samples first
+	dwt_util_memcpy_stride_i(tmp+0,  sizeof(int), addr1_const_i(src, 0, stride), 2*stride,  ceil_div2(N));
+	dwt_util_memcpy_stride_i(tmp+nE, sizeof(int), addr1_const_i(src, 1, stride), 2*stride, floor_div2(N));
 
-	for(int i=2; i<N-(N&1); i+=2)
-		tmp[i] += ( 1817*(tmp[i-1]+tmp[i+1]) + (1<<11) ) >> 12;
+	lift_int_line_i(tmp, tmp+nE, N, cdf97_fwd_steps_i, 4);
 
 	// copy tmp into dst
-	dwt_util_memcpy_stride_i(dst_l, stride, tmp+0, 2*sizeof(int),  ceil_div2(N));
-	dwt_util_memcpy_stride_i(dst_h, stride, tmp+1, 2*sizeof(int), floor_div2(N));
+	dwt_util_memcpy_stride_i(dst_l, stride, tmp+0,  sizeof(int),  ceil_div2(N));
+	dwt_util_memcpy_stride_i(dst_h, stride, tmp+nE, sizeof(int), floor_div2(N));
 }
 
 // http://www.ece.uvic.ca/~frodo/publications/phdthesis.pdf
@@ -10961,26 +12711,17 @@ void dwt_cdf53_f_ex_stride_i(
 	if(N < 2)
 		return;
 
-	// copy src into tmp
-	dwt_util_memcpy_stride_i(tmp, sizeof(int), src, stride, N);
-
-	// predict 1 + update 1
-	for(int i=1; i<N-2+(N&1); i+=2)
-		tmp[i] -= (tmp[i-1] + tmp[i+1]) >> 1;
-
-	if(is_odd(N))
-		tmp[N-1] += (tmp[N-2] + 1) >> 1;
-	else
-		tmp[N-1] -= tmp[N-2];
+	const int nE = ceil_div2(N);
 
-	tmp[0] += (tmp[1] + 1) >> 1;
+	// copy src into tmp, even samples first
+	dwt_util_memcpy_stride_i(tmp+0,  sizeof(int), addr1_const_i(src, 0, stride), 2*stride,  ceil_div2(N));
+	dwt_util_memcpy_stride_i(tmp+nE, sizeof(int), addr1_const_i(src, 1, stride), 2*stride, floor_div2(N));
 
-	for(int i=2; i<N-(N&1); i+=2)
-		tmp[i] += ( (tmp[i-1] + tmp[i+1]) + 2 ) >> 2;
+	lift_int_line_i(tmp, tmp+nE, N, cdf53_fwd_steps_i, 2);
 
 	// copy tmp into dst
-	dwt_util_memcpy_stride_i(dst_l, stride, tmp+0, 2*sizeof(int),  ceil_div2(N));
-	dwt_util_memcpy_stride_i(dst_h, stride, tmp+1, 2*sizeof(int), floor_div2(N));
+	dwt_util_memcpy_stride_i(dst_l, stride, tmp+0,  sizeof(int),  ceil_div2(N));
+	dwt_util_memcpy_stride_i(dst_h, stride, tmp+nE, sizeof(int), floor_div2(N));
 }
 
 void dwt_cdf53_f_ex_stride_s(
@@ -11710,40 +13451,17 @@ void dwt_cdf97_i_ex_stride_i(
 	if(N < 2)
 		return;
 
-	// copy src into tmp
-	dwt_util_memcpy_stride_i(tmp+0, 2*sizeof(int), src_l, stride,  ceil_div2(N));
-	dwt_util_memcpy_stride_i(tmp+1, 2*sizeof(int), src_h, stride, floor_div2(N));
-
-	// backward update 2 + backward predict 2
-	for(int i=2; i<N-(N&1); i+=2)
-		tmp[i] -= ( 1817*(tmp[i-1]+tmp[i+1]) + (1<<11) ) >> 12;
-
-	tmp[0] -= ( 1817*(tmp[1]+tmp[1]) + (1<<11) ) >> 12;
-
-	if(is_odd(N))
-		tmp[N-1] -= ( 1817*(tmp[N-2]+tmp[N-2]) + (1<<11) ) >> 12;
-	else
-		tmp[N-1] += ( -113*(tmp[N-2]+tmp[N-2]) - (1<<6) ) >> 7;
-
-	for(int i=1; i<N-2+(N&1); i+=2)
-		tmp[i] += ( -113*(tmp[i-1]+tmp[i+1]) - (1<<6) ) >> 7;
-
-	// backward update 1 + backward predict 1
-	for(int i=2; i<N-(N&1); i+=2)
-		tmp[i] -= ( -217*(tmp[i-1]+tmp[i+1]) + (1<<11) ) >> 12;
-
-	tmp[0] -= ( -217*(tmp[1]+tmp[1]) + (1<<11) ) >> 12;
+	const int nE = ceil_div2(N);
 
-	if(is_odd(N))
-		tmp[N-1] -= ( -217*(tmp[N-2]+tmp[N-2]) + (1<<11) ) >> 12;
-	else
-		tmp[N-1] += ( +203*(tmp[N-2]+tmp[N-2]) - (1<<6) ) >> 7;
+	// copy src into tmp, even samples first
+	dwt_util_memcpy_stride_i(tmp+0,  sizeof(int), src_l, stride,  ceil_div2(N));
+	dwt_util_memcpy_stride_i(tmp+nE, sizeof(int), src_h, stride, floor_div2(N));
 
-	for(int i=1; i<N-2+(N&1); i+=2)
-		tmp[i] += ( +203*(tmp[i-1]+tmp[i+1]) - (1<<6) ) >> 7;
+	lift_int_line_i(tmp, tmp+nE, N, cdf97_inv_steps_i, 4);
 
 	// copy tmp into dst
-	dwt_util_memcpy_stride_i(dst, stride, tmp, sizeof(int), N);
+	dwt_util_memcpy_stride_i(addr1_i(dst, 0, stride), 2*stride, tmp+0,  sizeof(int),  ceil_div2(N));
+	dwt_util_memcpy_stride_i(addr1_i(dst, 1, stride), 2*stride, tmp+nE, sizeof(int), floor_div2(N));
 }
 
 void dwt_cdf53_i_ex_stride_i(
@@ -11760,26 +13478,17 @@ void dwt_cdf53_i_ex_stride_i(
 	if(N < 2)
 		return;
 
-	// copy src into tmp
-	dwt_util_memcpy_stride_i(tmp+0, 2*sizeof(int), src_l, stride,  ceil_div2(N));
-	dwt_util_memcpy_stride_i(tmp+1, 2*sizeof(int), src_h, stride, floor_div2(N));
-
-	// backward update 1 + backward predict 1
-	for(int i=2; i<N-(N&1); i+=2)
-		tmp[i] -= ( (tmp[i-1] + tmp[i+1]) + 2 ) >> 2;
-
-	tmp[0] -= (tmp[1] + 1) >> 1;
+	const int nE = ceil_div2(N);
 
-	if(is_odd(N))
-		tmp[N-1] -= (tmp[N-2] + 1) >> 1;
-	else
-		tmp[N-1] += tmp[N-2];
+	// copy src into tmp, even samples first
+	dwt_util_memcpy_stride_i(tmp+0,  sizeof(int), src_l, stride,  ceil_div2(N));
+	dwt_util_memcpy_stride_i(tmp+nE, sizeof(int), src_h, stride, floor_div2(N));
 
-	for(int i=1; i<N-2+(N&1); i+=2)
-		tmp[i] += ( tmp[i-1] + tmp[i+1] ) >> 1;
+	lift_int_line_i(tmp, tmp+nE, N, cdf53_inv_steps_i, 2);
 
 	// copy tmp into dst
-	dwt_util_memcpy_stride_i(dst, stride, tmp, sizeof(int), N);
+	dwt_util_memcpy_stride_i(addr1_i(dst, 0, stride), 2*stride, tmp+0,  sizeof(int),  ceil_div2(N));
+	dwt_util_memcpy_stride_i(addr1_i(dst, 1, stride), 2*stride, tmp+nE, sizeof(int), floor_div2(N));
 }
 
 void dwt_cdf53_i_ex_stride_s(
@@ -12836,6 +14545,8 @@ void dwt_cdf97_2f_s(
 #ifndef DISABLE_Y
 		if( lines_x > 1 )
 		{
+			const dwt_trace_t trace = DWT_TRACE_BEGIN();
+
 			set_data_step_s( stride_x );
 			#pragma omp parallel for schedule(static, threads_segment_y)
 			for(int y = 0; y < workers_lines_y; y += workers)
@@ -12860,12 +14571,16 @@ void dwt_cdf97_2f_s(
 					stride_y);
 			}
 			dwt_util_set_num_workers(workers);
+
+			DWT_TRACE_END("cdf97_2f_s rows", j, trace);
 		}
 #endif
 
 #ifndef DISABLE_X
 		if( lines_y > 1 )
 		{
+			const dwt_trace_t trace = DWT_TRACE_BEGIN();
+
 			set_data_step_s( stride_y );
 			#pragma omp parallel for schedule(static, threads_segment_x)
 			for(int x = 0; x < workers_lines_x; x += workers)
@@ -12890,6 +14605,8 @@ void dwt_cdf97_2f_s(
 					stride_x);
 			}
 			dwt_util_set_num_workers(workers);
+
+			DWT_TRACE_END("cdf97_2f_s columns", j, trace);
 		}
 #endif
 
@@ -12923,6 +14640,225 @@ void dwt_cdf97_2f_s(
 	FUNC_END;
 }
 
+// the number of lines (rows or columns) in a single tile of the pool
+#define POOL_TILE_LINES 16
+
+/**
+ * A band of lines (rows or columns) of a single decomposition level.
+ */
+struct pool_lines_s {
+	void *ptr;		///< the first line
+	int stride_line;	///< stride between lines
+	int stride_sample;	///< stride between samples in the line
+	int lines;		///< the number of lines
+	int N;			///< the length of the lines
+	int inverse;		///< zero value for the forward transform
+	int across;		///< lift the lines of the tile together, sample by sample? zero value if not
+};
+
+/**
+ * The lifting step dst[c] += w * (a[c] + b[c]) for @p lines lines, the
+ * samples of the lines are @p stride apart.
+ */
+static
+void pool_lines_step_s(
+	float *dst,
+	const float *a,
+	const float *b,
+	int lines,
+	int stride,
+	float w)
+{
+	if( sizeof(float) == stride )
+	{
+		for(int c = 0; c < lines; c++)
+			dst[c] += w * (a[c] + b[c]);
+	}
+	else
+	{
+		for(int c = 0; c < lines; c++)
+			*addr1_s(dst, c, stride) += w * (*addr1_const_s(a, c, stride) + *addr1_const_s(b, c, stride));
+	}
+}
+
+static
+void pool_lines_scale_s(
+	float *dst,
+	int lines,
+	int stride,
+	float z)
+{
+	if( sizeof(float) == stride )
+	{
+		for(int c = 0; c < lines; c++)
+			dst[c] *= z;
+	}
+	else
+	{
+		for(int c = 0; c < lines; c++)
+			*addr1_s(dst, c, stride) *= z;
+	}
+}
+
+/**
+ * The same as the prolog, core and epilog of
+ * dwt_cdf97_f_ex_stride_inplace_part_core_s (or its inverse), but the
+ * @p lines lines are lifted together, one sample of all the lines after
+ * another. Thus, the columns of a tile are lifted row by row.
+ *
+ * The rows are swept once, the step k is applied k rows behind the first
+ * one (the double-loop approach on whole rows). The lines are at least
+ * 5 (4 for the inverse) samples long.
+ */
+static
+void pool_lines_across_s(
+	void *ptr,
+	int N,
+	int stride_sample,
+	int stride_line,
+	int lines,
+	int inverse)
+{
+	const float zeta = dwt_cdf97_s1_s;
+
+	// the first step is applied to the odd samples
+	const float fwd[4] = { -dwt_cdf97_p1_s, dwt_cdf97_u1_s, -dwt_cdf97_p2_s, dwt_cdf97_u2_s };
+	// the first step is applied to the even samples
+	const float inv[4] = { -dwt_cdf97_u2_s, dwt_cdf97_p2_s, -dwt_cdf97_u1_s, dwt_cdf97_p1_s };
+
+	const float *w = inverse ? inv : fwd;
+
+	// the parity of the samples updated by the first step
+	const int parity = !inverse;
+
+	// the inverse scaling precedes the first use of the sample
+	if( inverse )
+		pool_lines_scale_s(addr1_s(ptr, 0, stride_sample), lines, stride_line, 1/zeta);
+
+	for(int t = 0; t < N+4; t++)
+	{
+		if( inverse && t+1 < N )
+			pool_lines_scale_s(addr1_s(ptr, t+1, stride_sample), lines, stride_line, is_even(t+1) ? 1/zeta : zeta);
+
+		for(int k = 0; k < 4; k++)
+		{
+			const int i = t-k;
+
+			if( i < 0 || i >= N || (i & 1) != (parity ^ (k & 1)) )
+				continue;
+
+			// symmetric extension
+			const int l = i > 0 ? i-1 : i+1;
+			const int r = i < N-1 ? i+1 : i-1;
+
+			pool_lines_step_s(
+				addr1_s(ptr, i, stride_sample),
+				addr1_s(ptr, l, stride_sample),
+				addr1_s(ptr, r, stride_sample),
+				lines,
+				stride_line,
+				w[k]);
+		}
+
+		// the sample is not used by the steps anymore
+		if( !inverse && t >= 4 )
+			pool_lines_scale_s(addr1_s(ptr, t-4, stride_sample), lines, stride_line, is_even(t-4) ? zeta : 1/zeta);
+	}
+}
+
+static
+void pool_lines_tile_s(
+	void *arg,
+	int tile,
+	int thread)
+{
+	const struct pool_lines_s *l = arg;
+
+	UNUSED(thread);
+
+	const dwt_trace_t trace = DWT_TRACE_BEGIN();
+
+	const int begin = tile * POOL_TILE_LINES;
+	const int end = min(begin + POOL_TILE_LINES, l->lines);
+
+	if( l->across && l->N >= (l->inverse ? 4 : 5) )
+	{
+		pool_lines_across_s(addr1_s(l->ptr, begin, l->stride_line), l->N, l->stride_sample, l->stride_line, end-begin, l->inverse);
+
+		DWT_TRACE_END("pool tile", tile, trace);
+		return;
+	}
+
+	for(int line = begin; line < end; line++)
+	{
+		void *ptr = addr1_s(l->ptr, line, l->stride_line);
+
+		if( !l->inverse )
+		{
+			if( l->N < 5 )
+			{
+				dwt_cdf97_f_ex_stride_inplace_part_exceptions_s(ptr, l->N, l->stride_sample);
+			}
+			else
+			{
+				dwt_cdf97_f_ex_stride_inplace_part_prolog_s(ptr, l->N, l->stride_sample);
+				dwt_cdf97_f_ex_stride_inplace_part_core_s(ptr, l->N, l->stride_sample);
+				dwt_cdf97_f_ex_stride_inplace_part_epilog_s(ptr, l->N, l->stride_sample);
+			}
+		}
+		else
+		{
+			if( l->N < 4 )
+			{
+				dwt_cdf97_i_ex_stride_inplace_part_exceptions_s(ptr, l->N, l->stride_sample);
+			}
+			else
+			{
+				dwt_cdf97_i_ex_stride_inplace_part_prolog_s(ptr, l->N, l->stride_sample);
+				dwt_cdf97_i_ex_stride_inplace_part_core_s(ptr, l->N, l->stride_sample);
+				dwt_cdf97_i_ex_stride_inplace_part_epilog_s(ptr, l->N, l->stride_sample);
+			}
+		}
+	}
+
+	DWT_TRACE_END("pool tile", tile, trace);
+}
+
+/**
+ * One level of the in-place transform using the thread pool.
+ *
+ * The rows are cut into bands of POOL_TILE_LINES rows, the columns into
+ * strips of POOL_TILE_LINES columns, which are lifted row by row across
+ * the strip. The bands (and then the strips) are
+ * independent so that the pool can balance them by stealing. Since the
+ * horizontal and vertical lifting commute, the order of the passes does not
+ * matter.
+ */
+static
+void cdf97_2_inplace_pool_level_s(
+	void *ptr,
+	int stride_x_j,
+	int stride_y_j,
+	int size_x,
+	int size_y,
+	int inverse)
+{
+	if( size_x > 1 )
+	{
+		struct pool_lines_s rows = { ptr, stride_x_j, stride_y_j, size_y, size_x, inverse, 0 };
+
+		dwt_pool_run(ceil_div(size_y, POOL_TILE_LINES), pool_lines_tile_s, &rows);
+	}
+
+	if( size_y > 1 )
+	{
+		// the columns of a strip are lifted row by row
+		struct pool_lines_s cols = { ptr, stride_y_j, stride_x_j, size_x, size_y, inverse, 1 };
+
+		dwt_pool_run(ceil_div(size_x, POOL_TILE_LINES), pool_lines_tile_s, &cols);
+	}
+}
+
 void dwt_cdf97_2f_inplace_s(
 	void *ptr,
 	int stride_x,
@@ -12969,6 +14905,18 @@ void dwt_cdf97_2f_inplace_s(
 		const int size_x = size_i_src_x;
 		const int size_y = size_i_src_y;
 
+		const dwt_trace_t trace = DWT_TRACE_BEGIN();
+
+		if( dwt_pool_get_threads() > 1 )
+		{
+			cdf97_2_inplace_pool_level_s(ptr, stride_x_j, stride_y_j, size_x, size_y, 0);
+
+			DWT_TRACE_END("cdf97_2f_inplace_s level", j, trace);
+
+			j++;
+			continue;
+		}
+
 		const int pairs_x = (to_even(size_x-offset)-4)/2;
 // 		const int pairs_y = (to_even(size_y-offset)-4)/2;
 
@@ -13474,6 +15422,8 @@ void dwt_cdf97_2f_inplace_s(
 // 					stride_x);
 // 		}
 
+		DWT_TRACE_END("cdf97_2f_inplace_s level", j, trace);
+
 		j++;
 	}
 
@@ -13542,6 +15492,8 @@ void dwt_cdf97_2f_inplace_sep_s(
 
 // 		const int max_y = to_even(size_y-offset)+offset;
 
+		dwt_trace_t trace = DWT_TRACE_BEGIN();
+
 		if( size_x > 1 && size_x < 5 )
 		{
 			for(int y = 0; y < size_y; y++)
@@ -13584,6 +15536,9 @@ void dwt_cdf97_2f_inplace_sep_s(
 			}
 		}
 
+		DWT_TRACE_END("cdf97_2f_inplace_sep_s prolog", j, trace);
+		trace = DWT_TRACE_BEGIN();
+
 		if( 1 )
 		{
 			if( size_x > 1 && size_x >= 5 )
@@ -13610,6 +15565,9 @@ void dwt_cdf97_2f_inplace_sep_s(
 			}
 		}
 
+		DWT_TRACE_END("cdf97_2f_inplace_sep_s core", j, trace);
+		trace = DWT_TRACE_BEGIN();
+
 		if( size_x > 1 && size_x >= 5 )
 		{
 			for(int y = 0; y < size_y; y++)
@@ -13631,6 +15589,8 @@ void dwt_cdf97_2f_inplace_sep_s(
 			}
 		}
 
+		DWT_TRACE_END("cdf97_2f_inplace_sep_s epilog", j, trace);
+
 		j++;
 	}
 
@@ -13740,7 +15700,54 @@ void dwt_cdf97_2f_inplace_sep_sdl_s(
 			}
 		}
 
-		if( 1 )
+#ifdef ENABLE_AVX
+		if( get_avx() )
+		{
+			// pairs of lines in 256-bit registers
+			const int pairs_y = floor_div2(size_i_src_y);
+			const int pairs_x = floor_div2(size_x);
+
+			if( size_x > 1 && size_x >= 5 )
+			{
+				#pragma omp parallel for schedule(static, ceil_div2(threads_segment_y))
+				for(int p = 0; p < pairs_y; p++)
+				{
+					dwt_cdf97_f_ex_stride_inplace_part_core_sdl_avx_s(
+						addr2_s(ptr, 2*p, 0, stride_x_j, stride_y_j),
+						size_x, // N
+						stride_y_j,
+						stride_x_j);
+				}
+				if( is_odd(size_i_src_y) )
+				{
+					dwt_cdf97_f_ex_stride_inplace_part_core_sdl_sse_s(
+						addr2_s(ptr, size_i_src_y-1, 0, stride_x_j, stride_y_j),
+						size_x, // N
+						stride_y_j);
+				}
+			}
+			if( size_y > 1 && size_y >= 5 )
+			{
+				#pragma omp parallel for schedule(static, ceil_div2(threads_segment_x))
+				for(int p = 0; p < pairs_x; p++)
+				{
+					dwt_cdf97_f_ex_stride_inplace_part_core_sdl_avx_s(
+						addr2_s(ptr, 0, 2*p, stride_x_j, stride_y_j),
+						size_y, // N
+						stride_x_j,
+						stride_y_j);
+				}
+				if( is_odd(size_x) )
+				{
+					dwt_cdf97_f_ex_stride_inplace_part_core_sdl_sse_s(
+						addr2_s(ptr, 0, size_x-1, stride_x_j, stride_y_j),
+						size_y, // N
+						stride_x_j);
+				}
+			}
+		}
+		else
+#endif
 		{
 			if( size_x > 1 && size_x >= 5 )
 			{
@@ -17235,73 +19242,29 @@ void dwt_cdf97_1i_inplace_s(
 }
 
 void dwt_cdf97_i_ex_stride_inplace_i(
-	int *tmp,
-	int N,
-	int stride
-)
-{
-	assert( N >= 0 && NULL != tmp && 0 != stride );
-
-	// fix for small N
-	if(N < 2)
-		return;
-#if 0
-	// backward update 2 + backward predict 2
-	for(int i=2; i<N-(N&1); i+=2)
-		*addr1_i(tmp, i, stride) -= ( 1817*(*addr1_i(tmp, i-1, stride)+*addr1_i(tmp, i+1, stride)) + (1<<11) ) >> 12;
-
-	*addr1_i(tmp, 0, stride) -= ( 1817*(*addr1_i(tmp, 1, stride)+*addr1_i(tmp, 1, stride)) + (1<<11) ) >> 12;
-
-	if(is_odd(N))
-		*addr1_i(tmp, N-1, stride) -= ( 1817*(*addr1_i(tmp, N-2, stride)+*addr1_i(tmp, N-2, stride)) + (1<<11) ) >> 12;
-	else
-		*addr1_i(tmp, N-1, stride) += ( -113*(*addr1_i(tmp, N-2, stride)+*addr1_i(tmp, N-2, stride)) - (1<<6) ) >> 7;
-
-	for(int i=1; i<N-2+(N&1); i+=2)
-		*addr1_i(tmp, i, stride) += ( -113*(*addr1_i(tmp, i-1, stride)+*addr1_i(tmp, i+1, stride)) - (1<<6) ) >> 7;
-
-	// backward update 1 + backward predict 1
-	for(int i=2; i<N-(N&1); i+=2)
-		*addr1_i(tmp, i, stride) -= ( -217*(*addr1_i(tmp, i-1, stride)+*addr1_i(tmp, i+1, stride)) + (1<<11) ) >> 12;
-
-	*addr1_i(tmp, 0, stride) -= ( -217*(*addr1_i(tmp, 1, stride)+*addr1_i(tmp, 1, stride)) + (1<<11) ) >> 12;
-
-	if(is_odd(N))
-		*addr1_i(tmp, N-1, stride) -= ( -217*(*addr1_i(tmp, N-2, stride)+*addr1_i(tmp, N-2, stride)) + (1<<11) ) >> 12;
-	else
-		*addr1_i(tmp, N-1, stride) += ( +203*(*addr1_i(tmp, N-2, stride)+*addr1_i(tmp, N-2, stride)) - (1<<6) ) >> 7;
-
-	for(int i=1; i<N-2+(N&1); i+=2)
-		*addr1_i(tmp, i, stride) += ( +203*(*addr1_i(tmp, i-1, stride)+*addr1_i(tmp, i+1, stride)) - (1<<6) ) >> 7;
-#else
-	// backward update 2 + backward predict 2
-	for(int i=2; i<N-(N&1); i+=2)
-		*addr1_i(tmp, i, stride) -= ( 1817*(*addr1_i(tmp, i-1, stride)+*addr1_i(tmp, i+1, stride)) + (1<<11) ) >> 12;
-
-	*addr1_i(tmp, 0, stride) -= ( 1817*(*addr1_i(tmp, 1, stride)+*addr1_i(tmp, 1, stride)) + (1<<11) ) >> 12;
+	int *tmp,
+	int N,
+	int stride
+)
+{
+	assert( N >= 0 && NULL != tmp && 0 != stride );
 
-	if(is_odd(N))
-		*addr1_i(tmp, N-1, stride) -= ( 1817*(*addr1_i(tmp, N-2, stride)+*addr1_i(tmp, N-2, stride)) + (1<<11) ) >> 12;
-	else
-		*addr1_i(tmp, N-1, stride) -= ( +113*(*addr1_i(tmp, N-2, stride)+*addr1_i(tmp, N-2, stride)) + (1<<6) ) >> 7;
+	// fix for small N
+	if(N < 2)
+		return;
 
-	for(int i=1; i<N-2+(N&1); i+=2)
-		*addr1_i(tmp, i, stride) -= ( +113*(*addr1_i(tmp, i-1, stride)+*addr1_i(tmp, i+1, stride)) + (1<<6) ) >> 7;
+	const int nE = ceil_div2(N);
 
-	// backward update 1 + backward predict 1
-	for(int i=2; i<N-(N&1); i+=2)
-		*addr1_i(tmp, i, stride) -= ( -217*(*addr1_i(tmp, i-1, stride)+*addr1_i(tmp, i+1, stride)) + (1<<11) ) >> 12;
+	int buff[N];
 
-	*addr1_i(tmp, 0, stride) -= ( -217*(*addr1_i(tmp, 1, stride)+*addr1_i(tmp, 1, stride)) + (1<<11) ) >> 12;
+	// even samples first
+	dwt_util_memcpy_stride_i(buff+0,  sizeof(int), addr1_i(tmp, 0, stride), 2*stride,  ceil_div2(N));
+	dwt_util_memcpy_stride_i(buff+nE, sizeof(int), addr1_i(tmp, 1, stride), 2*stride, floor_div2(N));
 
-	if(is_odd(N))
-		*addr1_i(tmp, N-1, stride) -= ( -217*(*addr1_i(tmp, N-2, stride)+*addr1_i(tmp, N-2, stride)) + (1<<11) ) >> 12;
-	else
-		*addr1_i(tmp, N-1, stride) -= ( -203*(*addr1_i(tmp, N-2, stride)+*addr1_i(tmp, N-2, stride)) + (1<<6) ) >> 7;
+	lift_int_line_i(buff, buff+nE, N, cdf97_inv_inplace_steps_i, 4);
 
-	for(int i=1; i<N-2+(N&1); i+=2)
-		*addr1_i(tmp, i, stride) -= ( -203*(*addr1_i(tmp, i-1, stride)+*addr1_i(tmp, i+1, stride)) + (1<<6) ) >> 7;
-#endif
+	dwt_util_memcpy_stride_i(addr1_i(tmp, 0, stride), 2*stride, buff+0,  sizeof(int),  ceil_div2(N));
+	dwt_util_memcpy_stride_i(addr1_i(tmp, 1, stride), 2*stride, buff+nE, sizeof(int), floor_div2(N));
 }
 
 // TODO: tested only with j=1
@@ -17334,13 +19297,29 @@ void dwt_cdf97_2i_inplace_i(
 		const int size_x_j = ceil_div_pow2(size_i_big_x, j-1);
 		const int size_y_j = ceil_div_pow2(size_i_big_y, j-1);
 
-		#pragma omp parallel for schedule(static, ceil_div(size_x_j, omp_get_num_threads()))
-		for(int x = 0; x < size_x_j; x++)
-			dwt_cdf97_i_ex_stride_inplace_i(
-				addr2_i(ptr, 0, x, stride_x, stride_y),
-				size_y_j,
-				stride_x
-			);
+		if( sizeof(int) == stride_y )
+		{
+			// whole rows at once
+			#pragma omp parallel for schedule(static)
+			for(int x = 0; x < size_x_j; x += LIFT_INT_COLS)
+				lift_int_cols_i(
+					addr2_i(ptr, 0, x, stride_x, stride_y),
+					size_y_j,
+					stride_x,
+					min(LIFT_INT_COLS, size_x_j-x),
+					cdf97_inv_inplace_steps_i, 4
+				);
+		}
+		else
+		{
+			#pragma omp parallel for schedule(static, ceil_div(size_x_j, omp_get_num_threads()))
+			for(int x = 0; x < size_x_j; x++)
+				dwt_cdf97_i_ex_stride_inplace_i(
+					addr2_i(ptr, 0, x, stride_x, stride_y),
+					size_y_j,
+					stride_x
+				);
+		}
 		#pragma omp parallel for schedule(static, ceil_div(size_y_j, omp_get_num_threads()))
 		for(int y = 0; y < size_y_j; y++)
 			dwt_cdf97_i_ex_stride_inplace_i(
@@ -17365,59 +19344,18 @@ void dwt_cdf97_f_ex_stride_inplace_i(
 	if(N < 2)
 		return;
 
-#if 0
-	// predict 1 + update 1
-	for(int i=1; i<N-2+(N&1); i+=2)
-		*addr1_i(tmp, i, stride) -= ( +203*(*addr1_i(tmp, i-1, stride)+*addr1_i(tmp, i+1, stride)) - (1<<6) ) >> 7;
-
-	if(is_odd(N))
-		*addr1_i(tmp, N-1, stride) += ( -217*(*addr1_i(tmp, N-2, stride)+*addr1_i(tmp, N-2, stride)) + (1<<11) ) >> 12;
-	else
-		*addr1_i(tmp, N-1, stride) -= ( +203*(*addr1_i(tmp, N-2, stride)+*addr1_i(tmp, N-2, stride)) - (1<<6) ) >> 7;
-	*addr1_i(tmp, 0, stride) += ( -217*(*addr1_i(tmp, 1, stride)+*addr1_i(tmp, 1, stride)) + (1<<11) ) >> 12;
-
-	for(int i=2; i<N-(N&1); i+=2)
-		*addr1_i(tmp, i, stride) += ( -217*(*addr1_i(tmp, i-1, stride)+*addr1_i(tmp, i+1, stride)) + (1<<11) ) >> 12;
-
-	// predict 2 + update 2
-	for(int i=1; i<N-2+(N&1); i+=2)
-		*addr1_i(tmp, i, stride) -= ( -113*(*addr1_i(tmp, i-1, stride)+*addr1_i(tmp, i+1, stride)) - (1<<6) ) >> 7;
-
-	if(is_odd(N))
-		*addr1_i(tmp, N-1, stride) += ( 1817*(*addr1_i(tmp, N-2, stride)+*addr1_i(tmp, N-2, stride)) + (1<<11) ) >> 12;
-	else
-		*addr1_i(tmp, N-1, stride) -= ( -113*(*addr1_i(tmp, N-2, stride)+*addr1_i(tmp, N-2, stride)) - (1<<6) ) >> 7;
-	*addr1_i(tmp, 0, stride) += ( 1817*(*addr1_i(tmp, 1, stride)+*addr1_i(tmp, 1, stride)) + (1<<11) ) >> 12;
-
-	for(int i=2; i<N-(N&1); i+=2)
-		*addr1_i(tmp, i, stride) += ( 1817*(*addr1_i(tmp, i-1, stride)+*addr1_i(tmp, i+1, stride)) + (1<<11) ) >> 12;
-#else
-	// predict 1 + update 1
-	for(int i=1; i<N-2+(N&1); i+=2)
-		*addr1_i(tmp, i, stride) += ( -203*(*addr1_i(tmp, i-1, stride)+*addr1_i(tmp, i+1, stride)) + (1<<6) ) >> 7;
-
-	if(is_odd(N))
-		*addr1_i(tmp, N-1, stride) += ( -217*(*addr1_i(tmp, N-2, stride)+*addr1_i(tmp, N-2, stride)) + (1<<11) ) >> 12;
-	else
-		*addr1_i(tmp, N-1, stride) += ( -203*(*addr1_i(tmp, N-2, stride)+*addr1_i(tmp, N-2, stride)) + (1<<6) ) >> 7;
-	*addr1_i(tmp, 0, stride) += ( -217*(*addr1_i(tmp, 1, stride)+*addr1_i(tmp, 1, stride)) + (1<<11) ) >> 12;
+	const int nE = ceil_div2(N);
 
-	for(int i=2; i<N-(N&1); i+=2)
-		*addr1_i(tmp, i, stride) += ( -217*(*addr1_i(tmp, i-1, stride)+*addr1_i(tmp, i+1, stride)) + (1<<11) ) >> 12;
+	int buff[N];
 
-	// predict 2 + update 2
-	for(int i=1; i<N-2+(N&1); i+=2)
-		*addr1_i(tmp, i, stride) += ( +113*(*addr1_i(tmp, i-1, stride)+*addr1_i(tmp, i+1, stride)) + (1<<6) ) >> 7;
+	// even samples first
+	dwt_util_memcpy_stride_i(buff+0,  sizeof(int), addr1_i(tmp, 0, stride), 2*stride,  ceil_div2(N));
+	dwt_util_memcpy_stride_i(buff+nE, sizeof(int), addr1_i(tmp, 1, stride), 2*stride, floor_div2(N));
 
-	if(is_odd(N))
-		*addr1_i(tmp, N-1, stride) += ( 1817*(*addr1_i(tmp, N-2, stride)+*addr1_i(tmp, N-2, stride)) + (1<<11) ) >> 12;
-	else
-		*addr1_i(tmp, N-1, stride) += ( +113*(*addr1_i(tmp, N-2, stride)+*addr1_i(tmp, N-2, stride)) + (1<<6) ) >> 7;
-	*addr1_i(tmp, 0, stride) += ( 1817*(*addr1_i(tmp, 1, stride)+*addr1_i(tmp, 1, stride)) + (1<<11) ) >> 12;
+	lift_int_line_i(buff, buff+nE, N, cdf97_fwd_inplace_steps_i, 4);
 
-	for(int i=2; i<N-(N&1); i+=2)
-		*addr1_i(tmp, i, stride) += ( 1817*(*addr1_i(tmp, i-1, stride)+*addr1_i(tmp, i+1, stride)) + (1<<11) ) >> 12;
-#endif
+	dwt_util_memcpy_stride_i(addr1_i(tmp, 0, stride), 2*stride, buff+0,  sizeof(int),  ceil_div2(N));
+	dwt_util_memcpy_stride_i(addr1_i(tmp, 1, stride), 2*stride, buff+nE, sizeof(int), floor_div2(N));
 }
 
 // TODO: tested only with j=1
@@ -17459,18 +19397,209 @@ void dwt_cdf97_2f_inplace_i(
 				size_x_j,
 				stride_y
 			);
-		#pragma omp parallel for schedule(static, ceil_div(size_x_j, omp_get_num_threads()))
-		for(int x = 0; x < size_x_j; x++)
-			dwt_cdf97_f_ex_stride_inplace_i(
-				addr2_i(ptr, 0, x, stride_x, stride_y),
-				size_y_j,
-				stride_x
-			);
+		if( sizeof(int) == stride_y )
+		{
+			// whole rows at once
+			#pragma omp parallel for schedule(static)
+			for(int x = 0; x < size_x_j; x += LIFT_INT_COLS)
+				lift_int_cols_i(
+					addr2_i(ptr, 0, x, stride_x, stride_y),
+					size_y_j,
+					stride_x,
+					min(LIFT_INT_COLS, size_x_j-x),
+					cdf97_fwd_inplace_steps_i, 4
+				);
+		}
+		else
+		{
+			#pragma omp parallel for schedule(static, ceil_div(size_x_j, omp_get_num_threads()))
+			for(int x = 0; x < size_x_j; x++)
+				dwt_cdf97_f_ex_stride_inplace_i(
+					addr2_i(ptr, 0, x, stride_x, stride_y),
+					size_y_j,
+					stride_x
+				);
+		}
 
 		j++;
 	}
 }
 
+/**
+ * The forward 2-D transform of 16-bit samples, in-place, interleaved
+ * subbands, the same levels as dwt_cdf97_2f_inplace_i.
+ */
+static
+void dwt_2f_inplace_i16(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_o_big_x,
+	int size_o_big_y,
+	int size_i_big_x,
+	int size_i_big_y,
+	int *j_max_ptr,
+	int decompose_one,
+	const struct lift_int_step *steps,
+	int count
+)
+{
+	const int size_o_big_min = min(size_o_big_x, size_o_big_y);
+	const int size_o_big_max = max(size_o_big_x, size_o_big_y);
+
+	const int j_limit = ceil_log2(decompose_one ? size_o_big_max : size_o_big_min);
+
+	if( *j_max_ptr < 0 || *j_max_ptr > j_limit )
+		*j_max_ptr = j_limit;
+
+	for(int j = 0; j < *j_max_ptr; j++)
+	{
+		const int size_x_j = ceil_div_pow2(size_i_big_x, j);
+		const int size_y_j = ceil_div_pow2(size_i_big_y, j);
+
+		#pragma omp parallel for schedule(static, ceil_div(size_y_j, omp_get_num_threads()))
+		for(int y = 0; y < size_y_j; y++)
+			lift_i16_stride_inplace_i16(addr2_i16(ptr, y, 0, stride_x, stride_y), size_x_j, stride_y, steps, count);
+
+		if( sizeof(int16_t) == stride_y )
+		{
+			// whole rows at once
+			#pragma omp parallel for schedule(static)
+			for(int x = 0; x < size_x_j; x += LIFT_INT_COLS)
+				lift_i16_cols_i16(addr2_i16(ptr, 0, x, stride_x, stride_y), size_y_j, stride_x, min(LIFT_INT_COLS, size_x_j-x), steps, count);
+		}
+		else
+		{
+			#pragma omp parallel for schedule(static, ceil_div(size_x_j, omp_get_num_threads()))
+			for(int x = 0; x < size_x_j; x++)
+				lift_i16_stride_inplace_i16(addr2_i16(ptr, 0, x, stride_x, stride_y), size_y_j, stride_x, steps, count);
+		}
+	}
+}
+
+/**
+ * The inverse of dwt_2f_inplace_i16.
+ */
+static
+void dwt_2i_inplace_i16(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_o_big_x,
+	int size_o_big_y,
+	int size_i_big_x,
+	int size_i_big_y,
+	int j_max,
+	int decompose_one,
+	const struct lift_int_step *steps,
+	int count
+)
+{
+	const int size_o_big_min = min(size_o_big_x, size_o_big_y);
+	const int size_o_big_max = max(size_o_big_x, size_o_big_y);
+
+	int j = ceil_log2(decompose_one ? size_o_big_max : size_o_big_min);
+
+	if( j_max >= 0 && j_max < j )
+		j = j_max;
+
+	for(; j > 0; j--)
+	{
+		const int size_x_j = ceil_div_pow2(size_i_big_x, j-1);
+		const int size_y_j = ceil_div_pow2(size_i_big_y, j-1);
+
+		if( sizeof(int16_t) == stride_y )
+		{
+			// whole rows at once
+			#pragma omp parallel for schedule(static)
+			for(int x = 0; x < size_x_j; x += LIFT_INT_COLS)
+				lift_i16_cols_i16(addr2_i16(ptr, 0, x, stride_x, stride_y), size_y_j, stride_x, min(LIFT_INT_COLS, size_x_j-x), steps, count);
+		}
+		else
+		{
+			#pragma omp parallel for schedule(static, ceil_div(size_x_j, omp_get_num_threads()))
+			for(int x = 0; x < size_x_j; x++)
+				lift_i16_stride_inplace_i16(addr2_i16(ptr, 0, x, stride_x, stride_y), size_y_j, stride_x, steps, count);
+		}
+
+		#pragma omp parallel for schedule(static, ceil_div(size_y_j, omp_get_num_threads()))
+		for(int y = 0; y < size_y_j; y++)
+			lift_i16_stride_inplace_i16(addr2_i16(ptr, y, 0, stride_x, stride_y), size_x_j, stride_y, steps, count);
+	}
+}
+
+void dwt_cdf53_2f_inplace_i16(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_o_big_x,
+	int size_o_big_y,
+	int size_i_big_x,
+	int size_i_big_y,
+	int *j_max_ptr,
+	int decompose_one,
+	int zero_padding
+)
+{
+	UNUSED(zero_padding);
+
+	dwt_2f_inplace_i16(ptr, stride_x, stride_y, size_o_big_x, size_o_big_y, size_i_big_x, size_i_big_y, j_max_ptr, decompose_one, cdf53_fwd_steps_i, 2);
+}
+
+void dwt_cdf53_2i_inplace_i16(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_o_big_x,
+	int size_o_big_y,
+	int size_i_big_x,
+	int size_i_big_y,
+	int j_max,
+	int decompose_one,
+	int zero_padding
+)
+{
+	UNUSED(zero_padding);
+
+	dwt_2i_inplace_i16(ptr, stride_x, stride_y, size_o_big_x, size_o_big_y, size_i_big_x, size_i_big_y, j_max, decompose_one, cdf53_inv_steps_i, 2);
+}
+
+void dwt_cdf97_2f_inplace_i16(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_o_big_x,
+	int size_o_big_y,
+	int size_i_big_x,
+	int size_i_big_y,
+	int *j_max_ptr,
+	int decompose_one,
+	int zero_padding
+)
+{
+	UNUSED(zero_padding);
+
+	dwt_2f_inplace_i16(ptr, stride_x, stride_y, size_o_big_x, size_o_big_y, size_i_big_x, size_i_big_y, j_max_ptr, decompose_one, cdf97_fwd_inplace_steps_i, 4);
+}
+
+void dwt_cdf97_2i_inplace_i16(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_o_big_x,
+	int size_o_big_y,
+	int size_i_big_x,
+	int size_i_big_y,
+	int j_max,
+	int decompose_one,
+	int zero_padding
+)
+{
+	UNUSED(zero_padding);
+
+	dwt_2i_inplace_i16(ptr, stride_x, stride_y, size_o_big_x, size_o_big_y, size_i_big_x, size_i_big_y, j_max, decompose_one, cdf97_inv_inplace_steps_i, 4);
+}
+
 void dwt_cdf97_2i_inplace_s(
 	void *ptr,
 	int stride_x,
@@ -17513,6 +19642,14 @@ void dwt_cdf97_2i_inplace_s(
 		const int stride_y_j = stride_y * (1 << (j-1));
 		const int stride_x_j = stride_x * (1 << (j-1));
 
+		if( dwt_pool_get_threads() > 1 )
+		{
+			cdf97_2_inplace_pool_level_s(ptr, stride_x_j, stride_y_j, lines_x, lines_y, 1);
+
+			j--;
+			continue;
+		}
+
 		if( lines_x > 1 && lines_x < 4 )
 		{
 			for(int y = 0; y < lines_y; y++)
@@ -17622,6 +19759,88 @@ void dwt_cdf97_2i_inplace_s(
 }
 
 // hole
+/**
+ * @brief The number of levels the inverse transform starts from.
+ */
+static
+int dwt_2i_levels(
+	int size_o_big_x,
+	int size_o_big_y,
+	int j_max,
+	int decompose_one)
+{
+	int j = ceil_log2( decompose_one ? max(size_o_big_x,size_o_big_y) : min(size_o_big_x,size_o_big_y) );
+
+	if( j_max >= 0 && j_max < j )
+		j = j_max;
+
+	return j;
+}
+
+void dwt_cdf97_2i_level_s(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_o_big_x,
+	int size_o_big_y,
+	int size_i_big_x,
+	int size_i_big_y,
+	int j_max,
+	int decompose_one,
+	int zero_padding,
+	int level)
+{
+	const int j = dwt_2i_levels(size_o_big_x, size_o_big_y, j_max, decompose_one);
+
+	assert( level >= 0 && level <= j );
+
+	// the LL subband of the level is the transform of the level with j-level levels
+	dwt_cdf97_2i_s(
+		ptr,
+		stride_x,
+		stride_y,
+		ceil_div_pow2(size_o_big_x, level),
+		ceil_div_pow2(size_o_big_y, level),
+		ceil_div_pow2(size_i_big_x, level),
+		ceil_div_pow2(size_i_big_y, level),
+		j - level,
+		decompose_one,
+		zero_padding
+	);
+}
+
+void dwt_cdf97_2i_inplace_level_s(
+	void *ptr,
+	int stride_x,
+	int stride_y,
+	int size_o_big_x,
+	int size_o_big_y,
+	int size_i_big_x,
+	int size_i_big_y,
+	int j_max,
+	int decompose_one,
+	int zero_padding,
+	int level)
+{
+	const int j = dwt_2i_levels(size_o_big_x, size_o_big_y, j_max, decompose_one);
+
+	assert( level >= 0 && level <= j );
+
+	// the same with the lattice of the level
+	dwt_cdf97_2i_inplace_s(
+		ptr,
+		mul_pow2(stride_x, level),
+		mul_pow2(stride_y, level),
+		ceil_div_pow2(size_o_big_x, level),
+		ceil_div_pow2(size_o_big_y, level),
+		ceil_div_pow2(size_i_big_x, level),
+		ceil_div_pow2(size_i_big_y, level),
+		j - level,
+		decompose_one,
+		zero_padding
+	);
+}
+
 void dwt_cdf97_2i_inplace_hole_s(
 	void *ptr,
 	int stride_x,
@@ -19120,9 +21339,9 @@ void dwt_util_set_num_threads(
 
 #ifdef _OPENMP
 	omp_set_num_threads(num_threads);
-#else
-	UNUSED(num_threads);
 #endif
+
+	dwt_pool_set_threads(num_threads);
 }
 
 void dwt_util_set_num_workers(
@@ -19180,6 +21399,8 @@ void dwt_util_init()
 	dwt_util_set_accel(1);
 #endif /* microblaze */
 
+	set_avx( detect_avx() );
+
 	FUNC_END;
 }
 
@@ -19187,6 +21408,8 @@ void dwt_util_finish()
 {
 	FUNC_BEGIN;
 
+	dwt_pool_destroy();
+
 #ifdef __asvp__
 	for(int w = 0; w < get_total_workers(); w++)
 	{
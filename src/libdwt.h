@@ -581,6 +581,8 @@ void dwt_cdf97_2f_s(
  *
  * This function implements single-loop (SL) approach using double-loop (DL) horizontally and double-loop (DL) vertically.
  *
+ * When more than one thread is set by @ref dwt_util_set_num_threads, the levels are computed in separable bands of rows and columns distributed over the thread pool (see pool.h).
+ *
  * @warning experimental
  */
 void dwt_cdf97_2f_inplace_s(
@@ -884,6 +886,8 @@ void dwt_cdf97_2i_s(
  *
  * This function works with single precision floating point numbers (i.e. float data type).
  *
+ * When more than one thread is set by @ref dwt_util_set_num_threads, the bands of rows and columns are distributed over the thread pool (see pool.h).
+ *
  * @warning experimental
  */
 void dwt_cdf97_2i_inplace_s(
@@ -899,6 +903,50 @@ void dwt_cdf97_2i_inplace_s(
 	int zero_padding	///< fill padding in channels with zeros? zero value if not, should be non zero only for sparse decomposition
 );
 
+/**
+ * @brief Inverse image fast wavelet transform using CDF 9/7 wavelet, reconstruction down to the level @p level only.
+ *
+ * The counterpart of @ref dwt_cdf97_2i_s which stops at the decomposition level @p level (zero for the full reconstruction).
+ * The LL subband of this level is left at the beginning of the image data, its size is ceil_div_pow2(size_i_big, level).
+ * The HL, LH and HH subbands of the finer levels are not touched at all.
+ */
+void dwt_cdf97_2i_level_s(
+	void *ptr,		///< pointer to beginning of image data
+	int stride_x,		///< difference between rows (in bytes)
+	int stride_y,		///< difference between columns (in bytes)
+	int size_o_big_x,	///< width of outer image frame (in elements)
+	int size_o_big_y,	///< height of outer image frame (in elements)
+	int size_i_big_x,	///< width of nested image (in elements)
+	int size_i_big_y,	///< height of nested image (in elements)
+	int j_max,		///< pointer to the number of achieved decomposition levels (scales)
+	int decompose_one,	///< should be row or column of size one pixel decomposed? zero value if not
+	int zero_padding,	///< fill padding in channels with zeros? zero value if not, should be non zero only for sparse decomposition
+	int level		///< the level to reconstruct, from 0 up to the number of levels
+);
+
+/**
+ * @brief Inverse image fast wavelet transform using CDF 9/7 wavelet, in-place version, reconstruction down to the level @p level only.
+ *
+ * The counterpart of @ref dwt_cdf97_2i_inplace_s which stops at the decomposition level @p level (zero for the full reconstruction).
+ * The LL subband of this level is left at the beginning of the image data with the strides multiplied by 2^level, its size is ceil_div_pow2(size_i_big, level).
+ * The coefficients of the finer levels are not touched (although they share the cache lines with the coarser ones).
+ *
+ * @warning experimental
+ */
+void dwt_cdf97_2i_inplace_level_s(
+	void *ptr,		///< pointer to beginning of image data
+	int stride_x,		///< difference between rows (in bytes)
+	int stride_y,		///< difference between columns (in bytes)
+	int size_o_big_x,	///< width of outer image frame (in elements)
+	int size_o_big_y,	///< height of outer image frame (in elements)
+	int size_i_big_x,	///< width of nested image (in elements)
+	int size_i_big_y,	///< height of nested image (in elements)
+	int j_max,		///< pointer to the number of achieved decomposition levels (scales)
+	int decompose_one,	///< should be row or column of size one pixel decomposed? zero value if not
+	int zero_padding,	///< fill padding in channels with zeros? zero value if not, should be non zero only for sparse decomposition
+	int level		///< the level to reconstruct, from 0 up to the number of levels
+);
+
 void dwt_cdf97_1i_inplace_s(
 	void *ptr,
 	int stride,
@@ -1045,6 +1093,94 @@ void dwt_cdf97_2f_inplace_i(
 	int zero_padding
 );
 
+/**
+ * @brief Forward image fast wavelet transform using CDF 5/3 wavelet and lifting scheme, in-place version, interleaved subbands.
+ *
+ * This function works with 16-bit integers (i.e. int16_t data type). The lifting steps are the same as in @ref dwt_cdf53_f_ex_stride_i.
+ * The lifting steps are evaluated in int, the coefficients are stored modulo
+ * 2^16, so the forward and the inverse transform are always exact inverses.
+ * The coefficients equal those of the int transforms as long as they fit
+ * into 16 bits. Eight (SSE4.1) or sixteen (AVX2) samples share a vector.
+ */
+void dwt_cdf53_2f_inplace_i16(
+	void *ptr,		///< pointer to beginning of image data
+	int stride_x,		///< difference between rows (in bytes)
+	int stride_y,		///< difference between columns (in bytes)
+	int size_o_big_x,	///< width of outer image frame (in elements)
+	int size_o_big_y,	///< height of outer image frame (in elements)
+	int size_i_big_x,	///< width of nested image (in elements)
+	int size_i_big_y,	///< height of nested image (in elements)
+	int *j_max_ptr,		///< pointer to the number of intended decomposition levels (scales), the number of achieved decomposition levels will be stored also here
+	int decompose_one,	///< should be row or column of size one pixel decomposed? zero value if not
+	int zero_padding	///< ignored
+);
+
+/**
+ * @brief Inverse image fast wavelet transform using CDF 5/3 wavelet and lifting scheme, in-place version, interleaved subbands.
+ *
+ * This function works with 16-bit integers (i.e. int16_t data type). The lifting steps are the same as in @ref dwt_cdf53_i_ex_stride_i.
+ * The lifting steps are evaluated in int, the coefficients are stored modulo
+ * 2^16, so the forward and the inverse transform are always exact inverses.
+ * The coefficients equal those of the int transforms as long as they fit
+ * into 16 bits. Eight (SSE4.1) or sixteen (AVX2) samples share a vector.
+ */
+void dwt_cdf53_2i_inplace_i16(
+	void *ptr,		///< pointer to beginning of image data
+	int stride_x,		///< difference between rows (in bytes)
+	int stride_y,		///< difference between columns (in bytes)
+	int size_o_big_x,	///< width of outer image frame (in elements)
+	int size_o_big_y,	///< height of outer image frame (in elements)
+	int size_i_big_x,	///< width of nested image (in elements)
+	int size_i_big_y,	///< height of nested image (in elements)
+	int j_max,		///< the number of achieved decomposition levels (scales)
+	int decompose_one,	///< should be row or column of size one pixel decomposed? zero value if not
+	int zero_padding	///< ignored
+);
+
+/**
+ * @brief Forward image fast wavelet transform using CDF 9/7 wavelet and lifting scheme, in-place version, interleaved subbands.
+ *
+ * This function works with 16-bit integers (i.e. int16_t data type). The lifting steps are the same as in @ref dwt_cdf97_2f_inplace_i.
+ * The lifting steps are evaluated in int, the coefficients are stored modulo
+ * 2^16, so the forward and the inverse transform are always exact inverses.
+ * The coefficients equal those of the int transforms as long as they fit
+ * into 16 bits. Eight (SSE4.1) or sixteen (AVX2) samples share a vector.
+ */
+void dwt_cdf97_2f_inplace_i16(
+	void *ptr,		///< pointer to beginning of image data
+	int stride_x,		///< difference between rows (in bytes)
+	int stride_y,		///< difference between columns (in bytes)
+	int size_o_big_x,	///< width of outer image frame (in elements)
+	int size_o_big_y,	///< height of outer image frame (in elements)
+	int size_i_big_x,	///< width of nested image (in elements)
+	int size_i_big_y,	///< height of nested image (in elements)
+	int *j_max_ptr,		///< pointer to the number of intended decomposition levels (scales), the number of achieved decomposition levels will be stored also here
+	int decompose_one,	///< should be row or column of size one pixel decomposed? zero value if not
+	int zero_padding	///< ignored
+);
+
+/**
+ * @brief Inverse image fast wavelet transform using CDF 9/7 wavelet and lifting scheme, in-place version, interleaved subbands.
+ *
+ * This function works with 16-bit integers (i.e. int16_t data type). The lifting steps are the same as in @ref dwt_cdf97_2i_inplace_i.
+ * The lifting steps are evaluated in int, the coefficients are stored modulo
+ * 2^16, so the forward and the inverse transform are always exact inverses.
+ * The coefficients equal those of the int transforms as long as they fit
+ * into 16 bits. Eight (SSE4.1) or sixteen (AVX2) samples share a vector.
+ */
+void dwt_cdf97_2i_inplace_i16(
+	void *ptr,		///< pointer to beginning of image data
+	int stride_x,		///< difference between rows (in bytes)
+	int stride_y,		///< difference between columns (in bytes)
+	int size_o_big_x,	///< width of outer image frame (in elements)
+	int size_o_big_y,	///< height of outer image frame (in elements)
+	int size_i_big_x,	///< width of nested image (in elements)
+	int size_i_big_y,	///< height of nested image (in elements)
+	int j_max,		///< the number of achieved decomposition levels (scales)
+	int decompose_one,	///< should be row or column of size one pixel decomposed? zero value if not
+	int zero_padding	///< ignored
+);
+
 /**
  * @brief Inverse image fast wavelet transform using CDF 5/3 wavelet and lifting scheme, in-place version.
  *
@@ -1675,6 +1811,7 @@ int dwt_util_get_max_workers();
  * @brief Wrapper to @p omp_set_num_threads function.
  *
  * Sets the number of threads that will be used in parallel region.
+ * The thread pool of the library (see @ref dwt_pool_set_threads) is resized as well.
  *
  * @warning experimental
  */
@@ -1709,8 +1846,8 @@ void dwt_util_set_num_workers(
  *   @li  5 for CPU shifted double-loop algorithm (reference implementation),
  *   @li  6 for CPU shifted double-loop algorithm (2 iterations merged),
  *   @li  7 for CPU shifted double-loop algorithm (6 iterations merged),
- *   @li  8 for CPU shifted double-loop algorithm (2 iterations merged, SSE implementation, x86 platform),
- *   @li  9 for CPU shifted double-loop algorithm (6 iterations merged, SSE implementation, x86 platform),
+ *   @li  8 for CPU shifted double-loop algorithm (2 iterations merged, SSE or AVX2 implementation, x86 platform),
+ *   @li  9 for CPU shifted double-loop algorithm (6 iterations merged, SSE or AVX2 implementation, x86 platform),
  *   @li 10 for CPU double-loop algorithm (4 workers),
  *   @li 11 for CPU double-loop algorithm (4 workers, SSE implementation, x86 platform),
  *   @li 12 for CPU multi-loop algorithm (4 workers, SSE implementation, x86 platform),
@@ -1734,8 +1871,36 @@ void dwt_util_set_accel(
  */
 int dwt_util_get_accel();
 
+/**
+ * @brief Enable or disable AVX2/FMA implementation of shifted double-loop algorithms.
+ *
+ * The AVX2 kernels are compiled regardless of compiler flags and process
+ * two workers (or two lines in separable 2-D transforms) in 256-bit registers.
+ * Their availability is detected by CPUID in @ref dwt_util_init function.
+ * Requests to enable them on a CPU without AVX2 and FMA support are ignored.
+ *
+ * @note This function affects acceleration types 8 and 9 when more than one worker is active, @ref dwt_cdf97_2f_inplace_sep_sdl_s function,
+ * and the integer lifting (CDF 5/3 and fixed-point CDF 9/7) of @ref dwt_cdf53_f_ex_stride_i, @ref dwt_cdf97_f_ex_stride_i,
+ * their inverses and the in-place integer 2-D transforms (including the 16-bit ones, e.g. @ref dwt_cdf53_2f_inplace_i16), which use AVX2 instead of SSE4.1 then.
+ * @warning experimental
+ */
+void dwt_util_set_avx(
+	int avx			///< nonzero to enable AVX2 kernels
+);
+
+/**
+ * @brief Check if AVX2/FMA implementation of shifted double-loop algorithms is used.
+ *
+ * @returns Nonzero if enabled, see @ref dwt_util_set_avx function.
+ *
+ * @warning experimental
+ */
+int dwt_util_get_avx();
+
 /**
  * @brief Initialize workers in UTIA ASVP platform.
+ *
+ * On x86 platform, detect the instruction set extensions available at run-time.
  */
 void dwt_util_init();
 
@@ -0,0 +1,324 @@
+#include "pool.h"
+
+// dwt_util_log
+#include "libdwt.h"
+
+// ALIGNED
+#include "inline.h"
+
+// assert
+#include <assert.h>
+
+// intptr_t
+#include <stdint.h>
+
+#if defined(__linux__) && !defined(__uClinux__)
+	#define POOL_PTHREADS
+#endif
+
+#ifdef POOL_PTHREADS
+	#include <pthread.h>
+#endif
+
+#define POOL_MAX_THREADS 256
+
+// the number of threads requested by dwt_pool_set_threads
+static int pool_threads = 1;
+
+#ifdef POOL_PTHREADS
+
+/**
+ * A contiguous range of tiles [lo; hi) owned by a single thread.
+ * The owner pops from the front, thieves cut off the back half.
+ */
+struct pool_part {
+	pthread_mutex_t lock;
+	int lo;
+	int hi;
+} ALIGNED(64);
+
+static struct pool_part pool_parts[POOL_MAX_THREADS];
+static int pool_parts_init = 0;
+
+// the number of threads currently running (including the caller)
+static int pool_started = 1;
+static pthread_t pool_tid[POOL_MAX_THREADS];
+static unsigned pool_seen[POOL_MAX_THREADS];
+
+// serializes dwt_pool_run calls, held for the whole job
+static pthread_mutex_t pool_run_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// protects the job description below
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pool_wake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t pool_done = PTHREAD_COND_INITIALIZER;
+
+static unsigned pool_generation = 0;
+static int pool_quit = 0;
+static int pool_busy = 0;
+static dwt_pool_tile_func_t pool_func = NULL;
+static void *pool_arg = NULL;
+
+static
+int pool_pop(
+	int id,
+	int *tile)
+{
+	struct pool_part *part = &pool_parts[id];
+	int ok = 0;
+
+	pthread_mutex_lock(&part->lock);
+	if( part->lo < part->hi )
+	{
+		*tile = part->lo++;
+		ok = 1;
+	}
+	pthread_mutex_unlock(&part->lock);
+
+	return ok;
+}
+
+static
+int pool_steal(
+	int id,
+	int threads)
+{
+	for(;;)
+	{
+		// find the largest part
+		int victim = -1;
+		int best = 0;
+
+		for(int t = 0; t < threads; t++)
+		{
+			if( t == id )
+				continue;
+
+			pthread_mutex_lock(&pool_parts[t].lock);
+			const int rem = pool_parts[t].hi - pool_parts[t].lo;
+			pthread_mutex_unlock(&pool_parts[t].lock);
+
+			if( rem > best )
+			{
+				best = rem;
+				victim = t;
+			}
+		}
+
+		// all parts are empty
+		if( victim < 0 )
+			return 0;
+
+		int lo = 0, hi = 0;
+
+		pthread_mutex_lock(&pool_parts[victim].lock);
+		const int rem = pool_parts[victim].hi - pool_parts[victim].lo;
+		if( rem > 0 )
+		{
+			hi = pool_parts[victim].hi;
+			lo = hi - (rem+1)/2;
+			pool_parts[victim].hi = lo;
+		}
+		pthread_mutex_unlock(&pool_parts[victim].lock);
+
+		if( hi > lo )
+		{
+			pthread_mutex_lock(&pool_parts[id].lock);
+			pool_parts[id].lo = lo;
+			pool_parts[id].hi = hi;
+			pthread_mutex_unlock(&pool_parts[id].lock);
+
+			return 1;
+		}
+
+		// the victim was drained meanwhile, try another one
+	}
+}
+
+static
+void pool_work(
+	int id,
+	int threads,
+	dwt_pool_tile_func_t func,
+	void *arg)
+{
+	int tile;
+
+	for(;;)
+	{
+		if( pool_pop(id, &tile) )
+		{
+			func(arg, tile, id);
+			continue;
+		}
+
+		if( !pool_steal(id, threads) )
+			break;
+	}
+}
+
+static
+void *pool_worker(
+	void *ptr)
+{
+	const int id = (int)(intptr_t)ptr;
+
+	pthread_mutex_lock(&pool_lock);
+
+	for(;;)
+	{
+		while( !pool_quit && pool_seen[id] == pool_generation )
+			pthread_cond_wait(&pool_wake, &pool_lock);
+
+		if( pool_quit )
+			break;
+
+		pool_seen[id] = pool_generation;
+
+		const int threads = pool_started;
+		const dwt_pool_tile_func_t func = pool_func;
+		void *arg = pool_arg;
+
+		pthread_mutex_unlock(&pool_lock);
+
+		pool_work(id, threads, func, arg);
+
+		pthread_mutex_lock(&pool_lock);
+
+		if( 0 == --pool_busy )
+			pthread_cond_signal(&pool_done);
+	}
+
+	pthread_mutex_unlock(&pool_lock);
+
+	return NULL;
+}
+
+// NOTE: the pool_run_lock must be held
+static
+void pool_stop()
+{
+	pthread_mutex_lock(&pool_lock);
+	pool_quit = 1;
+	pthread_cond_broadcast(&pool_wake);
+	pthread_mutex_unlock(&pool_lock);
+
+	for(int t = 1; t < pool_started; t++)
+		pthread_join(pool_tid[t], NULL);
+
+	pool_quit = 0;
+	pool_started = 1;
+}
+
+// NOTE: the pool_run_lock must be held
+static
+void pool_start()
+{
+	if( !pool_parts_init )
+	{
+		for(int t = 0; t < POOL_MAX_THREADS; t++)
+			pthread_mutex_init(&pool_parts[t].lock, NULL);
+
+		pool_parts_init = 1;
+	}
+
+	if( pool_started == pool_threads )
+		return;
+
+	pool_stop();
+
+	pthread_mutex_lock(&pool_lock);
+
+	for(int t = 1; t < pool_threads; t++)
+	{
+		pool_seen[t] = pool_generation;
+
+		if( pthread_create(&pool_tid[t], NULL, pool_worker, (void *)(intptr_t)t) )
+		{
+			dwt_util_log(LOG_WARN, "pool: unable to create thread %i of %i\n", t, pool_threads);
+			break;
+		}
+
+		pool_started = t+1;
+	}
+
+	pthread_mutex_unlock(&pool_lock);
+}
+
+#endif /* POOL_PTHREADS */
+
+void dwt_pool_set_threads(
+	int threads)
+{
+	assert( threads > 0 );
+
+	if( threads > POOL_MAX_THREADS )
+		threads = POOL_MAX_THREADS;
+
+	pool_threads = threads;
+}
+
+int dwt_pool_get_threads()
+{
+	return pool_threads;
+}
+
+void dwt_pool_run(
+	int tiles,
+	dwt_pool_tile_func_t func,
+	void *arg)
+{
+	assert( func );
+
+#ifdef POOL_PTHREADS
+	// serial execution, also for nested or concurrent calls
+	if( pool_threads < 2 || tiles < 2 || pthread_mutex_trylock(&pool_run_lock) )
+	{
+		for(int tile = 0; tile < tiles; tile++)
+			func(arg, tile, 0);
+
+		return;
+	}
+
+	pool_start();
+
+	const int threads = pool_started;
+
+	for(int t = 0; t < threads; t++)
+	{
+		pthread_mutex_lock(&pool_parts[t].lock);
+		pool_parts[t].lo = (int)((long)tiles * (t+0) / threads);
+		pool_parts[t].hi = (int)((long)tiles * (t+1) / threads);
+		pthread_mutex_unlock(&pool_parts[t].lock);
+	}
+
+	pthread_mutex_lock(&pool_lock);
+	pool_func = func;
+	pool_arg = arg;
+	pool_busy = threads-1;
+	pool_generation++;
+	pthread_cond_broadcast(&pool_wake);
+	pthread_mutex_unlock(&pool_lock);
+
+	pool_work(0, threads, func, arg);
+
+	pthread_mutex_lock(&pool_lock);
+	while( pool_busy )
+		pthread_cond_wait(&pool_done, &pool_lock);
+	pthread_mutex_unlock(&pool_lock);
+
+	pthread_mutex_unlock(&pool_run_lock);
+#else
+	for(int tile = 0; tile < tiles; tile++)
+		func(arg, tile, 0);
+#endif
+}
+
+void dwt_pool_destroy()
+{
+#ifdef POOL_PTHREADS
+	pthread_mutex_lock(&pool_run_lock);
+	pool_stop();
+	pthread_mutex_unlock(&pool_run_lock);
+#endif
+}
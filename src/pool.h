@@ -0,0 +1,67 @@
+/**
+ * @brief Persistent worker pool with tile work-stealing.
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+/**
+ * @brief Tile callback.
+ *
+ * Called once for each tile in the range [0; tiles). The @p thread is the
+ * index of the calling thread in the range [0; threads), it is intended to
+ * index per-thread temporary buffers.
+ */
+typedef void (*dwt_pool_tile_func_t)(
+	void *arg,	///< user data passed to @ref dwt_pool_run
+	int tile,	///< index of the tile
+	int thread	///< index of the thread running the tile
+);
+
+/**
+ * @brief Set the number of threads in the pool.
+ *
+ * The pool includes the calling thread, i.e. @p threads-1 workers are kept
+ * alive between the calls of @ref dwt_pool_run. The workers are (re)started
+ * lazily. This function is called by @ref dwt_util_set_num_threads.
+ *
+ * @warning experimental
+ */
+void dwt_pool_set_threads(
+	int threads	///< the number of threads, one means serial execution
+);
+
+/**
+ * @brief Get the number of threads in the pool.
+ *
+ * @warning experimental
+ */
+int dwt_pool_get_threads();
+
+/**
+ * @brief Run @p func for all tiles in the range [0; tiles) and wait for them.
+ *
+ * The range is initially split into contiguous parts, one for each thread.
+ * A thread takes the tiles from the front of its part. When its part is
+ * exhausted, it steals the back half of the largest part of the others. The
+ * calling thread participates in the work. Nested calls (from within a tile)
+ * are executed serially.
+ *
+ * @warning experimental
+ */
+void dwt_pool_run(
+	int tiles,			///< the number of tiles
+	dwt_pool_tile_func_t func,	///< the tile callback
+	void *arg			///< user data passed to @p func
+);
+
+/**
+ * @brief Stop and join the workers.
+ *
+ * Called by @ref dwt_util_finish. The pool can be used again afterwards.
+ *
+ * @warning experimental
+ */
+void dwt_pool_destroy();
+
+#endif
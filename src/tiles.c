@@ -0,0 +1,243 @@
+/**
+ * @brief Tiled transform (as in JPEG 2000) on top of image_t.
+ */
+
+#include "tiles.h"
+
+#include "libdwt.h"
+#include "inline.h"
+#include "system.h" // dwt_util_free
+#include "pool.h" // dwt_pool_run
+
+// assert
+#include <assert.h>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+
+tiles_t *tiles_create_s(
+	image_t *image,
+	int tile_size_x,
+	int tile_size_y)
+{
+	assert( image && tile_size_x > 0 && tile_size_y > 0 );
+
+	tiles_t *tiles = dwt_util_alloc(1, sizeof(tiles_t));
+
+	if( !tiles )
+		return NULL;
+
+	tiles->image = image;
+	tiles->tile_size_x = tile_size_x;
+	tiles->tile_size_y = tile_size_y;
+	tiles->count_x = ceil_div(image->size_x, tile_size_x);
+	tiles->count_y = ceil_div(image->size_y, tile_size_y);
+	tiles->wavelet = WAVELET_CDF97;
+
+	const int count = tiles->count_x * tiles->count_y;
+
+	tiles->tiles = dwt_util_alloc(count, sizeof(image_t));
+	tiles->levels = dwt_util_alloc(count, sizeof(int));
+
+	if( !tiles->tiles || !tiles->levels )
+	{
+		dwt_util_log(LOG_ERR, "%s: unable to allocate %i tiles\n", __FUNCTION__, count);
+
+		dwt_util_free(tiles->tiles);
+		dwt_util_free(tiles->levels);
+		dwt_util_free(tiles);
+
+		return NULL;
+	}
+
+	for(int ty = 0; ty < tiles->count_y; ty++)
+	{
+		for(int tx = 0; tx < tiles->count_x; tx++)
+		{
+			image_t *tile = &tiles->tiles[ty * tiles->count_x + tx];
+
+			const int size_x = min(tile_size_x, image->size_x - tx * tile_size_x);
+			const int size_y = min(tile_size_y, image->size_y - ty * tile_size_y);
+
+			image_init(tile, NULL, size_x, size_y, dwt_util_get_opt_stride(sizeof(float)*size_x), sizeof(float));
+			image_alloc(tile);
+
+			tiles->levels[ty * tiles->count_x + tx] = 0;
+		}
+	}
+
+	return tiles;
+}
+
+void tiles_destroy(
+	tiles_t *tiles)
+{
+	if( !tiles )
+		return;
+
+	for(int t = 0; t < tiles->count_x * tiles->count_y; t++)
+		image_free(&tiles->tiles[t]);
+
+	dwt_util_free(tiles->tiles);
+	dwt_util_free(tiles->levels);
+	dwt_util_free(tiles);
+}
+
+image_t *tiles_tile(
+	tiles_t *tiles,
+	int tile_x,
+	int tile_y)
+{
+	assert( tiles );
+	assert( tile_x >= 0 && tile_x < tiles->count_x );
+	assert( tile_y >= 0 && tile_y < tiles->count_y );
+
+	return &tiles->tiles[tile_y * tiles->count_x + tile_x];
+}
+
+/**
+ * The part of the image covered by the tile.
+ */
+static
+void *tiles_origin(
+	const tiles_t *tiles,
+	int tile)
+{
+	const int tx = tile % tiles->count_x;
+	const int ty = tile / tiles->count_x;
+
+	return addr2_s(
+		tiles->image->ptr,
+		ty * tiles->tile_size_y,
+		tx * tiles->tile_size_x,
+		tiles->image->stride_x,
+		tiles->image->stride_y
+	);
+}
+
+struct tiles_job {
+	tiles_t *tiles;
+	int levels;
+};
+
+/**
+ * The tiles themselves run in parallel, keep the engines serial.
+ */
+#ifdef _OPENMP
+	#define TILES_OMP_SERIAL_BEGIN \
+		const int omp_threads = omp_get_max_threads(); \
+		omp_set_num_threads(1);
+	#define TILES_OMP_SERIAL_END \
+		omp_set_num_threads(omp_threads);
+#else
+	#define TILES_OMP_SERIAL_BEGIN
+	#define TILES_OMP_SERIAL_END
+#endif
+
+static
+void tiles_fdwt_tile(
+	void *arg,
+	int t,
+	int thread)
+{
+	UNUSED(thread);
+
+	struct tiles_job *job = arg;
+	tiles_t *tiles = job->tiles;
+	image_t *tile = &tiles->tiles[t];
+
+	TILES_OMP_SERIAL_BEGIN
+
+	dwt_util_copy3_s(
+		tiles_origin(tiles, t),
+		tile->ptr,
+		tiles->image->stride_x,
+		tiles->image->stride_y,
+		tile->stride_x,
+		tile->stride_y,
+		tile->size_x,
+		tile->size_y
+	);
+
+	tiles->levels[t] = image_fdwt_s(tile, job->levels, tiles->wavelet);
+
+	TILES_OMP_SERIAL_END
+}
+
+static
+void tiles_idwt_tile(
+	void *arg,
+	int t,
+	int thread)
+{
+	UNUSED(thread);
+
+	struct tiles_job *job = arg;
+	tiles_t *tiles = job->tiles;
+	image_t *tile = &tiles->tiles[t];
+
+	TILES_OMP_SERIAL_BEGIN
+
+	// keep the coefficients
+	image_t *temp = image_create_opt_s(tile->size_x, tile->size_y);
+
+	image_copy(tile, temp);
+
+	image_idwt_s(temp, tiles->levels[t], tiles->wavelet);
+
+	dwt_util_copy3_s(
+		temp->ptr,
+		tiles_origin(tiles, t),
+		temp->stride_x,
+		temp->stride_y,
+		tiles->image->stride_x,
+		tiles->image->stride_y,
+		temp->size_x,
+		temp->size_y
+	);
+
+	image_destroy(temp);
+
+	TILES_OMP_SERIAL_END
+}
+
+int tiles_fdwt_s(
+	tiles_t *tiles,
+	int levels,
+	enum wavelet_t wavelet)
+{
+	assert( tiles );
+
+	tiles->wavelet = wavelet;
+
+	struct tiles_job job = { .tiles = tiles, .levels = levels };
+
+	dwt_pool_run(tiles->count_x * tiles->count_y, tiles_fdwt_tile, &job);
+
+	return tiles->levels[0];
+}
+
+void tiles_idwt_s(
+	tiles_t *tiles)
+{
+	assert( tiles );
+
+	struct tiles_job job = { .tiles = tiles, .levels = 0 };
+
+	dwt_pool_run(tiles->count_x * tiles->count_y, tiles_idwt_tile, &job);
+}
+
+void tiles_idwt_tile_s(
+	tiles_t *tiles,
+	int tile_x,
+	int tile_y)
+{
+	assert( tiles );
+	assert( tile_x >= 0 && tile_x < tiles->count_x );
+	assert( tile_y >= 0 && tile_y < tiles->count_y );
+
+	struct tiles_job job = { .tiles = tiles, .levels = 0 };
+
+	tiles_idwt_tile(&job, tile_y * tiles->count_x + tile_x, 0);
+}
@@ -0,0 +1,92 @@
+/**
+ * @brief Tiled transform (as in JPEG 2000) on top of image_t.
+ */
+
+#ifndef TILES_H
+#define TILES_H
+
+#include "image.h" // image_t, enum wavelet_t
+
+/**
+ * @brief Image split into independently transformed tiles.
+ *
+ * The tile grid is anchored at the top-left corner of the image, all tiles
+ * have the nominal size except the last column and the last row of tiles
+ * which hold the rest of the image. Each tile keeps its coefficients in its
+ * own buffer in the layout of the underlying engine.
+ */
+struct tiles_t {
+	image_t *image;		///< the image (not owned)
+	int tile_size_x;	///< nominal width of a tile
+	int tile_size_y;	///< nominal height of a tile
+	int count_x;		///< the number of tiles in a row
+	int count_y;		///< the number of tiles in a column
+	enum wavelet_t wavelet;	///< the wavelet used by the last forward transform
+	image_t *tiles;		///< coefficients, count_y rows of count_x tiles
+	int *levels;		///< the number of levels achieved in each tile
+};
+
+typedef struct tiles_t tiles_t;
+
+/**
+ * @brief Split the @p image into tiles and allocate their buffers.
+ *
+ * @returns NULL on failure
+ */
+tiles_t *tiles_create_s(
+	image_t *image,
+	int tile_size_x,
+	int tile_size_y
+);
+
+/** Free the tiles, the image is not touched */
+void tiles_destroy(
+	tiles_t *tiles
+);
+
+/**
+ * @brief Coefficients of the tile in the column @p tile_x and the row @p tile_y.
+ */
+image_t *tiles_tile(
+	tiles_t *tiles,
+	int tile_x,
+	int tile_y
+);
+
+/**
+ * @brief Forward transform of all tiles.
+ *
+ * The tiles are copied out of the image and transformed by @ref image_fdwt_s
+ * in parallel, one tile per thread of the pool (see @ref dwt_pool_run). Each
+ * tile is transformed on its own, there is no dependency between the tiles.
+ * The number of levels achieved can differ for the small tiles on the edges.
+ *
+ * @returns the number of levels achieved in the first tile
+ */
+int tiles_fdwt_s(
+	tiles_t *tiles,
+	int levels,
+	enum wavelet_t wavelet
+);
+
+/**
+ * @brief Inverse transform of all tiles back into the image.
+ *
+ * The coefficients of the tiles are kept.
+ */
+void tiles_idwt_s(
+	tiles_t *tiles
+);
+
+/**
+ * @brief Inverse transform of a single tile back into its part of the image.
+ *
+ * The other tiles are not touched, the coefficients of the tile are kept.
+ */
+void tiles_idwt_tile_s(
+	tiles_t *tiles,
+	int tile_x,
+	int tile_y
+);
+
+#endif
@@ -0,0 +1,205 @@
+/**
+ * @brief Low-overhead tracing of the transform phases.
+ */
+
+#include "trace.h"
+
+// dwt_util_log
+#include "libdwt.h"
+
+// UNUSED
+#include "inline.h"
+
+// assert
+#include <assert.h>
+
+// FILE, fopen, fprintf
+#include <stdio.h>
+
+// calloc
+#include <stdlib.h>
+
+#if defined(__linux__) && !defined(__uClinux__)
+	#define TRACE_PTHREADS
+#endif
+
+#ifdef TRACE_PTHREADS
+	#include <pthread.h>
+	#include <time.h> // clock_gettime
+	#include <unistd.h> // getpid
+#endif
+
+struct trace_event_t {
+	const char *name;
+	int arg;
+	dwt_trace_t begin;
+	dwt_trace_t end;
+};
+
+struct trace_ring_t {
+	int tid;		///< sequential number of the thread
+	unsigned count;		///< the number of the phases recorded so far
+	struct trace_event_t events[DWT_TRACE_EVENTS];
+	struct trace_ring_t *next;
+};
+
+int dwt_trace_on = 0;
+
+#ifdef TRACE_PTHREADS
+// the rings of all the threads, the threads never release them
+static struct trace_ring_t *trace_rings = NULL;
+static int trace_threads = 0;
+static pthread_mutex_t trace_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static __thread struct trace_ring_t *trace_ring = NULL;
+
+// the time the tracing was enabled, the timestamps are relative to it
+static dwt_trace_t trace_epoch = 0;
+#endif
+
+dwt_trace_t dwt_trace_clock()
+{
+#ifdef TRACE_PTHREADS
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (dwt_trace_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#else
+	return 0;
+#endif
+}
+
+void dwt_trace_enable(
+	int enable)
+{
+#ifdef TRACE_PTHREADS
+	pthread_mutex_lock(&trace_lock);
+
+	if( enable && !trace_epoch )
+		trace_epoch = dwt_trace_clock();
+
+	dwt_trace_on = enable;
+
+	pthread_mutex_unlock(&trace_lock);
+#else
+	if( enable )
+		dwt_util_log(LOG_WARN, "%s: the tracing is not available on this system\n", __FUNCTION__);
+#endif
+}
+
+#ifdef TRACE_PTHREADS
+static
+struct trace_ring_t *trace_ring_create()
+{
+	struct trace_ring_t *ring = calloc(1, sizeof(struct trace_ring_t));
+
+	if( !ring )
+		return NULL;
+
+	pthread_mutex_lock(&trace_lock);
+
+	ring->tid = trace_threads++;
+	ring->next = trace_rings;
+	trace_rings = ring;
+
+	pthread_mutex_unlock(&trace_lock);
+
+	return ring;
+}
+#endif
+
+void dwt_trace_record(
+	const char *name,
+	int arg,
+	dwt_trace_t begin)
+{
+#ifdef TRACE_PTHREADS
+	const dwt_trace_t end = dwt_trace_clock();
+
+	if( !trace_ring )
+	{
+		trace_ring = trace_ring_create();
+
+		if( !trace_ring )
+			return;
+	}
+
+	struct trace_event_t *event = &trace_ring->events[trace_ring->count % DWT_TRACE_EVENTS];
+
+	event->name = name;
+	event->arg = arg;
+	event->begin = begin;
+	event->end = end;
+
+	trace_ring->count++;
+#else
+	UNUSED(name);
+	UNUSED(arg);
+	UNUSED(begin);
+#endif
+}
+
+int dwt_trace_dump(
+	const char *path)
+{
+	assert( path );
+
+	FILE *file = fopen(path, "w");
+
+	if( !file )
+	{
+		dwt_util_log(LOG_ERR, "%s: unable to open %s\n", __FUNCTION__, path);
+		return -1;
+	}
+
+	int events = 0;
+
+	fprintf(file, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+
+#ifdef TRACE_PTHREADS
+	const int pid = (int)getpid();
+
+	pthread_mutex_lock(&trace_lock);
+
+	for(const struct trace_ring_t *ring = trace_rings; ring; ring = ring->next)
+	{
+		fprintf(file, "%s\t{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %i, \"tid\": %i, \"args\": {\"name\": \"thread %i\"}}",
+			ring == trace_rings ? "" : ",\n", pid, ring->tid, ring->tid);
+
+		// the oldest phases are overwritten
+		const unsigned first = ring->count > DWT_TRACE_EVENTS ? ring->count - DWT_TRACE_EVENTS : 0;
+
+		for(unsigned n = first; n < ring->count; n++)
+		{
+			const struct trace_event_t *event = &ring->events[n % DWT_TRACE_EVENTS];
+
+			// in microseconds
+			fprintf(file, ",\n\t{\"name\": \"%s\", \"cat\": \"libdwt\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": %i, \"tid\": %i, \"args\": {\"arg\": %i}}",
+				event->name, (event->begin - trace_epoch) / 1e3, (event->end - event->begin) / 1e3, pid, ring->tid, event->arg);
+		}
+
+		events += ring->count - first;
+	}
+
+	pthread_mutex_unlock(&trace_lock);
+#endif
+
+	fprintf(file, "\n]}\n");
+
+	fclose(file);
+
+	return events;
+}
+
+void dwt_trace_clear()
+{
+#ifdef TRACE_PTHREADS
+	pthread_mutex_lock(&trace_lock);
+
+	for(struct trace_ring_t *ring = trace_rings; ring; ring = ring->next)
+		ring->count = 0;
+
+	pthread_mutex_unlock(&trace_lock);
+#endif
+}
@@ -0,0 +1,92 @@
+/**
+ * @brief Low-overhead tracing of the transform phases.
+ *
+ * The phases are recorded into a ring buffer of each thread, the last
+ * @ref DWT_TRACE_EVENTS phases of each thread are kept. The buffers can be
+ * dumped as the trace-event JSON of Chrome (chrome://tracing, Perfetto).
+ *
+ * When the tracing is not enabled by @ref dwt_trace_enable, a phase costs a
+ * single test of a global flag. Define DISABLE_TRACE to compile the tracing
+ * out completely.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h> // int64_t
+
+/**
+ * @brief The number of the phases kept for each thread.
+ */
+#define DWT_TRACE_EVENTS 4096
+
+/**
+ * @brief Timestamp in nanoseconds, zero value if the tracing is off.
+ */
+typedef int64_t dwt_trace_t;
+
+/**
+ * @brief Is the tracing on? Use @ref dwt_trace_enable to change it.
+ */
+extern int dwt_trace_on;
+
+#ifdef DISABLE_TRACE
+	#define DWT_TRACE_BEGIN() ((dwt_trace_t)0)
+	#define DWT_TRACE_END(name, arg, begin) ((void)(begin))
+#else
+	/**
+	 * @brief Start a phase, returns its @ref dwt_trace_t.
+	 */
+	#define DWT_TRACE_BEGIN() ( dwt_trace_on ? dwt_trace_clock() : (dwt_trace_t)0 )
+
+	/**
+	 * @brief Record the phase @p name started by @ref DWT_TRACE_BEGIN at @p begin.
+	 *
+	 * The @p name must be a string literal (it is not copied), the @p arg
+	 * is an integer shown along (e.g. the level).
+	 */
+	#define DWT_TRACE_END(name, arg, begin) do { if( begin ) dwt_trace_record((name), (arg), (begin)); } while(0)
+#endif
+
+/**
+ * @brief Turn the tracing on or off.
+ *
+ * The recorded phases are kept until @ref dwt_trace_clear is called.
+ * Available on Linux only.
+ */
+void dwt_trace_enable(
+	int enable	///< zero value to turn the tracing off
+);
+
+/**
+ * @brief The current timestamp.
+ */
+dwt_trace_t dwt_trace_clock();
+
+/**
+ * @brief Store the phase into the ring buffer of the calling thread.
+ */
+void dwt_trace_record(
+	const char *name,
+	int arg,
+	dwt_trace_t begin
+);
+
+/**
+ * @brief Write the recorded phases of all the threads into @p path.
+ *
+ * The file is the trace-event JSON of Chrome with a complete event ("X")
+ * per phase. The threads should not run any transform meanwhile.
+ *
+ * @returns the number of the phases written, -1 if the file cannot be written
+ */
+int dwt_trace_dump(
+	const char *path
+);
+
+/**
+ * @brief Drop the recorded phases of all the threads.
+ */
+void dwt_trace_clear();
+
+#endif
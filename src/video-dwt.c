@@ -0,0 +1,366 @@
+/**
+ * @brief Streaming temporal (2-D+t) transform of video frames.
+ */
+
+#include "video-dwt.h"
+#include "volume.h" // struct volume_t, volume_alloc_realiably
+#include "libdwt.h"
+#include "inline.h"
+#include "system.h" // dwt_util_alloc1, dwt_util_free
+#include "trace.h" // DWT_TRACE_BEGIN, DWT_TRACE_END
+// assert
+#include <assert.h>
+// memcpy
+#include <string.h>
+// INT_MAX
+#include <limits.h>
+
+// the number of frames kept for each level, at least 6 are needed
+#define VIDEO_RING 8
+
+/**
+ * A single temporal decomposition level.
+ */
+struct video_level_s {
+	int frames;		///< the number of frames received so far
+	int size;		///< the number of frames of the clip, INT_MAX until known
+	struct volume_t *ring;	///< VIDEO_RING frames as the slices
+};
+
+struct video_stream_s {
+	int size_x;
+	int size_y;
+	int J;
+	int j_spatial;
+	int flushed;
+	struct video_level_s *level;
+	video_sink_s_t sink;
+	void *sink_ctx;
+};
+
+/**
+ * whole-sample symmetric extension
+ */
+static
+int video_mirror(
+	int t,
+	int size)
+{
+	if( t < 0 )
+		return -t;
+	if( t >= size )
+		return 2*(size-1) - t;
+	return t;
+}
+
+static
+void *video_frame(
+	const struct video_level_s *level,
+	int t)
+{
+	const int m = video_mirror(t, level->size);
+
+	return volume_get_slice(level->ring, m % VIDEO_RING);
+}
+
+/**
+ * dst += w * (a + b) for all pixels of the frames
+ */
+static
+void video_lift_s(
+	const struct video_stream_s *stream,
+	const struct volume_t *ring,
+	void *dst,
+	const void *a,
+	const void *b,
+	float w)
+{
+	for(int y = 0; y < stream->size_y; y++)
+	{
+		float *restrict d = addr1_s(dst, y, ring->stride_y);
+		const float *restrict l = addr1_const_s(a, y, ring->stride_y);
+		const float *restrict r = addr1_const_s(b, y, ring->stride_y);
+
+		for(int x = 0; x < stream->size_x; x++)
+			d[x] += w * (l[x] + r[x]);
+	}
+}
+
+static
+void video_scale_s(
+	const struct video_stream_s *stream,
+	const struct volume_t *ring,
+	void *dst,
+	float v)
+{
+	for(int y = 0; y < stream->size_y; y++)
+	{
+		float *restrict d = addr1_s(dst, y, ring->stride_y);
+
+		for(int x = 0; x < stream->size_x; x++)
+			d[x] *= v;
+	}
+}
+
+/**
+ * Pass the complete frame to the sink, transformed spatially.
+ */
+static
+int video_sink_s(
+	struct video_stream_s *stream,
+	const struct volume_t *ring,
+	int j,
+	int highpass,
+	int t,
+	void *frame)
+{
+	if( stream->j_spatial )
+	{
+		int j_spatial = stream->j_spatial;
+
+		dwt_cdf97_2f_s(frame, ring->stride_y, ring->stride_x, stream->size_x, stream->size_y, stream->size_x, stream->size_y, &j_spatial, 0, 0);
+	}
+
+	return stream->sink(stream->sink_ctx, j, highpass, t, frame, ring->stride_y, ring->stride_x, stream->size_x, stream->size_y);
+}
+
+static
+int video_push_s(
+	struct video_stream_s *stream,
+	int j,
+	const void *frame,
+	int stride_x,
+	int stride_y
+);
+
+/**
+ * Emit the complete L frame, it goes to the next level unless this one is the last.
+ */
+static
+int video_emit_l_s(
+	struct video_stream_s *stream,
+	int j,
+	int t)
+{
+	struct video_level_s *level = &stream->level[j];
+
+	void *frame = video_frame(level, t);
+
+	// not decomposed for a single frame
+	if( level->size > 1 )
+		video_scale_s(stream, level->ring, frame, dwt_cdf97_s1_s);
+
+	if( j+1 < stream->J )
+		return video_push_s(stream, j+1, frame, level->ring->stride_y, level->ring->stride_x);
+
+	return video_sink_s(stream, level->ring, j+1, 0, t/2, frame);
+}
+
+/**
+ * Emit the complete H frame.
+ */
+static
+int video_emit_h_s(
+	struct video_stream_s *stream,
+	int j,
+	int t)
+{
+	struct video_level_s *level = &stream->level[j];
+
+	void *frame = video_frame(level, t);
+
+	video_scale_s(stream, level->ring, frame, 1/dwt_cdf97_s1_s);
+
+	return video_sink_s(stream, level->ring, j+1, 1, t/2, frame);
+}
+
+/**
+ * Temporal lifting triggered by the (real or virtual) even frame @p e.
+ *
+ * The same schedule as in the streaming 2-D transform: the 1st predict on
+ * e-1, the 1st update on e-2, the 2nd predict on e-3, the 2nd update on e-4.
+ * The frames e-5 and e-4 are complete after that.
+ */
+static
+int video_step_s(
+	struct video_stream_s *stream,
+	int j,
+	int e)
+{
+	struct video_level_s *level = &stream->level[j];
+
+	const float w[4] = { -dwt_cdf97_p1_s, dwt_cdf97_u1_s, -dwt_cdf97_p2_s, dwt_cdf97_u2_s };
+
+	for(int k = 0; k < 4; k++)
+	{
+		const int t = e-1-k;
+
+		if( t >= 0 && t < level->size )
+			video_lift_s(stream, level->ring, video_frame(level, t), video_frame(level, t-1), video_frame(level, t+1), w[k]);
+	}
+
+	int err = 0;
+
+	if( e-5 >= 0 && e-5 < level->size )
+		err |= video_emit_h_s(stream, j, e-5);
+	if( e-4 >= 0 && e-4 < level->size )
+		err |= video_emit_l_s(stream, j, e-4);
+
+	return err;
+}
+
+static
+int video_push_s(
+	struct video_stream_s *stream,
+	int j,
+	const void *frame,
+	int stride_x,
+	int stride_y)
+{
+	struct video_level_s *level = &stream->level[j];
+
+	const int t = level->frames++;
+
+	void *dst = volume_get_slice(level->ring, t % VIDEO_RING);
+
+	for(int y = 0; y < stream->size_y; y++)
+	{
+		float *restrict d = addr1_s(dst, y, level->ring->stride_y);
+
+		if( sizeof(float) == stride_y )
+			memcpy(d, addr1_const_s(frame, y, stride_x), sizeof(float) * stream->size_x);
+		else
+			for(int x = 0; x < stream->size_x; x++)
+				d[x] = *addr2_const_s(frame, y, x, stride_x, stride_y);
+	}
+
+	// the frames up to t are needed only, the length of the clip is not known yet
+	if( !(t & 1) )
+		return video_step_s(stream, j, t);
+
+	return 0;
+}
+
+/**
+ * The clip ends at the level @p j, flush it using the symmetric extension.
+ */
+static
+int video_flush_s(
+	struct video_stream_s *stream,
+	int j)
+{
+	struct video_level_s *level = &stream->level[j];
+
+	level->size = level->frames;
+
+	if( !level->size )
+		return 0;
+
+	// not decomposed
+	if( 1 == level->size )
+		return video_emit_l_s(stream, j, 0);
+
+	int err = 0;
+
+	for(int e = to_even(level->size+1); e < level->size+5; e += 2)
+		err |= video_step_s(stream, j, e);
+
+	return err;
+}
+
+struct video_stream_s *video_cdf97_stream_create_s(
+	int size_x,
+	int size_y,
+	int j_max,
+	int j_spatial,
+	video_sink_s_t sink,
+	void *sink_ctx)
+{
+	assert( size_x > 0 && size_y > 0 && j_max > 0 && sink );
+
+	struct video_stream_s *stream = dwt_util_alloc1(sizeof(struct video_stream_s));
+	struct video_level_s *level = dwt_util_alloc1(sizeof(struct video_level_s) * j_max);
+
+	if( !stream || !level )
+	{
+		dwt_util_log(LOG_ERR, "%s: unable to allocate memory\n", __FUNCTION__);
+		dwt_util_free(stream);
+		dwt_util_free(level);
+		return NULL;
+	}
+
+	for(int j = 0; j < j_max; j++)
+	{
+		level[j].frames = 0;
+		level[j].size = INT_MAX;
+		level[j].ring = volume_alloc_realiably(sizeof(float), size_x, size_y, VIDEO_RING, 0);
+	}
+
+	stream->size_x = size_x;
+	stream->size_y = size_y;
+	stream->J = j_max;
+	stream->j_spatial = j_spatial;
+	stream->flushed = 0;
+	stream->level = level;
+	stream->sink = sink;
+	stream->sink_ctx = sink_ctx;
+
+	return stream;
+}
+
+int video_cdf97_stream_push_s(
+	struct video_stream_s *stream,
+	const void *frame,
+	int stride_x,
+	int stride_y)
+{
+	assert( stream && frame );
+
+	if( stream->flushed )
+	{
+		dwt_util_log(LOG_ERR, "%s: the stream has been already flushed\n", __FUNCTION__);
+		return 1;
+	}
+
+	const dwt_trace_t trace = DWT_TRACE_BEGIN();
+
+	const int t = stream->level[0].frames;
+
+	const int err = video_push_s(stream, 0, frame, stride_x, stride_y);
+
+	DWT_TRACE_END("video frame", t, trace);
+
+	return err;
+}
+
+int video_cdf97_stream_flush_s(
+	struct video_stream_s *stream)
+{
+	assert( stream );
+
+	if( stream->flushed )
+		return 0;
+
+	stream->flushed = 1;
+
+	int err = 0;
+
+	// each level pushes its last frames into the next one
+	for(int j = 0; j < stream->J; j++)
+		err |= video_flush_s(stream, j);
+
+	return err;
+}
+
+void video_cdf97_stream_destroy_s(
+	struct video_stream_s *stream)
+{
+	if( !stream )
+		return;
+
+	for(int j = 0; j < stream->J; j++)
+		volume_free(stream->level[j].ring);
+
+	dwt_util_free(stream->level);
+	dwt_util_free(stream);
+}
@@ -0,0 +1,94 @@
+/**
+ * @brief Streaming temporal (2-D+t) transform of video frames.
+ */
+
+#ifndef VIDEO_DWT_H
+#define VIDEO_DWT_H
+
+/**
+ * @brief Coefficient frame sink.
+ *
+ * Receives the frame @p t of the temporal highpass (or lowpass) subband of
+ * the temporal decomposition level @p j (from 1 to J). In the interleaved
+ * layout along the time, the frame belongs to the position
+ * (2*t+highpass)*2^(j-1). The lowpass frames are emitted for the last level
+ * only. The frames of each subband come in the increasing order. The
+ * @p frame is valid only during the call.
+ *
+ * @returns zero value on success
+ */
+typedef int (*video_sink_s_t)(
+	void *ctx,		///< user data
+	int j,			///< temporal decomposition level
+	int highpass,		///< zero for the lowpass subband
+	int t,			///< index of the frame in the subband
+	const void *frame,	///< coefficients
+	int stride_x,		///< difference between rows (in bytes)
+	int stride_y,		///< difference between columns (in bytes)
+	int size_x,		///< width of the frame
+	int size_y		///< height of the frame
+);
+
+/**
+ * @brief State of the streaming temporal transform.
+ */
+struct video_stream_s;
+
+/**
+ * @brief Begin the forward CDF 9/7 transform of a stream of frames.
+ *
+ * The frames are transformed along the time using @p j_max temporal levels.
+ * Each level keeps only eight frames, i.e. the window of the lifting, in
+ * memory. The memory use as well as the latency thus does not depend on the
+ * length of the clip. The coefficients of the level j at the position p
+ * are emitted when the frame p+9*2^(j-1)-4 is pushed, i.e. with the lag of
+ * 5 frames for a single level. The symmetric extension on both ends of the
+ * clip is the same as with the transform of the whole volume. Each emitted
+ * frame is further transformed by @ref dwt_cdf97_2f_s using @p j_spatial
+ * spatial levels.
+ *
+ * @returns NULL on failure
+ *
+ * @warning experimental
+ */
+struct video_stream_s *video_cdf97_stream_create_s(
+	int size_x,		///< width of the frames
+	int size_y,		///< height of the frames
+	int j_max,		///< the number of temporal levels, at least one
+	int j_spatial,		///< the number of spatial levels of the emitted frames, zero for none, -1 for all
+	video_sink_s_t sink,	///< coefficient sink
+	void *sink_ctx		///< user data for @p sink
+);
+
+/**
+ * @brief Push the next frame of the clip.
+ *
+ * @returns zero value on success
+ */
+int video_cdf97_stream_push_s(
+	struct video_stream_s *stream,
+	const void *frame,	///< the frame of floats
+	int stride_x,		///< difference between rows (in bytes)
+	int stride_y		///< difference between columns (in bytes)
+);
+
+/**
+ * @brief End the clip, the remaining frames are emitted.
+ *
+ * If the clip is too short for the number of temporal levels, the single
+ * remaining frame is passed to the further levels without a change.
+ *
+ * @returns zero value on success
+ */
+int video_cdf97_stream_flush_s(
+	struct video_stream_s *stream
+);
+
+/**
+ * @brief Release the stream.
+ */
+void video_cdf97_stream_destroy_s(
+	struct video_stream_s *stream
+);
+
+#endif
@@ -0,0 +1,495 @@
+/**
+ * @brief Out-of-core 3-D transform of bricked volumes.
+ */
+
+#include "volume-brick.h"
+#include "libdwt.h" // dwt_util_log
+#include "inline.h" // min, max
+// assert
+#include <assert.h>
+// memcpy, memcmp
+#include <string.h>
+// open
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+// mmap, madvise
+#include <sys/mman.h>
+// ftruncate, close, sysconf
+#include <unistd.h>
+
+#define VOLUME_BRICK_MAGIC "LIBDWTBV"
+
+/**
+ * The voxels of the neighbours needed to transform a brick, the support of
+ * the lifting in each direction.
+ */
+#define VOLUME_BRICK_SUPPORT 4
+
+/**
+ * The shortest extended brick, the cores need a few voxels on short volumes.
+ */
+#define VOLUME_BRICK_MIN_WINDOW 16
+
+/**
+ * The header at the beginning of the file.
+ */
+struct volume_brick_header {
+	char magic[8];
+	int size_x, size_y, size_z;
+	int brick_x, brick_y, brick_z;
+	int halo;
+};
+
+static
+void volume_brick_geometry(
+	struct volume_brick_t *map,
+	int size_x,
+	int size_y,
+	int size_z,
+	int brick_x,
+	int brick_y,
+	int brick_z,
+	int halo)
+{
+	map->size_x = size_x;
+	map->size_y = size_y;
+	map->size_z = size_z;
+
+	map->brick_x = brick_x;
+	map->brick_y = brick_y;
+	map->brick_z = brick_z;
+	map->halo = halo;
+
+	map->count_x = ceil_div(size_x, brick_x);
+	map->count_y = ceil_div(size_y, brick_y);
+	map->count_z = ceil_div(size_z, brick_z);
+
+	map->stride_x = sizeof(float);
+	map->stride_y = map->stride_x * (brick_x + 2*halo);
+	map->stride_z = map->stride_y * (brick_y + 2*halo);
+	map->brick_size = map->stride_z * (brick_z + 2*halo);
+
+	map->length = VOLUME_BRICK_HEADER + map->brick_size * map->count_x * map->count_y * map->count_z;
+}
+
+static
+int volume_brick_map(
+	struct volume_brick_t *map,
+	int writable)
+{
+	void *ptr = mmap(0, map->length, writable ? PROT_READ|PROT_WRITE : PROT_READ, MAP_SHARED, map->fd, 0);
+	if( MAP_FAILED == ptr )
+	{
+		dwt_util_log(LOG_ERR, "mmap() fails\n");
+		close(map->fd);
+		return 1;
+	}
+
+	map->ptr = ptr;
+	map->writable = writable;
+
+	return 0;
+}
+
+int volume_brick_create_s(
+	struct volume_brick_t *map,
+	const char *path,
+	int size_x,
+	int size_y,
+	int size_z,
+	int brick_x,
+	int brick_y,
+	int brick_z,
+	int halo)
+{
+	assert( map && path );
+	assert( size_x > 0 && size_y > 0 && size_z > 0 );
+	assert( brick_x > 0 && brick_y > 0 && brick_z > 0 && halo >= 0 );
+
+	volume_brick_geometry(map, size_x, size_y, size_z, brick_x, brick_y, brick_z, halo);
+	map->ptr = NULL;
+
+	map->fd = open(path, O_CREAT|O_RDWR|O_TRUNC, S_IRUSR|S_IWUSR);
+	if( map->fd < 0 )
+	{
+		dwt_util_log(LOG_ERR, "open() fails for '%s'\n", path);
+		return 1;
+	}
+
+	if( ftruncate(map->fd, map->length) )
+	{
+		dwt_util_log(LOG_ERR, "ftruncate() fails\n");
+		close(map->fd);
+		return 1;
+	}
+
+	if( volume_brick_map(map, 1) )
+		return 1;
+
+	const struct volume_brick_header header = {
+		.magic = VOLUME_BRICK_MAGIC,
+		.size_x = size_x,
+		.size_y = size_y,
+		.size_z = size_z,
+		.brick_x = brick_x,
+		.brick_y = brick_y,
+		.brick_z = brick_z,
+		.halo = halo,
+	};
+
+	memcpy(map->ptr, &header, sizeof(header));
+
+	return 0;
+}
+
+int volume_brick_open_s(
+	struct volume_brick_t *map,
+	const char *path,
+	int writable)
+{
+	assert( map && path );
+
+	map->ptr = NULL;
+
+	map->fd = open(path, writable ? O_RDWR : O_RDONLY);
+	if( map->fd < 0 )
+	{
+		dwt_util_log(LOG_ERR, "open() fails for '%s'\n", path);
+		return 1;
+	}
+
+	struct volume_brick_header header;
+
+	if( (ssize_t)sizeof(header) != read(map->fd, &header, sizeof(header)) || memcmp(header.magic, VOLUME_BRICK_MAGIC, sizeof(header.magic)) )
+	{
+		dwt_util_log(LOG_ERR, "'%s' is not a bricked volume\n", path);
+		close(map->fd);
+		return 1;
+	}
+
+	if( header.size_x < 1 || header.size_y < 1 || header.size_z < 1 ||
+		header.brick_x < 1 || header.brick_y < 1 || header.brick_z < 1 || header.halo < 0 )
+	{
+		dwt_util_log(LOG_ERR, "'%s' has an invalid header\n", path);
+		close(map->fd);
+		return 1;
+	}
+
+	volume_brick_geometry(map, header.size_x, header.size_y, header.size_z, header.brick_x, header.brick_y, header.brick_z, header.halo);
+
+	struct stat st;
+
+	if( fstat(map->fd, &st) || (size_t)st.st_size < map->length )
+	{
+		dwt_util_log(LOG_ERR, "'%s' is too short for %ix%ix%i floats\n", path, map->size_x, map->size_y, map->size_z);
+		close(map->fd);
+		return 1;
+	}
+
+	return volume_brick_map(map, writable);
+}
+
+void volume_brick_close_s(
+	struct volume_brick_t *map)
+{
+	assert( map );
+
+	if( map->ptr )
+		munmap(map->ptr, map->length);
+
+	close(map->fd);
+
+	map->ptr = NULL;
+	map->fd = -1;
+}
+
+static
+char *volume_brick_get(
+	const struct volume_brick_t *map,
+	int i,
+	int j,
+	int k)
+{
+	return (char *)map->ptr + VOLUME_BRICK_HEADER + (((size_t)k * map->count_y + j) * map->count_x + i) * map->brick_size;
+}
+
+/**
+ * Copy the intersection of the box at (x0, y0, z0) with the brick (i, j, k)
+ * extended by @p ext voxels (at most by the halo) from or into the brick.
+ */
+static
+void volume_brick_copy_s(
+	const struct volume_brick_t *map,
+	int i,
+	int j,
+	int k,
+	int ext,
+	int x0,
+	int y0,
+	int z0,
+	struct volume_t *volume,
+	int store)
+{
+	assert( ext <= map->halo );
+	assert( volume->stride_x == sizeof(float) );
+
+	// the intersection
+	const int ax = max(max(x0, i * map->brick_x - ext), 0);
+	const int ay = max(max(y0, j * map->brick_y - ext), 0);
+	const int az = max(max(z0, k * map->brick_z - ext), 0);
+	const int bx = min(min(x0 + volume->size_x, (i+1) * map->brick_x + ext), map->size_x);
+	const int by = min(min(y0 + volume->size_y, (j+1) * map->brick_y + ext), map->size_y);
+	const int bz = min(min(z0 + volume->size_z, (k+1) * map->brick_z + ext), map->size_z);
+
+	if( ax >= bx || ay >= by || az >= bz )
+		return;
+
+	// the first voxel of the brick including the halo
+	const int ox = i * map->brick_x - map->halo;
+	const int oy = j * map->brick_y - map->halo;
+	const int oz = k * map->brick_z - map->halo;
+
+	char *brick = volume_brick_get(map, i, j, k);
+
+	const size_t bytes = sizeof(float) * (bx - ax);
+
+	for(int z = az; z < bz; z++)
+	{
+		for(int y = ay; y < by; y++)
+		{
+			char *b = brick + (ax - ox) * map->stride_x + (y - oy) * map->stride_y + (z - oz) * map->stride_z;
+			char *v = volume_get_pix(volume, ax - x0, y - y0, z - z0);
+
+			if( store )
+				memcpy(b, v, bytes);
+			else
+				memcpy(v, b, bytes);
+		}
+	}
+}
+
+void volume_brick_read_s(
+	const struct volume_brick_t *map,
+	int x0,
+	int y0,
+	int z0,
+	struct volume_t *volume)
+{
+	assert( map && map->ptr && volume );
+	assert( x0 >= 0 && x0 + volume->size_x <= map->size_x );
+	assert( y0 >= 0 && y0 + volume->size_y <= map->size_y );
+	assert( z0 >= 0 && z0 + volume->size_z <= map->size_z );
+
+	const int h = map->halo;
+
+	// the brick which could hold the whole box in its halo
+	const int i = min((x0 + h) / map->brick_x, map->count_x - 1);
+	const int j = min((y0 + h) / map->brick_y, map->count_y - 1);
+	const int k = min((z0 + h) / map->brick_z, map->count_z - 1);
+
+	if( x0 >= i * map->brick_x - h && x0 + volume->size_x <= (i+1) * map->brick_x + h &&
+		y0 >= j * map->brick_y - h && y0 + volume->size_y <= (j+1) * map->brick_y + h &&
+		z0 >= k * map->brick_z - h && z0 + volume->size_z <= (k+1) * map->brick_z + h )
+	{
+		volume_brick_copy_s(map, i, j, k, h, x0, y0, z0, volume, 0);
+		return;
+	}
+
+	for(int k = z0 / map->brick_z; k <= (z0 + volume->size_z - 1) / map->brick_z; k++)
+		for(int j = y0 / map->brick_y; j <= (y0 + volume->size_y - 1) / map->brick_y; j++)
+			for(int i = x0 / map->brick_x; i <= (x0 + volume->size_x - 1) / map->brick_x; i++)
+				volume_brick_copy_s(map, i, j, k, 0, x0, y0, z0, volume, 0);
+}
+
+void volume_brick_write_s(
+	struct volume_brick_t *map,
+	int x0,
+	int y0,
+	int z0,
+	struct volume_t *volume)
+{
+	assert( map && map->ptr && map->writable && volume );
+	assert( x0 >= 0 && x0 + volume->size_x <= map->size_x );
+	assert( y0 >= 0 && y0 + volume->size_y <= map->size_y );
+	assert( z0 >= 0 && z0 + volume->size_z <= map->size_z );
+
+	const int h = map->halo;
+
+	// all the bricks whose halo overlaps the box
+	for(int k = max(z0 - h, 0) / map->brick_z; k <= min((z0 + volume->size_z - 1 + h) / map->brick_z, map->count_z - 1); k++)
+		for(int j = max(y0 - h, 0) / map->brick_y; j <= min((y0 + volume->size_y - 1 + h) / map->brick_y, map->count_y - 1); j++)
+			for(int i = max(x0 - h, 0) / map->brick_x; i <= min((x0 + volume->size_x - 1 + h) / map->brick_x, map->count_x - 1); i++)
+				volume_brick_copy_s(map, i, j, k, h, x0, y0, z0, volume, 1);
+}
+
+/**
+ * Drop the pages of @p bricks bricks starting at the brick (i, j, k) from the
+ * process. The pages are read again from the file when touched later.
+ */
+static
+void volume_brick_drop(
+	const struct volume_brick_t *map,
+	int i,
+	int j,
+	int k,
+	int bricks)
+{
+	if( k < 0 )
+		return;
+
+	const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+
+	const size_t begin = (size_t)(volume_brick_get(map, i, j, k) - (char *)map->ptr);
+	const size_t end = begin + map->brick_size * bricks;
+
+	// only the pages completely inside the bricks
+	const size_t first = (begin + page - 1) / page * page;
+	const size_t last = end / page * page;
+
+	if( first < last )
+		madvise((char *)map->ptr + first, last - first, MADV_DONTNEED);
+}
+
+/**
+ * The brick @p i covers [a, b), it is transformed within the window [A, B).
+ */
+static
+void volume_brick_window(
+	int i,
+	int brick,
+	int size,
+	int *a,
+	int *b,
+	int *A,
+	int *B)
+{
+	*a = i * brick;
+	*b = min(*a + brick, size);
+	*B = min(*b + VOLUME_BRICK_SUPPORT, size);
+	// on a multiple of four, this keeps the parity as well as the steps of the cube cores
+	*A = max(min(*a - VOLUME_BRICK_SUPPORT, (*B - VOLUME_BRICK_MIN_WINDOW) & ~3), 0);
+}
+
+static
+struct volume_t volume_brick_view(
+	struct volume_t *volume,
+	int x0,
+	int y0,
+	int z0,
+	int size_x,
+	int size_y,
+	int size_z)
+{
+	struct volume_t view = *volume;
+
+	view.data = volume_get_pix(volume, x0, y0, z0);
+	view.size_x = size_x;
+	view.size_y = size_y;
+	view.size_z = size_z;
+
+	return view;
+}
+
+static
+int volume_brick_97op_s(
+	struct volume_brick_t *src,
+	struct volume_brick_t *dst,
+	enum volume_approach approach,
+	int inverse)
+{
+	assert( src && src->ptr && dst && dst->ptr );
+
+	if( src->size_x != dst->size_x || src->size_y != dst->size_y || src->size_z != dst->size_z ||
+		src->brick_x != dst->brick_x || src->brick_y != dst->brick_y || src->brick_z != dst->brick_z )
+	{
+		dwt_util_log(LOG_ERR, "%s: the volumes differ in their size or bricks\n", __FUNCTION__);
+		return 1;
+	}
+
+	if( !dst->writable )
+	{
+		dwt_util_log(LOG_ERR, "%s: the destination is not writable\n", __FUNCTION__);
+		return 1;
+	}
+
+	if( (src->brick_x & 3) || (src->brick_y & 3) || (src->brick_z & 3) ||
+		src->brick_x < VOLUME_BRICK_MIN_WINDOW || src->brick_y < VOLUME_BRICK_MIN_WINDOW || src->brick_z < VOLUME_BRICK_MIN_WINDOW )
+	{
+		dwt_util_log(LOG_ERR, "%s: unsupported size of bricks %ix%ix%i\n", __FUNCTION__, src->brick_x, src->brick_y, src->brick_z);
+		return 1;
+	}
+
+	// the bricks extended by the support on each side
+	const int extended_x = src->brick_x + 2*VOLUME_BRICK_SUPPORT;
+	const int extended_y = src->brick_y + 2*VOLUME_BRICK_SUPPORT;
+	const int extended_z = src->brick_z + 2*VOLUME_BRICK_SUPPORT;
+
+	struct volume_t *temp_src = volume_alloc_realiably(sizeof(float), extended_x, extended_y, extended_z, 0);
+	struct volume_t *temp_dst = volume_alloc_realiably(sizeof(float), extended_x, extended_y, extended_z, 0);
+
+	for(int k = 0; k < src->count_z; k++)
+	{
+		int az, bz, Az, Bz;
+		volume_brick_window(k, src->brick_z, src->size_z, &az, &bz, &Az, &Bz);
+
+		for(int j = 0; j < src->count_y; j++)
+		{
+			int ay, by, Ay, By;
+			volume_brick_window(j, src->brick_y, src->size_y, &ay, &by, &Ay, &By);
+
+			for(int i = 0; i < src->count_x; i++)
+			{
+				int ax, bx, Ax, Bx;
+				volume_brick_window(i, src->brick_x, src->size_x, &ax, &bx, &Ax, &Bx);
+
+				struct volume_t window_src = volume_brick_view(temp_src, 0, 0, 0, Bx - Ax, By - Ay, Bz - Az);
+				struct volume_t window_dst = volume_brick_view(temp_dst, 0, 0, 0, Bx - Ax, By - Ay, Bz - Az);
+
+				volume_brick_read_s(src, Ax, Ay, Az, &window_src);
+
+				if( inverse )
+					cdf97_3i_op_wrapper_s(&window_src, &window_dst, approach);
+				else
+					cdf97_3f_op_wrapper_s(&window_src, &window_dst, approach);
+
+				// the brick without the extension
+				struct volume_t interior = volume_brick_view(temp_dst, ax - Ax, ay - Ay, az - Az, bx - ax, by - ay, bz - az);
+
+				volume_brick_write_s(dst, ax, ay, az, &interior);
+
+				// the neighbours touch the halo of the brick only
+				volume_brick_drop(dst, i, j, k, 1);
+
+				// the brick including its halo is read by itself only
+				if( src->halo >= VOLUME_BRICK_SUPPORT )
+					volume_brick_drop(src, i, j, k, 1);
+			}
+		}
+
+		// otherwise, the next layer reads the previous one
+		if( src->halo < VOLUME_BRICK_SUPPORT )
+			volume_brick_drop(src, 0, 0, k-1, src->count_x * src->count_y);
+	}
+
+	volume_free(temp_src);
+	volume_free(temp_dst);
+
+	return 0;
+}
+
+int volume_brick_cdf97_3f_s(
+	struct volume_brick_t *src,
+	struct volume_brick_t *dst,
+	enum volume_approach approach)
+{
+	return volume_brick_97op_s(src, dst, approach, 0);
+}
+
+int volume_brick_cdf97_3i_s(
+	struct volume_brick_t *src,
+	struct volume_brick_t *dst,
+	enum volume_approach approach)
+{
+	return volume_brick_97op_s(src, dst, approach, 1);
+}
@@ -0,0 +1,167 @@
+/**
+ * @brief Out-of-core 3-D transform of bricked volumes.
+ */
+
+#ifndef VOLUME_BRICK_H
+#define VOLUME_BRICK_H
+
+#include "volume.h" // struct volume_t
+#include "volume-dwt.h" // enum volume_approach
+#include <stddef.h> // size_t
+
+/**
+ * @brief Bricked volume of floats in a memory-mapped file.
+ *
+ * The volume is split into bricks of brick_x*brick_y*brick_z voxels. Each
+ * brick is stored including a halo of @e halo voxels on each side, the halo
+ * holds copies of the voxels of the neighbouring bricks. Thus, a brick with
+ * its halo can be read as a single contiguous block. The halo outside the
+ * volume (and the bricks on the border beyond the volume) are zero.
+ *
+ * The file starts with a header of @ref VOLUME_BRICK_HEADER bytes. The bricks
+ * follow in z, y, x order (x changes fastest), as do the voxels inside the
+ * bricks.
+ */
+struct volume_brick_t {
+	int fd;
+	void *ptr;		///< the whole file including the header
+	size_t length;		///< length of the file (in bytes)
+	int writable;
+
+	int size_x;		///< columns of the volume
+	int size_y;		///< rows of the volume
+	int size_z;		///< slices of the volume
+
+	int brick_x;		///< columns of a brick (without the halo)
+	int brick_y;		///< rows of a brick (without the halo)
+	int brick_z;		///< slices of a brick (without the halo)
+	int halo;		///< the halo around each brick (in voxels)
+
+	int count_x;		///< the number of bricks in each direction
+	int count_y;
+	int count_z;
+
+	size_t stride_x;	///< sizeof(float)
+	size_t stride_y;	///< sizeof(row of a brick including the halo)
+	size_t stride_z;	///< sizeof(slice of a brick including the halo)
+	size_t brick_size;	///< sizeof(brick including the halo)
+};
+
+/**
+ * @brief Size of the file header, the bricks start at this offset.
+ */
+#define VOLUME_BRICK_HEADER 4096
+
+/**
+ * @brief Create (or truncate) the bricked volume file and map it for writing.
+ *
+ * All the voxels are zero.
+ *
+ * @returns zero value on success
+ */
+int volume_brick_create_s(
+	struct volume_brick_t *map,
+	const char *path,
+	int size_x,	///< columns of the volume
+	int size_y,	///< rows of the volume
+	int size_z,	///< slices of the volume
+	int brick_x,	///< columns of a brick
+	int brick_y,	///< rows of a brick
+	int brick_z,	///< slices of a brick
+	int halo	///< the halo (in voxels), may be zero
+);
+
+/**
+ * @brief Map the existing bricked volume file.
+ *
+ * The geometry is taken from the header of the file.
+ *
+ * @returns zero value on success
+ */
+int volume_brick_open_s(
+	struct volume_brick_t *map,
+	const char *path,
+	int writable	///< map the file for writing too?
+);
+
+/**
+ * @brief Unmap the file.
+ */
+void volume_brick_close_s(
+	struct volume_brick_t *map
+);
+
+/**
+ * @brief Read the box of size of @p volume at (@p x0, @p y0, @p z0) into @p volume.
+ *
+ * If the box fits into a single brick including its halo, the brick is
+ * the only one touched.
+ */
+void volume_brick_read_s(
+	const struct volume_brick_t *map,
+	int x0,
+	int y0,
+	int z0,
+	struct volume_t *volume
+);
+
+/**
+ * @brief Write @p volume into the box at (@p x0, @p y0, @p z0).
+ *
+ * The halos of the neighbouring bricks are updated as well.
+ */
+void volume_brick_write_s(
+	struct volume_brick_t *map,
+	int x0,
+	int y0,
+	int z0,
+	struct volume_t *volume
+);
+
+/**
+ * @brief Forward 3-D transform of the bricked volume.
+ *
+ * The bricks are transformed one by one using @ref cdf97_3f_op_wrapper_s.
+ * Each brick is extended by four voxels of its neighbours on each side,
+ * i.e. by the support of the lifting, before it is transformed. Only the
+ * coefficients of the brick itself are then written into @p dst. Thus,
+ * the result is the same as with the volume transformed at once. The
+ * pages of the bricks are dropped from the process as soon as they are
+ * processed. Thus, the memory footprint is bounded by a few bricks if the
+ * halo of the @p src covers the four voxels, otherwise by two layers of
+ * bricks of the @p src.
+ *
+ * The @p dst must have the same size and bricks as the @p src, its halo
+ * can differ. The size of the bricks has to be a multiple of four and at
+ * least 16 voxels.
+ *
+ * * dimensions: 3-D
+ * * direction: forward
+ * * scales: 1
+ * * wavelet: CDF 9/7
+ * * data type: float
+ * * strategy: out-of-core
+ * * layout: interleaved subbands
+ *
+ * @returns zero value on success
+ */
+int volume_brick_cdf97_3f_s(
+	struct volume_brick_t *src,
+	struct volume_brick_t *dst,
+	enum volume_approach approach
+);
+
+/**
+ * @brief Inverse 3-D transform of the bricked volume.
+ *
+ * The inverse of @ref volume_brick_cdf97_3f_s using @ref cdf97_3i_op_wrapper_s.
+ *
+ * @returns zero value on success
+ */
+int volume_brick_cdf97_3i_s(
+	struct volume_brick_t *src,
+	struct volume_brick_t *dst,
+	enum volume_approach approach
+);
+
+#endif
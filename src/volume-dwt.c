@@ -14,6 +14,7 @@
 #endif
 #include "inline-sdl.h"
 #include <limits.h> // ULONG_MAX
+#include "pool.h" // dwt_pool_get_threads
 
 static
 int virt2real(int pos, int offset, int overlap, int size)
@@ -674,7 +675,220 @@ void cdf97_3f_op_HORIZ_vert2x2x2_s(struct volume_t *volume_src, struct volume_t
 #endif
 }
 
-void cdf97_3f_ip_sep_horizontal_s(struct volume_t *volume)
+/**
+ * The slices of the neighbouring slabs needed for the lifting over z-axe.
+ * The CDF 9/7 spans four samples to each side in both directions. The slabs
+ * start at the multiples of the halo, thus the parity of the slices is kept
+ * and the z-step of all the cores is satisfied.
+ */
+#define VOLUME_SLAB_HALO 4
+
+typedef void (*volume_func_t)(struct volume_t *, struct volume_t *);
+
+/**
+ * The slices [z0; z1) are transformed within the slices [A; B).
+ */
+struct volume_slab {
+	int z0, z1;
+	int A, B;
+	struct volume_t *temp; // the slices [A; B), only the halos for in-place transforms
+};
+
+static
+struct volume_t volume_view(struct volume_t *volume, int z0, int z1)
+{
+	struct volume_t view = *volume;
+
+	view.data = volume_get_slice(volume, z0);
+	view.size_z = z1 - z0;
+
+	return view;
+}
+
+/**
+ * Is the volume transformed per slabs by several threads?
+ */
+static
+int volume_slabs_enabled(struct volume_t *volume)
+{
+	// at least two slabs of at least two halos
+	return dwt_util_get_num_threads() > 1 && volume->size_z >= 4*VOLUME_SLAB_HALO;
+}
+
+/**
+ * Partition the slices into at most @p threads slabs.
+ *
+ * @return the number of slabs
+ */
+static
+int volume_slabs(struct volume_slab *slab, int size_z, int threads)
+{
+	const int units = size_z / VOLUME_SLAB_HALO;
+
+	// at least two units per slab
+	const int slabs = max(1, min(threads, units / 2));
+
+	for(int k = 0; k < slabs; k++)
+	{
+		slab[k].z0 = VOLUME_SLAB_HALO * (k * units / slabs);
+		slab[k].z1 = (k+1 == slabs) ? size_z : VOLUME_SLAB_HALO * ((k+1) * units / slabs);
+		slab[k].A = max(0, slab[k].z0 - VOLUME_SLAB_HALO);
+		slab[k].B = min(size_z, slab[k].z1 + VOLUME_SLAB_HALO);
+		slab[k].temp = NULL;
+	}
+
+	return slabs;
+}
+
+/**
+ * Copy the slices [z0; z1) of the slab back.
+ */
+static
+void volume_slab_store(struct volume_slab *slab, struct volume_t *volume_dst)
+{
+	struct volume_t from = volume_view(slab->temp, slab->z0 - slab->A, slab->z1 - slab->A);
+	struct volume_t to = volume_view(volume_dst, slab->z0, slab->z1);
+
+	volume_copy_s(&to, &from);
+}
+
+/**
+ * Out-of-place transform per slabs.
+ *
+ * Each thread transforms the slices of its slab including the halos using
+ * @p func into a temporary volume, the halos are then dropped.
+ */
+static
+void volume_op_slabs(struct volume_t *volume_src, struct volume_t *volume_dst, volume_func_t func)
+{
+	assert( volume_src != volume_dst );
+
+	const int threads = dwt_util_get_num_threads();
+
+	struct volume_slab slab[threads];
+
+	const int slabs = volume_slabs(slab, volume_src->size_z, threads);
+
+	#pragma omp parallel for schedule(static, 1)
+	for(int k = 0; k < slabs; k++)
+	{
+		struct volume_t src = volume_view(volume_src, slab[k].A, slab[k].B);
+
+		slab[k].temp = volume_alloc_realiably(sizeof(float), src.size_x, src.size_y, src.size_z, 0);
+
+		func(&src, slab[k].temp);
+
+		volume_slab_store(&slab[k], volume_dst);
+
+		volume_free(slab[k].temp);
+	}
+}
+
+/**
+ * Exchange the samples of two equally-sized volumes.
+ */
+static
+void volume_swap_s(struct volume_t *volume_l, struct volume_t *volume_r)
+{
+	assert( volume_l->size_x == volume_r->size_x );
+	assert( volume_l->size_y == volume_r->size_y );
+	assert( volume_l->size_z == volume_r->size_z );
+
+	for(int z = 0; z < volume_l->size_z; z++)
+	{
+		for(int y = 0; y < volume_l->size_y; y++)
+		{
+			for(int x = 0; x < volume_l->size_x; x++)
+			{
+				float *l = volume_get_pix(volume_l, x, y, z);
+				float *r = volume_get_pix(volume_r, x, y, z);
+
+				const float t = *l;
+				*l = *r;
+				*r = t;
+			}
+		}
+	}
+}
+
+/**
+ * The halos [A; z0) and [z1; B) of the volume and of the slab (one after another).
+ */
+static
+void volume_slab_halos(struct volume_slab *slab, struct volume_t *volume, struct volume_t halo_volume[2], struct volume_t halo_slab[2])
+{
+	const int L = slab->z0 - slab->A;
+	const int R = slab->B - slab->z1;
+
+	halo_volume[0] = volume_view(volume, slab->A, slab->z0);
+	halo_volume[1] = volume_view(volume, slab->z1, slab->B);
+
+	halo_slab[0] = volume_view(slab->temp, 0, L);
+	halo_slab[1] = volume_view(slab->temp, L, L+R);
+}
+
+/**
+ * In-place transform per slabs.
+ *
+ * Only the halos of the slabs are kept aside before the transform. The
+ * slabs run in two waves, odd and even ones, thus the slabs transformed at
+ * once do not overlap. Each slab puts the original halos into the volume,
+ * transforms the slices [A; B) in-place, and puts the samples of the
+ * neighbouring slabs back.
+ */
+static
+void volume_ip_slabs(struct volume_t *volume, void (*func)(struct volume_t *))
+{
+	const int threads = dwt_util_get_num_threads();
+
+	// two waves of slabs
+	struct volume_slab slab[2*threads];
+
+	const int slabs = volume_slabs(slab, volume->size_z, 2*threads);
+
+	#pragma omp parallel for schedule(static, 1)
+	for(int k = 0; k < slabs; k++)
+	{
+		const int halos = (slab[k].z0 - slab[k].A) + (slab[k].B - slab[k].z1);
+
+		slab[k].temp = volume_alloc_realiably(sizeof(float), volume->size_x, volume->size_y, halos, 0);
+
+		struct volume_t halo_volume[2], halo_slab[2];
+
+		volume_slab_halos(&slab[k], volume, halo_volume, halo_slab);
+
+		volume_copy_s(&halo_slab[0], &halo_volume[0]);
+		volume_copy_s(&halo_slab[1], &halo_volume[1]);
+	}
+
+	for(int wave = 0; wave < 2; wave++)
+	{
+		#pragma omp parallel for schedule(static, 1)
+		for(int k = wave; k < slabs; k += 2)
+		{
+			struct volume_t halo_volume[2], halo_slab[2];
+
+			volume_slab_halos(&slab[k], volume, halo_volume, halo_slab);
+
+			// original halos in, samples of the neighbours aside
+			volume_swap_s(&halo_volume[0], &halo_slab[0]);
+			volume_swap_s(&halo_volume[1], &halo_slab[1]);
+
+			struct volume_t view = volume_view(volume, slab[k].A, slab[k].B);
+
+			func(&view);
+
+			// samples of the neighbours back
+			volume_copy_s(&halo_volume[0], &halo_slab[0]);
+			volume_copy_s(&halo_volume[1], &halo_slab[1]);
+
+			volume_free(slab[k].temp);
+		}
+	}
+}
+
+static
+void cdf97_3f_ip_sep_horizontal_serial_s(struct volume_t *volume)
 {
 	assert( volume );
 
@@ -724,6 +938,16 @@ void cdf97_3f_ip_sep_horizontal_s(struct volume_t *volume)
 	}
 }
 
+void cdf97_3f_ip_sep_horizontal_s(struct volume_t *volume)
+{
+	assert( volume );
+
+	if( volume_slabs_enabled(volume) )
+		volume_ip_slabs(volume, cdf97_3f_ip_sep_horizontal_serial_s);
+	else
+		cdf97_3f_ip_sep_horizontal_serial_s(volume);
+}
+
 void cdf97_3f_op_sep_horizontal_s(struct volume_t *volume_src, struct volume_t *volume_dst)
 {
 	assert( volume_src );
@@ -1313,14 +1537,14 @@ void cube_4x4x2(
 		t[0][1],
 		&t[0][0],
 		&t[0][1],
-		buffer_x + (y+0)*4 + (z+0)*(super_x*4)
+		buffer_x + (y+0)*4 + (z+0)*(super_y*4)
 	);
 	vert_2x4(
 		t[0][2],
 		t[0][3],
 		&t[0][2],
 		&t[0][3],
-		buffer_x + (y+0)*4 + (z+0)*(super_x*4)
+		buffer_x + (y+0)*4 + (z+0)*(super_y*4)
 	);
 	// back 4x4 slice
 	vert_2x4(
@@ -1328,14 +1552,14 @@ void cube_4x4x2(
 		t[1][1],
 		&t[1][0],
 		&t[1][1],
-		buffer_x + (y+0)*4 + (z+1)*(super_x*4)
+		buffer_x + (y+0)*4 + (z+1)*(super_y*4)
 	);
 	vert_2x4(
 		t[1][2],
 		t[1][3],
 		&t[1][2],
 		&t[1][3],
-		buffer_x + (y+0)*4 + (z+1)*(super_x*4)
+		buffer_x + (y+0)*4 + (z+1)*(super_y*4)
 	);
 #endif
 	// transpose
@@ -2782,124 +3006,1793 @@ void cdf97_3f_op_HORIZ_vert4x4x4_s(struct volume_t *volume_src, struct volume_t
 	free(buffer_z);
 }
 
-typedef void (*volume_func_t)(struct volume_t *, struct volume_t *);
+/**
+ * The lifting steps of the forward CDF 9/7 transform, the odd samples are
+ * modified by the steps 0 and 2, the even ones by the steps 1 and 3.
+ */
+#define MS3_STEPS 4
 
-void cdf97_3f_op_wrapper_s(struct volume_t *volume_src, struct volume_t *volume_dst, enum volume_approach approach)
+static
+float ms3_weight(int s)
 {
-	assert( approach >= 0 && approach < VOL_LAST );
+	switch(s)
+	{
+		case 0: return -dwt_cdf97_p1_s;
+		case 1: return +dwt_cdf97_u1_s;
+		case 2: return -dwt_cdf97_p2_s;
+		default: return +dwt_cdf97_u2_s;
+	}
+}
 
-	volume_func_t volume_func[VOL_LAST] = {
-		[VOL_SEP_HORIZONTAL] = cdf97_3f_op_sep_horizontal_s,
-		[VOL_SEP_VERTICAL] = cdf97_3f_op_sep_vertical_s,
-		[VOL_SLICES_VERT4X4] = cdf97_3f_op_slices_vert4x4_s,
-		[VOL_BASELINE_VERT2X2X2] = cdf97_3f_op_baseline_vert2x2x2_s,
-		[VOL_HORIZ_VERT2X2X2] = cdf97_3f_op_HORIZ_vert2x2x2_s,
-		[VOL_BASELINE_VERT4X4X2] = cdf97_3f_op_cube_vert4x4x2_s,
-		[VOL_HORIZ_VERT4X4X2] = cdf97_3f_op_HORIZ_vert4x4x2_s,
-		[VOL_HORIZ_VERT4X4X4] = cdf97_3f_op_HORIZ_vert4x4x4_s,
-		[VOL_BASELINE_DIAG2X2X2] = cdf97_3f_op_baseline_diag2x2x2_s,
-		[VOL_HORIZ_DIAG2X2X2] = cdf97_3f_op_HORIZ_diag2x2x2_s,
-		[VOL_SEP_HORIZONTAL_X] = cdf97_3f_op_sep_horizontal_x_s,
-		[VOL_SEP_HORIZONTAL_Y] = cdf97_3f_op_sep_horizontal_y_s,
-		[VOL_SEP_HORIZONTAL_Z] = cdf97_3f_op_sep_horizontal_z_s,
-	};
+static
+int ms3_parity(int s)
+{
+	return !(s & 1);
+}
 
-	volume_func[approach](volume_src, volume_dst);
+// whole-sample symmetric extension
+static
+int ms3_reflect(int p, int N)
+{
+	if( p < 0 )
+		return -p;
+	if( p >= N )
+		return 2*N - 2 - p;
+	return p;
 }
 
-int volume_perftest_fwd97op_s(
-	int size, // size_x, size_y_ size_z
-	int opt_stride,
-	enum volume_approach approach,
-	int N, // tests, select minimum
-	double *secs, // seconds per pixel
-	long unsigned *faults // page faults
-)
+/**
+ * c += w * (l + r) over a lattice of size_x times size_y samples.
+ */
+static
+void ms3_lift_plane(
+	char *c,
+	const char *l,
+	const char *r,
+	float w,
+	int size_x,
+	int size_y,
+	size_t stride_x,
+	size_t stride_y)
 {
-	const int pixels = size*size*size;
-	const int clock_type = dwt_util_clock_autoselect();
+	if( sizeof(float) == stride_x )
+	{
+		for(int y = 0; y < size_y; y++)
+		{
+			float *restrict c_row = (float *)(c + y*stride_y);
+			const float *restrict l_row = (const float *)(l + y*stride_y);
+			const float *restrict r_row = (const float *)(r + y*stride_y);
 
-	int return_code = 0;
-	*secs = +INFINITY;
-	*faults = 0 /*ULONG_MAX*/;
+			for(int x = 0; x < size_x; x++)
+				c_row[x] += w * (l_row[x] + r_row[x]);
+		}
+	}
+	else
+	{
+		for(int y = 0; y < size_y; y++)
+			for(int x = 0; x < size_x; x++)
+				*(float *)(c + y*stride_y + x*stride_x) += w * (
+					*(const float *)(l + y*stride_y + x*stride_x) +
+					*(const float *)(r + y*stride_y + x*stride_x) );
+	}
+}
 
-	// allocate
-	struct volume_t *data1 = volume_alloc_realiably_locked(sizeof(float), size, size, size, opt_stride);
-	struct volume_t *data2 = volume_alloc_realiably_locked(sizeof(float), size, size, size, opt_stride);
+/**
+ * c *= w over a lattice of size_x times size_y samples.
+ */
+static
+void ms3_scale_plane(
+	char *c,
+	float w,
+	int size_x,
+	int size_y,
+	size_t stride_x,
+	size_t stride_y)
+{
+	if( sizeof(float) == stride_x )
+	{
+		for(int y = 0; y < size_y; y++)
+		{
+			float *restrict c_row = (float *)(c + y*stride_y);
 
-	for(int n = 0; n < N; n++)
+			for(int x = 0; x < size_x; x++)
+				c_row[x] *= w;
+		}
+	}
+	else
 	{
-		// fill with test pattern
-		volume_fill_s(data1);
+		for(int y = 0; y < size_y; y++)
+			for(int x = 0; x < size_x; x++)
+				*(float *)(c + y*stride_y + x*stride_x) *= w;
+	}
+}
 
-		// invalidate CPU cache
-		volume_invalidate_cache(data1);
-		volume_invalidate_cache(data2);
+/**
+ * Forward transform of @p N samples, each of them is the lattice of
+ * size_x times size_y elements, the samples are @p stride bytes apart.
+ */
+static
+void ms3_lift_lines(
+	char *ptr,
+	int N,
+	size_t stride,
+	int size_x,
+	int size_y,
+	size_t stride_x,
+	size_t stride_y)
+{
+	for(int s = 0; s < MS3_STEPS; s++)
+	{
+		const float w = ms3_weight(s);
 
-		// start measurement
-		long unsigned page_faults_start = dwt_util_get_page_fault();
-		dwt_clock_t start = dwt_util_get_clock(clock_type);
+		for(int p = ms3_parity(s); p < N; p += 2)
+			ms3_lift_plane(ptr + p*stride, ptr + ms3_reflect(p-1, N)*stride, ptr + ms3_reflect(p+1, N)*stride, w, size_x, size_y, stride_x, stride_y);
+	}
 
-		// forward transform
-		cdf97_3f_op_wrapper_s(data1, data2, approach);
+	for(int p = 0; p < N; p++)
+		ms3_scale_plane(ptr + p*stride, (p & 1) ? 1/dwt_cdf97_s1_s : dwt_cdf97_s1_s, size_x, size_y, stride_x, stride_y);
+}
 
-		// stop measurement
-		dwt_clock_t stop = dwt_util_get_clock(clock_type);
-		long unsigned page_faults_stop = dwt_util_get_page_fault();
+/**
+ * Forward transform of a contiguous line of @p N samples.
+ */
+static
+void ms3_lift_row(float *row, int N)
+{
+	for(int s = 0; s < MS3_STEPS; s++)
+	{
+		const float w = ms3_weight(s);
 
-		// elapsed time
-		const double elapsed_time_in_seconds = (stop - start)/(double)dwt_util_get_frequency(clock_type);
-		const double secs_per_pel = elapsed_time_in_seconds/pixels;
+		// the first sample
+		int p = ms3_parity(s);
 
-		// new page faults
-		long unsigned page_faults = page_faults_stop - page_faults_start;
-#if 0
-		dwt_util_log(LOG_DBG, "page faults: %lu - %lu = %lu\n", page_faults_stop, page_faults_start, page_faults);
-#endif
+		if( 0 == p )
+		{
+			row[0] += w * (row[1] + row[1]);
+			p += 2;
+		}
 
-		// select minimum time
-		if( secs_per_pel < *secs )
-			*secs = secs_per_pel;
+		for(; p < N-1; p += 2)
+			row[p] += w * (row[p-1] + row[p+1]);
 
-		// select minimum faults
-		if( page_faults > /*<*/ *faults )
-			*faults = page_faults;
+		// the last sample
+		if( p == N-1 )
+			row[p] += w * (row[p-1] + row[p-1]);
+	}
 
-		// inverse transform
-		cdf97_3i_ip_sep_horizontal_s(data2);
+	for(int p = 0; p < N; p++)
+		row[p] *= (p & 1) ? 1/dwt_cdf97_s1_s : dwt_cdf97_s1_s;
+}
 
-		// compare volumes
-		const int error = volume_compare_s(data1, data2);
-		return_code += error;
-	}
+/**
+ * The number of the recent slices of a level kept in the plane buffer.
+ */
+#define MS3_PLANES 16
 
-	// free data
-	volume_free(data1);
-	volume_free(data2);
+/**
+ * A single level of the fused transform.
+ *
+ * The slices of the level arrive one by one, the lifting over the z-axis is
+ * performed as soon as the neighbouring slices are available. The slices
+ * [0; done[s]) have completed the lifting steps preceding the step s.
+ *
+ * Unless the level is contiguous in the volume, its recent slices are
+ * transformed in the plane buffer and stored into the volume once final.
+ */
+struct ms3_level {
+	char *data;		///< the sample (0,0,0) of the level
+	int size_x, size_y, size_z;
+	size_t stride_x, stride_y, stride_z;
+	float *planes;		///< MS3_PLANES contiguous slices, NULL when transformed in the volume
+	size_t slice_stride_x;	///< the strides of a slice being transformed
+	size_t slice_stride_y;
+	int next[MS3_STEPS];	///< the next slice modified by each step
+	int done[MS3_STEPS+1];	///< done[0] is the number of slices arrived
+	int final;		///< the slices [0; final) were scaled
+};
 
-	return return_code;
+/**
+ * The slice @p p of the level being transformed.
+ */
+static
+char *ms3_slice(struct ms3_level *l, int p)
+{
+	if( l->planes )
+		return (char *)(l->planes + (p % MS3_PLANES) * l->size_x * l->size_y);
+
+	return l->data + p*l->stride_z;
 }
 
 static
-int size_grow(int size, int align)
+void ms3_push_slice(struct ms3_level *level, int j, int J, const void *src, size_t src_stride_x, size_t src_stride_y);
+
+/**
+ * Perform the lifting over the z-axis as far as possible, pass the final
+ * lowpass slices to the next level.
+ */
+static
+void ms3_advance(struct ms3_level *level, int j, int J)
 {
-	assert( is_pow2(align) );
+	struct ms3_level *l = &level[j];
 
-	extern float g_growth_factor_s;
+	const int N = l->size_z;
 
-	size *= g_growth_factor_s;
-	size += 1;
-	size +=  (align-1);
-	size &= ~(align-1);
+	for(int s = 0; s < MS3_STEPS; s++)
+	{
+		const float w = ms3_weight(s);
 
-	return size;
+		while( l->next[s] < l->done[s]
+			&& ms3_reflect(l->next[s]-1, N) < l->done[s]
+			&& ms3_reflect(l->next[s]+1, N) < l->done[s] )
+		{
+			const int p = l->next[s];
+
+			ms3_lift_plane(
+				ms3_slice(l, p),
+				ms3_slice(l, ms3_reflect(p-1, N)),
+				ms3_slice(l, ms3_reflect(p+1, N)),
+				w, l->size_x, l->size_y, l->slice_stride_x, l->slice_stride_y);
+
+			l->next[s] += 2;
+		}
+
+		l->done[s+1] = min(l->done[s], min(l->next[s], N));
+	}
+
+	// the next slice still reads the last one
+	const int final = (l->done[MS3_STEPS] == N) ? N : l->done[MS3_STEPS] - 1;
+
+	for(; l->final < final; l->final++)
+	{
+		const int p = l->final;
+
+		char *slice = ms3_slice(l, p);
+
+		ms3_scale_plane(slice, (p & 1) ? 1/dwt_cdf97_s1_s : dwt_cdf97_s1_s, l->size_x, l->size_y, l->slice_stride_x, l->slice_stride_y);
+
+		if( l->planes )
+		{
+			dwt_util_copy3_s(
+				slice,
+				l->data + p*l->stride_z,
+				l->slice_stride_y,
+				l->slice_stride_x,
+				l->stride_y,
+				l->stride_x,
+				l->size_x,
+				l->size_y
+			);
+		}
+
+		if( !(p & 1) && j+1 < J )
+			ms3_push_slice(level, j+1, J, slice, 2*l->slice_stride_x, 2*l->slice_stride_y);
+	}
+}
+
+/**
+ * The next slice of the level arrives from @p src, transform it over the x-
+ * and y-axes.
+ */
+static
+void ms3_push_slice(struct ms3_level *level, int j, int J, const void *src, size_t src_stride_x, size_t src_stride_y)
+{
+	struct ms3_level *l = &level[j];
+
+	// the slot is not live anymore
+	assert( l->done[0] - l->final < MS3_PLANES || !l->planes );
+
+	char *slice = ms3_slice(l, l->done[0]);
+
+	if( src != slice )
+	{
+		dwt_util_copy3_s(
+			src,
+			slice,
+			src_stride_y,
+			src_stride_x,
+			l->slice_stride_y,
+			l->slice_stride_x,
+			l->size_x,
+			l->size_y
+		);
+	}
+
+	// rows
+	if( sizeof(float) == l->slice_stride_x )
+	{
+		for(int y = 0; y < l->size_y; y++)
+			ms3_lift_row((float *)(slice + y*l->slice_stride_y), l->size_x);
+	}
+	else
+	{
+		// the samples are the columns of the height one
+		for(int y = 0; y < l->size_y; y++)
+			ms3_lift_lines(slice + y*l->slice_stride_y, l->size_x, l->slice_stride_x, 1, 1, l->slice_stride_x, l->slice_stride_y);
+	}
+
+	// columns, the samples are the rows
+	ms3_lift_lines(slice, l->size_y, l->slice_stride_y, l->size_x, 1, l->slice_stride_x, l->slice_stride_y);
+
+	l->done[0]++;
+
+	ms3_advance(level, j, J);
+}
+
+int cdf97_3f_op_ms_fused_s(struct volume_t *volume_src, struct volume_t *volume_dst, int J)
+{
+	assert( volume_src );
+	assert( volume_dst );
+	assert( volume_dst->size_x == volume_src->size_x );
+	assert( volume_dst->size_y == volume_src->size_y );
+	assert( volume_dst->size_z == volume_src->size_z );
+
+	const int size_min = min(volume_dst->size_x, min(volume_dst->size_y, volume_dst->size_z));
+	const int J_limit = ceil_log2(size_min);
+
+	if( J < 0 || J > J_limit )
+		J = J_limit;
+
+	struct ms3_level level[J+1];
+
+	for(int j = 0; j < J; j++)
+	{
+		struct ms3_level *l = &level[j];
+
+		l->data = volume_dst->data;
+		l->size_x = ceil_div_pow2(volume_dst->size_x, j);
+		l->size_y = ceil_div_pow2(volume_dst->size_y, j);
+		l->size_z = ceil_div_pow2(volume_dst->size_z, j);
+		l->stride_x = volume_dst->stride_x << j;
+		l->stride_y = volume_dst->stride_y << j;
+		l->stride_z = volume_dst->stride_z << j;
+
+		// the levels with the rows scattered in the volume are transformed in the plane buffers
+		if( sizeof(float) == l->stride_x )
+		{
+			l->planes = NULL;
+			l->slice_stride_x = l->stride_x;
+			l->slice_stride_y = l->stride_y;
+		}
+		else
+		{
+			l->planes = dwt_util_alloc_aligned_ex_reliably(MS3_PLANES * l->size_x * l->size_y, sizeof(float), 16);
+			l->slice_stride_x = sizeof(float);
+			l->slice_stride_y = sizeof(float) * l->size_x;
+		}
+
+		for(int s = 0; s < MS3_STEPS; s++)
+			l->next[s] = ms3_parity(s);
+		for(int s = 0; s <= MS3_STEPS; s++)
+			l->done[s] = 0;
+		l->final = 0;
+	}
+
+	for(int z = 0; z < volume_dst->size_z; z++)
+	{
+		// the slices are copied just before they are needed
+		if( J > 0 )
+			ms3_push_slice(level, 0, J, volume_get_slice(volume_src, z), volume_src->stride_x, volume_src->stride_y);
+		else if( volume_src != volume_dst )
+			dwt_util_copy3_s(
+				volume_get_slice(volume_src, z),
+				volume_get_slice(volume_dst, z),
+				volume_src->stride_y,
+				volume_src->stride_x,
+				volume_dst->stride_y,
+				volume_dst->stride_x,
+				volume_src->size_x,
+				volume_src->size_y
+			);
+	}
+
+	for(int j = 0; j < J; j++)
+		free(level[j].planes);
+
+	return J;
+}
+
+/**
+ * inverse single-loop core, the counterpart of vert2x1
+ *
+ * The virtual pair (x0, x1) consists of the even and the odd sample.
+ * The inverse scaling is expected to be done before.
+ */
+static
+void ivert2x1(
+	float *x0,
+	float *x1,
+	float *y0,
+	float *y1,
+	float *buff4
+)
+{
+	const float w[4] = { dwt_cdf97_p1_s, -dwt_cdf97_u1_s, dwt_cdf97_p2_s, -dwt_cdf97_u2_s };
+
+	float c[4], r[4];
+
+	float *l = buff4;
+
+	// inputs
+	const float in0 = *x0;
+	const float in1 = *x1;
+
+	// shuffles
+	const float out0 = l[0];
+	c[0] = l[1];
+	c[1] = l[2];
+	c[2] = l[3];
+	c[3] = in0;
+
+	// operation
+	r[3] = in1;
+	r[2] = c[3]+w[3]*(l[3]+r[3]);
+	r[1] = c[2]+w[2]*(l[2]+r[2]);
+	r[0] = c[1]+w[1]*(l[1]+r[1]);
+
+	// outputs
+	*y1 = c[0]+w[0]*(l[0]+r[0]);
+	*y0 = out0;
+
+	// update l[]
+	l[0] = r[0];
+	l[1] = r[1];
+	l[2] = r[2];
+	l[3] = r[3];
+}
+
+#ifdef __SSE__
+/**
+ * inverse single-loop core, the counterpart of vert_2x4x1
+ */
+static
+void ivert_2x4(
+	__m128 *data0,
+	__m128 *data1,
+	float *buff	// 16 * float
+)
+{
+	// weights
+	const __m128 w0 = { +dwt_cdf97_p1_s, +dwt_cdf97_p1_s, +dwt_cdf97_p1_s, +dwt_cdf97_p1_s };
+	const __m128 w1 = { -dwt_cdf97_u1_s, -dwt_cdf97_u1_s, -dwt_cdf97_u1_s, -dwt_cdf97_u1_s };
+	const __m128 w2 = { +dwt_cdf97_p2_s, +dwt_cdf97_p2_s, +dwt_cdf97_p2_s, +dwt_cdf97_p2_s };
+	const __m128 w3 = { -dwt_cdf97_u2_s, -dwt_cdf97_u2_s, -dwt_cdf97_u2_s, -dwt_cdf97_u2_s };
+
+	// variables
+	__m128 l0, l1, l2, l3;
+	__m128 c0, c1, c2, c3;
+	__m128 r0, r1, r2, r3;
+	__m128 x0, x1;
+	__m128 y0, y1;
+
+	// load "L"
+	l0 = _mm_load_ps(&buff[0*(1*4)]);
+	l1 = _mm_load_ps(&buff[1*(1*4)]);
+	l2 = _mm_load_ps(&buff[2*(1*4)]);
+	l3 = _mm_load_ps(&buff[3*(1*4)]);
+
+	// inputs
+	x0 = *data0;
+	x1 = *data1;
+
+	// shuffles
+	y0 = l0;
+	c0 = l1;
+	c1 = l2;
+	c2 = l3;
+	c3 = x0;
+
+	// operation
+	r3 = x1;
+	r2 = c3 + w3 * (l3 + r3);
+	r1 = c2 + w2 * (l2 + r2);
+	r0 = c1 + w1 * (l1 + r1);
+	y1 = c0 + w0 * (l0 + r0);
+
+	// update
+	l0 = r0;
+	l1 = r1;
+	l2 = r2;
+	l3 = r3;
+
+	// outputs
+	*data0 = y0;
+	*data1 = y1;
+
+	// store "L"
+	_mm_store_ps(&buff[0*(1*4)], l0);
+	_mm_store_ps(&buff[1*(1*4)], l1);
+	_mm_store_ps(&buff[2*(1*4)], l2);
+	_mm_store_ps(&buff[3*(1*4)], l3);
+}
+#endif
+
+#ifdef __SSE__
+/**
+ * inverse diagonal core, the counterpart of diag2x2_elem_op
+ */
+static
+__m128 idiag2x2_elem_op(
+	__m128 input, // in [ y0x0 y0x1 y1x0 y1x1 ]
+	float * ALIGNED(16) buffL, // l.L [3*4*float]
+	float * ALIGNED(16) buffR  // l.R [3*4*float]
+)
+{
+	const __m128 w = { dwt_cdf97_p1_s, -dwt_cdf97_u1_s, dwt_cdf97_p2_s, -dwt_cdf97_u2_s };
+
+	__m128 z;
+
+	// L+R
+	op4s_sdl2_shuffle_input_low_s_sse(input, *(__m128 *)(buffL+4), *(__m128 *)(buffL+8));
+	op4s_sdl2_shuffle_input_high_s_sse(input, *(__m128 *)(buffR+4), *(__m128 *)(buffR+8));
+
+	// L
+	op4s_sdl2_op_s_sse(z, *(__m128 *)(buffL+4), w, *(__m128 *)(buffL+0), *(__m128 *)(buffL+8));
+	op4s_sdl2_output_low_s_sse(input, *(__m128 *)(buffL+0), z);
+	op4s_sdl2_update_s_sse(*(__m128 *)(buffL+4), *(__m128 *)(buffL+0), *(__m128 *)(buffL+8), z);
+
+	// R
+	op4s_sdl2_op_s_sse(z, *(__m128 *)(buffR+4), w, *(__m128 *)(buffR+0), *(__m128 *)(buffR+8));
+	op4s_sdl2_output_high_s_sse(input, *(__m128 *)(buffR+0), z);
+	op4s_sdl2_update_s_sse(*(__m128 *)(buffR+4), *(__m128 *)(buffR+0), *(__m128 *)(buffR+8), z);
+
+	return input;
+}
+#endif
+
+/**
+ * inverse 1-D transform using the single-loop core
+ *
+ * The source is copied first, thus @p src can be equal to @p dst.
+ */
+static
+void idwt1_single_cdf97_vertical_s(
+	const void *src,
+	int src_stride,
+	void *dst,
+	int dst_stride,
+	int size
+)
+{
+	assert( size >= 2 );
+
+	const int overlap_L = 4;
+	const int overlap_R = 4 + (size & 1);
+
+	const int shift = 4;
+
+	const int super = overlap_L + size + overlap_R;
+
+	float line[size];
+
+	dwt_util_memcpy_stride_s(line, sizeof(float), src, src_stride, size);
+
+	float l[4] = { 0.f, 0.f, 0.f, 0.f };
+
+	for(int v = 0; v < super; v += 2)
+	{
+		float t[2];
+
+		for(int vv = 0; vv < 2; vv++)
+		{
+			// virtual => real coordinates, the symmetric extension is repeated for the short signals
+			int pos = v + vv - overlap_L;
+
+			while( pos < 0 || pos > size-1 )
+			{
+				if( pos < 0 )
+					pos *= -1;
+				if( pos > size-1 )
+					pos = 2*(size-1) - pos;
+			}
+
+			// NOTE: inverse scaling
+			t[vv] = line[pos] * ( (pos & 1) ? dwt_cdf97_s1_s : 1.f/dwt_cdf97_s1_s );
+		}
+
+		ivert2x1(&t[0], &t[1], &t[0], &t[1], l);
+
+		for(int vv = 0; vv < 2; vv++)
+		{
+			const int pos = virt2real_error(v-shift, vv, overlap_L, size);
+
+			if( pos < 0 )
+				continue;
+
+			*addr1_s(dst, pos, dst_stride) = t[vv];
+		}
+	}
+}
+
+void cdf97_3i_op_sep_horizontal_s(struct volume_t *volume_src, struct volume_t *volume_dst)
+{
+	assert( volume_src );
+	assert( volume_dst );
+
+	// NOTE: over x-axis (x=0..size_x-1)
+	// for each y
+	for(int y = 0; y < volume_dst->size_y; y++)
+	{
+		// for each z
+		for(int z = 0; z < volume_dst->size_z; z++)
+		{
+			// copy vector here
+			dwt_util_memcpy_stride_s(
+				volume_get_pix(volume_dst, 0, y, z),
+				volume_dst->stride_x,
+				volume_get_pix(volume_src, 0, y, z),
+				volume_src->stride_x,
+				volume_dst->size_x
+			);
+
+			// get pointer to (x=0,y,z)
+			void *ptr = volume_get_pix(volume_dst, 0, y, z);
+
+			// transform vector (ptr, size_x, stride_x)
+			dwt_cdf97_1i_inplace_s(ptr, volume_dst->stride_x, volume_dst->size_x, 1);
+		}
+	}
+
+	// NOTE: over y-axis (y=0..size_y-1)
+	// for each x
+	for(int x = 0; x < volume_dst->size_x; x++)
+	{
+		// for each z
+		for(int z = 0; z < volume_dst->size_z; z++)
+		{
+			// get pointer to (x,y=0,z)
+			void *ptr = volume_get_pix(volume_dst, x, 0, z);
+
+			// transform vector (ptr, size_y, stride_y)
+			dwt_cdf97_1i_inplace_s(ptr, volume_dst->stride_y, volume_dst->size_y, 1);
+		}
+	}
+
+	// NOTE: over z-axis (z=0..size_z-1)
+	// for each x
+	for(int x = 0; x < volume_dst->size_x; x++)
+	{
+		// for each y
+		for(int y = 0; y < volume_dst->size_y; y++)
+		{
+			// get pointer to (x,y,z=0)
+			void *ptr = volume_get_pix(volume_dst, x, y, 0);
+
+			// transform vector (ptr, size_z, stride_z)
+			dwt_cdf97_1i_inplace_s(ptr, volume_dst->stride_z, volume_dst->size_z, 1);
+		}
+	}
+}
+
+// only x-axes (+copying)
+void cdf97_3i_op_sep_horizontal_x_s(struct volume_t *volume_src, struct volume_t *volume_dst)
+{
+	assert( volume_src );
+	assert( volume_dst );
+
+	// NOTE: over x-axis (x=0..size_x-1)
+	// for each y
+	for(int y = 0; y < volume_dst->size_y; y++)
+	{
+		// for each z
+		for(int z = 0; z < volume_dst->size_z; z++)
+		{
+			// copy vector here
+			dwt_util_memcpy_stride_s(
+				volume_get_pix(volume_dst, 0, y, z),
+				volume_dst->stride_x,
+				volume_get_pix(volume_src, 0, y, z),
+				volume_src->stride_x,
+				volume_dst->size_x
+			);
+
+			// get pointer to (x=0,y,z)
+			void *ptr = volume_get_pix(volume_dst, 0, y, z);
+
+			// transform vector (ptr, size_x, stride_x)
+			dwt_cdf97_1i_inplace_s(ptr, volume_dst->stride_x, volume_dst->size_x, 1);
+		}
+	}
+}
+
+// only y-axes (+copying)
+void cdf97_3i_op_sep_horizontal_y_s(struct volume_t *volume_src, struct volume_t *volume_dst)
+{
+	assert( volume_src );
+	assert( volume_dst );
+
+	// NOTE: over y-axis (y=0..size_y-1)
+	// for each x
+	for(int x = 0; x < volume_dst->size_x; x++)
+	{
+		// for each z
+		for(int z = 0; z < volume_dst->size_z; z++)
+		{
+			// copy vector here
+			dwt_util_memcpy_stride_s(
+				volume_get_pix(volume_dst, x, 0, z),
+				volume_dst->stride_y,
+				volume_get_pix(volume_src, x, 0, z),
+				volume_src->stride_y,
+				volume_dst->size_y
+			);
+
+			// get pointer to (x,y=0,z)
+			void *ptr = volume_get_pix(volume_dst, x, 0, z);
+
+			// transform vector (ptr, size_y, stride_y)
+			dwt_cdf97_1i_inplace_s(ptr, volume_dst->stride_y, volume_dst->size_y, 1);
+		}
+	}
+}
+
+// only z-axes (+copying)
+void cdf97_3i_op_sep_horizontal_z_s(struct volume_t *volume_src, struct volume_t *volume_dst)
+{
+	assert( volume_src );
+	assert( volume_dst );
+
+	// NOTE: over z-axis (z=0..size_z-1)
+	// for each x
+	for(int x = 0; x < volume_dst->size_x; x++)
+	{
+		// for each y
+		for(int y = 0; y < volume_dst->size_y; y++)
+		{
+			// copy vector here
+			dwt_util_memcpy_stride_s(
+				volume_get_pix(volume_dst, x, y, 0),
+				volume_dst->stride_z,
+				volume_get_pix(volume_src, x, y, 0),
+				volume_src->stride_z,
+				volume_dst->size_z
+			);
+
+			// get pointer to (x,y,z=0)
+			void *ptr = volume_get_pix(volume_dst, x, y, 0);
+
+			// transform vector (ptr, size_z, stride_z)
+			dwt_cdf97_1i_inplace_s(ptr, volume_dst->stride_z, volume_dst->size_z, 1);
+		}
+	}
+}
+
+void cdf97_3i_op_sep_vertical_s(struct volume_t *volume_src, struct volume_t *volume_dst)
+{
+	assert( volume_src );
+	assert( volume_dst );
+
+	// NOTE: over x-axis (x=0..size_x-1)
+	// for each y
+	for(int y = 0; y < volume_dst->size_y; y++)
+	{
+		// for each z
+		for(int z = 0; z < volume_dst->size_z; z++)
+		{
+			// transform vector (ptr, size_x, stride_x) including the copying
+			idwt1_single_cdf97_vertical_s(
+				volume_get_pix(volume_src, 0, y, z),
+				volume_src->stride_x,
+				volume_get_pix(volume_dst, 0, y, z),
+				volume_dst->stride_x,
+				volume_dst->size_x
+			);
+		}
+	}
+
+	// NOTE: over y-axis (y=0..size_y-1)
+	// for each x
+	for(int x = 0; x < volume_dst->size_x; x++)
+	{
+		// for each z
+		for(int z = 0; z < volume_dst->size_z; z++)
+		{
+			// get pointer to (x,y=0,z)
+			void *ptr = volume_get_pix(volume_dst, x, 0, z);
+
+			// transform vector (ptr, size_y, stride_y)
+			idwt1_single_cdf97_vertical_s(ptr, volume_dst->stride_y, ptr, volume_dst->stride_y, volume_dst->size_y);
+		}
+	}
+
+	// NOTE: over z-axis (z=0..size_z-1)
+	// for each x
+	for(int x = 0; x < volume_dst->size_x; x++)
+	{
+		// for each y
+		for(int y = 0; y < volume_dst->size_y; y++)
+		{
+			// get pointer to (x,y,z=0)
+			void *ptr = volume_get_pix(volume_dst, x, y, 0);
+
+			// transform vector (ptr, size_z, stride_z)
+			idwt1_single_cdf97_vertical_s(ptr, volume_dst->stride_z, ptr, volume_dst->stride_z, volume_dst->size_z);
+		}
+	}
+}
+
+void cdf97_3i_op_slices_vert4x4_s(struct volume_t *volume_src, struct volume_t *volume_dst)
+{
+	assert( volume_dst );
+	assert( volume_src );
+	assert( volume_dst->size_x == volume_src->size_x );
+	assert( volume_dst->size_y == volume_src->size_y );
+	assert( volume_dst->size_z == volume_src->size_z );
+
+	// for each slice
+	for(int z = 0; z < volume_src->size_z; z++)
+	{
+		// get slices
+		void *slice_dst = volume_get_slice(volume_dst, z);
+		void *slice_src = volume_get_slice(volume_src, z);
+
+		// transform the slice out-of-place
+		cdf97_2i_dl_4x4_s(
+			volume_dst->size_x,
+			volume_dst->size_y,
+			slice_src,
+			volume_src->stride_y,
+			volume_src->stride_x,
+			slice_dst,
+			volume_dst->stride_y,
+			volume_dst->stride_x
+		);
+	}
+
+	// now, a transform over z-axe is missing
+	// lets perform it as separable-vertical
+
+	// for each x
+	for(int x = 0; x < volume_dst->size_x; x++)
+	{
+		// for each y
+		for(int y = 0; y < volume_dst->size_y; y++)
+		{
+			// get pointer to (x,y,z=0)
+			void *ptr = volume_get_pix(volume_dst, x, y, 0);
+
+			// transform vector (ptr, size_z, stride_z)
+			idwt1_single_cdf97_vertical_s(ptr, volume_dst->stride_z, ptr, volume_dst->stride_z, volume_dst->size_z);
+		}
+	}
+}
+
+/**
+ * inverse cores
+ *
+ * The same blocking as the forward cores. The virtual pairs start with the
+ * even samples, thus the left overlap is even. The inverse scaling is done
+ * just after the loading. If @p horiz is non-zero, the buffers of the
+ * finished rows and slices are reused (HORIZ variants).
+ */
+typedef void (*icube_func_t)(
+	int x,
+	int y,
+	int z,
+	int size_x,
+	int size_y,
+	int size_z,
+	const float *src_ptr,
+	int src_stride_x,
+	int src_stride_y,
+	int src_stride_z,
+	float *dst_ptr,
+	int dst_stride_x,
+	int dst_stride_y,
+	int dst_stride_z,
+	float * ALIGNED(16) buffer_x,
+	float * ALIGNED(16) buffer_y,
+	float * ALIGNED(16) buffer_z,
+	int super_x,
+	int super_y,
+	int super_z,
+	int horiz
+);
+
+/**
+ * inverse vertical 2^3 core
+ */
+static
+void icube_2x2x2(
+	// coordinates
+	int x,
+	int y,
+	int z,
+	// image size
+	int size_x,
+	int size_y,
+	int size_z,
+	// poiter to pixel at (0,0,0) in struct volume_t
+	const float *src_ptr,
+	// strides (to address another pixels)
+	int src_stride_x,
+	int src_stride_y,
+	int src_stride_z,
+	// poiter to pixel at (0,0,0) in struct volume_t
+	float *dst_ptr,
+	// strides (to address another pixels)
+	int dst_stride_x,
+	int dst_stride_y,
+	int dst_stride_z,
+	// pointers to three buffers (aligned to 16 bytes = 4 floats)
+	float * ALIGNED(16) buffer_x,
+	float * ALIGNED(16) buffer_y,
+	float * ALIGNED(16) buffer_z,
+	// super sizes in order to access elements in buffers
+	int super_x,
+	int super_y,
+	int super_z,
+	// reuse the buffers of the finished rows and slices
+	int horiz
+)
+{
+	UNUSED(super_z);
+
+	const int overlap_x_L = 4;
+	const int overlap_y_L = 4;
+	const int overlap_z_L = 4;
+
+	const int shift = 4;
+
+	const int step_x = 2;
+	const int step_y = 2;
+	const int step_z = 2;
+
+#ifdef __SSE__
+	// 2^3 pixels = 8x float = 2x __m128 (z=0..1)
+	__m128 t[2];
+
+	// LOAD
+	for(int xx = 0; xx < step_x; xx++)
+	{
+		for(int yy = 0; yy < step_y; yy++)
+		{
+			for(int zz = 0; zz < step_z; zz++)
+			{
+				// virtual => real coordinates
+				const int pos_x = virt2real(x, xx, overlap_x_L, size_x);
+				const int pos_y = virt2real(y, yy, overlap_y_L, size_y);
+				const int pos_z = virt2real(z, zz, overlap_z_L, size_z);
+
+				// [0] : yy=0 xx=0
+				// [1] : yy=0 xx=1
+				// [2] : yy=1 xx=0
+				// [3] : yy=1 xx=1
+				t[zz][yy*step_x+xx] = *( (const float *)( (const char *)src_ptr + pos_x*src_stride_x + pos_y*src_stride_y + pos_z*src_stride_z ) );
+			}
+		}
+	}
+
+	// CALC
+	// NOTE: scaling
+	const float z1 = dwt_cdf97_s1_s;
+	const float z3 = dwt_cdf97_s1_s*dwt_cdf97_s1_s*dwt_cdf97_s1_s;
+
+	t[0] *= (__m128){ 1.f/z3, 1.f/z1, 1.f/z1, z1 };
+	t[1] *= (__m128){ 1.f/z1, z1, z1, z3 };
+
+	// NOTE: along x-axis (4 times ivert2x1)
+	for(int zz = 0; zz < step_z; zz++)
+	{
+		for(int yy = 0; yy < step_y; yy++)
+		{
+			ivert2x1(
+				&t[zz][yy*step_x+0],
+				&t[zz][yy*step_x+1],
+				&t[zz][yy*step_x+0],
+				&t[zz][yy*step_x+1],
+				horiz ? buffer_x + (yy+zz*step_y)*4 : buffer_x + (y+yy)*4 + (z+zz)*(super_y*4)
+			);
+		}
+	}
+	// NOTE: along y-axis (4 times ivert2x1)
+	for(int zz = 0; zz < step_z; zz++)
+	{
+		for(int xx = 0; xx < step_x; xx++)
+		{
+			ivert2x1(
+				&t[zz][0*step_x+xx],
+				&t[zz][1*step_x+xx],
+				&t[zz][0*step_x+xx],
+				&t[zz][1*step_x+xx],
+				buffer_y + (x+xx)*4 + ((horiz ? 0 : z)+zz)*(super_x*4)
+			);
+		}
+	}
+	// NOTE: along z-axis (4 times ivert2x1)
+	for(int yy = 0; yy < step_y; yy++)
+	{
+		for(int xx = 0; xx < step_x; xx++)
+		{
+			ivert2x1(
+				&t[0][yy*step_x+xx],
+				&t[1][yy*step_x+xx],
+				&t[0][yy*step_x+xx],
+				&t[1][yy*step_x+xx],
+				buffer_z + (x+xx)*4 + (y+yy)*(super_x*4)
+			);
+		}
+	}
+
+	// STORE
+	for(int xx = 0; xx < step_x; xx++)
+	{
+		for(int yy = 0; yy < step_y; yy++)
+		{
+			for(int zz = 0; zz < step_z; zz++)
+			{
+				// virtual => real coordinates
+				const int pos_x = virt2real_error(x-shift, xx, overlap_x_L, size_x);
+				const int pos_y = virt2real_error(y-shift, yy, overlap_y_L, size_y);
+				const int pos_z = virt2real_error(z-shift, zz, overlap_z_L, size_z);
+
+				if( pos_x < 0 || pos_y < 0 || pos_z < 0 )
+					continue;
+
+				*( (float *)( (char *)dst_ptr + pos_x*dst_stride_x + pos_y*dst_stride_y + pos_z*dst_stride_z ) ) = t[zz][yy*step_x+xx];
+			}
+		}
+	}
+#endif
+}
+
+/**
+ * inverse vertical 4x4x2 core
+ */
+static
+void icube_4x4x2(
+	// coordinates
+	int x,
+	int y,
+	int z,
+	// image size
+	int size_x,
+	int size_y,
+	int size_z,
+	// poiter to pixel at (0,0,0) in struct volume_t
+	const float *src_ptr,
+	// strides (to address another pixels)
+	int src_stride_x,
+	int src_stride_y,
+	int src_stride_z,
+	// poiter to pixel at (0,0,0) in struct volume_t
+	float *dst_ptr,
+	// strides (to address another pixels)
+	int dst_stride_x,
+	int dst_stride_y,
+	int dst_stride_z,
+	// pointers to three buffers (aligned to 16 bytes = 4 floats)
+	float * ALIGNED(16) buffer_x,
+	float * ALIGNED(16) buffer_y,
+	float * ALIGNED(16) buffer_z,
+	// super sizes in order to access elements in buffers
+	int super_x,
+	int super_y,
+	int super_z,
+	// reuse the buffers of the finished rows and slices
+	int horiz
+)
+{
+	UNUSED(super_z);
+
+	const int overlap_x_L = 4;
+	const int overlap_y_L = 4;
+	const int overlap_z_L = 4;
+
+	const int shift = 4;
+
+	const int step_x = 4;
+	const int step_y = 4;
+	const int step_z = 2;
+
+#ifdef __SSE__
+	// 4^3 / 2 pixels = 32x float = 8x __m128 (z=0..1, y=0..3)
+	__m128 t[2][4]; // NOTE: [z][y][x]
+
+	// LOAD
+	for(int xx = 0; xx < step_x; xx++)
+	{
+		for(int yy = 0; yy < step_y; yy++)
+		{
+			for(int zz = 0; zz < step_z; zz++)
+			{
+				// virtual => real coordinates
+				const int pos_x = virt2real(x, xx, overlap_x_L, size_x);
+				const int pos_y = virt2real(y, yy, overlap_y_L, size_y);
+				const int pos_z = virt2real(z, zz, overlap_z_L, size_z);
+
+				// NOTE: transposed x-y
+				t[zz][xx][yy] = *( (const float *)( (const char *)src_ptr + pos_x*src_stride_x + pos_y*src_stride_y + pos_z*src_stride_z ) );
+			}
+		}
+	}
+
+	// CALC
+	// NOTE: scaling
+	const float z1 = dwt_cdf97_s1_s;
+	const float z3 = dwt_cdf97_s1_s*dwt_cdf97_s1_s*dwt_cdf97_s1_s;
+	const float r1 = 1.f/z1;
+	const float r3 = 1.f/z3;
+
+	const __m128 scale[2][2] = {
+		{ { r3, r1, r3, r1 }, { r1, z1, r1, z1 } },
+		{ { r1, z1, r1, z1 }, { z1, z3, z1, z3 } }
+	};
+
+	for(int zz = 0; zz < step_z; zz++)
+		for(int xx = 0; xx < step_x; xx++)
+			t[zz][xx] *= scale[zz&1][xx&1];
+
+	// NOTE: along x-axis (4 times ivert_2x4)
+	for(int zz = 0; zz < step_z; zz++)
+	{
+		for(int xx = 0; xx < step_x; xx += 2)
+		{
+			ivert_2x4(
+				&t[zz][xx+0],
+				&t[zz][xx+1],
+				horiz ? buffer_x + zz*16 : buffer_x + (y+0)*4 + (z+zz)*(super_y*4)
+			);
+		}
+	}
+	// transpose
+	_MM_TRANSPOSE4_PS(t[0][0], t[0][1], t[0][2], t[0][3]);
+	_MM_TRANSPOSE4_PS(t[1][0], t[1][1], t[1][2], t[1][3]);
+	// NOTE: along y-axis (4 times ivert_2x4)
+	for(int zz = 0; zz < step_z; zz++)
+	{
+		for(int yy = 0; yy < step_y; yy += 2)
+		{
+			ivert_2x4(
+				&t[zz][yy+0],
+				&t[zz][yy+1],
+				buffer_y + (x+0)*4 + ((horiz ? 0 : z)+zz)*(super_x*4)
+			);
+		}
+	}
+	// NOTE: along z-axis (4 times ivert_2x4)
+	for(int yy = 0; yy < step_y; yy++)
+	{
+		ivert_2x4(
+			&t[0][yy],
+			&t[1][yy],
+			buffer_z + (x+0)*4 + (y+yy)*(super_x*4)
+		);
+	}
+
+	// STORE
+	for(int xx = 0; xx < step_x; xx++)
+	{
+		for(int yy = 0; yy < step_y; yy++)
+		{
+			for(int zz = 0; zz < step_z; zz++)
+			{
+				// virtual => real coordinates
+				const int pos_x = virt2real_error(x-shift, xx, overlap_x_L, size_x);
+				const int pos_y = virt2real_error(y-shift, yy, overlap_y_L, size_y);
+				const int pos_z = virt2real_error(z-shift, zz, overlap_z_L, size_z);
+
+				if( pos_x < 0 || pos_y < 0 || pos_z < 0 )
+					continue;
+
+				*( (float *)( (char *)dst_ptr + pos_x*dst_stride_x + pos_y*dst_stride_y + pos_z*dst_stride_z ) ) = t[zz][yy][xx];
+			}
+		}
+	}
+#endif
+}
+
+/**
+ * inverse vertical 4x4x4 core
+ */
+static
+void icube_4x4x4(
+	// coordinates
+	int x,
+	int y,
+	int z,
+	// image size
+	int size_x,
+	int size_y,
+	int size_z,
+	// poiter to pixel at (0,0,0) in struct volume_t
+	const float *src_ptr,
+	// strides (to address another pixels)
+	int src_stride_x,
+	int src_stride_y,
+	int src_stride_z,
+	// poiter to pixel at (0,0,0) in struct volume_t
+	float *dst_ptr,
+	// strides (to address another pixels)
+	int dst_stride_x,
+	int dst_stride_y,
+	int dst_stride_z,
+	// pointers to three buffers (aligned to 16 bytes = 4 floats)
+	float * ALIGNED(16) buffer_x,
+	float * ALIGNED(16) buffer_y,
+	float * ALIGNED(16) buffer_z,
+	// super sizes in order to access elements in buffers
+	int super_x,
+	int super_y,
+	int super_z,
+	// reuse the buffers of the finished rows and slices
+	int horiz
+)
+{
+	UNUSED(super_z);
+
+	const int overlap_x_L = 4;
+	const int overlap_y_L = 4;
+	const int overlap_z_L = 4;
+
+	const int shift = 4;
+
+	const int step_x = 4;
+	const int step_y = 4;
+	const int step_z = 4;
+
+#ifdef __SSE__
+	// 4^3 pixels = 64x float = 16x __m128 (z=0..3, y=0..3)
+	__m128 t[4][4]; // NOTE: [z][y][x]
+
+	// LOAD
+	for(int xx = 0; xx < step_x; xx++)
+	{
+		for(int yy = 0; yy < step_y; yy++)
+		{
+			for(int zz = 0; zz < step_z; zz++)
+			{
+				// virtual => real coordinates
+				const int pos_x = virt2real(x, xx, overlap_x_L, size_x);
+				const int pos_y = virt2real(y, yy, overlap_y_L, size_y);
+				const int pos_z = virt2real(z, zz, overlap_z_L, size_z);
+
+				// NOTE: transposed x<->y
+				t[zz][xx][yy] = *( (const float *)( (const char *)src_ptr + pos_x*src_stride_x + pos_y*src_stride_y + pos_z*src_stride_z ) );
+			}
+		}
+	}
+
+	// CALC
+	// NOTE: scaling
+	const float z1 = dwt_cdf97_s1_s;
+	const float z3 = dwt_cdf97_s1_s*dwt_cdf97_s1_s*dwt_cdf97_s1_s;
+	const float r1 = 1.f/z1;
+	const float r3 = 1.f/z3;
+
+	const __m128 scale[2][2] = {
+		{ { r3, r1, r3, r1 }, { r1, z1, r1, z1 } },
+		{ { r1, z1, r1, z1 }, { z1, z3, z1, z3 } }
+	};
+
+	for(int zz = 0; zz < step_z; zz++)
+		for(int xx = 0; xx < step_x; xx++)
+			t[zz][xx] *= scale[zz&1][xx&1];
+
+	// NOTE: along x-axis
+	for(int zz = 0; zz < step_z; zz++)
+	{
+		for(int xx = 0; xx < step_x; xx += 2)
+		{
+			ivert_2x4(
+				&t[zz][xx+0],
+				&t[zz][xx+1],
+				horiz ? buffer_x + zz*16 : buffer_x + (y+0)*4 + (z+zz)*(super_y*4)
+			);
+		}
+	}
+	// transpose
+	_MM_TRANSPOSE4_PS(t[0][0], t[0][1], t[0][2], t[0][3]);
+	_MM_TRANSPOSE4_PS(t[1][0], t[1][1], t[1][2], t[1][3]);
+	_MM_TRANSPOSE4_PS(t[2][0], t[2][1], t[2][2], t[2][3]);
+	_MM_TRANSPOSE4_PS(t[3][0], t[3][1], t[3][2], t[3][3]);
+	// NOTE: along y-axis
+	for(int zz = 0; zz < step_z; zz++)
+	{
+		for(int yy = 0; yy < step_y; yy += 2)
+		{
+			ivert_2x4(
+				&t[zz][yy+0],
+				&t[zz][yy+1],
+				buffer_y + (x+0)*4 + ((horiz ? 0 : z)+zz)*(super_x*4)
+			);
+		}
+	}
+	// NOTE: along z-axis
+	for(int zz = 0; zz < step_z; zz += 2)
+	{
+		for(int yy = 0; yy < step_y; yy++)
+		{
+			ivert_2x4(
+				&t[zz+0][yy],
+				&t[zz+1][yy],
+				buffer_z + (x+0)*4 + (y+yy)*(super_x*4)
+			);
+		}
+	}
+
+	// STORE
+	for(int xx = 0; xx < step_x; xx++)
+	{
+		for(int yy = 0; yy < step_y; yy++)
+		{
+			for(int zz = 0; zz < step_z; zz++)
+			{
+				// virtual => real coordinates
+				const int pos_x = virt2real_error(x-shift, xx, overlap_x_L, size_x);
+				const int pos_y = virt2real_error(y-shift, yy, overlap_y_L, size_y);
+				const int pos_z = virt2real_error(z-shift, zz, overlap_z_L, size_z);
+
+				if( pos_x < 0 || pos_y < 0 || pos_z < 0 )
+					continue;
+
+				*( (float *)( (char *)dst_ptr + pos_x*dst_stride_x + pos_y*dst_stride_y + pos_z*dst_stride_z ) ) = t[zz][yy][xx];
+			}
+		}
+	}
+#endif
+}
+
+/**
+ * inverse diagonal 2x2x2 core
+ */
+static
+void icube_diag2x2x2(
+	// coordinates
+	int x,
+	int y,
+	int z,
+	// image size
+	int size_x,
+	int size_y,
+	int size_z,
+	// poiter to pixel at (0,0,0) in struct volume_t
+	const float *src_ptr,
+	// strides (to address another pixels)
+	int src_stride_x,
+	int src_stride_y,
+	int src_stride_z,
+	// poiter to pixel at (0,0,0) in struct volume_t
+	float *dst_ptr,
+	// strides (to address another pixels)
+	int dst_stride_x,
+	int dst_stride_y,
+	int dst_stride_z,
+	// pointers to three buffers (aligned to 16 bytes = 4 floats)
+	float * ALIGNED(16) buffer_x,
+	float * ALIGNED(16) buffer_y,
+	float * ALIGNED(16) buffer_z,
+	// super sizes in order to access elements in buffers
+	int super_x,
+	int super_y,
+	int super_z,
+	// reuse the buffers of the finished rows and slices
+	int horiz
+)
+{
+	UNUSED(super_z);
+
+	const int overlap_x_L = 4;
+	const int overlap_y_L = 4;
+	const int overlap_z_L = 4;
+
+	const int shift = 10;
+
+	const int step_x = 2;
+	const int step_y = 2;
+	const int step_z = 2;
+
+#ifdef __SSE__
+	// 2^3 pixels = 8x float = 2x __m128 (z=0..1)
+	__m128 t[2];
+
+	// LOAD
+	for(int xx = 0; xx < step_x; xx++)
+	{
+		for(int yy = 0; yy < step_y; yy++)
+		{
+			for(int zz = 0; zz < step_z; zz++)
+			{
+				// virtual => real coordinates
+				const int pos_x = virt2real(x, xx, overlap_x_L, size_x);
+				const int pos_y = virt2real(y, yy, overlap_y_L, size_y);
+				const int pos_z = virt2real(z, zz, overlap_z_L, size_z);
+
+				// [0] : yy=0 xx=0
+				// [1] : yy=0 xx=1
+				// [2] : yy=1 xx=0
+				// [3] : yy=1 xx=1
+				t[zz][yy*step_x+xx] = *( (const float *)( (const char *)src_ptr + pos_x*src_stride_x + pos_y*src_stride_y + pos_z*src_stride_z ) );
+			}
+		}
+	}
+
+	// CALC
+	// NOTE: scaling
+	const float z1 = dwt_cdf97_s1_s;
+	const float z3 = dwt_cdf97_s1_s*dwt_cdf97_s1_s*dwt_cdf97_s1_s;
+
+	t[0] *= (__m128){
+		1.f/z3, 1.f/z1,
+		1.f/z1, z1
+	};
+	t[1] *= (__m128){
+		1.f/z1, z1,
+		z1, z3
+	};
+
+	// NOTE: along x-axis
+	for(int zz = 0; zz < step_z; zz++)
+	{
+		t[zz] = idiag2x2_elem_op(
+			t[zz],
+			horiz ? buffer_x + (0+zz*step_y)*12 : buffer_x + (y+0)*12 + (z+zz)*(super_y*12),
+			horiz ? buffer_x + (1+zz*step_y)*12 : buffer_x + (y+1)*12 + (z+zz)*(super_y*12)
+		);
+	}
+	// transpose
+	_MM_TRANSPOSE1_PS(t[0]);
+	_MM_TRANSPOSE1_PS(t[1]);
+	// NOTE: along y-axis
+	for(int zz = 0; zz < step_z; zz++)
+	{
+		t[zz] = idiag2x2_elem_op(
+			t[zz],
+			buffer_y + (x+0)*12 + ((horiz ? 0 : z)+zz)*(super_x*12),
+			buffer_y + (x+1)*12 + ((horiz ? 0 : z)+zz)*(super_x*12)
+		);
+	}
+	// transpose
+	_MM_TRANSPOSE2_PS(t[0], t[1]);
+	// NOTE: along z-axis
+	for(int yy = 0; yy < step_y; yy++)
+	{
+		t[yy] = idiag2x2_elem_op(
+			t[yy],
+			buffer_z + (x+0)*12 + (y+yy)*(super_x*12),
+			buffer_z + (x+1)*12 + (y+yy)*(super_x*12)
+		);
+	}
+
+	// STORE
+	for(int xx = 0; xx < step_x; xx++)
+	{
+		for(int yy = 0; yy < step_y; yy++)
+		{
+			for(int zz = 0; zz < step_z; zz++)
+			{
+				// virtual => real coordinates
+				const int pos_x = virt2real_error(x-shift, xx, overlap_x_L, size_x);
+				const int pos_y = virt2real_error(y-shift, yy, overlap_y_L, size_y);
+				const int pos_z = virt2real_error(z-shift, zz, overlap_z_L, size_z);
+
+				if( pos_x < 0 || pos_y < 0 || pos_z < 0 )
+					continue;
+
+				// NOTE: transposed x<->y, then y<->z
+				*( (float *)( (char *)dst_ptr + pos_x*dst_stride_x + pos_y*dst_stride_y + pos_z*dst_stride_z ) ) = t[xx][yy*step_x+zz];
+			}
+		}
+	}
+#endif
 }
 
-int volume_measure_fwd97op_s(int size_min, int size_max, int size_step, int N, int opt_stride, enum volume_approach approach)
+/**
+ * run the inverse core over the whole volume, inlined in order to inline the core
+ */
+static inline ALWAYS_INLINE
+void icube_run(
+	struct volume_t *volume_src,
+	struct volume_t *volume_dst,
+	icube_func_t core,
+	// step_x, step_y, step_z
+	int step_x,
+	int step_y,
+	int step_z,
+	// overlap_x_R, overlap_y_R, overlap_z_R
+	int overlap_R,
+	// width of buffers
+	int buff_elem_size,
+	// reuse the buffers of the finished rows and slices
+	int horiz
+)
+{
+	assert( volume_dst );
+	assert( volume_src );
+	assert( volume_dst->size_x == volume_src->size_x );
+	assert( volume_dst->size_y == volume_src->size_y );
+	assert( volume_dst->size_z == volume_src->size_z );
+
+	// super sizes
+	const int super_x = /*overlap_x_L*/4 + volume_src->size_x + overlap_R;
+	const int super_y = /*overlap_y_L*/4 + volume_src->size_y + overlap_R;
+	const int super_z = /*overlap_z_L*/4 + volume_src->size_z + overlap_R;
+
+	assert( 0 == super_x % step_x );
+	assert( 0 == super_y % step_y );
+	assert( 0 == super_z % step_z );
+
+	// alloc buffers
+	const int buffer_x_elems = (horiz ? step_y*step_z : super_y*super_z) * buff_elem_size;
+	const int buffer_y_elems = super_x*(horiz ? step_z : super_z) * buff_elem_size;
+	const int buffer_z_elems = super_x*super_y * buff_elem_size;
+
+	float * ALIGNED(16) buffer_x = dwt_util_alloc_aligned_ex_reliably(buffer_x_elems, sizeof(float), 16);
+	float * ALIGNED(16) buffer_y = dwt_util_alloc_aligned_ex_reliably(buffer_y_elems, sizeof(float), 16);
+	float * ALIGNED(16) buffer_z = dwt_util_alloc_aligned_ex_reliably(buffer_z_elems, sizeof(float), 16);
+
+	// for each z
+	for(int z = 0; z < super_z; z += step_z)
+		// for each y
+		for(int y = 0; y < super_y; y += step_y)
+			// for each x (CPU cache friendly)
+			for(int x = 0; x < super_x; x += step_x)
+			{
+				// call cube core
+				core(
+					// coordinates
+					x,
+					y,
+					z,
+					// image size
+					volume_src->size_x,
+					volume_src->size_y,
+					volume_src->size_z,
+					// poiter to pixel at (0,0,0) in struct volume_t
+					volume_src->data,
+					// strides (to address another pixels)
+					volume_src->stride_x,
+					volume_src->stride_y,
+					volume_src->stride_z,
+					// poiter to pixel at (0,0,0) in struct volume_t
+					volume_dst->data,
+					// strides (to address another pixels)
+					volume_dst->stride_x,
+					volume_dst->stride_y,
+					volume_dst->stride_z,
+					// pointers to three buffers (aligned to 16 bytes = 4 floats)
+					buffer_x,
+					buffer_y,
+					buffer_z,
+					// super sizes in order to access elements in buffers
+					super_x,
+					super_y,
+					super_z,
+					horiz
+				);
+			}
+
+	free(buffer_x);
+	free(buffer_y);
+	free(buffer_z);
+}
+
+void cdf97_3i_op_baseline_vert2x2x2_s(struct volume_t *volume_src, struct volume_t *volume_dst)
+{
+	icube_run(volume_src, volume_dst, icube_2x2x2, 2, 2, 2, 4, 4, 0);
+}
+
+void cdf97_3i_op_HORIZ_vert2x2x2_s(struct volume_t *volume_src, struct volume_t *volume_dst)
+{
+	icube_run(volume_src, volume_dst, icube_2x2x2, 2, 2, 2, 4, 4, 1);
+}
+
+void cdf97_3i_op_cube_vert4x4x2_s(struct volume_t *volume_src, struct volume_t *volume_dst)
+{
+	icube_run(volume_src, volume_dst, icube_4x4x2, 4, 4, 2, 4, 4, 0);
+}
+
+void cdf97_3i_op_HORIZ_vert4x4x2_s(struct volume_t *volume_src, struct volume_t *volume_dst)
+{
+	icube_run(volume_src, volume_dst, icube_4x4x2, 4, 4, 2, 4, 4, 1);
+}
+
+void cdf97_3i_op_HORIZ_vert4x4x4_s(struct volume_t *volume_src, struct volume_t *volume_dst)
+{
+	icube_run(volume_src, volume_dst, icube_4x4x4, 4, 4, 4, 4, 4, 1);
+}
+
+void cdf97_3i_op_baseline_diag2x2x2_s(struct volume_t *volume_src, struct volume_t *volume_dst)
+{
+	icube_run(volume_src, volume_dst, icube_diag2x2x2, 2, 2, 2, 10, 12, 0);
+}
+
+void cdf97_3i_op_HORIZ_diag2x2x2_s(struct volume_t *volume_src, struct volume_t *volume_dst)
+{
+	icube_run(volume_src, volume_dst, icube_diag2x2x2, 2, 2, 2, 10, 12, 1);
+}
+
+void cdf97_3f_op_wrapper_s(struct volume_t *volume_src, struct volume_t *volume_dst, enum volume_approach approach)
+{
+	assert( approach >= 0 && approach < VOL_LAST );
+
+	volume_func_t volume_func[VOL_LAST] = {
+		[VOL_SEP_HORIZONTAL] = cdf97_3f_op_sep_horizontal_s,
+		[VOL_SEP_VERTICAL] = cdf97_3f_op_sep_vertical_s,
+		[VOL_SLICES_VERT4X4] = cdf97_3f_op_slices_vert4x4_s,
+		[VOL_BASELINE_VERT2X2X2] = cdf97_3f_op_baseline_vert2x2x2_s,
+		[VOL_HORIZ_VERT2X2X2] = cdf97_3f_op_HORIZ_vert2x2x2_s,
+		[VOL_BASELINE_VERT4X4X2] = cdf97_3f_op_cube_vert4x4x2_s,
+		[VOL_HORIZ_VERT4X4X2] = cdf97_3f_op_HORIZ_vert4x4x2_s,
+		[VOL_HORIZ_VERT4X4X4] = cdf97_3f_op_HORIZ_vert4x4x4_s,
+		[VOL_BASELINE_DIAG2X2X2] = cdf97_3f_op_baseline_diag2x2x2_s,
+		[VOL_HORIZ_DIAG2X2X2] = cdf97_3f_op_HORIZ_diag2x2x2_s,
+		[VOL_SEP_HORIZONTAL_X] = cdf97_3f_op_sep_horizontal_x_s,
+		[VOL_SEP_HORIZONTAL_Y] = cdf97_3f_op_sep_horizontal_y_s,
+		[VOL_SEP_HORIZONTAL_Z] = cdf97_3f_op_sep_horizontal_z_s,
+	};
+
+	// the single-direction variants measure a single direction only, they are never split
+	if( volume_src != volume_dst && approach < VOL_SEP_HORIZONTAL_X && volume_slabs_enabled(volume_src) )
+		volume_op_slabs(volume_src, volume_dst, volume_func[approach]);
+	else
+		volume_func[approach](volume_src, volume_dst);
+}
+
+void cdf97_3i_op_wrapper_s(struct volume_t *volume_src, struct volume_t *volume_dst, enum volume_approach approach)
+{
+	assert( approach >= 0 && approach < VOL_LAST );
+
+	volume_func_t volume_func[VOL_LAST] = {
+		[VOL_SEP_HORIZONTAL] = cdf97_3i_op_sep_horizontal_s,
+		[VOL_SEP_VERTICAL] = cdf97_3i_op_sep_vertical_s,
+		[VOL_SLICES_VERT4X4] = cdf97_3i_op_slices_vert4x4_s,
+		[VOL_BASELINE_VERT2X2X2] = cdf97_3i_op_baseline_vert2x2x2_s,
+		[VOL_HORIZ_VERT2X2X2] = cdf97_3i_op_HORIZ_vert2x2x2_s,
+		[VOL_BASELINE_VERT4X4X2] = cdf97_3i_op_cube_vert4x4x2_s,
+		[VOL_HORIZ_VERT4X4X2] = cdf97_3i_op_HORIZ_vert4x4x2_s,
+		[VOL_HORIZ_VERT4X4X4] = cdf97_3i_op_HORIZ_vert4x4x4_s,
+		[VOL_BASELINE_DIAG2X2X2] = cdf97_3i_op_baseline_diag2x2x2_s,
+		[VOL_HORIZ_DIAG2X2X2] = cdf97_3i_op_HORIZ_diag2x2x2_s,
+		[VOL_SEP_HORIZONTAL_X] = cdf97_3i_op_sep_horizontal_x_s,
+		[VOL_SEP_HORIZONTAL_Y] = cdf97_3i_op_sep_horizontal_y_s,
+		[VOL_SEP_HORIZONTAL_Z] = cdf97_3i_op_sep_horizontal_z_s,
+	};
+
+	// the single-direction variants measure a single direction only, they are never split
+	if( volume_src != volume_dst && approach < VOL_SEP_HORIZONTAL_X && volume_slabs_enabled(volume_src) )
+		volume_op_slabs(volume_src, volume_dst, volume_func[approach]);
+	else
+		volume_func[approach](volume_src, volume_dst);
+}
+
+static
+int volume_perftest_97op_s(
+	int size, // size_x, size_y_ size_z
+	int opt_stride,
+	enum volume_approach approach,
+	int N, // tests, select minimum
+	double *secs, // seconds per pixel
+	long unsigned *faults, // page faults
+	int inverse // measure the inverse transform instead of the forward one
+)
+{
+	const int pixels = size*size*size;
+	const int clock_type = dwt_util_clock_autoselect();
+
+	int return_code = 0;
+	*secs = +INFINITY;
+	*faults = 0 /*ULONG_MAX*/;
+
+	// allocate
+	struct volume_t *data1 = volume_alloc_realiably_locked(sizeof(float), size, size, size, opt_stride);
+	struct volume_t *data2 = volume_alloc_realiably_locked(sizeof(float), size, size, size, opt_stride);
+
+	for(int n = 0; n < N; n++)
+	{
+		// fill with test pattern
+		volume_fill_s(data1);
+
+		// the coefficients for the inverse transform
+		if( inverse )
+			cdf97_3f_op_wrapper_s(data1, data2, approach);
+
+		// invalidate CPU cache
+		volume_invalidate_cache(data1);
+		volume_invalidate_cache(data2);
+
+		// start measurement
+		long unsigned page_faults_start = dwt_util_get_page_fault();
+		dwt_clock_t start = dwt_util_get_clock(clock_type);
+
+		// forward or inverse transform
+		if( inverse )
+			cdf97_3i_op_wrapper_s(data2, data1, approach);
+		else
+			cdf97_3f_op_wrapper_s(data1, data2, approach);
+
+		// stop measurement
+		dwt_clock_t stop = dwt_util_get_clock(clock_type);
+		long unsigned page_faults_stop = dwt_util_get_page_fault();
+
+		// elapsed time
+		const double elapsed_time_in_seconds = (stop - start)/(double)dwt_util_get_frequency(clock_type);
+		const double secs_per_pel = elapsed_time_in_seconds/pixels;
+
+		// new page faults
+		long unsigned page_faults = page_faults_stop - page_faults_start;
+#if 0
+		dwt_util_log(LOG_DBG, "page faults: %lu - %lu = %lu\n", page_faults_stop, page_faults_start, page_faults);
+#endif
+
+		// select minimum time
+		if( secs_per_pel < *secs )
+			*secs = secs_per_pel;
+
+		// select minimum faults
+		if( page_faults > /*<*/ *faults )
+			*faults = page_faults;
+
+		if( inverse )
+		{
+			// the original volume
+			volume_fill_s(data2);
+		}
+		else
+		{
+			// inverse transform
+			cdf97_3i_ip_sep_horizontal_s(data2);
+		}
+
+		// compare volumes
+		const int error = volume_compare_s(data1, data2);
+		return_code += error;
+	}
+
+	// free data
+	volume_free(data1);
+	volume_free(data2);
+
+	return return_code;
+}
+
+int volume_perftest_fwd97op_s(
+	int size,
+	int opt_stride,
+	enum volume_approach approach,
+	int N,
+	double *secs,
+	long unsigned *faults
+)
+{
+	return volume_perftest_97op_s(size, opt_stride, approach, N, secs, faults, 0);
+}
+
+int volume_perftest_inv97op_s(
+	int size,
+	int opt_stride,
+	enum volume_approach approach,
+	int N,
+	double *secs,
+	long unsigned *faults
+)
+{
+	return volume_perftest_97op_s(size, opt_stride, approach, N, secs, faults, 1);
+}
+
+static
+int size_grow(int size, int align)
+{
+	assert( is_pow2(align) );
+
+	extern float g_growth_factor_s;
+
+	size *= g_growth_factor_s;
+	size += 1;
+	size +=  (align-1);
+	size &= ~(align-1);
+
+	return size;
+}
+
+static
+int volume_measure_97op_s(int size_min, int size_max, int size_step, int N, int opt_stride, enum volume_approach approach, int inverse)
 {
 	char path[4096];
 
-	sprintf(path, "data/perftest/time-stride=%i-approach=%i.txt", opt_stride, approach);
+	// the inverse transform is prefixed
+	const char *prefix = inverse ? "inv-" : "";
+
+	sprintf(path, "data/perftest/%stime-stride=%i-approach=%i.txt", prefix, opt_stride, approach);
 
 #ifdef DEBUG
 	dwt_util_log(LOG_DBG, "file=%s\n", path);
@@ -2912,15 +4805,26 @@ int volume_measure_fwd97op_s(int size_min, int size_max, int size_step, int N, i
 		dwt_util_error("unable to open file: %s\n", path);
 	}
 
-	sprintf(path, "data/perftest/faults-stride=%i-approach=%i.txt", opt_stride, approach);
+	sprintf(path, "data/perftest/%sfaults-stride=%i-approach=%i.txt", prefix, opt_stride, approach);
 	FILE *file_faults = fopen(path, "w");
 	if( !file_faults )
 	{
 		dwt_util_error("unable to open file: %s\n", path);
 	}
 
+	sprintf(path, "data/perftest/%sscaling-stride=%i-approach=%i.txt", prefix, opt_stride, approach);
+	FILE *file_scaling = fopen(path, "w");
+	if( !file_scaling )
+	{
+		dwt_util_error("unable to open file: %s\n", path);
+	}
+
 	fprintf(file_time, "# voxels secs/pel\n");
 	fprintf(file_faults, "# voxels page_faults\n");
+	fprintf(file_scaling, "# voxels threads secs/pel(1 thread) speedup\n");
+
+	const int threads = dwt_util_get_num_threads();
+	const int pool_threads = dwt_pool_get_threads();
 
 	int total_errors = 0;
 
@@ -2929,30 +4833,66 @@ int volume_measure_fwd97op_s(int size_min, int size_max, int size_step, int N, i
 		double secs;
 		long unsigned faults;
 
-		int errors = volume_perftest_fwd97op_s(
+		int errors = volume_perftest_97op_s(
 			size,
 			opt_stride,
 			approach,
 			N,
 			&secs,
-			&faults
+			&faults,
+			inverse
 		);
 
+		// the same using a single thread
+		double secs_serial = secs;
+
+		if( threads > 1 )
+		{
+			long unsigned faults_serial;
+
+			dwt_util_set_num_threads(1);
+
+			errors += volume_perftest_97op_s(
+				size,
+				opt_stride,
+				approach,
+				N,
+				&secs_serial,
+				&faults_serial,
+				inverse
+			);
+
+			dwt_util_set_num_threads(threads);
+			dwt_pool_set_threads(pool_threads);
+		}
+
 		const int voxels = size*size*size;
 
 		dwt_util_log(LOG_INFO,
-			"perftest: size=%4i opt_stride=%i approach=%2i (N=%2i): time=%f [nsecs/pel]; errors=%i; faults=%lu\n",
-			size, opt_stride, approach, N, secs*1e9, errors, faults
+			"perftest: size=%4i opt_stride=%i approach=%2i%s (N=%2i): time=%f [nsecs/pel]; errors=%i; faults=%lu; threads=%i; speedup=%.2f\n",
+			size, opt_stride, approach, inverse ? " inverse" : "", N, secs*1e9, errors, faults, threads, secs_serial/secs
 		);
 
 		fprintf(file_time, "%i\t%.20f\n", voxels, secs);
 		fprintf(file_faults, "%i\t%lu\n", voxels, faults);
+		fprintf(file_scaling, "%i\t%i\t%.20f\t%f\n", voxels, threads, secs_serial, secs_serial/secs);
 
 		total_errors += errors;
 	}
 
 	fclose(file_time);
 	fclose(file_faults);
+	fclose(file_scaling);
 
 	return total_errors;
 }
+
+int volume_measure_fwd97op_s(int size_min, int size_max, int size_step, int N, int opt_stride, enum volume_approach approach)
+{
+	return volume_measure_97op_s(size_min, size_max, size_step, N, opt_stride, approach, 0);
+}
+
+int volume_measure_inv97op_s(int size_min, int size_max, int size_step, int N, int opt_stride, enum volume_approach approach)
+{
+	return volume_measure_97op_s(size_min, size_max, size_step, N, opt_stride, approach, 1);
+}
@@ -8,6 +8,9 @@
  *
  * Plain 1-D horizontal vectorization separated for each direction.
  *
+ * The slabs of @ref cdf97_3f_op_wrapper_s are used if several threads are
+ * available.
+ *
  * * dimensions: 3-D
  * * direction: forward
  * * scales: 1
@@ -207,6 +210,208 @@ void cdf97_3f_op_HORIZ_vert4x4x4_s(struct volume_t *volume_src, struct volume_t
  */
 void cdf97_3i_ip_sep_horizontal_s(struct volume_t *volume);
 
+/**
+ * @brief Inverse 3-D transform.
+ *
+ * The counterpart of @ref cdf97_3f_op_sep_horizontal_s.
+ *
+ * * dimensions: 3-D
+ * * direction: inverse
+ * * scales: 1
+ * * wavelet: CDF 9/7
+ * * data type: float
+ * * vectorization: horizontal
+ * * approach: separated for each dimension
+ * * strategy: out-of-place
+ * * layout: interleaved subbands
+ */
+void cdf97_3i_op_sep_horizontal_s(struct volume_t *volume_src, struct volume_t *volume_dst);
+
+/**
+ * @brief Inverse 3-D transform.
+ *
+ * The counterpart of @ref cdf97_3f_op_sep_vertical_s.
+ *
+ * * dimensions: 3-D
+ * * direction: inverse
+ * * scales: 1
+ * * wavelet: CDF 9/7
+ * * data type: float
+ * * vectorization: vertical
+ * * approach: separated for each dimension
+ * * strategy: out-of-place
+ * * layout: interleaved subbands
+ */
+void cdf97_3i_op_sep_vertical_s(struct volume_t *volume_src, struct volume_t *volume_dst);
+
+/**
+ * @brief Inverse 3-D transform.
+ *
+ * The counterpart of @ref cdf97_3f_op_slices_vert4x4_s.
+ *
+ * * dimensions: 3-D
+ * * direction: inverse
+ * * scales: 1
+ * * wavelet: CDF 9/7
+ * * data type: float
+ * * vectorization: combined (both vertical)
+ * * approach: combined, 2-D core vert4x4 per slices, then separated vertical over z-axe
+ * * strategy: out-of-place
+ * * layout: interleaved subbands
+ */
+void cdf97_3i_op_slices_vert4x4_s(struct volume_t *volume_src, struct volume_t *volume_dst);
+
+/**
+ * @brief Inverse 3-D transform.
+ *
+ * The counterpart of @ref cdf97_3f_op_baseline_vert2x2x2_s.
+ *
+ * * dimensions: 3-D
+ * * direction: inverse
+ * * scales: 1
+ * * wavelet: CDF 9/7
+ * * data type: float
+ * * vectorization: vertical
+ * * approach: 3-D core vert2x2x2
+ * * strategy: out-of-place
+ * * layout: interleaved subbands
+ */
+void cdf97_3i_op_baseline_vert2x2x2_s(struct volume_t *volume_src, struct volume_t *volume_dst);
+
+/**
+ * @brief Inverse 3-D transform.
+ *
+ * The counterpart of @ref cdf97_3f_op_HORIZ_vert2x2x2_s.
+ *
+ * * dimensions: 3-D
+ * * direction: inverse
+ * * scales: 1
+ * * wavelet: CDF 9/7
+ * * data type: float
+ * * vectorization: vertical
+ * * approach: 3-D core vert2x2x2
+ * * strategy: out-of-place
+ * * layout: interleaved subbands
+ */
+void cdf97_3i_op_HORIZ_vert2x2x2_s(struct volume_t *volume_src, struct volume_t *volume_dst);
+
+/**
+ * @brief Inverse 3-D transform.
+ *
+ * The counterpart of @ref cdf97_3f_op_cube_vert4x4x2_s.
+ *
+ * * dimensions: 3-D
+ * * direction: inverse
+ * * scales: 1
+ * * wavelet: CDF 9/7
+ * * data type: float
+ * * vectorization: vertical
+ * * approach: 3-D core vert4x4x2
+ * * strategy: out-of-place
+ * * layout: interleaved subbands
+ */
+void cdf97_3i_op_cube_vert4x4x2_s(struct volume_t *volume_src, struct volume_t *volume_dst);
+
+/**
+ * @brief Inverse 3-D transform.
+ *
+ * The counterpart of @ref cdf97_3f_op_HORIZ_vert4x4x2_s.
+ *
+ * * dimensions: 3-D
+ * * direction: inverse
+ * * scales: 1
+ * * wavelet: CDF 9/7
+ * * data type: float
+ * * vectorization: vertical
+ * * approach: 3-D core vert4x4x2
+ * * strategy: out-of-place
+ * * layout: interleaved subbands
+ */
+void cdf97_3i_op_HORIZ_vert4x4x2_s(struct volume_t *volume_src, struct volume_t *volume_dst);
+
+/**
+ * @brief Inverse 3-D transform.
+ *
+ * The counterpart of @ref cdf97_3f_op_HORIZ_vert4x4x4_s.
+ *
+ * * dimensions: 3-D
+ * * direction: inverse
+ * * scales: 1
+ * * wavelet: CDF 9/7
+ * * data type: float
+ * * vectorization: vertical
+ * * approach: 3-D core vert4x4x4
+ * * strategy: out-of-place
+ * * layout: interleaved subbands
+ */
+void cdf97_3i_op_HORIZ_vert4x4x4_s(struct volume_t *volume_src, struct volume_t *volume_dst);
+
+/**
+ * @brief Inverse 3-D transform.
+ *
+ * The counterpart of @ref cdf97_3f_op_baseline_diag2x2x2_s.
+ *
+ * * dimensions: 3-D
+ * * direction: inverse
+ * * scales: 1
+ * * wavelet: CDF 9/7
+ * * data type: float
+ * * vectorization: diagonal
+ * * approach: 3-D core diag2x2x2
+ * * strategy: out-of-place
+ * * layout: interleaved subbands
+ */
+void cdf97_3i_op_baseline_diag2x2x2_s(struct volume_t *volume_src, struct volume_t *volume_dst);
+
+/**
+ * @brief Inverse 3-D transform.
+ *
+ * The counterpart of @ref cdf97_3f_op_HORIZ_diag2x2x2_s.
+ *
+ * * dimensions: 3-D
+ * * direction: inverse
+ * * scales: 1
+ * * wavelet: CDF 9/7
+ * * data type: float
+ * * vectorization: diagonal
+ * * approach: 3-D core diag2x2x2
+ * * strategy: out-of-place
+ * * layout: interleaved subbands
+ */
+void cdf97_3i_op_HORIZ_diag2x2x2_s(struct volume_t *volume_src, struct volume_t *volume_dst);
+
+/**
+ * @brief Forward multi-scale 3-D transform.
+ *
+ * All the levels are computed in a single pass over the volume. The slices
+ * are streamed along the z-axis, each level keeps the progress of its
+ * lifting steps over the z-axis. A slice of a level is transformed over the
+ * x- and y-axes once it arrives, the lifting over the z-axis follows as soon
+ * as the neighbouring slices are available. The final lowpass slices are
+ * immediately passed to the next level. Thus, only a few recent slices of
+ * each level are touched at a time. The coarser levels keep these slices
+ * contiguous in per-level plane buffers and store them into the volume once
+ * they are final. The result is the same as @p J
+ * repetitions of @ref cdf97_3f_ip_sep_horizontal_s on the lowpass subband.
+ *
+ * * dimensions: 3-D
+ * * direction: forward
+ * * scales: J
+ * * wavelet: CDF 9/7
+ * * data type: float
+ * * vectorization: horizontal
+ * * approach: fused multi-scale, slices streamed over z-axe
+ * * strategy: out-of-place (in-place if @p volume_src equals @p volume_dst)
+ * * layout: interleaved subbands, the level j at the strides multiplied by 2^j
+ *
+ * @return the number of levels performed
+ */
+int cdf97_3f_op_ms_fused_s(
+	struct volume_t *volume_src,
+	struct volume_t *volume_dst,
+	int J	///< the number of levels, negative value for the maximal number
+);
+
 enum volume_approach {
 	VOL_SEP_HORIZONTAL = 0,
 	VOL_SEP_VERTICAL = 1,
@@ -224,8 +429,24 @@ enum volume_approach {
 	VOL_LAST
 };
 
+/**
+ * @brief Forward transform using the approach @p approach.
+ *
+ * If several threads are available (see @ref dwt_util_get_num_threads), the
+ * volume is partitioned into slabs of slices. Each slab is transformed by
+ * its own thread including a halo of four slices to each side, the halos are
+ * dropped afterwards. The result is the same as with a single thread.
+ */
 void cdf97_3f_op_wrapper_s(struct volume_t *volume_src, struct volume_t *volume_dst, enum volume_approach approach);
 
+/**
+ * @brief Inverse transform using the approach @p approach.
+ *
+ * The inverse of @ref cdf97_3f_op_wrapper_s using the same approach. The
+ * slabs are used in the same way.
+ */
+void cdf97_3i_op_wrapper_s(struct volume_t *volume_src, struct volume_t *volume_dst, enum volume_approach approach);
+
 /**
  * @brief Perform a single measurment.
  *
@@ -240,8 +461,29 @@ int volume_perftest_fwd97op_s(
 	long unsigned *faults // page faults
 );
 
+/**
+ * @brief Perform a single measurment of the inverse transform.
+ *
+ * The coefficients are produced by @ref cdf97_3f_op_wrapper_s using the
+ * same approach, the inverse transform by @ref cdf97_3i_op_wrapper_s is
+ * measured.
+ *
+ * @return zero if the test pass; non-zero if fails
+ */
+int volume_perftest_inv97op_s(
+	int size, // size_x, size_y_ size_z
+	int opt_stride,
+	enum volume_approach approach,
+	int N, // tests, select minimum
+	double *secs, // seconds per pixel
+	long unsigned *faults // page faults
+);
+
 /**
  * @brief Perform series of measurments.
+ *
+ * If several threads are used, the measurement is repeated using a single
+ * thread and the speedup is reported.
  */
 int volume_measure_fwd97op_s(
 	int size_min,
@@ -252,4 +494,19 @@ int volume_measure_fwd97op_s(
 	enum volume_approach approach
 );
 
+/**
+ * @brief Perform series of measurments of the inverse transform.
+ *
+ * The results are written next to the ones of @ref volume_measure_fwd97op_s
+ * with the "inv-" prefix.
+ */
+int volume_measure_inv97op_s(
+	int size_min,
+	int size_max,
+	int size_step,
+	int N,
+	int opt_stride,
+	enum volume_approach approach
+);
+
 #endif